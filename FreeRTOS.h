@@ -142,6 +142,10 @@ extern "C" {
 	#error Missing definition:  configUSE_16_BIT_TICKS must be defined in FreeRTOSConfig.h as either 1 or 0.  See the Configuration section of the FreeRTOS API documentation for details.
 #endif
 
+#ifndef configUSE_64_BIT_TICKS
+	#define configUSE_64_BIT_TICKS 0
+#endif
+
 #ifndef configMAX_PRIORITIES
 	#error configMAX_PRIORITIES must be defined to be greater than or equal to 1.
 #endif
@@ -618,6 +622,62 @@ extern "C" {
 	#define traceEVENT_GROUP_DELETE( xEventGroup )
 #endif
 
+#ifndef traceSTREAM_BUFFER_CREATE_FAILED
+	#define traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+	#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FAILED
+	#define traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+	#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+	#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FAILED
+	#define traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceBLOCK_POOL_CREATE
+	#define traceBLOCK_POOL_CREATE( xBlockPool )
+#endif
+
+#ifndef traceBLOCK_POOL_CREATE_FAILED
+	#define traceBLOCK_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceBLOCK_POOL_DELETE
+	#define traceBLOCK_POOL_DELETE( xBlockPool )
+#endif
+
+#ifndef traceBLOCK_POOL_ALLOCATE
+	#define traceBLOCK_POOL_ALLOCATE( xBlockPool, pvBlock )
+#endif
+
+#ifndef traceBLOCK_POOL_FREE
+	#define traceBLOCK_POOL_FREE( xBlockPool, pvBlock )
+#endif
+
 #ifndef tracePEND_FUNC_CALL
 	#define tracePEND_FUNC_CALL(xFunctionToPend, pvParameter1, ulParameter2, ret)
 #endif
@@ -631,37 +691,43 @@ extern "C" {
 #endif
 
 #ifndef traceTASK_NOTIFY_TAKE_BLOCK
-	#define traceTASK_NOTIFY_TAKE_BLOCK()
+	#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )
 #endif
 
 #ifndef traceTASK_NOTIFY_TAKE
-	#define traceTASK_NOTIFY_TAKE()
+	#define traceTASK_NOTIFY_TAKE( uxIndexToWait )
 #endif
 
 #ifndef traceTASK_NOTIFY_WAIT_BLOCK
-	#define traceTASK_NOTIFY_WAIT_BLOCK()
+	#define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )
 #endif
 
 #ifndef traceTASK_NOTIFY_WAIT
-	#define traceTASK_NOTIFY_WAIT()
+	#define traceTASK_NOTIFY_WAIT( uxIndexToWait )
 #endif
 
 #ifndef traceTASK_NOTIFY
-	#define traceTASK_NOTIFY()
+	#define traceTASK_NOTIFY( uxIndexToNotify )
 #endif
 
 #ifndef traceTASK_NOTIFY_FROM_ISR
-	#define traceTASK_NOTIFY_FROM_ISR()
+	#define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )
 #endif
 
 #ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
-	#define traceTASK_NOTIFY_GIVE_FROM_ISR()
+	#define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )
 #endif
 
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
 
+/* The type of the run time counter, which can be set to uint64_t when the run
+time counter clock is fast enough for a 32-bit count to overflow. */
+#ifndef configRUN_TIME_COUNTER_TYPE
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
@@ -708,6 +774,101 @@ extern "C" {
 	#define configUSE_TICKLESS_IDLE 0
 #endif
 
+#ifndef configUSE_TIMING_WHEEL
+	#define configUSE_TIMING_WHEEL 0
+#endif
+
+#ifndef configUSE_SKIP_LIST
+	#define configUSE_SKIP_LIST 0
+#endif
+
+#ifndef configSKIP_LIST_LEVELS
+	#define configSKIP_LIST_LEVELS 4
+#endif
+
+#ifndef configUSE_QUEUE_ZERO_COPY
+	#define configUSE_QUEUE_ZERO_COPY 0
+#endif
+
+#ifndef configUSE_QUEUE_BATCHING
+	#define configUSE_QUEUE_BATCHING 0
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configUSE_PERIOD_MONITOR
+	#define configUSE_PERIOD_MONITOR 0
+#endif
+
+/* The number of buckets in each period monitor histogram.  Bucket 0 counts
+times below ( 1 << configPERIOD_MONITOR_RESOLUTION_BITS ) run time counter
+units, each following bucket counts times up to twice as long as the bucket
+before it, and the last bucket also counts everything longer. */
+#ifndef configPERIOD_MONITOR_BUCKETS
+	#define configPERIOD_MONITOR_BUCKETS 24
+#endif
+
+#ifndef configPERIOD_MONITOR_RESOLUTION_BITS
+	#define configPERIOD_MONITOR_RESOLUTION_BITS 10
+#endif
+
+#ifndef configUSE_DEADLINE_MISS_HOOK
+	#define configUSE_DEADLINE_MISS_HOOK 0
+#endif
+
+#if( configUSE_PERIOD_MONITOR == 1 )
+	#if( configGENERATE_RUN_TIME_STATS == 0 )
+		#error configUSE_PERIOD_MONITOR requires configGENERATE_RUN_TIME_STATS to be 1 as it is timed by the run time counter.
+	#endif
+
+	#if( INCLUDE_vTaskDelayUntil == 0 ) && ( configUSE_EDF_SCHEDULING == 0 )
+		#error configUSE_PERIOD_MONITOR requires INCLUDE_vTaskDelayUntil or configUSE_EDF_SCHEDULING to be 1 as periodic tasks are monitored through vTaskDelayUntil() and xTaskWaitForNextPeriod().
+	#endif
+#endif
+
+#if( configUSE_DEADLINE_MISS_HOOK == 1 ) && ( configUSE_PERIOD_MONITOR == 0 )
+	#error configUSE_DEADLINE_MISS_HOOK requires configUSE_PERIOD_MONITOR to be 1.
+#endif
+
+/* The functions used to allocate and free the memory of dynamically created
+tasks and queues.  They can be defined in FreeRTOSConfig.h to take fixed size
+objects from block pools (see block_pool.h) rather than from the heap. */
+#ifndef configTASK_TCB_MALLOC
+	#define configTASK_TCB_MALLOC( xSize ) pvPortMalloc( xSize )
+#endif
+
+#ifndef configTASK_TCB_FREE
+	#define configTASK_TCB_FREE( pv ) vPortFree( pv )
+#endif
+
+#ifndef configTASK_STACK_MALLOC
+	#define configTASK_STACK_MALLOC( xSize ) pvPortMalloc( xSize )
+#endif
+
+#ifndef configTASK_STACK_FREE
+	#define configTASK_STACK_FREE( pv ) vPortFree( pv )
+#endif
+
+#ifndef configQUEUE_MALLOC
+	#define configQUEUE_MALLOC( xSize ) pvPortMalloc( xSize )
+#endif
+
+#ifndef configQUEUE_FREE
+	#define configQUEUE_FREE( pv ) vPortFree( pv )
+#endif
+
+#ifndef configNUM_CORES
+	#define configNUM_CORES 1
+#endif
+
+/* Called by the idle tasks to wait for the next interrupt.  Only ports that
+implement configNUM_CORES > 1 need to define it. */
+#ifndef portWAIT_FOR_INTERRUPT
+	#define portWAIT_FOR_INTERRUPT()
+#endif
+
 #ifndef configPRE_SLEEP_PROCESSING
 	#define configPRE_SLEEP_PROCESSING( x )
 #endif
@@ -768,6 +929,14 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES < 1 )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
 	#define portTICK_TYPE_IS_ATOMIC 0
 #endif
@@ -789,6 +958,18 @@ extern "C" {
 	#endif /* INCLUDE_vTaskSuspend */
 #endif /* configUSE_TICKLESS_IDLE */
 
+#if( ( configUSE_64_BIT_TICKS == 1 ) && ( configUSE_16_BIT_TICKS == 1 ) )
+	#error configUSE_64_BIT_TICKS and configUSE_16_BIT_TICKS cannot both be 1.
+#endif
+
+#if( ( configUSE_TIMING_WHEEL == 1 ) && ( configUSE_16_BIT_TICKS == 1 ) )
+	#error configUSE_TIMING_WHEEL cannot be used with 16 bit ticks as the timing wheel covers 2^20 ticks.
+#endif
+
+#if( ( configUSE_SKIP_LIST == 1 ) && ( configSKIP_LIST_LEVELS < 1 ) )
+	#error configSKIP_LIST_LEVELS must be at least 1 when configUSE_SKIP_LIST is set to 1
+#endif
+
 #if( ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
@@ -797,6 +978,28 @@ extern "C" {
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( configNUM_CORES > 1 )
+	#ifndef portGET_CORE_ID
+		#error configNUM_CORES is greater than 1 but the port does not support more than one core.
+	#endif
+
+	#if( configNUM_CORES > 32 )
+		#error configNUM_CORES cannot be greater than 32 as core affinity masks hold one bit per core.
+	#endif
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE must be 0 when configNUM_CORES is greater than 1.
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		#error configUSE_EDF_SCHEDULING cannot be used when configNUM_CORES is greater than 1.
+	#endif
+
+	#if( configUSE_CO_ROUTINES != 0 )
+		#error configUSE_CO_ROUTINES must be 0 when configNUM_CORES is greater than 1 as the co-routine lists are not protected against concurrent access.
+	#endif
+#endif /* configNUM_CORES */
+
 #if( portTICK_TYPE_IS_ATOMIC == 0 )
 	/* Either variables of tick type cannot be read atomically, or
 	portTICK_TYPE_IS_ATOMIC was not set - map the critical sections used when
@@ -875,6 +1078,10 @@ struct xSTATIC_LIST_ITEM
 {
 	TickType_t xDummy1;
 	void *pvDummy2[ 4 ];
+	#if( configUSE_SKIP_LIST == 1 )
+		void *pvDummy3[ 2 * configSKIP_LIST_LEVELS ];
+		UBaseType_t uxDummy4;
+	#endif
 };
 typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
 
@@ -892,6 +1099,9 @@ typedef struct xSTATIC_LIST
 	UBaseType_t uxDummy1;
 	void *pvDummy2;
 	StaticMiniListItem_t xDummy3;
+	#if( configUSE_SKIP_LIST == 1 )
+		void *pvDummy4[ configSKIP_LIST_LEVELS ];
+	#endif
 } StaticList_t;
 
 /*
@@ -936,18 +1146,31 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE	ulDummy16[ 3 ];
+		uint32_t		ulDummy24;
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t			uxDummy20;
 	#endif
+	#if( configNUM_CORES > 1 )
+		BaseType_t		xDummy22;
+		UBaseType_t		uxDummy23;
+	#endif
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xDummy25[ 4 ];
+	#endif
+	#if( configUSE_PERIOD_MONITOR == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulDummy26[ 3 ];
+		uint32_t		ulDummy27[ 4 + ( 2 * configPERIOD_MONITOR_BUCKETS ) ];
+		uint8_t			ucDummy28;
+	#endif
 
 } StaticTask_t;
 
@@ -979,6 +1202,10 @@ typedef struct xSTATIC_QUEUE
 	UBaseType_t uxDummy4[ 3 ];
 	uint8_t ucDummy5[ 2 ];
 
+	#if( configUSE_QUEUE_ZERO_COPY == 1 )
+		uint8_t ucDummy10;
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucDummy6;
 	#endif
@@ -1055,6 +1282,28 @@ typedef struct xSTATIC_TIMER
 
 } StaticTimer_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the stream buffer structure used
+ * internally by FreeRTOS is not accessible to application code.  However, if
+ * the application writer wants to statically allocate the memory required to
+ * create a stream or message buffer then the size of the stream buffer object
+ * needs to be know.  The StaticStreamBuffer_t structure below is provided for
+ * this purpose.  Its sizes and alignment requirements are guaranteed to match
+ * those of the genuine structure, no matter which architecture is being used,
+ * and no matter how the values in FreeRTOSConfig.h are set.  Its contents are
+ * somewhat obfuscated in the hope users will recognise that it would be unwise
+ * to make direct use of the structure members.
+ */
+typedef struct xSTATIC_STREAM_BUFFER
+{
+	size_t				xDummy1[ 4 ];
+	void				*pvDummy2[ 3 ];
+	uint8_t				ucDummy3;
+} StaticStreamBuffer_t;
+typedef StaticStreamBuffer_t StaticMessageBuffer_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -79,15 +79,42 @@
  *----------------------------------------------------------*/
 
 #define configUSE_PREEMPTION					1
-#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
-#define configMAX_PRIORITIES					5
-#define configUSE_IDLE_HOOK						0
+
+/* The simulator ports select the highest priority ready task with a bit scan,
+through a two level bit map when configMAX_PRIORITIES is greater than 32, so up
+to 1024 priorities can be used.  They can be set on the compiler command line,
+see priority_benchmark.c. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION	1
+#endif
+#ifndef configMAX_PRIORITIES
+	#define configMAX_PRIORITIES				5
+#endif
+
+/* The idle hook schedules the co-routines, see below. */
+#define configUSE_IDLE_HOOK						configUSE_CO_ROUTINES
 #define configUSE_TICK_HOOK						0
 #define configTICK_RATE_HZ						( 100 ) /* This is a simulated environment and therefore not real-time. */
 #define configMINIMAL_STACK_SIZE				( ( unsigned short ) 50 ) /* In this simulated case, the stack only has to hold one small structure as the real stack is part of the win32 thread. */
-#define configTOTAL_HEAP_SIZE					( ( size_t ) ( 20 * 1024 ) )
+/* The demo does not use the heap, see configSUPPORT_STATIC_ALLOCATION below,
+but the benchmarks create their objects dynamically.  It can be made larger on
+the compiler command line, see timer_benchmark.c. */
+#ifndef configTOTAL_HEAP_SIZE
+	#define configTOTAL_HEAP_SIZE				( ( size_t ) ( 20 * 1024 ) )
+#endif
+
+/* The demo creates its tasks, queues, timers and co-routines from memory it
+allocates statically, and provides the memory of the idle and timer service
+tasks through vApplicationGetIdleTaskMemory() and
+vApplicationGetTimerTaskMemory() in supporting_functions.c, so nothing is
+allocated from the heap, and the startup cannot fail for lack of it.  Set
+configSUPPORT_DYNAMIC_ALLOCATION to 0 on the compiler command line, and leave
+heap_4.c out of the build, to check this. */
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION		1
+#endif
 #define configMAX_TASK_NAME_LEN					( 12 )
-#define configUSE_TRACE_FACILITY				0
+#define configUSE_TRACE_FACILITY				1
 #define configUSE_16_BIT_TICKS					0
 #define configIDLE_SHOULD_YIELD					1
 #define configUSE_MUTEXES						1
@@ -100,19 +127,223 @@
 #define configUSE_ALTERNATIVE_API				0
 #define configUSE_QUEUE_SETS					1
 
-/* Software timer related configuration options. */
-#define configUSE_TIMERS						0
+/* Software timer related configuration options.  The timer service task keeps
+the active timers in a timing wheel, so starting, stopping and resetting a
+timer takes the same time however many timers are active. */
+#define configUSE_TIMERS						1
 #define configTIMER_TASK_PRIORITY				( configMAX_PRIORITIES - 1 )
 #define configTIMER_QUEUE_LENGTH				20
 #define configTIMER_TASK_STACK_DEPTH			( configMINIMAL_STACK_SIZE * 2 )
 
-/* Run time stats gathering configuration options. */
-#define configGENERATE_RUN_TIME_STATS			0
+/* Set configNUM_CORES to more than 1 to run the scheduler on that many simulated
+cores, each of which runs a task at the same time on its own host thread (POSIX
+hosts only).  Tasks can be restricted to a subset of the cores using
+vTaskCoreAffinitySet().  Tickless idle is not used in that case - each idle
+core instead sleeps until it is next interrupted.  It can be set on the
+compiler command line. */
+#ifndef configNUM_CORES
+	#define configNUM_CORES						1
+#endif
+
+/* Set configUSE_FIBERS to 1 to run every task in its own user space context, or
+fiber, on the host thread that started the scheduler, rather than in a host
+thread of its own (POSIX hosts only).  A context switch is then a swapcontext()
+call rather than the stop and start of two host threads, so is much faster.  A
+task is not preempted while it is executing host library code, so ticks and
+other interrupts that occur during a long host call are held pending until it
+returns.  It can be set on the compiler command line. */
+#ifndef configUSE_FIBERS
+	#define configUSE_FIBERS					0
+#endif
+
+/* Set configUSE_JOURNAL to 1 to include xPortJournalOpen(), which records the
+timing of every tick, simulated interrupt and context switch, and any host data
+passed to vPortJournalData(), to a file - or replays a run from that file, so it
+makes exactly the same scheduling decisions again (POSIX hosts only, other than
+when configNUM_CORES is more than 1 or configUSE_FIBERS is 1).  While a journal
+is open, interrupts raised by the timer and other peripheral threads are held
+until the task in the Running state next exits a critical section or yields, so
+a task that does not call the FreeRTOS API is not preempted.  It can be set on
+the compiler command line. */
+#ifndef configUSE_JOURNAL
+	#define configUSE_JOURNAL					0
+#endif
+
+/* Simulated interrupt priorities (POSIX hosts only, other than when
+configNUM_CORES is more than 1 or configUSE_FIBERS is 1).  Each simulated
+interrupt has a priority from 0, the most urgent, to 15, set with
+vPortSetInterruptPriority().  Pending interrupts are processed most urgent
+first, and a more urgent interrupt preempts the handler of a less urgent one
+when that handler next calls a FromISR API function or raises an interrupt.
+configKERNEL_INTERRUPT_PRIORITY is the priority of the yield and tick
+interrupts, and of any interrupt that has not been given a priority.  Critical
+sections mask interrupts at configMAX_SYSCALL_INTERRUPT_PRIORITY and less
+urgent, in the same way as BASEPRI on an ARM Cortex-M, so more urgent
+interrupts are still processed while a task is in a critical section - but
+their handlers must not call FreeRTOS API functions.  Both can be set on the
+compiler command line. */
+#ifndef configKERNEL_INTERRUPT_PRIORITY
+	#define configKERNEL_INTERRUPT_PRIORITY		15
+#endif
+#ifndef configMAX_SYSCALL_INTERRUPT_PRIORITY
+	#define configMAX_SYSCALL_INTERRUPT_PRIORITY	4
+#endif
+
+/* Simulated time configuration options.  When configUSE_TICKLESS_IDLE is set to
+1 the simulated timer stops generating ticks whenever all the tasks are blocked,
+and the host thread sleeps until the next task unblocks or another simulated
+interrupt occurs - so an idle simulator does not use host CPU time.  When
+configUSE_VIRTUAL_TIME is also set to 1 the tick count instead jumps straight to
+the time at which the next task unblocks, without sleeping.  This allows long
+timelines to execute much faster than real time.  Both can be set on the
+compiler command line. */
+#ifndef configUSE_TICKLESS_IDLE
+	#if( configNUM_CORES > 1 )
+		#define configUSE_TICKLESS_IDLE			0
+	#else
+		#define configUSE_TICKLESS_IDLE			1
+	#endif
+#endif
+#ifndef configUSE_VIRTUAL_TIME
+	#define configUSE_VIRTUAL_TIME				0
+#endif
+
+/* Set configUSE_64_BIT_TICKS to 1 to make TickType_t 64 bits wide (64-bit hosts
+only).  The tick count then never overflows - it would take over 500,000 years
+at a 1MHz tick - so the kernel has no overflow lists for the tasks and
+co-routines that are to wake after the tick count wraps, and nothing to switch
+when it does, while xTaskGetTickCount() is still a single load.  A 32-bit tick
+count wraps after 497 days at the 100Hz tick, but after 12 hours at a 100kHz
+tick, which virtual time runs through in minutes.  It can be set on the
+compiler command line. */
+#ifndef configUSE_64_BIT_TICKS
+	#define configUSE_64_BIT_TICKS				0
+#endif
+
+/* Set configUSE_TIMING_WHEEL to 1 to hold delayed tasks in a hierarchical timing
+wheel, rather than in a sorted list.  A task then enters and leaves the Blocked
+state in constant time however many other tasks are delayed, which is faster
+when many tasks are delayed at once.  It can be set on the compiler command
+line. */
+#ifndef configUSE_TIMING_WHEEL
+	#define configUSE_TIMING_WHEEL				0
+#endif
+
+/* Set configUSE_SKIP_LIST to 1 to index the sorted lists (the event lists that
+hold tasks waiting on queues and semaphores in priority order, and the delayed
+lists when the timing wheel is not used) with a skip list, so vListInsert() takes
+logarithmic rather than linear time.  Each list item then grows by
+( 2 * configSKIP_LIST_LEVELS ) + 1 words, which only pays off when lists hold
+more than a few dozen items.  It can be set on the compiler command line. */
+#ifndef configUSE_SKIP_LIST
+	#define configUSE_SKIP_LIST					0
+#endif
 
-/* Co-routine related configuration options. */
-#define configUSE_CO_ROUTINES 					0
+/* Set configUSE_EDF_SCHEDULING to 1 to include vTaskSetDeadline() and
+xTaskWaitForNextPeriod().  Tasks of equal priority then run earliest deadline
+first, rather than round robin, with tasks that have no deadline running after
+those that do.  Priorities still take precedence, so give the tasks that are to
+be scheduled by deadline the same priority.  A task that holds a mutex still
+inherits the priority of a higher priority task that waits for it.  Only
+available when configNUM_CORES is 1.  It can be set on the compiler command
+line. */
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING			0
+#endif
+
+/* Set configUSE_QUEUE_ZERO_COPY to 1 to include xQueueSendReserve(),
+xQueueSendCommit(), xQueueReceiveAcquire() and xQueueReceiveRelease(), which
+let tasks write and read queue items in place in the queue storage area rather
+than copying them in and out.  It can be set on the compiler command line. */
+#ifndef configUSE_QUEUE_ZERO_COPY
+	#define configUSE_QUEUE_ZERO_COPY			0
+#endif
+
+/* Set configUSE_QUEUE_BATCHING to 1 to include xQueueSendMany() and
+xQueueReceiveMany(), which move several queue items under a single critical
+section.  It can be set on the compiler command line. */
+#ifndef configUSE_QUEUE_BATCHING
+	#define configUSE_QUEUE_BATCHING			0
+#endif
+
+/* configTASK_TCB_MALLOC(), configTASK_STACK_MALLOC() and configQUEUE_MALLOC(),
+and the matching _FREE() macros, can be defined here to allocate tasks and
+queues from fixed size block pools rather than from the heap.  See
+block_pool.h for an example.  Set configUSE_APPLICATION_POOL_MALLOC to 1 to
+direct them all to pvApplicationPoolMalloc() and vApplicationPoolFree(), which
+the application must then provide, as block_pool_benchmark.c does.  It can be
+set on the compiler command line. */
+#ifndef configUSE_APPLICATION_POOL_MALLOC
+	#define configUSE_APPLICATION_POOL_MALLOC	0
+#endif
+
+#if( configUSE_APPLICATION_POOL_MALLOC == 1 )
+	extern void *pvApplicationPoolMalloc( size_t xSize );
+	extern void vApplicationPoolFree( void *pv );
+	#define configTASK_TCB_MALLOC( xSize )		pvApplicationPoolMalloc( xSize )
+	#define configTASK_TCB_FREE( pv )			vApplicationPoolFree( pv )
+	#define configTASK_STACK_MALLOC( xSize )	pvApplicationPoolMalloc( xSize )
+	#define configTASK_STACK_FREE( pv )			vApplicationPoolFree( pv )
+	#define configQUEUE_MALLOC( xSize )			pvApplicationPoolMalloc( xSize )
+	#define configQUEUE_FREE( pv )				vApplicationPoolFree( pv )
+#endif
+
+/* Run time stats gathering configuration options.  The simulator ports count
+run time in nanoseconds of host time, so the counter needs 64 bits.  Each task's
+time in the Running and Blocked states and its number of context switches are
+counted, and can be sampled periodically by the profiler task in
+cpu_profiler.c.  It can be set on the compiler command line. */
+#ifndef configGENERATE_RUN_TIME_STATS
+	#define configGENERATE_RUN_TIME_STATS		1
+#endif
+#define configRUN_TIME_COUNTER_TYPE				uint64_t
+
+/* Set configUSE_PERIOD_MONITOR to 1 to time each release of the tasks that run
+periodically with vTaskDelayUntil() or xTaskWaitForNextPeriod(): the latency
+from the release to the task running and the time from the release to the task
+completing, as histograms, with counts of overruns and missed deadlines.  See
+vTaskGetPeriodStats().  vApplicationDeadlineMissHook() is called when a task
+completes after its deadline if configUSE_DEADLINE_MISS_HOOK is also 1.  They
+can be set on the compiler command line. */
+#ifndef configUSE_PERIOD_MONITOR
+	#define configUSE_PERIOD_MONITOR			configGENERATE_RUN_TIME_STATS
+#endif
+#ifndef configUSE_DEADLINE_MISS_HOOK
+	#define configUSE_DEADLINE_MISS_HOOK		configUSE_PERIOD_MONITOR
+#endif
+
+/* Each task has configTASK_NOTIFICATION_ARRAY_ENTRIES independent notification
+values.  Index 0 (tskDEFAULT_INDEX_TO_NOTIFY) is used by the kernel's stream
+buffers, and the demo returns the camera's responses to the OBC and PDPU tasks
+at index 1 - see I2C_RESPONSE_NOTIFICATION in main.c. */
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES	2
+#endif
+
+/* Co-routine related configuration options.  The demo runs its housekeeping
+sensors as co-routines, which share the idle task's stack and are scheduled from
+the idle hook, so each sensor costs a co-routine control block rather than a
+task control block and a stack.  Co-routines are only scheduled by the idle task
+of a single core, so they are disabled when configNUM_CORES is greater than 1.
+It can be set on the compiler command line. */
+#ifndef configUSE_CO_ROUTINES
+	#if( configNUM_CORES > 1 )
+		#define configUSE_CO_ROUTINES			0
+	#else
+		#define configUSE_CO_ROUTINES			1
+	#endif
+#endif
 #define configMAX_CO_ROUTINE_PRIORITIES 		2
 
+/* Set configUSE_TRACE_RECORDER to 1 to record context switches, queue, event
+group and notification activity into a ring buffer for each core, which can be
+streamed to a file with xTraceRecorderStart() and converted to Chrome trace JSON
+with the trace_to_json program.  See trace_recorder.h.  It can be set on the
+compiler command line. */
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER			0
+#endif
+
 /* This demo does not make use of one or more example stats formatting
 functions, which format the raw data provided by the uxTaskGetSystemState()
 function in to human readable ASCII form. */
@@ -141,4 +372,9 @@ uses the same semantics as the standard C assert() macro. */
 extern void vAssertCalled( uint32_t ulLine, const char * const pcFileName );
 #define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __LINE__, __FILE__ )
 
+/* The trace recorder defines the kernel's trace macros. */
+#if( configUSE_TRACE_RECORDER == 1 )
+	#include "trace_recorder.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,392 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "block_pool.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to build block_pool.c
+#endif
+
+/* The structure placed in the first bytes of each free block. */
+typedef struct xFREE_BLOCK
+{
+	struct xFREE_BLOCK *pxNextFreeBlock;
+} FreeBlock_t;
+
+typedef struct xBLOCK_POOL /*lint !e9058 Style convention uses tag. */
+{
+	FreeBlock_t *pxFreeBlocks;				/*< The free blocks, most recently freed first. */
+	uint8_t *pucBlocks;						/*< The first block.  The blocks are allocated directly after the structure. */
+	size_t xBlockSize;						/*< The size of each block, rounded up to a multiple of portBYTE_ALIGNMENT. */
+	UBaseType_t uxBlockCount;
+	UBaseType_t uxFreeBlocks;
+	UBaseType_t uxMinimumEverFreeBlocks;
+} BlockPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Remove a block from, or return a block to, the free list.  Called from
+ * within a critical section.
+ */
+static void *prvTakeBlock( BlockPool_t * const pxBlockPool );
+static void prvReturnBlock( BlockPool_t * const pxBlockPool, void *pvBlock );
+
+/*-----------------------------------------------------------*/
+
+/* The blocks start at the first aligned address after the pool structure. */
+static const size_t xPoolStructSize = ( sizeof( BlockPool_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/*-----------------------------------------------------------*/
+
+BlockPoolHandle_t xBlockPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount )
+{
+BlockPool_t *pxBlockPool;
+FreeBlock_t *pxBlock;
+UBaseType_t uxBlock;
+
+	configASSERT( xBlockSize > ( size_t ) 0 );
+	configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+	/* Each free block must be able to hold the free list link, and every
+	block must be aligned. */
+	if( xBlockSize < sizeof( FreeBlock_t ) )
+	{
+		xBlockSize = sizeof( FreeBlock_t );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( ( xBlockSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+	{
+		xBlockSize += ( portBYTE_ALIGNMENT - ( xBlockSize & portBYTE_ALIGNMENT_MASK ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Check the multiplication does not overflow. */
+	if( ( ( ~( size_t ) 0 - xPoolStructSize ) / xBlockSize ) < ( size_t ) uxBlockCount )
+	{
+		pxBlockPool = NULL;
+	}
+	else
+	{
+		pxBlockPool = ( BlockPool_t * ) pvPortMalloc( xPoolStructSize + ( xBlockSize * ( size_t ) uxBlockCount ) ); /*lint !e9079 MISRA exception as the casts are only redundant for some paths. */
+	}
+
+	if( pxBlockPool != NULL )
+	{
+		pxBlockPool->pucBlocks = ( ( uint8_t * ) pxBlockPool ) + xPoolStructSize; /*lint !e9016 Pointer arithmetic allowed on char types. */
+		pxBlockPool->xBlockSize = xBlockSize;
+		pxBlockPool->uxBlockCount = uxBlockCount;
+		pxBlockPool->uxFreeBlocks = uxBlockCount;
+		pxBlockPool->uxMinimumEverFreeBlocks = uxBlockCount;
+
+		/* Link the blocks in address order.  This is the only part of the pool
+		that is not constant time. */
+		pxBlockPool->pxFreeBlocks = ( void * ) pxBlockPool->pucBlocks;
+
+		for( uxBlock = ( UBaseType_t ) 0; uxBlock < uxBlockCount; uxBlock++ )
+		{
+			pxBlock = ( void * ) &( pxBlockPool->pucBlocks[ ( size_t ) uxBlock * xBlockSize ] );
+
+			if( uxBlock < ( uxBlockCount - ( UBaseType_t ) 1 ) )
+			{
+				pxBlock->pxNextFreeBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+			}
+			else
+			{
+				pxBlock->pxNextFreeBlock = NULL;
+			}
+		}
+
+		traceBLOCK_POOL_CREATE( pxBlockPool );
+	}
+	else
+	{
+		traceBLOCK_POOL_CREATE_FAILED();
+	}
+
+	return ( BlockPoolHandle_t ) pxBlockPool;
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolDelete( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t * const pxBlockPool = ( BlockPool_t * ) xBlockPool;
+
+	configASSERT( pxBlockPool );
+
+	/* Deleting a pool while blocks are still in use would leave dangling
+	pointers. */
+	configASSERT( pxBlockPool->uxFreeBlocks == pxBlockPool->uxBlockCount );
+
+	traceBLOCK_POOL_DELETE( pxBlockPool );
+	vPortFree( ( void * ) pxBlockPool );
+}
+/*-----------------------------------------------------------*/
+
+void *pvBlockPoolAllocate( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t * const pxBlockPool = ( BlockPool_t * ) xBlockPool;
+void *pvReturn;
+
+	configASSERT( pxBlockPool );
+
+	taskENTER_CRITICAL();
+	{
+		pvReturn = prvTakeBlock( pxBlockPool );
+	}
+	taskEXIT_CRITICAL();
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvBlockPoolAllocateFromISR( BlockPoolHandle_t xBlockPool )
+{
+BlockPool_t * const pxBlockPool = ( BlockPool_t * ) xBlockPool;
+void *pvReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxBlockPool );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pvReturn = prvTakeBlock( pxBlockPool );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolFree( BlockPoolHandle_t xBlockPool, void *pvBlock )
+{
+BlockPool_t * const pxBlockPool = ( BlockPool_t * ) xBlockPool;
+
+	configASSERT( pxBlockPool );
+
+	if( pvBlock != NULL )
+	{
+		configASSERT( xBlockPoolContains( xBlockPool, pvBlock ) != pdFALSE );
+
+		taskENTER_CRITICAL();
+		{
+			prvReturnBlock( pxBlockPool, pvBlock );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolFreeFromISR( BlockPoolHandle_t xBlockPool, void *pvBlock )
+{
+BlockPool_t * const pxBlockPool = ( BlockPool_t * ) xBlockPool;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxBlockPool );
+
+	if( pvBlock != NULL )
+	{
+		configASSERT( xBlockPoolContains( xBlockPool, pvBlock ) != pdFALSE );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			prvReturnBlock( pxBlockPool, pvBlock );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xBlockPoolContains( BlockPoolHandle_t xBlockPool, const void *pvBlock )
+{
+const BlockPool_t * const pxBlockPool = ( const BlockPool_t * ) xBlockPool;
+size_t xOffset;
+BaseType_t xReturn = pdFALSE;
+
+	/* The pool's fields are not changed after creation, so no critical section
+	is needed. */
+	if( ( pxBlockPool != NULL ) && ( ( const uint8_t * ) pvBlock >= pxBlockPool->pucBlocks ) )
+	{
+		xOffset = ( size_t ) ( ( const uint8_t * ) pvBlock - pxBlockPool->pucBlocks );
+
+		if( ( xOffset < ( pxBlockPool->xBlockSize * ( size_t ) pxBlockPool->uxBlockCount ) ) && ( ( xOffset % pxBlockPool->xBlockSize ) == ( size_t ) 0 ) )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBlockPoolGetFreeBlocks( BlockPoolHandle_t xBlockPool )
+{
+	configASSERT( xBlockPool );
+	return ( ( BlockPool_t * ) xBlockPool )->uxFreeBlocks;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBlockPoolGetMinimumEverFreeBlocks( BlockPoolHandle_t xBlockPool )
+{
+	configASSERT( xBlockPool );
+	return ( ( BlockPool_t * ) xBlockPool )->uxMinimumEverFreeBlocks;
+}
+/*-----------------------------------------------------------*/
+
+size_t xBlockPoolGetBlockSize( BlockPoolHandle_t xBlockPool )
+{
+	configASSERT( xBlockPool );
+	return ( ( BlockPool_t * ) xBlockPool )->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTakeBlock( BlockPool_t * const pxBlockPool )
+{
+FreeBlock_t *pxBlock;
+
+	pxBlock = pxBlockPool->pxFreeBlocks;
+
+	if( pxBlock != NULL )
+	{
+		pxBlockPool->pxFreeBlocks = pxBlock->pxNextFreeBlock;
+		( pxBlockPool->uxFreeBlocks )--;
+
+		if( pxBlockPool->uxFreeBlocks < pxBlockPool->uxMinimumEverFreeBlocks )
+		{
+			pxBlockPool->uxMinimumEverFreeBlocks = pxBlockPool->uxFreeBlocks;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	traceBLOCK_POOL_ALLOCATE( pxBlockPool, pxBlock );
+
+	return ( void * ) pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReturnBlock( BlockPool_t * const pxBlockPool, void *pvBlock )
+{
+FreeBlock_t * const pxBlock = ( FreeBlock_t * ) pvBlock;
+
+	configASSERT( pxBlockPool->uxFreeBlocks < pxBlockPool->uxBlockCount );
+
+	pxBlock->pxNextFreeBlock = pxBlockPool->pxFreeBlocks;
+	pxBlockPool->pxFreeBlocks = pxBlock;
+	( pxBlockPool->uxFreeBlocks )++;
+
+	traceBLOCK_POOL_FREE( pxBlockPool, pvBlock );
+}
+
@@ -0,0 +1,286 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include block_pool.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A block pool hands out fixed size blocks of memory from a region that is
+ * allocated once, when the pool is created.  Free blocks are kept on a singly
+ * linked list threaded through the blocks themselves, so allocating and freeing
+ * a block is a constant time operation that never searches or coalesces, and
+ * the pool can never become fragmented.
+ *
+ * Pools suit objects that are created and deleted repeatedly and have one of a
+ * few fixed sizes, such as task control blocks, task stacks, queues and the
+ * payload buffers passed through queues.  The kernel's own allocations can be
+ * directed to pools by defining the configTASK_TCB_MALLOC(),
+ * configTASK_STACK_MALLOC() and configQUEUE_MALLOC() macros, and their _FREE()
+ * counterparts, in FreeRTOSConfig.h.  For example:
+ *
+ * <pre>
+ // In FreeRTOSConfig.h.
+ extern void *pvApplicationPoolMalloc( size_t xSize );
+ extern void vApplicationPoolFree( void *pv );
+ #define configTASK_TCB_MALLOC( xSize )	pvApplicationPoolMalloc( xSize )
+ #define configTASK_TCB_FREE( pv )		vApplicationPoolFree( pv )
+ #define configQUEUE_MALLOC( xSize )	pvApplicationPoolMalloc( xSize )
+ #define configQUEUE_FREE( pv )			vApplicationPoolFree( pv )
+
+ // In the application.  sizeof( StaticTask_t ) is the size of a TCB, and a
+ // queue needs sizeof( StaticQueue_t ) bytes plus its storage area.
+ static BlockPoolHandle_t xTCBPool, xMessageQueuePool;
+
+ void *pvApplicationPoolMalloc( size_t xSize )
+ {
+ void *pv = NULL;
+
+	if( xSize == sizeof( StaticTask_t ) )
+	{
+		pv = pvBlockPoolAllocate( xTCBPool );
+	}
+	else if( xSize == sizeof( StaticQueue_t ) + ( 5 * sizeof( Message_t ) ) )
+	{
+		pv = pvBlockPoolAllocate( xMessageQueuePool );
+	}
+
+	// Fall back to the heap for other sizes, or if the pool is empty.
+	if( pv == NULL )
+	{
+		pv = pvPortMalloc( xSize );
+	}
+
+	return pv;
+ }
+
+ void vApplicationPoolFree( void *pv )
+ {
+	if( xBlockPoolContains( xTCBPool, pv ) != pdFALSE )
+	{
+		vBlockPoolFree( xTCBPool, pv );
+	}
+	else if( xBlockPoolContains( xMessageQueuePool, pv ) != pdFALSE )
+	{
+		vBlockPoolFree( xMessageQueuePool, pv );
+	}
+	else
+	{
+		vPortFree( pv );
+	}
+ }
+ </pre>
+ *
+ * The pools must be created before the first task or queue is created.
+ *
+ * \defgroup BlockPool
+ */
+
+/**
+ * block_pool.h
+ *
+ * Type by which block pools are referenced.  For example, a call to
+ * xBlockPoolCreate() returns a BlockPoolHandle_t variable that can then be
+ * used as a parameter to pvBlockPoolAllocate() and vBlockPoolFree().
+ *
+ * \defgroup BlockPoolHandle_t BlockPoolHandle_t
+ * \ingroup BlockPool
+ */
+typedef void * BlockPoolHandle_t;
+
+/**
+ * block_pool.h
+ * <pre>
+ BlockPoolHandle_t xBlockPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount );
+ </pre>
+ *
+ * Create a pool of uxBlockCount blocks, each of which can hold xBlockSize
+ * bytes.  The memory for the pool is obtained with a single call to
+ * pvPortMalloc().
+ *
+ * @param xBlockSize The number of bytes each block must hold.  The size is
+ * rounded up to a multiple of portBYTE_ALIGNMENT, and every block is aligned to
+ * portBYTE_ALIGNMENT.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @return The handle of the created pool, or NULL if there was not enough heap
+ * memory to create it.
+ *
+ * \defgroup xBlockPoolCreate xBlockPoolCreate
+ * \ingroup BlockPool
+ */
+BlockPoolHandle_t xBlockPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ void vBlockPoolDelete( BlockPoolHandle_t xBlockPool );
+ </pre>
+ *
+ * Delete a pool, returning its memory to the heap.  All the blocks must have
+ * been freed first.
+ *
+ * \defgroup vBlockPoolDelete vBlockPoolDelete
+ * \ingroup BlockPool
+ */
+void vBlockPoolDelete( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ void *pvBlockPoolAllocate( BlockPoolHandle_t xBlockPool );
+ void *pvBlockPoolAllocateFromISR( BlockPoolHandle_t xBlockPool );
+ </pre>
+ *
+ * Take a block from a pool.  The FromISR() version can be called from an
+ * interrupt service routine.  Neither version blocks.
+ *
+ * @param xBlockPool The pool to take the block from.
+ *
+ * @return A pointer to the block, or NULL if every block in the pool is in
+ * use.
+ *
+ * \defgroup pvBlockPoolAllocate pvBlockPoolAllocate
+ * \ingroup BlockPool
+ */
+void *pvBlockPoolAllocate( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+void *pvBlockPoolAllocateFromISR( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ void vBlockPoolFree( BlockPoolHandle_t xBlockPool, void *pvBlock );
+ void vBlockPoolFreeFromISR( BlockPoolHandle_t xBlockPool, void *pvBlock );
+ </pre>
+ *
+ * Return a block to the pool it was allocated from.  The FromISR() version can
+ * be called from an interrupt service routine.
+ *
+ * @param xBlockPool The pool the block was allocated from.
+ *
+ * @param pvBlock The block, as returned by pvBlockPoolAllocate() or
+ * pvBlockPoolAllocateFromISR().  NULL is ignored.
+ *
+ * \defgroup vBlockPoolFree vBlockPoolFree
+ * \ingroup BlockPool
+ */
+void vBlockPoolFree( BlockPoolHandle_t xBlockPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+void vBlockPoolFreeFromISR( BlockPoolHandle_t xBlockPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ BaseType_t xBlockPoolContains( BlockPoolHandle_t xBlockPool, const void *pvBlock );
+ </pre>
+ *
+ * Query whether pvBlock is one of the blocks of a pool, which lets a free
+ * function that is given only a pointer decide which pool, if any, the pointer
+ * belongs to.  It does not say whether the block is currently allocated.
+ *
+ * @return pdTRUE if pvBlock is the start of a block in xBlockPool, otherwise
+ * pdFALSE.  pdFALSE is also returned if xBlockPool is NULL.
+ *
+ * \defgroup xBlockPoolContains xBlockPoolContains
+ * \ingroup BlockPool
+ */
+BaseType_t xBlockPoolContains( BlockPoolHandle_t xBlockPool, const void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ UBaseType_t uxBlockPoolGetFreeBlocks( BlockPoolHandle_t xBlockPool );
+ UBaseType_t uxBlockPoolGetMinimumEverFreeBlocks( BlockPoolHandle_t xBlockPool );
+ size_t xBlockPoolGetBlockSize( BlockPoolHandle_t xBlockPool );
+ </pre>
+ *
+ * Return the number of blocks that are currently free, the lowest number of
+ * blocks that have been free since the pool was created, and the size of each
+ * block after it was rounded up for alignment.
+ *
+ * \defgroup uxBlockPoolGetFreeBlocks uxBlockPoolGetFreeBlocks
+ * \ingroup BlockPool
+ */
+UBaseType_t uxBlockPoolGetFreeBlocks( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+UBaseType_t uxBlockPoolGetMinimumEverFreeBlocks( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+size_t xBlockPoolGetBlockSize( BlockPoolHandle_t xBlockPool ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCK_POOL_H */
+
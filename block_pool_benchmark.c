@@ -0,0 +1,564 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A benchmark of the fixed size block pools of block_pool.c against heap_4.c
+ * when the heap has become fragmented.  The kernel's allocation hooks are
+ * directed to pvApplicationPoolMalloc() and vApplicationPoolFree() below, which
+ * serve task control blocks, task stacks and queues from pools when xUsePools
+ * is pdTRUE, and from the heap otherwise, so both are measured in one run.
+ *
+ * Before the scheduler is started the pool API is checked: the block size is
+ * rounded up for alignment, a pool runs out of blocks after the number it was
+ * created with, a pool too large to size is not created, and returning more
+ * blocks than a pool holds, or a block of another pool, trips configASSERT().
+ * The asserts are caught by wrapping vAssertCalled() at link time, as
+ * vAssertCalled() never returns.  The FromISR() functions are then checked from
+ * a simulated interrupt once the scheduler is running.
+ *
+ * The benchmark task then fragments the heap into bpbFRAGMENTS free fragments,
+ * each too small for any of the objects, so heap_4.c walks past all of them
+ * for every allocation.  With and without the pools it times:
+ *
+ * + Creating and deleting a queue of bpbQUEUE_LENGTH items of bpbITEM_SIZE
+ *   bytes.
+ *
+ * + Creating a task with a stack of bpbSTACK_DEPTH words.  The time includes
+ *   the creation of the simulator's host thread or fiber for the task, which
+ *   is the same either way.  Each task is deleted before it runs, outside the
+ *   timed region.
+ *
+ * Each time is the mean of the fastest of bpbRUNS runs.
+ *
+ * The benchmark is built in place of main.c with the hooks and a heap large
+ * enough for the fragments:
+ *
+ *   gcc -O2 -I. -DconfigUSE_APPLICATION_POOL_MALLOC=1 -DconfigTOTAL_HEAP_SIZE=2000000 -Wl,--wrap=vAssertCalled block_pool_benchmark.c block_pool.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o block_pool_benchmark -lpthread
+ *   ./block_pool_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "block_pool.h"
+
+#if( configUSE_APPLICATION_POOL_MALLOC != 1 )
+	#error The benchmark must be built with configUSE_APPLICATION_POOL_MALLOC set to 1.
+#endif
+
+/* The objects created and deleted. */
+#define bpbQUEUE_LENGTH			( 5 )
+#define bpbITEM_SIZE			( 64 )
+#define bpbSTACK_DEPTH			( 100 )
+
+/* The number of blocks in each pool.  Only one task or queue exists at a time
+while the benchmark runs, but the idle task and the benchmark task are also
+allocated through the hooks before the pools are created. */
+#define bpbPOOL_BLOCKS			( 4 )
+
+/* The heap is fragmented by allocating twice bpbFRAGMENTS blocks of
+bpbFRAGMENT_SIZE bytes and freeing every other one. */
+#define bpbFRAGMENTS			( 1500 )
+#define bpbFRAGMENT_SIZE		( 32 )
+
+#define bpbQUEUES				( 1000UL )
+#define bpbTASKS				( 200UL )
+#define bpbRUNS					( 3 )
+
+#define bpbBENCHMARK_PRIORITY	( tskIDLE_PRIORITY + 2 )
+
+/* The simulated interrupt that checks the FromISR() functions, and the pool it
+uses. */
+#define bpbINTERRUPT_NUMBER		( 3UL )
+#define bpbISR_POOL_BLOCKS		( 8 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Checks the pool API, and that misuse is caught by configASSERT().  Called
+ * before the scheduler is started, as an assert is left by longjmp().
+ */
+static void prvCheckPools( void );
+
+/*
+ * Checks the FromISR() functions from a simulated interrupt, fragments the
+ * heap, times the objects with and without the pools, prints the results and
+ * exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Takes every block of xISRPool with pvBlockPoolAllocateFromISR(), then
+ * returns them all with vBlockPoolFreeFromISR().
+ */
+static uint32_t prvPoolInterruptHandler( void );
+
+/*
+ * The mean nanoseconds to create and delete a queue, and to create a task, in
+ * the fastest of bpbRUNS runs.
+ */
+static double prvTimeQueues( void );
+static double prvTimeTasks( void );
+
+/*
+ * Never runs, as each task is deleted as soon as it has been created.
+ */
+static void prvIdleWorkerTask( void *pvParameters );
+
+/*
+ * Stops the benchmark with a message if xPassed is pdFALSE.
+ */
+static void prvCheck( BaseType_t xPassed, const char *pcWhat );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*
+ * Linked in place of vAssertCalled() by -Wl,--wrap=vAssertCalled.
+ */
+void __real_vAssertCalled( uint32_t ulLine, const char * const pcFileName );
+void __wrap_vAssertCalled( uint32_t ulLine, const char * const pcFileName );
+
+/*-----------------------------------------------------------*/
+
+/* The pools used by the allocation hooks, which use the heap until xUsePools
+is set. */
+static BlockPoolHandle_t xTCBPool = NULL, xStackPool = NULL, xQueuePool = NULL;
+static volatile BaseType_t xUsePools = pdFALSE;
+
+/* The pool used by the simulated interrupt, and what the interrupt saw. */
+static BlockPoolHandle_t xISRPool = NULL;
+static volatile UBaseType_t uxISRBlocksTaken = 0, uxISRBlocksFreeWhenExhausted = 0;
+
+/* Set while an assert is expected, in which case the assert returns to
+xAssertJump rather than stopping. */
+static volatile BaseType_t xCatchAssert = pdFALSE;
+static jmp_buf xAssertJump;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	prvCheckPools();
+
+	/* The pools are created before the tasks and queues they are to hold. */
+	xTCBPool = xBlockPoolCreate( sizeof( StaticTask_t ), bpbPOOL_BLOCKS );
+	xStackPool = xBlockPoolCreate( bpbSTACK_DEPTH * sizeof( StackType_t ), bpbPOOL_BLOCKS );
+	xQueuePool = xBlockPoolCreate( sizeof( StaticQueue_t ) + ( bpbQUEUE_LENGTH * bpbITEM_SIZE ), bpbPOOL_BLOCKS );
+	xISRPool = xBlockPoolCreate( bpbITEM_SIZE, bpbISR_POOL_BLOCKS );
+	configASSERT( xTCBPool && xStackPool && xQueuePool && xISRPool );
+
+	vPortSetInterruptHandler( bpbINTERRUPT_NUMBER, prvPoolInterruptHandler );
+
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, bpbBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckPools( void )
+{
+BlockPoolHandle_t xPool, xOtherPool;
+void *pvBlocks[ bpbPOOL_BLOCKS ];
+void * volatile pvForeignBlock;
+UBaseType_t uxBlock;
+size_t xFreeHeap;
+
+	/* 20 bytes is rounded up to the next multiple of portBYTE_ALIGNMENT. */
+	xPool = xBlockPoolCreate( 20, bpbPOOL_BLOCKS );
+	prvCheck( xPool != NULL, "xBlockPoolCreate() created a pool" );
+	xFreeHeap = xPortGetFreeHeapSize();
+	prvCheck( xBlockPoolGetBlockSize( xPool ) == ( ( 20 + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) ), "The block size was rounded up for alignment" );
+	prvCheck( uxBlockPoolGetFreeBlocks( xPool ) == bpbPOOL_BLOCKS, "A new pool has every block free" );
+
+	/* Take every block, then one more. */
+	for( uxBlock = 0; uxBlock < bpbPOOL_BLOCKS; uxBlock++ )
+	{
+		pvBlocks[ uxBlock ] = pvBlockPoolAllocate( xPool );
+		prvCheck( pvBlocks[ uxBlock ] != NULL, "pvBlockPoolAllocate() returned a block" );
+		prvCheck( ( ( size_t ) pvBlocks[ uxBlock ] & portBYTE_ALIGNMENT_MASK ) == 0, "The block is aligned" );
+		prvCheck( xBlockPoolContains( xPool, pvBlocks[ uxBlock ] ) != pdFALSE, "xBlockPoolContains() found the block" );
+		memset( pvBlocks[ uxBlock ], 0xa5, xBlockPoolGetBlockSize( xPool ) );
+	}
+
+	prvCheck( pvBlockPoolAllocate( xPool ) == NULL, "pvBlockPoolAllocate() returned NULL once the pool was exhausted" );
+	prvCheck( uxBlockPoolGetMinimumEverFreeBlocks( xPool ) == 0, "The minimum ever free blocks fell to 0" );
+	prvCheck( xBlockPoolContains( xPool, ( uint8_t * ) pvBlocks[ 0 ] + 1 ) == pdFALSE, "xBlockPoolContains() rejected a pointer inside a block" );
+	prvCheck( xBlockPoolContains( NULL, pvBlocks[ 0 ] ) == pdFALSE, "xBlockPoolContains() rejected a NULL pool" );
+
+	/* A freed block is the next to be allocated. */
+	vBlockPoolFree( xPool, pvBlocks[ 1 ] );
+	prvCheck( pvBlockPoolAllocate( xPool ) == pvBlocks[ 1 ], "A freed block was allocated again" );
+
+	for( uxBlock = 0; uxBlock < bpbPOOL_BLOCKS; uxBlock++ )
+	{
+		vBlockPoolFree( xPool, pvBlocks[ uxBlock ] );
+	}
+
+	prvCheck( uxBlockPoolGetFreeBlocks( xPool ) == bpbPOOL_BLOCKS, "Every block was returned" );
+	vBlockPoolFree( xPool, NULL );
+
+	/* Returning a block to a pool that already has every block free would
+	overflow the free count. */
+	xCatchAssert = pdTRUE;
+	if( setjmp( xAssertJump ) == 0 )
+	{
+		vBlockPoolFree( xPool, pvBlocks[ 0 ] );
+		prvCheck( pdFALSE, "Freeing a block twice trips configASSERT()" );
+	}
+
+	/* A block must be returned to the pool it came from. */
+	xOtherPool = xBlockPoolCreate( 20, 1 );
+	prvCheck( xOtherPool != NULL, "xBlockPoolCreate() created a second pool" );
+	pvForeignBlock = pvBlockPoolAllocate( xOtherPool );
+
+	xCatchAssert = pdTRUE;
+	if( setjmp( xAssertJump ) == 0 )
+	{
+		vBlockPoolFree( xPool, pvForeignBlock );
+		prvCheck( pdFALSE, "Freeing a block of another pool trips configASSERT()" );
+	}
+	xCatchAssert = pdFALSE;
+
+	prvCheck( uxBlockPoolGetFreeBlocks( xPool ) == bpbPOOL_BLOCKS, "The free count was not changed by the asserts" );
+	vBlockPoolFree( xOtherPool, pvForeignBlock );
+	vBlockPoolDelete( xOtherPool );
+
+	/* The size of a pool that would not fit in size_t cannot be calculated,
+	so the pool is not created and nothing is taken from the heap. */
+	prvCheck( xBlockPoolCreate( ( ( size_t ) -1 ) / 4, 8 ) == NULL, "xBlockPoolCreate() rejected a pool too large to size" );
+	prvCheck( xPortGetFreeHeapSize() == xFreeHeap, "Deleting a pool returned its memory to the heap" );
+	vBlockPoolDelete( xPool );
+
+	printf( "Pool API checks passed\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+static void *pvFragments[ 2 * bpbFRAGMENTS ];
+double dHeapQueue, dPoolQueue, dHeapTask, dPoolTask;
+size_t xFreeHeap;
+int iFragment;
+
+	( void ) pvParameters;
+
+	/* The interrupt is processed before vPortGenerateSimulatedInterrupt()
+	returns to a task. */
+	vPortGenerateSimulatedInterrupt( bpbINTERRUPT_NUMBER );
+	prvCheck( uxISRBlocksTaken == bpbISR_POOL_BLOCKS, "pvBlockPoolAllocateFromISR() took every block" );
+	prvCheck( uxISRBlocksFreeWhenExhausted == 0, "pvBlockPoolAllocateFromISR() returned NULL once the pool was exhausted" );
+	prvCheck( uxBlockPoolGetFreeBlocks( xISRPool ) == bpbISR_POOL_BLOCKS, "vBlockPoolFreeFromISR() returned every block" );
+	printf( "FromISR checks passed\n\n" );
+
+	/* Leave bpbFRAGMENTS free fragments between blocks that stay allocated. */
+	for( iFragment = 0; iFragment < ( 2 * bpbFRAGMENTS ); iFragment++ )
+	{
+		pvFragments[ iFragment ] = pvPortMalloc( bpbFRAGMENT_SIZE );
+		configASSERT( pvFragments[ iFragment ] );
+	}
+
+	for( iFragment = 0; iFragment < ( 2 * bpbFRAGMENTS ); iFragment += 2 )
+	{
+		vPortFree( pvFragments[ iFragment ] );
+	}
+
+	xFreeHeap = xPortGetFreeHeapSize();
+
+	xUsePools = pdFALSE;
+	dHeapQueue = prvTimeQueues();
+	dHeapTask = prvTimeTasks();
+
+	xUsePools = pdTRUE;
+	dPoolQueue = prvTimeQueues();
+	dPoolTask = prvTimeTasks();
+
+	prvCheck( xPortGetFreeHeapSize() == xFreeHeap, "The free heap was the same after the churn" );
+	prvCheck( ( uxBlockPoolGetFreeBlocks( xTCBPool ) == bpbPOOL_BLOCKS ) && ( uxBlockPoolGetFreeBlocks( xStackPool ) == bpbPOOL_BLOCKS ) && ( uxBlockPoolGetFreeBlocks( xQueuePool ) == bpbPOOL_BLOCKS ), "Every pool block was returned after the churn" );
+
+	printf( "%d free heap fragments, mean of the fastest of %d runs\n\n", bpbFRAGMENTS, bpbRUNS );
+	printf( "Operation                 heap_4 (us)   pools (us)\n" );
+	printf( "Queue create + delete     %11.2f  %11.2f\n", dHeapQueue / 1000.0, dPoolQueue / 1000.0 );
+	printf( "Task create               %11.2f  %11.2f\n", dHeapTask / 1000.0, dPoolTask / 1000.0 );
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPoolInterruptHandler( void )
+{
+void *pvBlocks[ bpbISR_POOL_BLOCKS ];
+UBaseType_t uxBlock;
+
+	uxISRBlocksTaken = 0;
+
+	while( uxISRBlocksTaken < bpbISR_POOL_BLOCKS )
+	{
+		pvBlocks[ uxISRBlocksTaken ] = pvBlockPoolAllocateFromISR( xISRPool );
+
+		if( pvBlocks[ uxISRBlocksTaken ] == NULL )
+		{
+			break;
+		}
+
+		uxISRBlocksTaken++;
+	}
+
+	uxISRBlocksFreeWhenExhausted = ( pvBlockPoolAllocateFromISR( xISRPool ) == NULL ) ? uxBlockPoolGetFreeBlocks( xISRPool ) : ( UBaseType_t ) -1;
+
+	for( uxBlock = 0; uxBlock < uxISRBlocksTaken; uxBlock++ )
+	{
+		vBlockPoolFreeFromISR( xISRPool, pvBlocks[ uxBlock ] );
+	}
+
+	/* No task was unblocked. */
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeQueues( void )
+{
+QueueHandle_t xQueue;
+double dStart, dTime, dFastest = 1e30;
+uint32_t ulQueue;
+int iRun;
+
+	for( iRun = 0; iRun < bpbRUNS; iRun++ )
+	{
+		dStart = prvNanoseconds();
+
+		for( ulQueue = 0; ulQueue < bpbQUEUES; ulQueue++ )
+		{
+			xQueue = xQueueCreate( bpbQUEUE_LENGTH, bpbITEM_SIZE );
+			configASSERT( xQueue );
+			vQueueDelete( xQueue );
+		}
+
+		dTime = ( prvNanoseconds() - dStart ) / ( double ) bpbQUEUES;
+
+		if( dTime < dFastest )
+		{
+			dFastest = dTime;
+		}
+	}
+
+	return dFastest;
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeTasks( void )
+{
+TaskHandle_t xTask;
+double dStart, dTotal, dFastest = 1e30;
+uint32_t ulTask;
+int iRun;
+
+	for( iRun = 0; iRun < bpbRUNS; iRun++ )
+	{
+		dTotal = 0.0;
+
+		for( ulTask = 0; ulTask < bpbTASKS; ulTask++ )
+		{
+			/* The task has a lower priority than this task, so is deleted
+			before it can run. */
+			dStart = prvNanoseconds();
+			if( xTaskCreate( prvIdleWorkerTask, "WORKER", bpbSTACK_DEPTH, NULL, tskIDLE_PRIORITY, &xTask ) != pdPASS )
+			{
+				printf( "Could not create a task\n" );
+				exit( 1 );
+			}
+			dTotal += prvNanoseconds() - dStart;
+
+			vTaskDelete( xTask );
+		}
+
+		if( ( dTotal / ( double ) bpbTASKS ) < dFastest )
+		{
+			dFastest = dTotal / ( double ) bpbTASKS;
+		}
+	}
+
+	return dFastest;
+}
+/*-----------------------------------------------------------*/
+
+static void prvIdleWorkerTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *pvApplicationPoolMalloc( size_t xSize )
+{
+void *pv = NULL;
+
+	if( xUsePools != pdFALSE )
+	{
+		if( xSize == sizeof( StaticTask_t ) )
+		{
+			pv = pvBlockPoolAllocate( xTCBPool );
+		}
+		else if( xSize == ( bpbSTACK_DEPTH * sizeof( StackType_t ) ) )
+		{
+			pv = pvBlockPoolAllocate( xStackPool );
+		}
+		else if( xSize == ( sizeof( StaticQueue_t ) + ( bpbQUEUE_LENGTH * bpbITEM_SIZE ) ) )
+		{
+			pv = pvBlockPoolAllocate( xQueuePool );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	/* Other sizes, and any size once its pool is empty, come from the heap. */
+	if( pv == NULL )
+	{
+		pv = pvPortMalloc( xSize );
+	}
+
+	return pv;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationPoolFree( void *pv )
+{
+	/* A block is returned to its pool even if xUsePools has since been
+	cleared. */
+	if( xBlockPoolContains( xTCBPool, pv ) != pdFALSE )
+	{
+		vBlockPoolFree( xTCBPool, pv );
+	}
+	else if( xBlockPoolContains( xStackPool, pv ) != pdFALSE )
+	{
+		vBlockPoolFree( xStackPool, pv );
+	}
+	else if( xBlockPoolContains( xQueuePool, pv ) != pdFALSE )
+	{
+		vBlockPoolFree( xQueuePool, pv );
+	}
+	else
+	{
+		vPortFree( pv );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void __wrap_vAssertCalled( uint32_t ulLine, const char * const pcFileName )
+{
+	if( xCatchAssert != pdFALSE )
+	{
+		xCatchAssert = pdFALSE;
+		longjmp( xAssertJump, 1 );
+	}
+	else
+	{
+		printf( "Assert at %s:%lu\n", pcFileName, ( unsigned long ) ulLine );
+		__real_vAssertCalled( ulLine, pcFileName );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheck( BaseType_t xPassed, const char *pcWhat )
+{
+	if( xPassed == pdFALSE )
+	{
+		printf( "FAILED: %s\n", pcWhat );
+		exit( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
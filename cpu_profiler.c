@@ -0,0 +1,315 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cpu_profiler.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The profiler is only built when the kernel gathers the statistics it
+reports, so this file can always be compiled. */
+#if( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) )
+
+#ifndef configNUM_CORES
+	#define configNUM_CORES 1
+#endif
+
+/* Two sets of task states, so each sample can be compared with the one taken
+at the start of the period. */
+typedef struct xPROFILER_SAMPLE
+{
+	TaskStatus_t xTasks[ configCPU_PROFILER_MAX_TASKS ];
+	UBaseType_t uxNumberOfTasks;
+	configRUN_TIME_COUNTER_TYPE ulTotalRunTime;
+} ProfilerSample_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The profiler task.
+ */
+static portTASK_FUNCTION_PROTO( prvCpuProfilerTask, pvParameters );
+
+/*
+ * Take a sample into pxSample.  Returns pdFALSE if there were more tasks than
+ * configCPU_PROFILER_MAX_TASKS.
+ */
+static BaseType_t prvTakeSample( ProfilerSample_t *pxSample );
+
+/*
+ * Work out the statistics for the period between two samples.
+ */
+static void prvCalculateStats( const ProfilerSample_t *pxPrevious, const ProfilerSample_t *pxCurrent, CpuProfilerSnapshot_t *pxSnapshot );
+
+/*-----------------------------------------------------------*/
+
+static ProfilerSample_t xSamples[ 2 ];
+static CpuProfilerSnapshot_t xWorkingSnapshot;
+
+/* Only accessed from within a critical section once the profiler is running. */
+static CpuProfilerSnapshot_t xPublishedSnapshot;
+
+static TaskHandle_t xProfilerTaskHandle = NULL;
+static TickType_t xProfilerSamplePeriod = ( TickType_t ) 0;
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	/* The profiler task is created statically in case
+	configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+	static StaticTask_t xProfilerTaskTCB;
+	static StackType_t uxProfilerTaskStack[ configMINIMAL_STACK_SIZE ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+BaseType_t xCpuProfilerStart( TickType_t xSamplePeriod, UBaseType_t uxPriority )
+{
+BaseType_t xReturn;
+
+	configASSERT( xSamplePeriod > ( TickType_t ) 0 );
+	configASSERT( xProfilerTaskHandle == NULL );
+
+	xProfilerSamplePeriod = xSamplePeriod;
+	xPublishedSnapshot.ulSampleNumber = 0UL;
+
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		xProfilerTaskHandle = xTaskCreateStatic( prvCpuProfilerTask, "PROFILER", configMINIMAL_STACK_SIZE, NULL, uxPriority, uxProfilerTaskStack, &xProfilerTaskTCB );
+		xReturn = ( xProfilerTaskHandle != NULL ) ? pdPASS : pdFAIL;
+	}
+	#else
+	{
+		xReturn = xTaskCreate( prvCpuProfilerTask, "PROFILER", configMINIMAL_STACK_SIZE, NULL, uxPriority, &xProfilerTaskHandle );
+	}
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xCpuProfilerGetSnapshot( CpuProfilerSnapshot_t *pxSnapshot )
+{
+BaseType_t xReturn = pdFALSE;
+
+	configASSERT( pxSnapshot );
+
+	taskENTER_CRITICAL();
+	{
+		if( xPublishedSnapshot.ulSampleNumber != 0UL )
+		{
+			*pxSnapshot = xPublishedSnapshot;
+			xReturn = pdTRUE;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvCpuProfilerTask, pvParameters )
+{
+TickType_t xLastWakeTime;
+BaseType_t xCurrent = 0, xHaveBaseline;
+
+	( void ) pvParameters;
+
+	xLastWakeTime = xTaskGetTickCount();
+	xHaveBaseline = prvTakeSample( &( xSamples[ xCurrent ] ) );
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, xProfilerSamplePeriod );
+
+		/* Sample into the other buffer, leaving the last sample as the
+		baseline for this period. */
+		xCurrent ^= 1;
+
+		if( prvTakeSample( &( xSamples[ xCurrent ] ) ) != pdFALSE )
+		{
+			if( xHaveBaseline != pdFALSE )
+			{
+				prvCalculateStats( &( xSamples[ xCurrent ^ 1 ] ), &( xSamples[ xCurrent ] ), &xWorkingSnapshot );
+
+				/* Only the copy is done with interrupts masked, so readers
+				never see a partly written snapshot. */
+				taskENTER_CRITICAL();
+				{
+					xWorkingSnapshot.ulSampleNumber = xPublishedSnapshot.ulSampleNumber + 1UL;
+					xPublishedSnapshot = xWorkingSnapshot;
+				}
+				taskEXIT_CRITICAL();
+			}
+
+			xHaveBaseline = pdTRUE;
+		}
+		else
+		{
+			/* Too many tasks to sample, so there is no baseline for the next
+			period either. */
+			xHaveBaseline = pdFALSE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeSample( ProfilerSample_t *pxSample )
+{
+	/* uxTaskGetSystemState() returns 0 if the array is too small to hold every
+	task. */
+	pxSample->uxNumberOfTasks = uxTaskGetSystemState( pxSample->xTasks, configCPU_PROFILER_MAX_TASKS, &( pxSample->ulTotalRunTime ) );
+
+	return ( pxSample->uxNumberOfTasks > ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCalculateStats( const ProfilerSample_t *pxPrevious, const ProfilerSample_t *pxCurrent, CpuProfilerSnapshot_t *pxSnapshot )
+{
+UBaseType_t uxTask, uxPreviousTask;
+const TaskStatus_t *pxTask, *pxPreviousTask;
+CpuProfilerTaskStats_t *pxStats;
+uint64_t ullCapacity;
+
+	pxSnapshot->ulPeriod = pxCurrent->ulTotalRunTime - pxPrevious->ulTotalRunTime;
+	pxSnapshot->uxNumberOfTasks = pxCurrent->uxNumberOfTasks;
+
+	/* Each core provides a period's worth of run time. */
+	ullCapacity = ( uint64_t ) pxSnapshot->ulPeriod * ( uint64_t ) configNUM_CORES;
+
+	for( uxTask = 0; uxTask < pxCurrent->uxNumberOfTasks; uxTask++ )
+	{
+		pxTask = &( pxCurrent->xTasks[ uxTask ] );
+		pxStats = &( pxSnapshot->xTasks[ uxTask ] );
+
+		/* Tasks are matched by their task number rather than their handle, as
+		a new task can be given the memory of one that was deleted.  Most tasks
+		stay at the same position between samples, so look there first. */
+		pxPreviousTask = NULL;
+
+		if( ( uxTask < pxPrevious->uxNumberOfTasks ) && ( pxPrevious->xTasks[ uxTask ].xTaskNumber == pxTask->xTaskNumber ) )
+		{
+			pxPreviousTask = &( pxPrevious->xTasks[ uxTask ] );
+		}
+		else
+		{
+			for( uxPreviousTask = 0; uxPreviousTask < pxPrevious->uxNumberOfTasks; uxPreviousTask++ )
+			{
+				if( pxPrevious->xTasks[ uxPreviousTask ].xTaskNumber == pxTask->xTaskNumber )
+				{
+					pxPreviousTask = &( pxPrevious->xTasks[ uxPreviousTask ] );
+					break;
+				}
+			}
+		}
+
+		pxStats->xHandle = pxTask->xHandle;
+		strncpy( pxStats->pcTaskName, pxTask->pcTaskName, configMAX_TASK_NAME_LEN );
+		pxStats->pcTaskName[ configMAX_TASK_NAME_LEN - 1 ] = 0x00;
+		pxStats->eCurrentState = pxTask->eCurrentState;
+		pxStats->uxCurrentPriority = pxTask->uxCurrentPriority;
+
+		if( pxPreviousTask != NULL )
+		{
+			pxStats->ulRunTime = pxTask->ulRunTimeCounter - pxPreviousTask->ulRunTimeCounter;
+			pxStats->ulBlockedTime = pxTask->ulBlockedTimeCounter - pxPreviousTask->ulBlockedTimeCounter;
+			pxStats->ulSwitchIns = pxTask->ulSwitchInCount - pxPreviousTask->ulSwitchInCount;
+		}
+		else
+		{
+			/* The task was created during the period. */
+			pxStats->ulRunTime = pxTask->ulRunTimeCounter;
+			pxStats->ulBlockedTime = pxTask->ulBlockedTimeCounter;
+			pxStats->ulSwitchIns = pxTask->ulSwitchInCount;
+		}
+
+		if( ullCapacity > 0ULL )
+		{
+			pxStats->ulCpuPercentTimes100 = ( uint32_t ) ( ( ( uint64_t ) pxStats->ulRunTime * 10000ULL ) / ullCapacity );
+		}
+		else
+		{
+			pxStats->ulCpuPercentTimes100 = 0UL;
+		}
+	}
+}
+
+#endif /* ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TRACE_FACILITY == 1 ) */
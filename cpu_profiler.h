@@ -0,0 +1,184 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef CPU_PROFILER_H
+#define CPU_PROFILER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include cpu_profiler.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The CPU profiler is a task that wakes periodically, takes a snapshot of every
+ * task with uxTaskGetSystemState(), and works out how much of the last period
+ * each task spent in the Running and Blocked states, and how many times it was
+ * switched in.  The results are published as a snapshot that any task can copy
+ * with xCpuProfilerGetSnapshot(), so the profiler itself never formats or
+ * prints anything and the kernel's own overhead is only the reading of the run
+ * time counter on each context switch.
+ *
+ * configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY must both be set
+ * to 1.  Times are in units of the run time counter, which is nanoseconds in
+ * the simulator ports.
+ *
+ * \defgroup CpuProfiler
+ */
+
+/* The maximum number of tasks the profiler reports on, including the idle and
+profiler tasks.  No snapshot is published for a period in which there were
+more tasks than this. */
+#ifndef configCPU_PROFILER_MAX_TASKS
+	#define configCPU_PROFILER_MAX_TASKS	16
+#endif
+
+/**
+ * cpu_profiler.h
+ *
+ * The statistics for one task over the last sample period.
+ *
+ * \defgroup CpuProfilerTaskStats_t CpuProfilerTaskStats_t
+ * \ingroup CpuProfiler
+ */
+typedef struct xCPU_PROFILER_TASK_STATS
+{
+	TaskHandle_t xHandle;
+	char pcTaskName[ configMAX_TASK_NAME_LEN ];		/* A copy of the name, so it stays valid if the task is deleted. */
+	eTaskState eCurrentState;						/* The state of the task when the sample was taken. */
+	UBaseType_t uxCurrentPriority;
+	uint32_t ulCpuPercentTimes100;					/* The share of the CPU time in the period used by the task, in hundredths of a percent. */
+	uint32_t ulSwitchIns;							/* The number of times the task was switched in during the period. */
+	configRUN_TIME_COUNTER_TYPE ulRunTime;			/* The time the task spent in the Running state during the period. */
+	configRUN_TIME_COUNTER_TYPE ulBlockedTime;		/* The time the task spent in the Blocked state that ended during the period. */
+} CpuProfilerTaskStats_t;
+
+/**
+ * cpu_profiler.h
+ *
+ * A published sample.
+ *
+ * \defgroup CpuProfilerSnapshot_t CpuProfilerSnapshot_t
+ * \ingroup CpuProfiler
+ */
+typedef struct xCPU_PROFILER_SNAPSHOT
+{
+	uint32_t ulSampleNumber;						/* Incremented each time a sample is published, starting from 1. */
+	configRUN_TIME_COUNTER_TYPE ulPeriod;			/* The run time counter time covered by the sample. */
+	UBaseType_t uxNumberOfTasks;					/* The number of valid entries in xTasks[]. */
+	CpuProfilerTaskStats_t xTasks[ configCPU_PROFILER_MAX_TASKS ];
+} CpuProfilerSnapshot_t;
+
+/**
+ * cpu_profiler.h
+ * <pre>
+ BaseType_t xCpuProfilerStart( TickType_t xSamplePeriod, UBaseType_t uxPriority );
+ </pre>
+ *
+ * Create the profiler task.  It can be called before or after the scheduler
+ * is started, but only once.
+ *
+ * @param xSamplePeriod The time between samples, in ticks.
+ *
+ * @param uxPriority The priority of the profiler task.  A high priority keeps
+ * the sample period accurate - the task only runs briefly each period.
+ *
+ * @return pdPASS if the task was created, otherwise pdFAIL.
+ *
+ * \defgroup xCpuProfilerStart xCpuProfilerStart
+ * \ingroup CpuProfiler
+ */
+BaseType_t xCpuProfilerStart( TickType_t xSamplePeriod, UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * cpu_profiler.h
+ * <pre>
+ BaseType_t xCpuProfilerGetSnapshot( CpuProfilerSnapshot_t *pxSnapshot );
+ </pre>
+ *
+ * Copy the most recently published sample into *pxSnapshot.  The copy is made
+ * in a short critical section, so it can be called from any task while the
+ * profiler is running.
+ *
+ * @return pdTRUE if a sample was copied, or pdFALSE if the profiler has not
+ * yet completed its first period.
+ *
+ * \defgroup xCpuProfilerGetSnapshot xCpuProfilerGetSnapshot
+ * \ingroup CpuProfiler
+ */
+BaseType_t xCpuProfilerGetSnapshot( CpuProfilerSnapshot_t *pxSnapshot ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CPU_PROFILER_H */
+
@@ -170,7 +170,63 @@ typedef struct corCoRoutineControlBlock
  * \defgroup xCoRoutineCreate xCoRoutineCreate
  * \ingroup Tasks
  */
-BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex );
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	BaseType_t xCoRoutineCreate( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex );
+#endif
+
+/**
+ * croutine. h
+ *<pre>
+ BaseType_t xCoRoutineCreateStatic(
+                                 crCOROUTINE_CODE pxCoRoutineCode,
+                                 UBaseType_t uxPriority,
+                                 UBaseType_t uxIndex,
+                                 CRCB_t *pxCoRoutineBuffer
+                               );</pre>
+ *
+ * As xCoRoutineCreate(), but the co-routine control block is provided by the
+ * caller rather than allocated from the FreeRTOS heap.  Co-routines cannot be
+ * deleted, so the buffer must remain valid for as long as the application
+ * runs - it is normally a global or static variable.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param pxCoRoutineCode Pointer to the co-routine function.
+ *
+ * @param uxPriority The priority with respect to other co-routines at which
+ *  the co-routine will run.
+ *
+ * @param uxIndex Used to distinguish between different co-routines that
+ * execute the same function.
+ *
+ * @param pxCoRoutineBuffer Must point to a variable of type CRCB_t, which will
+ * be used to hold the co-routine's control block.
+ *
+ * @return pdPASS if the co-routine was successfully created and added to a
+ * ready list, otherwise pdFAIL.
+ *
+ * Example usage:
+   <pre>
+ // One control block for each co-routine that runs vFlashCoRoutine().
+ static CRCB_t xFlashCoRoutines[ 2 ];
+
+ void vOtherFunction( void )
+ {
+ UBaseType_t uxIndex;
+
+     for( uxIndex = 0; uxIndex < 2; uxIndex++ )
+     {
+         xCoRoutineCreateStatic( vFlashCoRoutine, 0, uxIndex, &( xFlashCoRoutines[ uxIndex ] ) );
+     }
+ }
+   </pre>
+ * \defgroup xCoRoutineCreateStatic xCoRoutineCreateStatic
+ * \ingroup Tasks
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	BaseType_t xCoRoutineCreateStatic( crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex, CRCB_t *pxCoRoutineBuffer );
+#endif
 
 
 /**
@@ -755,6 +811,17 @@ void vCoRoutineAddToDelayedList( TickType_t xTicksToDelay, List_t *pxEventList )
  */
 BaseType_t xCoRoutineRemoveFromEventList( const List_t *pxEventList );
 
+/*
+ * This function is intended for internal use by the kernel only.  The
+ * function should not be used by application writers.
+ *
+ * Returns the number of ticks until the next co-routine is ready to run - 0 if
+ * one is ready now, or portMAX_DELAY if no co-routines have been created.  The
+ * idle task, which schedules the co-routines from the idle hook, uses this so
+ * it does not sleep past a co-routine's wake time.
+ */
+TickType_t xCoRoutineGetExpectedIdleTime( void );
+
 #ifdef __cplusplus
 }
 #endif
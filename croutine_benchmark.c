@@ -0,0 +1,430 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A benchmark of the cost of running housekeeping sensors as co-routines,
+ * compared with running each sensor as a task.  crbCOUNTS[] sets how many
+ * sensors run in each test.  Every sensor samples as often as it can, passing
+ * each reading through a queue to a collector of a higher priority, so the
+ * time per sample is the cost of scheduling a sensor and passing its reading.
+ *
+ * For each count the benchmark prints:
+ *
+ * + The bytes of FreeRTOS heap used per sensor.  A co-routine only needs its
+ *   control block, as all the co-routines share the stack of the idle task.  A
+ *   task needs its TCB and its stack.  Note these are host sizes, as a
+ *   pointer is 8 bytes on the host but 4 bytes on a 32-bit target.
+ *
+ * + The kilobytes of host memory (resident set) used per sensor.  Each task
+ *   is also a host thread or fiber, with a host stack that is mostly not
+ *   touched, so this is small, but it is zero for a co-routine.
+ *
+ * + The nanoseconds of host time per sample.  The co-routines are run by the
+ *   idle task, from the idle hook in supporting_functions.c, while the
+ *   benchmark task is delayed.
+ *
+ * The co-routines cannot be deleted, so they are created last for each count,
+ * and those created for one count are reused by the next.  The tasks are
+ * deleted before the co-routines are created, and do not run after that.
+ *
+ * The benchmark is built in place of main.c with a heap large enough for the
+ * tasks, for example:
+ *
+ *   gcc -O2 -I. -DconfigUSE_FIBERS=1 -DconfigTOTAL_HEAP_SIZE=2000000 croutine_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o croutine_benchmark -lpthread
+ *   ./croutine_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "croutine.h"
+
+#if( configUSE_CO_ROUTINES != 1 )
+	#error The co-routine benchmark must be built with configUSE_CO_ROUTINES set to 1.
+#endif
+
+#define crbMAX_SENSORS			( 1000UL )
+#define crbQUEUE_LENGTH			( 8 )
+#define crbMEASURE_TIME			pdMS_TO_TICKS( 500 )
+
+/* Priorities of the tasks.  The benchmark task must preempt the sensors. */
+#define crbSENSOR_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define crbCOLLECTOR_PRIORITY	( tskIDLE_PRIORITY + 2 )
+#define crbBENCHMARK_PRIORITY	( tskIDLE_PRIORITY + 3 )
+
+/* A reading passed from a sensor to its collector. */
+typedef struct SENSOR_READING
+{
+	uint16_t usSensor;
+	int16_t sValue;
+} SensorReading_t;
+
+/* The results of one test. */
+typedef struct SENSOR_COST
+{
+	double dHeapBytes;		/* FreeRTOS heap per sensor. */
+	double dHostKilobytes;	/* Host resident memory per sensor. */
+	double dSampleTime;		/* Host nanoseconds per sample. */
+} SensorCost_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the tests for each count in turn, prints the results and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Measure ulCount sensors run as tasks, then delete them.
+ */
+static void prvMeasureTasks( uint32_t ulCount, SensorCost_t *pxCost );
+
+/*
+ * Measure ulCount sensors run as co-routines, creating those that do not
+ * exist yet.
+ */
+static void prvMeasureCoRoutines( uint32_t ulCount, SensorCost_t *pxCost );
+
+/*
+ * The sensors and collectors, as tasks and as co-routines.
+ */
+static void prvSensorTask( void *pvParameters );
+static void prvCollectorTask( void *pvParameters );
+static void prvSensorCoRoutine( CoRoutineHandle_t xHandle, UBaseType_t uxIndex );
+static void prvCollectorCoRoutine( CoRoutineHandle_t xHandle, UBaseType_t uxIndex );
+
+/*
+ * The nanoseconds per sample while the sensors run for crbMEASURE_TIME.
+ */
+static double prvTimeSamples( void );
+
+/*
+ * The host's resident memory in bytes, and monotonic clock in nanoseconds.
+ */
+static double prvResidentBytes( void );
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static const uint32_t crbCOUNTS[] = { 10UL, 100UL, 1000UL };
+
+static TaskHandle_t xSensorTasks[ crbMAX_SENSORS ];
+static TaskHandle_t xCollectorTask = NULL;
+static QueueHandle_t xTaskQueue = NULL, xCoRoutineQueue = NULL;
+
+/* A co-routine does not keep its local variables while it is blocked, so the
+reading each one is sending is kept here. */
+static SensorReading_t xCoRoutineReadings[ crbMAX_SENSORS ];
+static uint32_t ulCoRoutinesCreated = 0UL;
+
+/* Incremented by the collectors for each reading received. */
+static volatile uint32_t ulSamples = 0UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskQueue = xQueueCreate( crbQUEUE_LENGTH, sizeof( SensorReading_t ) );
+	xCoRoutineQueue = xQueueCreate( crbQUEUE_LENGTH, sizeof( SensorReading_t ) );
+
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, crbBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+SensorCost_t xTasks, xCoRoutines;
+size_t x;
+
+	( void ) pvParameters;
+
+	printf( "sizeof( CRCB_t ) = %u bytes, sizeof( StaticTask_t ) = %u bytes, task stack = %u bytes\n\n",
+		( unsigned ) sizeof( CRCB_t ), ( unsigned ) sizeof( StaticTask_t ), ( unsigned ) ( configMINIMAL_STACK_SIZE * sizeof( StackType_t ) ) );
+	printf( "             Heap (bytes per sensor)   Host (KB per sensor)      Time (ns per sample)\n" );
+	printf( "Sensors      Tasks     Co-routines     Tasks     Co-routines     Tasks     Co-routines\n" );
+
+	for( x = 0; x < sizeof( crbCOUNTS ) / sizeof( crbCOUNTS[ 0 ] ); x++ )
+	{
+		prvMeasureTasks( crbCOUNTS[ x ], &xTasks );
+		prvMeasureCoRoutines( crbCOUNTS[ x ], &xCoRoutines );
+
+		printf( "%-12lu %-9.0f %-15.0f %-9.1f %-15.1f %-9.0f %.0f\n", ( unsigned long ) crbCOUNTS[ x ],
+			xTasks.dHeapBytes, xCoRoutines.dHeapBytes,
+			xTasks.dHostKilobytes, xCoRoutines.dHostKilobytes,
+			xTasks.dSampleTime, xCoRoutines.dSampleTime );
+	}
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureTasks( uint32_t ulCount, SensorCost_t *pxCost )
+{
+uint32_t ulSensor;
+size_t xFreeBefore;
+double dResidentBefore;
+
+	xFreeBefore = xPortGetFreeHeapSize();
+	dResidentBefore = prvResidentBytes();
+
+	for( ulSensor = 0; ulSensor < ulCount; ulSensor++ )
+	{
+		if( xTaskCreate( prvSensorTask, "SENSOR", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ulSensor, crbSENSOR_PRIORITY, &( xSensorTasks[ ulSensor ] ) ) != pdPASS )
+		{
+			printf( "Could not create %lu tasks, build with a larger configTOTAL_HEAP_SIZE\n", ( unsigned long ) ulCount );
+			exit( 1 );
+		}
+	}
+
+	pxCost->dHeapBytes = ( double ) ( xFreeBefore - xPortGetFreeHeapSize() ) / ( double ) ulCount;
+
+	/* The host memory is only touched once the tasks have run. */
+	xTaskCreate( prvCollectorTask, "COLLECT", configMINIMAL_STACK_SIZE, NULL, crbCOLLECTOR_PRIORITY, &xCollectorTask );
+	pxCost->dSampleTime = prvTimeSamples();
+	pxCost->dHostKilobytes = ( prvResidentBytes() - dResidentBefore ) / ( 1024.0 * ( double ) ulCount );
+
+	/* The idle task frees the memory of the deleted tasks. */
+	for( ulSensor = 0; ulSensor < ulCount; ulSensor++ )
+	{
+		vTaskDelete( xSensorTasks[ ulSensor ] );
+	}
+
+	vTaskDelete( xCollectorTask );
+	xQueueReset( xTaskQueue );
+	vTaskDelay( pdMS_TO_TICKS( 100 ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvMeasureCoRoutines( uint32_t ulCount, SensorCost_t *pxCost )
+{
+size_t xFreeBefore;
+double dResidentBefore;
+uint32_t ulCreated = ulCoRoutinesCreated;
+
+	xFreeBefore = xPortGetFreeHeapSize();
+	dResidentBefore = prvResidentBytes();
+
+	/* The collector is the first co-routine created. */
+	if( ulCoRoutinesCreated == 0UL )
+	{
+		xCoRoutineCreate( prvCollectorCoRoutine, 1, 0 );
+		xFreeBefore = xPortGetFreeHeapSize();
+	}
+
+	for( ; ulCoRoutinesCreated < ulCount; ulCoRoutinesCreated++ )
+	{
+		if( xCoRoutineCreate( prvSensorCoRoutine, 0, ulCoRoutinesCreated ) != pdPASS )
+		{
+			printf( "Could not create %lu co-routines, build with a larger configTOTAL_HEAP_SIZE\n", ( unsigned long ) ulCount );
+			exit( 1 );
+		}
+	}
+
+	pxCost->dHeapBytes = ( double ) ( xFreeBefore - xPortGetFreeHeapSize() ) / ( double ) ( ulCount - ulCreated );
+	pxCost->dSampleTime = prvTimeSamples();
+	pxCost->dHostKilobytes = ( prvResidentBytes() - dResidentBefore ) / ( 1024.0 * ( double ) ( ulCount - ulCreated ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSensorTask( void *pvParameters )
+{
+SensorReading_t xReading;
+
+	xReading.usSensor = ( uint16_t ) ( uintptr_t ) pvParameters;
+	xReading.sValue = 0;
+
+	for( ;; )
+	{
+		xReading.sValue++;
+		xQueueSend( xTaskQueue, &xReading, portMAX_DELAY );
+
+		/* Let the other sensors of the same priority sample. */
+		taskYIELD();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCollectorTask( void *pvParameters )
+{
+SensorReading_t xReading;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xQueueReceive( xTaskQueue, &xReading, portMAX_DELAY ) == pdPASS )
+		{
+			ulSamples++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSensorCoRoutine( CoRoutineHandle_t xHandle, UBaseType_t uxIndex )
+{
+BaseType_t xResult;
+
+	crSTART( xHandle );
+
+	xCoRoutineReadings[ uxIndex ].usSensor = ( uint16_t ) uxIndex;
+
+	for( ;; )
+	{
+		xCoRoutineReadings[ uxIndex ].sValue++;
+		crQUEUE_SEND( xHandle, xCoRoutineQueue, &( xCoRoutineReadings[ uxIndex ] ), crbMEASURE_TIME, &xResult );
+
+		/* Let the other sensors of the same priority sample. */
+		crDELAY( xHandle, 0 );
+	}
+
+	crEND();
+}
+/*-----------------------------------------------------------*/
+
+static void prvCollectorCoRoutine( CoRoutineHandle_t xHandle, UBaseType_t uxIndex )
+{
+static SensorReading_t xReading;
+BaseType_t xResult;
+
+	( void ) uxIndex;
+
+	crSTART( xHandle );
+
+	for( ;; )
+	{
+		crQUEUE_RECEIVE( xHandle, xCoRoutineQueue, &xReading, crbMEASURE_TIME, &xResult );
+
+		if( xResult == pdPASS )
+		{
+			ulSamples++;
+		}
+	}
+
+	crEND();
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeSamples( void )
+{
+uint32_t ulStartSamples;
+double dStart;
+
+	/* Let the sensors start before the measurement. */
+	vTaskDelay( pdMS_TO_TICKS( 100 ) );
+
+	ulStartSamples = ulSamples;
+	dStart = prvNanoseconds();
+
+	vTaskDelay( crbMEASURE_TIME );
+
+	return ( prvNanoseconds() - dStart ) / ( double ) ( ulSamples - ulStartSamples );
+}
+/*-----------------------------------------------------------*/
+
+static double prvResidentBytes( void )
+{
+FILE *pxFile;
+unsigned long ulSize = 0UL, ulResident = 0UL;
+
+	pxFile = fopen( "/proc/self/statm", "r" );
+
+	if( pxFile != NULL )
+	{
+		if( fscanf( pxFile, "%lu %lu", &ulSize, &ulResident ) != 2 )
+		{
+			ulResident = 0UL;
+		}
+
+		fclose( pxFile );
+	}
+
+	return ( double ) ulResident * ( double ) sysconf( _SC_PAGESIZE );
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
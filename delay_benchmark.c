@@ -0,0 +1,243 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A benchmark of delayed tasks, for comparing the timing wheel in tasks.c
+ * (configUSE_TIMING_WHEEL set to 1) with the sorted delayed list.  For each
+ * count in dbTASK_COUNTS[] that many tasks each block for a pseudo random 1 to
+ * dbMAX_DELAY ticks as soon as they unblock, until about dbCYCLES block and
+ * unblock cycles have completed, and the host time per cycle is printed.
+ *
+ * So as not to wait for the simulated timer, the benchmark task generates the
+ * ticks itself, by calling xTaskIncrementTick() from within a critical section
+ * as fast as it can, and yields whenever a delayed task unblocks.  The delayed
+ * tasks have the higher priority, so each runs and blocks again before the
+ * next tick.  The time per cycle includes the ticks on which no task unblocks
+ * and the context switches to and from the task.  The part that differs is
+ * placing the task into the delayed list, which walks the sorted list - so
+ * grows with the number of delayed tasks - but takes constant time with the
+ * timing wheel.
+ *
+ * The benchmark is built in place of main.c with fibers, so the context
+ * switches do not hide the difference, and with a heap large enough for the
+ * tasks - once with and once without the timing wheel:
+ *
+ *   gcc -O2 -I. -DconfigUSE_FIBERS=1 -DconfigTOTAL_HEAP_SIZE=2000000 delay_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o delay_benchmark -lpthread
+ *   gcc -O2 -I. -DconfigUSE_FIBERS=1 -DconfigTOTAL_HEAP_SIZE=2000000 -DconfigUSE_TIMING_WHEEL=1 delay_benchmark.c ... -o delay_benchmark_wheel -lpthread
+ *   ./delay_benchmark && ./delay_benchmark_wheel
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define dbMAX_TASKS				( 1000UL )
+#define dbCYCLES				( 200000UL )
+#define dbMAX_DELAY				( 1000UL )
+
+#define dbBENCHMARK_PRIORITY	( tskIDLE_PRIORITY + 1 )
+#define dbDELAYED_PRIORITY		( tskIDLE_PRIORITY + 2 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Resumes the delayed tasks for each count in turn, generates ticks until they
+ * have completed dbCYCLES cycles, prints the results and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Blocks for a pseudo random number of ticks, over and over, counting each
+ * time it unblocks.
+ */
+static void prvDelayedTask( void *pvParameters );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static const uint32_t dbTASK_COUNTS[] = { 10UL, 100UL, 1000UL };
+
+static TaskHandle_t xDelayedTasks[ dbMAX_TASKS ];
+
+/* The number of cycles completed by all the delayed tasks.  Only one task runs
+at a time, so it does not need to be incremented atomically. */
+static volatile uint32_t ulCycles = 0UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, dbBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+uint32_t ulTask, ulCount, ulCyclesDone;
+BaseType_t xSwitchRequired;
+double dStart, dTime;
+size_t x;
+
+	( void ) pvParameters;
+
+	/* Each task runs as soon as it is created, and is suspended once it has
+	blocked, so the tasks only run while they are being timed. */
+	for( ulTask = 0; ulTask < dbMAX_TASKS; ulTask++ )
+	{
+		if( xTaskCreate( prvDelayedTask, "DELAYED", configMINIMAL_STACK_SIZE, ( void * ) ( size_t ) ulTask, dbDELAYED_PRIORITY, &( xDelayedTasks[ ulTask ] ) ) != pdPASS )
+		{
+			printf( "Could not create %lu tasks, build with a larger configTOTAL_HEAP_SIZE\n", ( unsigned long ) dbMAX_TASKS );
+			exit( 1 );
+		}
+
+		vTaskSuspend( xDelayedTasks[ ulTask ] );
+	}
+
+	printf( "%s, %lu cycles per count\n", ( configUSE_TIMING_WHEEL == 1 ) ? "Timing wheel" : "Sorted delayed list", ( unsigned long ) dbCYCLES );
+	printf( "Delayed tasks  ns per block and unblock cycle\n" );
+
+	for( x = 0; x < sizeof( dbTASK_COUNTS ) / sizeof( dbTASK_COUNTS[ 0 ] ); x++ )
+	{
+		ulCount = dbTASK_COUNTS[ x ];
+		ulCycles = 0UL;
+		dStart = prvNanoseconds();
+
+		for( ulTask = 0; ulTask < ulCount; ulTask++ )
+		{
+			vTaskResume( xDelayedTasks[ ulTask ] );
+		}
+
+		while( ulCycles < dbCYCLES )
+		{
+			taskENTER_CRITICAL();
+			{
+				xSwitchRequired = xTaskIncrementTick();
+			}
+			taskEXIT_CRITICAL();
+
+			if( xSwitchRequired != pdFALSE )
+			{
+				taskYIELD();
+			}
+		}
+
+		for( ulTask = 0; ulTask < ulCount; ulTask++ )
+		{
+			vTaskSuspend( xDelayedTasks[ ulTask ] );
+		}
+
+		dTime = prvNanoseconds() - dStart;
+		ulCyclesDone = ulCycles;
+
+		printf( "%-14lu %.0f\n", ( unsigned long ) ulCount, dTime / ( double ) ulCyclesDone );
+	}
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelayedTask( void *pvParameters )
+{
+uint32_t ulRandomState = ( uint32_t ) ( size_t ) pvParameters + 1UL;
+
+	for( ;; )
+	{
+		/* xorshift32, seeded differently for each task. */
+		ulRandomState ^= ulRandomState << 13;
+		ulRandomState ^= ulRandomState >> 17;
+		ulRandomState ^= ulRandomState << 5;
+
+		vTaskDelay( ( TickType_t ) ( ( ulRandomState % dbMAX_DELAY ) + 1UL ) );
+		ulCycles++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
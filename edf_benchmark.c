@@ -0,0 +1,279 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A schedulability benchmark for configUSE_EDF_SCHEDULING.  Three periodic
+ * tasks with a total utilisation of 98% run for a number of hyperperiods, and
+ * the response time of every release is compared with its deadline, which is
+ * the end of its period.  By default the tasks share a priority and are
+ * scheduled earliest deadline first.  With --rm they are instead given rate
+ * monotonic priorities (the shorter the period the higher the priority) and
+ * scheduled by priority alone, for comparison.  98% is well above the 78%
+ * utilisation bound that guarantees three tasks can be scheduled rate
+ * monotonic, and EDF can schedule any set of tasks of up to 100%.
+ *
+ * The benchmark is built in place of main.c:
+ *
+ *   gcc -O2 -I. -DconfigUSE_EDF_SCHEDULING=1 edf_benchmark.c croutine.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c -o edf_benchmark -lpthread
+ *   ./edf_benchmark
+ *   ./edf_benchmark --rm
+ *
+ * Each task executes by spinning until it has seen the tick count change the
+ * number of times given by its execution time.  Releases and preemptions only
+ * occur on a tick, so each change seen is one tick that the task ran for, even
+ * when the task was preempted in between.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_EDF_SCHEDULING != 1 )
+	#error The benchmark must be built with configUSE_EDF_SCHEDULING set to 1.
+#endif
+
+/* The least common multiple of the periods, after which the pattern of
+releases repeats, and the number of hyperperiods the benchmark runs for. */
+#define edfHYPERPERIOD			( ( TickType_t ) 198 )
+#define edfHYPERPERIODS			( ( TickType_t ) 5 )
+
+#define edfREPORT_PRIORITY		( configMAX_PRIORITIES - 1 )
+
+typedef struct xBENCHMARK_TASK
+{
+	const char *pcName;
+	TickType_t xExecutionTime;			/* In ticks. */
+	TickType_t xPeriod;					/* In ticks.  The deadline is the end of the period. */
+	UBaseType_t uxRateMonotonicPriority;
+	uint32_t ulReleases;
+	uint32_t ulMisses;
+	TickType_t xWorstResponseTime;
+	TickType_t xTicksExecuted;
+} BenchmarkTask_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * A periodic task that executes for pxTask->xExecutionTime ticks each period.
+ */
+static void prvPeriodicTask( void *pvParameters );
+
+/*
+ * Waits for the benchmark to finish, then prints the results and exits.
+ */
+static void prvReportTask( void *pvParameters );
+
+/*
+ * Spin until the tick count has changed xTicks times.
+ */
+static void prvExecute( TickType_t xTicks );
+
+/*-----------------------------------------------------------*/
+
+/* Utilisation 2/6 + 5/9 + 1/11 = 98.0%. */
+static BenchmarkTask_t xBenchmarkTasks[] =
+{
+	{ "T6",  2,  6, 3, 0, 0, 0, 0 },
+	{ "T9",  5,  9, 2, 0, 0, 0, 0 },
+	{ "T11", 1, 11, 1, 0, 0, 0, 0 }
+};
+
+#define edfNUM_TASKS			( sizeof( xBenchmarkTasks ) / sizeof( xBenchmarkTasks[ 0 ] ) )
+
+static BaseType_t xUseEDF = pdTRUE;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+size_t x;
+TaskHandle_t xHandle;
+
+	if( ( argc > 1 ) && ( strcmp( argv[ 1 ], "--rm" ) == 0 ) )
+	{
+		xUseEDF = pdFALSE;
+	}
+
+	for( x = 0; x < edfNUM_TASKS; x++ )
+	{
+		/* Under EDF the tasks share a priority and are ordered by deadline.
+		Setting the deadlines before the scheduler starts releases every task
+		at tick 0. */
+		if( xUseEDF != pdFALSE )
+		{
+			xTaskCreate( prvPeriodicTask, xBenchmarkTasks[ x ].pcName, configMINIMAL_STACK_SIZE, &( xBenchmarkTasks[ x ] ), tskIDLE_PRIORITY + 1, &xHandle );
+			vTaskSetDeadline( xHandle, xBenchmarkTasks[ x ].xPeriod, xBenchmarkTasks[ x ].xPeriod );
+		}
+		else
+		{
+			xTaskCreate( prvPeriodicTask, xBenchmarkTasks[ x ].pcName, configMINIMAL_STACK_SIZE, &( xBenchmarkTasks[ x ] ), xBenchmarkTasks[ x ].uxRateMonotonicPriority, NULL );
+		}
+	}
+
+	xTaskCreate( prvReportTask, "REPORT", configMINIMAL_STACK_SIZE, NULL, edfREPORT_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+BenchmarkTask_t *pxTask = ( BenchmarkTask_t * ) pvParameters;
+TickType_t xRelease = ( TickType_t ) 0, xResponseTime;
+
+	for( ;; )
+	{
+		prvExecute( pxTask->xExecutionTime );
+
+		xResponseTime = xTaskGetTickCount() - xRelease;
+		pxTask->ulReleases++;
+		pxTask->xTicksExecuted += pxTask->xExecutionTime;
+
+		if( xResponseTime > pxTask->xWorstResponseTime )
+		{
+			pxTask->xWorstResponseTime = xResponseTime;
+		}
+
+		if( xResponseTime > pxTask->xPeriod )
+		{
+			pxTask->ulMisses++;
+		}
+
+		/* Both wait for the next release at a fixed interval, and neither
+		blocks if the release has already occurred. */
+		if( xUseEDF != pdFALSE )
+		{
+			( void ) xTaskWaitForNextPeriod();
+			xRelease += pxTask->xPeriod;
+		}
+		else
+		{
+			vTaskDelayUntil( &xRelease, pxTask->xPeriod );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReportTask( void *pvParameters )
+{
+size_t x;
+uint32_t ulMisses = 0;
+TickType_t xTicksExecuted = 0;
+const TickType_t xDuration = edfHYPERPERIOD * edfHYPERPERIODS;
+
+	( void ) pvParameters;
+
+	vTaskDelay( xDuration );
+
+	/* Stop the periodic tasks so the results do not change while they are
+	printed. */
+	vTaskSuspendAll();
+
+	printf( "%s: %lu ticks, %lu hyperperiods\n\n", ( xUseEDF != pdFALSE ) ? "Earliest deadline first" : "Rate monotonic", ( unsigned long ) xDuration, ( unsigned long ) edfHYPERPERIODS );
+	printf( "Task  C   T   Releases  Misses  Worst response\n" );
+
+	for( x = 0; x < edfNUM_TASKS; x++ )
+	{
+		printf( "%-5s %-3lu %-3lu %-9lu %-7lu %lu\n", xBenchmarkTasks[ x ].pcName, ( unsigned long ) xBenchmarkTasks[ x ].xExecutionTime, ( unsigned long ) xBenchmarkTasks[ x ].xPeriod,
+				( unsigned long ) xBenchmarkTasks[ x ].ulReleases, ( unsigned long ) xBenchmarkTasks[ x ].ulMisses, ( unsigned long ) xBenchmarkTasks[ x ].xWorstResponseTime );
+
+		ulMisses += xBenchmarkTasks[ x ].ulMisses;
+		xTicksExecuted += xBenchmarkTasks[ x ].xTicksExecuted;
+	}
+
+	printf( "\nUtilisation %.1f%%, %lu deadlines missed\n", ( 100.0 * ( double ) xTicksExecuted ) / ( double ) xDuration, ( unsigned long ) ulMisses );
+
+	exit( ( ulMisses == 0 ) ? 0 : 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvExecute( TickType_t xTicks )
+{
+TickType_t xLastTickCount = xTaskGetTickCount(), xTickCount;
+
+	while( xTicks > ( TickType_t ) 0 )
+	{
+		xTickCount = xTaskGetTickCount();
+
+		if( xTickCount != xLastTickCount )
+		{
+			xLastTickCount = xTickCount;
+			xTicks--;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,543 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A benchmark of the heap allocators that replays a trace of allocations and
+ * frees, so heap_4.c and heap_tlsf.c can be compared on the same requests.  It
+ * is built twice in place of main.c, once with each heap file, and prints:
+ *
+ * + The mean, the 99.9th percentile and the largest time taken by
+ *   pvPortMalloc() and by vPortFree().  The trace is replayed hbREPLAYS times
+ *   and each allocation and free is given the shortest time it took in any
+ *   replay, so time stolen by the host does not count, but the cost of the
+ *   allocator's own worst cases does.
+ *
+ * + The fragmentation.  The peak allocated bytes, including block headers and
+ *   alignment, is configTOTAL_HEAP_SIZE less xPortGetMinimumEverFreeHeapSize().
+ *   The span is the distance from the lowest to the highest byte of the heap
+ *   ever allocated, which is the smallest heap the trace could be replayed in.
+ *   The fragmentation is the part of the span that was never needed to hold
+ *   the peak allocated bytes.
+ *
+ * With no arguments the benchmark replays a synthetic trace that it generates
+ * when it starts, always the same from the same seed.  The trace imitates a
+ * session open and close churn - blocks of 16 bytes to 16 KiB that live for a
+ * short time, with small blocks that live until the end of the trace
+ * interleaved among them, which fragments the heap.  It is not a recording of
+ * the simulator.
+ *
+ * A trace in a file, for example one recorded from an application with the
+ * traceMALLOC() and traceFREE() hooks, is replayed by naming the file.  Each
+ * line is either "a <slot> <bytes>", which allocates bytes and holds the block
+ * in slot, or "f <slot>", which frees the block held in slot.  Lines that start
+ * with # are comments.  Every block must be freed by the end of the trace, so
+ * it can be replayed again from the start.  --generate writes the synthetic
+ * trace to a file in the same format.
+ *
+ *   gcc -O2 -I. -DconfigTOTAL_HEAP_SIZE=2000000 heap_benchmark.c heap_4.c croutine.c cpu_profiler.c event_groups.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o heap_benchmark -lpthread
+ *   ./heap_benchmark
+ *   gcc -O2 -I. -DconfigTOTAL_HEAP_SIZE=2000000 heap_benchmark.c heap_tlsf.c croutine.c cpu_profiler.c event_groups.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o heap_benchmark -lpthread
+ *   ./heap_benchmark
+ *
+ * Only the heap is exercised, so the scheduler is not started.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define hbMAX_EVENTS			( 100000UL )
+#define hbSLOTS					( 4096UL )
+#define hbREPLAYS				( 7 )
+
+/* The shape of the generated trace. */
+#define hbGENERATED_ALLOCATIONS	( 10000UL )
+#define hbLONG_LIVED_PERCENT	( 3UL )
+#define hbMAX_SHORT_LIVED		( 160UL )
+
+/* A request of the trace. */
+typedef struct HEAP_EVENT
+{
+	char cOperation;
+	uint32_t ulSlot;
+	size_t xBytes;
+} HeapEvent_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Generates the synthetic trace into xEvents[].
+ */
+static void prvGenerateTrace( void );
+
+/*
+ * Reads the trace in pcFileName into xEvents[], or writes the trace in
+ * xEvents[] to pcFileName.
+ */
+static void prvReadTrace( const char *pcFileName );
+static void prvWriteTrace( const char *pcFileName );
+
+/*
+ * Appends an event to xEvents[], keeping track of the bytes allocated.  Returns
+ * pdFALSE if the event allocates into a slot that is in use, or frees a slot
+ * that is not.
+ */
+static BaseType_t prvAddEvent( char cOperation, uint32_t ulSlot, size_t xBytes );
+
+/*
+ * Replays the trace, keeping the shortest time of each event in dEventTimes[].
+ */
+static void prvReplayTrace( void );
+
+/*
+ * Prints the mean, 99.9th percentile and largest of the times of the events
+ * that are cOperation.
+ */
+static void prvPrintTimes( const char *pcName, char cOperation );
+
+/*
+ * A pseudo random sequence used to generate the trace.
+ */
+static uint32_t prvRandom( void );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static HeapEvent_t xEvents[ hbMAX_EVENTS ];
+static double dEventTimes[ hbMAX_EVENTS ];
+static uint32_t ulEventCount = 0UL;
+
+static void *pvSlots[ hbSLOTS ];
+
+/* The bytes allocated in each slot while the trace is built, and the bytes
+allocated at once, now and at the peak. */
+static size_t xSlotBytes[ hbSLOTS ];
+static size_t xBytesHeld = 0, xPeakBytes = 0;
+
+/* The lowest and highest addresses of the heap that have been allocated. */
+static uint8_t *pucLowest = NULL, *pucHighest = NULL;
+
+/* The time taken to read the clock, which is taken off each event. */
+static double dClockTime = 0.0;
+
+static uint32_t ulRandomState = 1UL;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+size_t xPeakAllocated, xSpan;
+double dStart;
+int iReplay;
+
+	if( ( argc == 3 ) && ( strcmp( argv[ 1 ], "--generate" ) == 0 ) )
+	{
+		prvGenerateTrace();
+		prvWriteTrace( argv[ 2 ] );
+		return 0;
+	}
+	else if( argc == 2 )
+	{
+		prvReadTrace( argv[ 1 ] );
+	}
+	else if( argc == 1 )
+	{
+		prvGenerateTrace();
+	}
+	else
+	{
+		printf( "Usage: %s [trace | --generate trace]\n", argv[ 0 ] );
+		return 1;
+	}
+
+	/* A failed allocation would stop in the malloc failed hook. */
+	if( ( xPeakBytes * 2U ) > ( size_t ) configTOTAL_HEAP_SIZE )
+	{
+		printf( "The trace holds up to %lu bytes, build with a configTOTAL_HEAP_SIZE of at least twice that\n", ( unsigned long ) xPeakBytes );
+		return 1;
+	}
+
+	dClockTime = 1e30;
+	for( iReplay = 0; iReplay < 1000; iReplay++ )
+	{
+		dStart = prvNanoseconds();
+		dStart = prvNanoseconds() - dStart;
+		if( dStart < dClockTime )
+		{
+			dClockTime = dStart;
+		}
+	}
+
+	for( iReplay = 0; iReplay < hbREPLAYS; iReplay++ )
+	{
+		prvReplayTrace();
+	}
+
+	xPeakAllocated = ( size_t ) configTOTAL_HEAP_SIZE - xPortGetMinimumEverFreeHeapSize();
+	xSpan = ( size_t ) ( pucHighest - pucLowest );
+
+	printf( "%s trace of %lu events, shortest of %d replays, peak payload %lu bytes\n\n", ( argc == 1 ) ? "Synthetic" : argv[ 1 ], ( unsigned long ) ulEventCount, hbREPLAYS, ( unsigned long ) xPeakBytes );
+	printf( "               Mean (ns)  99.9%% (ns)  Largest (ns)\n" );
+	prvPrintTimes( "pvPortMalloc", 'a' );
+	prvPrintTimes( "vPortFree", 'f' );
+	printf( "\nPeak allocated %lu bytes, span %lu bytes, fragmentation %.1f%%\n", ( unsigned long ) xPeakAllocated,
+			( unsigned long ) xSpan, 100.0 * ( 1.0 - ( ( double ) xPeakAllocated / ( double ) xSpan ) ) );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGenerateTrace( void )
+{
+static uint32_t ulShortLived[ hbSLOTS ];
+static uint8_t ucSlotUsed[ hbSLOTS ];
+uint32_t ulAllocation, ulShortLivedCount = 0UL, ulSlot, ulIndex, ulShift;
+size_t xBytes;
+
+	for( ulAllocation = 0; ulAllocation < hbGENERATED_ALLOCATIONS; ulAllocation++ )
+	{
+		/* Find a free slot. */
+		do
+		{
+			ulSlot = prvRandom() % hbSLOTS;
+		} while( ucSlotUsed[ ulSlot ] != 0U );
+
+		if( ( prvRandom() % 100UL ) < hbLONG_LIVED_PERCENT )
+		{
+			/* A small block that lives until the end of the trace. */
+			xBytes = ( size_t ) ( 16UL + ( prvRandom() % 241UL ) );
+			ucSlotUsed[ ulSlot ] = 2U;
+		}
+		else
+		{
+			/* Free short lived blocks until there are fewer than a random
+			number of them. */
+			while( ulShortLivedCount > ( prvRandom() % hbMAX_SHORT_LIVED ) )
+			{
+				ulIndex = prvRandom() % ulShortLivedCount;
+				( void ) prvAddEvent( 'f', ulShortLived[ ulIndex ], 0U );
+				ucSlotUsed[ ulShortLived[ ulIndex ] ] = 0U;
+				ulShortLivedCount--;
+				ulShortLived[ ulIndex ] = ulShortLived[ ulShortLivedCount ];
+			}
+
+			/* Sizes from 16 bytes to 16 KiB, with as many blocks of each
+			power of two. */
+			ulShift = prvRandom() % 10UL;
+			xBytes = ( size_t ) ( ( 16UL << ulShift ) + ( prvRandom() % ( 16UL << ulShift ) ) );
+			ulShortLived[ ulShortLivedCount++ ] = ulSlot;
+			ucSlotUsed[ ulSlot ] = 1U;
+		}
+
+		( void ) prvAddEvent( 'a', ulSlot, xBytes );
+	}
+
+	/* Free the short lived blocks, then those that live until the end. */
+	for( ulIndex = 0; ulIndex < ulShortLivedCount; ulIndex++ )
+	{
+		( void ) prvAddEvent( 'f', ulShortLived[ ulIndex ], 0U );
+		ucSlotUsed[ ulShortLived[ ulIndex ] ] = 0U;
+	}
+
+	for( ulSlot = 0; ulSlot < hbSLOTS; ulSlot++ )
+	{
+		if( ucSlotUsed[ ulSlot ] != 0U )
+		{
+			( void ) prvAddEvent( 'f', ulSlot, 0U );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReadTrace( const char *pcFileName )
+{
+char cLine[ 200 ];
+unsigned long ulSlot, ulBytes;
+BaseType_t xValid;
+FILE *pxFile;
+
+	pxFile = fopen( pcFileName, "r" );
+	if( pxFile == NULL )
+	{
+		printf( "Could not read %s\n", pcFileName );
+		exit( 1 );
+	}
+
+	while( fgets( cLine, sizeof( cLine ), pxFile ) != NULL )
+	{
+		if( cLine[ 0 ] == '#' )
+		{
+			continue;
+		}
+		else if( ( sscanf( cLine, "a %lu %lu", &ulSlot, &ulBytes ) == 2 ) && ( ulSlot < hbSLOTS ) && ( ulBytes > 0UL ) )
+		{
+			xValid = prvAddEvent( 'a', ( uint32_t ) ulSlot, ( size_t ) ulBytes );
+		}
+		else if( ( sscanf( cLine, "f %lu", &ulSlot ) == 1 ) && ( ulSlot < hbSLOTS ) )
+		{
+			xValid = prvAddEvent( 'f', ( uint32_t ) ulSlot, 0U );
+		}
+		else
+		{
+			xValid = pdFALSE;
+		}
+
+		if( xValid == pdFALSE )
+		{
+			printf( "Event %lu of %s is not valid: %s", ( unsigned long ) ulEventCount + 1UL, pcFileName, cLine );
+			exit( 1 );
+		}
+	}
+
+	fclose( pxFile );
+
+	if( xBytesHeld != 0U )
+	{
+		printf( "%s does not free every block it allocates\n", pcFileName );
+		exit( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteTrace( const char *pcFileName )
+{
+uint32_t ulEvent;
+FILE *pxFile;
+
+	pxFile = fopen( pcFileName, "w" );
+	if( pxFile == NULL )
+	{
+		printf( "Could not write %s\n", pcFileName );
+		exit( 1 );
+	}
+
+	fprintf( pxFile, "# Synthetic heap trace generated by heap_benchmark.c --generate.  a <slot> <bytes> allocates, f <slot> frees.\n" );
+
+	for( ulEvent = 0; ulEvent < ulEventCount; ulEvent++ )
+	{
+		if( xEvents[ ulEvent ].cOperation == 'a' )
+		{
+			fprintf( pxFile, "a %lu %lu\n", ( unsigned long ) xEvents[ ulEvent ].ulSlot, ( unsigned long ) xEvents[ ulEvent ].xBytes );
+		}
+		else
+		{
+			fprintf( pxFile, "f %lu\n", ( unsigned long ) xEvents[ ulEvent ].ulSlot );
+		}
+	}
+
+	fclose( pxFile );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAddEvent( char cOperation, uint32_t ulSlot, size_t xBytes )
+{
+	if( ulEventCount == hbMAX_EVENTS )
+	{
+		printf( "The trace has more than %lu events\n", ( unsigned long ) hbMAX_EVENTS );
+		exit( 1 );
+	}
+
+	if( cOperation == 'a' )
+	{
+		if( xSlotBytes[ ulSlot ] != 0U )
+		{
+			return pdFALSE;
+		}
+
+		xSlotBytes[ ulSlot ] = xBytes;
+		xBytesHeld += xBytes;
+		if( xBytesHeld > xPeakBytes )
+		{
+			xPeakBytes = xBytesHeld;
+		}
+	}
+	else
+	{
+		if( xSlotBytes[ ulSlot ] == 0U )
+		{
+			return pdFALSE;
+		}
+
+		xBytesHeld -= xSlotBytes[ ulSlot ];
+		xSlotBytes[ ulSlot ] = 0U;
+	}
+
+	xEvents[ ulEventCount ].cOperation = cOperation;
+	xEvents[ ulEventCount ].ulSlot = ulSlot;
+	xEvents[ ulEventCount ].xBytes = xBytes;
+	dEventTimes[ ulEventCount ] = 1e30;
+	ulEventCount++;
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReplayTrace( void )
+{
+uint32_t ulEvent;
+HeapEvent_t *pxEvent;
+uint8_t *pucBlock;
+double dStart, dTime;
+
+	for( ulEvent = 0; ulEvent < ulEventCount; ulEvent++ )
+	{
+		pxEvent = &( xEvents[ ulEvent ] );
+
+		if( pxEvent->cOperation == 'a' )
+		{
+			dStart = prvNanoseconds();
+			pucBlock = ( uint8_t * ) pvPortMalloc( pxEvent->xBytes );
+			dTime = prvNanoseconds() - dStart;
+
+			pvSlots[ pxEvent->ulSlot ] = pucBlock;
+
+			if( ( pucLowest == NULL ) || ( pucBlock < pucLowest ) )
+			{
+				pucLowest = pucBlock;
+			}
+			if( ( pucBlock + pxEvent->xBytes ) > pucHighest )
+			{
+				pucHighest = pucBlock + pxEvent->xBytes;
+			}
+		}
+		else
+		{
+			dStart = prvNanoseconds();
+			vPortFree( pvSlots[ pxEvent->ulSlot ] );
+			dTime = prvNanoseconds() - dStart;
+		}
+
+		dTime -= dClockTime;
+		if( dTime < dEventTimes[ ulEvent ] )
+		{
+			dEventTimes[ ulEvent ] = dTime;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareTimes( const void *pv1, const void *pv2 )
+{
+double d1 = *( const double * ) pv1, d2 = *( const double * ) pv2;
+
+	return ( d1 > d2 ) - ( d1 < d2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintTimes( const char *pcName, char cOperation )
+{
+static double dTimes[ hbMAX_EVENTS ];
+uint32_t ulEvent, ulCount = 0UL;
+double dTotal = 0.0;
+
+	for( ulEvent = 0; ulEvent < ulEventCount; ulEvent++ )
+	{
+		if( xEvents[ ulEvent ].cOperation == cOperation )
+		{
+			dTimes[ ulCount++ ] = dEventTimes[ ulEvent ];
+			dTotal += dEventTimes[ ulEvent ];
+		}
+	}
+
+	qsort( dTimes, ulCount, sizeof( double ), prvCompareTimes );
+
+	printf( "%-14s %-10.0f %-11.0f %.0f\n", pcName, dTotal / ( double ) ulCount,
+			dTimes[ ( ulCount * 999UL ) / 1000UL ], dTimes[ ulCount - 1UL ] );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+	/* xorshift32. */
+	ulRandomState ^= ulRandomState << 13;
+	ulRandomState ^= ulRandomState >> 17;
+	ulRandomState ^= ulRandomState << 5;
+	return ulRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
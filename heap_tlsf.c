@@ -0,0 +1,708 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses a two
+ * level segregated fit (TLSF) allocator, so both functions execute in constant
+ * time regardless of how fragmented the heap has become.  It can be used in
+ * place of heap_4.c - only one heap_x.c file should be built.
+ *
+ * Free blocks are kept in an array of lists.  The first level index is the
+ * position of the most significant bit of the block size, and the second level
+ * index splits each power of two range into heapSECOND_LEVEL_COUNT equal
+ * parts.  Two bitmaps record which lists are not empty, so a suitable list is
+ * found with two find-first-set operations instead of a walk through the free
+ * blocks.  If the first block in the list the requested size maps to is not
+ * large enough, the size is rounded up to the start of the next range before
+ * searching, so any block in the list found is large enough.  This is a good
+ * fit rather than a best fit, so it can need a somewhat larger heap than
+ * heap_4.c for the same allocation pattern.
+ *
+ * Each block records the block physically before it, so a block being freed is
+ * combined with free neighbours on both sides, again in constant time.
+ *
+ * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
+ * memory management pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* Each power of two range of block sizes is split into 2 ^ heapSECOND_LEVEL_LOG2
+lists.  Blocks smaller than heapSMALL_BLOCK_SIZE all share the first first
+level index, where the lists are spaced heapSMALL_BLOCK_SIZE /
+heapSECOND_LEVEL_COUNT bytes apart. */
+#define heapSECOND_LEVEL_LOG2	( 4 )
+#define heapSECOND_LEVEL_COUNT	( 1 << heapSECOND_LEVEL_LOG2 )
+#define heapFIRST_LEVEL_SHIFT	( heapSECOND_LEVEL_LOG2 + 3 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFIRST_LEVEL_SHIFT )
+
+/* Integer log2 of a value of up to 32 bits, usable where a constant expression
+is required. */
+#define heapLOG2_2( x )		( ( ( x ) >= 2U ) ? 1 : 0 )
+#define heapLOG2_4( x )		( ( ( x ) >= 4U ) ? ( 2 + heapLOG2_2( ( x ) >> 2 ) ) : heapLOG2_2( x ) )
+#define heapLOG2_8( x )		( ( ( x ) >= 16U ) ? ( 4 + heapLOG2_4( ( x ) >> 4 ) ) : heapLOG2_4( x ) )
+#define heapLOG2_16( x )	( ( ( x ) >= 256U ) ? ( 8 + heapLOG2_8( ( x ) >> 8 ) ) : heapLOG2_8( x ) )
+#define heapLOG2( x )		( ( ( x ) >= 65536U ) ? ( 16 + heapLOG2_16( ( x ) >> 16 ) ) : heapLOG2_16( x ) )
+
+/* Only enough first level lists to hold a block the size of the whole heap are
+needed. */
+#define heapFIRST_LEVEL_COUNT	( heapLOG2( ( size_t ) configTOTAL_HEAP_SIZE ) - heapFIRST_LEVEL_SHIFT + 2 )
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The structure placed at the start of each block.  Only the first two members
+are used while the block is allocated, the free list links are stored in the
+space that is handed to the application. */
+typedef struct A_TLSF_BLOCK
+{
+	struct A_TLSF_BLOCK *pxPreviousPhysicalBlock;	/*<< The block immediately below this one in memory, or NULL for the first block. */
+	size_t xBlockSize;								/*<< The size of the block, including this structure. */
+	struct A_TLSF_BLOCK *pxNextFreeBlock;			/*<< The next block in the same free list. */
+	struct A_TLSF_BLOCK *pxPreviousFreeBlock;		/*<< The previous block in the same free list. */
+} TLSFBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Calculate the first and second level indexes of the list a free block of
+ * xBlockSize bytes is stored in.
+ */
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel );
+
+/*
+ * Find a free block of at least xWantedSize bytes and remove it from its free
+ * list.  Returns NULL if there is no such block.
+ */
+static TLSFBlock_t *prvTakeSuitableBlock( size_t xWantedSize );
+
+/*
+ * Add a free block to, or remove a free block from, the free list that
+ * matches its size.
+ */
+static void prvInsertFreeBlock( TLSFBlock_t *pxBlock );
+static void prvRemoveFreeBlock( TLSFBlock_t *pxBlock );
+
+/*
+ * Position of the most significant and least significant set bit of a non
+ * zero value.
+ */
+static UBaseType_t prvFindLastSet( uint32_t ulValue );
+static UBaseType_t prvFindFirstSet( uint32_t ulValue );
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*-----------------------------------------------------------*/
+
+/* The part of TLSFBlock_t that is placed at the beginning of each allocated
+memory block must by correctly byte aligned. */
+static const size_t xHeapStructSize	= ( sizeof( TLSFBlock_t * ) + sizeof( size_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* A free block must be large enough to hold the whole of TLSFBlock_t. */
+static const size_t xMinimumBlockSize = ( sizeof( TLSFBlock_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Bit N of ulFirstLevelBitmap is set when any list with first level index N
+is not empty.  Bit M of ulSecondLevelBitmap[ N ] is set when the list with
+first level index N and second level index M is not empty. */
+static uint32_t ulFirstLevelBitmap = 0U;
+static uint32_t ulSecondLevelBitmap[ heapFIRST_LEVEL_COUNT ];
+static TLSFBlock_t *pxFreeLists[ heapFIRST_LEVEL_COUNT ][ heapSECOND_LEVEL_COUNT ];
+
+/* Marks the end of the heap, so the last real block is never combined with
+the memory after it. */
+static TLSFBlock_t *pxEnd = NULL;
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of a TLSFBlock_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+TLSFBlock_t *pxBlock, *pxNewBlock, *pxNextBlock;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( pxEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Check the requested block size is not so large that the top bit is
+		set.  The top bit of the block size member of the TLSFBlock_t structure
+		is used to determine who owns the block - the application or the
+		kernel, so it must be free. */
+		if( ( xWantedSize > 0 ) && ( ( xWantedSize & xBlockAllocatedBit ) == 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+		{
+			/* The wanted size is increased so it can contain the block header
+			in addition to the requested amount of bytes, and so the block can
+			hold the free list links once it is freed. */
+			xWantedSize += xHeapStructSize;
+
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				/* Byte alignment required. */
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+				configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xWantedSize < xMinimumBlockSize )
+			{
+				xWantedSize = xMinimumBlockSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxBlock = prvTakeSuitableBlock( xWantedSize );
+
+			if( pxBlock != NULL )
+			{
+				/* If the block is larger than required it can be split into
+				two. */
+				if( ( pxBlock->xBlockSize - xWantedSize ) >= xMinimumBlockSize )
+				{
+					/* The void cast is used to prevent byte alignment warnings
+					from the compiler. */
+					pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+					configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+					pxNewBlock->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+					pxNewBlock->pxPreviousPhysicalBlock = pxBlock;
+					pxBlock->xBlockSize = xWantedSize;
+
+					pxNextBlock = ( void * ) ( ( ( uint8_t * ) pxNewBlock ) + pxNewBlock->xBlockSize );
+					pxNextBlock->pxPreviousPhysicalBlock = pxNewBlock;
+
+					prvInsertFreeBlock( pxNewBlock );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block is being returned - it is allocated and owned by
+				the application. */
+				pxBlock->xBlockSize |= xBlockAllocatedBit;
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+TLSFBlock_t *pxLink, *pxNeighbour;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a block header immediately before
+		it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+		if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+		{
+			vTaskSuspendAll();
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+				xFreeBytesRemaining += pxLink->xBlockSize;
+				traceFREE( pv, pxLink->xBlockSize );
+
+				/* Combine with the block above if it is free.  The end marker
+				is always marked as allocated. */
+				pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxLink ) + pxLink->xBlockSize );
+				if( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxLink->xBlockSize += pxNeighbour->xBlockSize;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Combine with the block below if it is free. */
+				pxNeighbour = pxLink->pxPreviousPhysicalBlock;
+				if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) )
+				{
+					prvRemoveFreeBlock( pxNeighbour );
+					pxNeighbour->xBlockSize += pxLink->xBlockSize;
+					pxLink = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block above now follows the combined block. */
+				pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxLink ) + pxLink->xBlockSize );
+				pxNeighbour->pxPreviousPhysicalBlock = pxLink;
+
+				prvInsertFreeBlock( pxLink );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel )
+{
+UBaseType_t uxMostSignificantBit;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are spread linearly across the lists of the first
+		first level index. */
+		*puxFirstLevel = ( UBaseType_t ) 0;
+		*puxSecondLevel = ( UBaseType_t ) ( xBlockSize / ( heapSMALL_BLOCK_SIZE / heapSECOND_LEVEL_COUNT ) );
+	}
+	else
+	{
+		/* The bits below the most significant bit select the second level
+		list. */
+		uxMostSignificantBit = prvFindLastSet( ( uint32_t ) xBlockSize );
+		*puxSecondLevel = ( UBaseType_t ) ( ( xBlockSize >> ( uxMostSignificantBit - heapSECOND_LEVEL_LOG2 ) ) ^ ( size_t ) heapSECOND_LEVEL_COUNT );
+		*puxFirstLevel = uxMostSignificantBit - ( UBaseType_t ) ( heapFIRST_LEVEL_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TLSFBlock_t *prvTakeSuitableBlock( size_t xWantedSize )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+uint32_t ulBitmap;
+TLSFBlock_t *pxBlock;
+
+	/* The first block in the list that the size itself maps to is often large
+	enough.  Using it avoids splitting a larger block unnecessarily, which
+	noticeably reduces fragmentation. */
+	prvMappingInsert( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( uxFirstLevel < ( UBaseType_t ) heapFIRST_LEVEL_COUNT )
+	{
+		pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+		if( ( pxBlock != NULL ) && ( pxBlock->xBlockSize >= xWantedSize ) )
+		{
+			prvRemoveFreeBlock( pxBlock );
+			return pxBlock;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Otherwise round the size up to the start of the next second level range,
+	so every block in the list that is found is large enough. */
+	if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xWantedSize += ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xWantedSize ) - heapSECOND_LEVEL_LOG2 ) ) - ( size_t ) 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMappingInsert( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( uxFirstLevel >= ( UBaseType_t ) heapFIRST_LEVEL_COUNT )
+	{
+		/* Larger than any block the heap could hold. */
+		return NULL;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Look for a non empty list in the same first level range first, then in
+	the smallest larger first level range. */
+	ulBitmap = ulSecondLevelBitmap[ uxFirstLevel ] & ( ~( uint32_t ) 0U << uxSecondLevel );
+
+	if( ulBitmap == 0U )
+	{
+		ulBitmap = ulFirstLevelBitmap & ( ~( uint32_t ) 0U << ( uxFirstLevel + ( UBaseType_t ) 1 ) );
+
+		if( ulBitmap == 0U )
+		{
+			return NULL;
+		}
+		else
+		{
+			uxFirstLevel = prvFindFirstSet( ulBitmap );
+			ulBitmap = ulSecondLevelBitmap[ uxFirstLevel ];
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	uxSecondLevel = prvFindFirstSet( ulBitmap );
+	pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+	configASSERT( pxBlock );
+
+	prvRemoveFreeBlock( pxBlock );
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMappingInsert( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+	configASSERT( uxFirstLevel < ( UBaseType_t ) heapFIRST_LEVEL_COUNT );
+
+	/* Insert at the head of the list. */
+	pxBlock->pxPreviousFreeBlock = NULL;
+	pxBlock->pxNextFreeBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+	ulFirstLevelBitmap |= ( uint32_t ) 1U << uxFirstLevel;
+	ulSecondLevelBitmap[ uxFirstLevel ] |= ( uint32_t ) 1U << uxSecondLevel;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TLSFBlock_t *pxBlock )
+{
+UBaseType_t uxFirstLevel, uxSecondLevel;
+
+	prvMappingInsert( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPreviousFreeBlock != NULL )
+	{
+		pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was at the head of its list. */
+		configASSERT( pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] == pxBlock );
+		pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+		if( pxBlock->pxNextFreeBlock == NULL )
+		{
+			/* The list is now empty. */
+			ulSecondLevelBitmap[ uxFirstLevel ] &= ~( ( uint32_t ) 1U << uxSecondLevel );
+
+			if( ulSecondLevelBitmap[ uxFirstLevel ] == 0U )
+			{
+				ulFirstLevelBitmap &= ~( ( uint32_t ) 1U << uxFirstLevel );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulValue )
+{
+UBaseType_t uxBit;
+
+	configASSERT( ulValue != 0U );
+
+	#if defined( __GNUC__ )
+	{
+		uxBit = ( UBaseType_t ) ( 31 - __builtin_clz( ulValue ) );
+	}
+	#elif defined( _MSC_VER )
+	{
+	unsigned long ulIndex;
+
+		( void ) _BitScanReverse( &ulIndex, ( unsigned long ) ulValue );
+		uxBit = ( UBaseType_t ) ulIndex;
+	}
+	#else
+	{
+	UBaseType_t uxShift;
+
+		/* Binary search, so still a fixed number of steps. */
+		uxBit = ( UBaseType_t ) 0;
+
+		for( uxShift = ( UBaseType_t ) 16; uxShift > ( UBaseType_t ) 0; uxShift >>= 1 )
+		{
+			if( ( ulValue >> uxShift ) != 0U )
+			{
+				ulValue >>= uxShift;
+				uxBit += uxShift;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	#endif
+
+	return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindFirstSet( uint32_t ulValue )
+{
+	/* Isolate the least significant set bit. */
+	return prvFindLastSet( ulValue & ( ~ulValue + 1U ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+TLSFBlock_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* pxEnd is used to mark the end of the heap.  Only its header is used, and
+	it is permanently marked as allocated so it is never combined with the
+	block below it. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+	pxFirstFreeBlock->pxPreviousPhysicalBlock = NULL;
+
+	pxEnd->xBlockSize = xBlockAllocatedBit;
+	pxEnd->pxPreviousPhysicalBlock = pxFirstFreeBlock;
+
+	prvInsertFreeBlock( pxFirstFreeBlock );
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+
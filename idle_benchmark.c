@@ -0,0 +1,218 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A benchmark of the host CPU time used by the simulator while every task is
+ * blocked - as when the OBC waits for a command to be typed.  One task waits
+ * for a queue that is never written, as the OBC waits for console input, and
+ * one wakes once a second, then the host CPU time and the number of host
+ * context switches (the number of times a host thread slept and was woken) of
+ * the whole process are measured over ibIDLE_SECONDS seconds, or the number of
+ * seconds given on the command line.
+ *
+ * The benchmark is built in place of main.c, with and without tickless idle,
+ * and with each task running in its own host thread or in a fiber:
+ *
+ *   gcc -O2 -I. idle_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o idle_benchmark -lpthread
+ *   gcc -O2 -I. -DconfigUSE_TICKLESS_IDLE=0 idle_benchmark.c ... -o idle_benchmark -lpthread
+ *   gcc -O2 -I. -DconfigUSE_FIBERS=1 idle_benchmark.c ... -o idle_benchmark -lpthread
+ *   ./idle_benchmark 10
+ *
+ * The tick count is printed too, to show that the suppressed ticks are still
+ * counted.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#if( configUSE_VIRTUAL_TIME == 1 )
+	#error The benchmark measures real time, so must be built with configUSE_VIRTUAL_TIME set to 0.
+#endif
+
+#define ibIDLE_SECONDS			( 10 )
+#define ibWAKE_PERIOD			pdMS_TO_TICKS( 1000 )
+
+#define ibTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define ibBENCHMARK_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Measures the process while the other tasks are blocked, prints the results
+ * and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Waits for xConsoleQueue, which nothing writes to.
+ */
+static void prvConsoleTask( void *pvParameters );
+
+/*
+ * Wakes every ibWAKE_PERIOD ticks.
+ */
+static void prvPeriodicTask( void *pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static QueueHandle_t xConsoleQueue = NULL;
+static int iIdleSeconds = ibIDLE_SECONDS;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+	if( argc > 1 )
+	{
+		iIdleSeconds = atoi( argv[ 1 ] );
+	}
+
+	xConsoleQueue = xQueueCreate( 1, sizeof( char ) );
+
+	xTaskCreate( prvConsoleTask, "CONSOLE", configMINIMAL_STACK_SIZE, NULL, ibTASK_PRIORITY, NULL );
+	xTaskCreate( prvPeriodicTask, "PERIODIC", configMINIMAL_STACK_SIZE, NULL, ibTASK_PRIORITY, NULL );
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, ibBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+struct rusage xStart, xEnd;
+TickType_t xStartTick, xEndTick;
+long lCpuMilliseconds, lContextSwitches;
+
+	( void ) pvParameters;
+
+	/* Let the other tasks block first. */
+	vTaskDelay( 1 );
+
+	getrusage( RUSAGE_SELF, &xStart );
+	xStartTick = xTaskGetTickCount();
+
+	vTaskDelay( pdMS_TO_TICKS( ( TickType_t ) iIdleSeconds * ( TickType_t ) 1000 ) );
+
+	xEndTick = xTaskGetTickCount();
+	getrusage( RUSAGE_SELF, &xEnd );
+
+	/* User and system time, and voluntary and involuntary context switches,
+	of all the threads of the process. */
+	lCpuMilliseconds = ( ( xEnd.ru_utime.tv_sec - xStart.ru_utime.tv_sec ) + ( xEnd.ru_stime.tv_sec - xStart.ru_stime.tv_sec ) ) * 1000L;
+	lCpuMilliseconds += ( ( xEnd.ru_utime.tv_usec - xStart.ru_utime.tv_usec ) + ( xEnd.ru_stime.tv_usec - xStart.ru_stime.tv_usec ) ) / 1000L;
+	lContextSwitches = ( xEnd.ru_nvcsw - xStart.ru_nvcsw ) + ( xEnd.ru_nivcsw - xStart.ru_nivcsw );
+
+	printf( "Idle for %d s (%s, tickless idle %s): %ld ms host CPU time, %ld host context switches, %lu ticks\n",
+			iIdleSeconds,
+			( configUSE_FIBERS != 0 ) ? "fibers" : "threads",
+			( configUSE_TICKLESS_IDLE != 0 ) ? "on" : "off",
+			lCpuMilliseconds,
+			lContextSwitches,
+			( unsigned long ) ( xEndTick - xStartTick ) );
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsoleTask( void *pvParameters )
+{
+char cCharacter;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		xQueueReceive( xConsoleQueue, &cCharacter, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void *pvParameters )
+{
+TickType_t xLastWakeTime = xTaskGetTickCount();
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, ibWAKE_PERIOD );
+	}
+}
+/*-----------------------------------------------------------*/
@@ -72,6 +72,26 @@
 #include "FreeRTOS.h"
 #include "list.h"
 
+#if( configUSE_SKIP_LIST == 1 )
+
+	/* Each item inserted by vListInsert() is placed on the first n skip list
+	levels with probability 1 / ( 4 ^ n ), so each level
+	holds roughly a quarter of the items on the level below. */
+	#define listSKIP_LIST_FANOUT_BITS	( 2U )
+	#define listSKIP_LIST_FANOUT_MASK	( ( 1UL << listSKIP_LIST_FANOUT_BITS ) - 1UL )
+
+	/*
+	 * Returns the number of skip list levels to place a newly inserted item on.
+	 */
+	static UBaseType_t prvSkipListRandomLevels( void ) PRIVILEGED_FUNCTION;
+
+	/* State of the xorshift generator used by prvSkipListRandomLevels().  The
+	generator only needs to break up patterns in the inserted values, so it is
+	not protected against concurrent access. */
+	PRIVILEGED_DATA static uint32_t ulSkipListRandomState = 0x9E3779B9UL;
+
+#endif /* configUSE_SKIP_LIST */
+
 /*-----------------------------------------------------------
  * PUBLIC LIST API documented in list.h
  *----------------------------------------------------------*/
@@ -94,6 +114,17 @@ void vListInitialise( List_t * const pxList )
 
 	pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+	#if( configUSE_SKIP_LIST == 1 )
+	{
+	UBaseType_t uxLevel;
+
+		for( uxLevel = ( UBaseType_t ) 0U; uxLevel < ( UBaseType_t ) configSKIP_LIST_LEVELS; uxLevel++ )
+		{
+			pxList->pxSkipHead[ uxLevel ] = NULL;
+		}
+	}
+	#endif /* configUSE_SKIP_LIST */
+
 	/* Write known values into the list if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -106,6 +137,12 @@ void vListInitialiseItem( ListItem_t * const pxItem )
 	/* Make sure the list item is not recorded as being on a list. */
 	pxItem->pvContainer = NULL;
 
+	#if( configUSE_SKIP_LIST == 1 )
+	{
+		pxItem->uxSkipLevels = ( UBaseType_t ) 0U;
+	}
+	#endif /* configUSE_SKIP_LIST */
+
 	/* Write known values into the list item if
 	configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 	listSET_FIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE( pxItem );
@@ -135,6 +172,41 @@ ListItem_t * const pxIndex = pxList->pxIndex;
 	pxIndex->pxPrevious->pxNext = pxNewListItem;
 	pxIndex->pxPrevious = pxNewListItem;
 
+	#if( configUSE_SKIP_LIST == 1 )
+	{
+		/* Unsorted items are not indexed. */
+		pxNewListItem->uxSkipLevels = ( UBaseType_t ) 0U;
+	}
+	#endif /* configUSE_SKIP_LIST */
+
+	/* Remember which list the item is in. */
+	pxNewListItem->pvContainer = ( void * ) pxList;
+
+	( pxList->uxNumberOfItems )++;
+}
+/*-----------------------------------------------------------*/
+
+void vListInsertBefore( List_t * const pxList, ListItem_t * const pxPosition, ListItem_t * const pxNewListItem )
+{
+	listTEST_LIST_INTEGRITY( pxList );
+	listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
+
+	pxNewListItem->pxNext = pxPosition;
+	pxNewListItem->pxPrevious = pxPosition->pxPrevious;
+
+	/* Only used during decision coverage testing. */
+	mtCOVERAGE_TEST_DELAY();
+
+	pxPosition->pxPrevious->pxNext = pxNewListItem;
+	pxPosition->pxPrevious = pxNewListItem;
+
+	#if( configUSE_SKIP_LIST == 1 )
+	{
+		/* Items placed by the caller are not indexed. */
+		pxNewListItem->uxSkipLevels = ( UBaseType_t ) 0U;
+	}
+	#endif /* configUSE_SKIP_LIST */
+
 	/* Remember which list the item is in. */
 	pxNewListItem->pvContainer = ( void * ) pxList;
 
@@ -146,6 +218,11 @@ void vListInsert( List_t * const pxList, ListItem_t * const pxNewListItem )
 {
 ListItem_t *pxIterator;
 const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+#if( configUSE_SKIP_LIST == 1 )
+	ListItem_t *pxSkipPredecessor[ configSKIP_LIST_LEVELS ];
+	ListItem_t *pxSkipPosition = NULL, *pxSkipNext;
+	UBaseType_t uxLevel, uxLevels;
+#endif
 
 	/* Only effective when configASSERT() is also defined, these tests may catch
 	the list data structures being overwritten in memory.  They will not catch
@@ -161,6 +238,37 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 	share of the CPU.  However, if the xItemValue is the same as the back marker
 	the iteration loop below will not end.  Therefore the value is checked
 	first, and the algorithm slightly modified if necessary. */
+	#if( configUSE_SKIP_LIST == 1 )
+	{
+		/* Descend the skip list levels to find, on each level, the last item
+		with a value less than or equal to the value being inserted.  NULL
+		means the new item goes before every item on that level.  The level
+		below can then be searched starting from the item found. */
+		uxLevel = ( UBaseType_t ) configSKIP_LIST_LEVELS;
+		while( uxLevel > ( UBaseType_t ) 0U )
+		{
+			uxLevel--;
+
+			if( pxSkipPosition == NULL )
+			{
+				pxSkipNext = pxList->pxSkipHead[ uxLevel ];
+			}
+			else
+			{
+				pxSkipNext = pxSkipPosition->pxSkipNext[ uxLevel ];
+			}
+
+			while( ( pxSkipNext != NULL ) && ( pxSkipNext->xItemValue <= xValueOfInsertion ) )
+			{
+				pxSkipPosition = pxSkipNext;
+				pxSkipNext = pxSkipNext->pxSkipNext[ uxLevel ];
+			}
+
+			pxSkipPredecessor[ uxLevel ] = pxSkipPosition;
+		}
+	}
+	#endif /* configUSE_SKIP_LIST */
+
 	if( xValueOfInsertion == portMAX_DELAY )
 	{
 		pxIterator = pxList->xListEnd.pxPrevious;
@@ -189,7 +297,26 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 			   before vTaskStartScheduler() has been called?).
 		**********************************************************************/
 
-		for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		#if( configUSE_SKIP_LIST == 1 )
+		{
+			/* Only the items between the position found on the lowest skip
+			list level and the next item on that level need to be walked. */
+			if( pxSkipPosition == NULL )
+			{
+				pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+			}
+			else
+			{
+				pxIterator = pxSkipPosition;
+			}
+		}
+		#else
+		{
+			pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		}
+		#endif /* configUSE_SKIP_LIST */
+
+		for( ; pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext )
 		{
 			/* There is nothing to do here, just iterating to the wanted
 			insertion position. */
@@ -201,6 +328,40 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 	pxNewListItem->pxPrevious = pxIterator;
 	pxIterator->pxNext = pxNewListItem;
 
+	#if( configUSE_SKIP_LIST == 1 )
+	{
+		/* Link the new item onto a random number of skip list levels, after
+		the predecessor found on each level so equal values stay in insertion
+		order. */
+		uxLevels = prvSkipListRandomLevels();
+		pxNewListItem->uxSkipLevels = uxLevels;
+
+		for( uxLevel = ( UBaseType_t ) 0U; uxLevel < uxLevels; uxLevel++ )
+		{
+			pxSkipPosition = pxSkipPredecessor[ uxLevel ];
+			pxNewListItem->pxSkipPrevious[ uxLevel ] = pxSkipPosition;
+
+			if( pxSkipPosition == NULL )
+			{
+				pxSkipNext = pxList->pxSkipHead[ uxLevel ];
+				pxList->pxSkipHead[ uxLevel ] = pxNewListItem;
+			}
+			else
+			{
+				pxSkipNext = pxSkipPosition->pxSkipNext[ uxLevel ];
+				pxSkipPosition->pxSkipNext[ uxLevel ] = pxNewListItem;
+			}
+
+			pxNewListItem->pxSkipNext[ uxLevel ] = pxSkipNext;
+
+			if( pxSkipNext != NULL )
+			{
+				pxSkipNext->pxSkipPrevious[ uxLevel ] = pxNewListItem;
+			}
+		}
+	}
+	#endif /* configUSE_SKIP_LIST */
+
 	/* Remember which list the item is in.  This allows fast removal of the
 	item later. */
 	pxNewListItem->pvContainer = ( void * ) pxList;
@@ -218,6 +379,37 @@ List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 	pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
 	pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
 
+	#if( configUSE_SKIP_LIST == 1 )
+	{
+	UBaseType_t uxLevel;
+	ListItem_t *pxSkipPrevious, *pxSkipNext;
+
+		/* The item is unlinked from each skip list level it is on without a
+		search, so removal remains constant time. */
+		for( uxLevel = ( UBaseType_t ) 0U; uxLevel < pxItemToRemove->uxSkipLevels; uxLevel++ )
+		{
+			pxSkipPrevious = pxItemToRemove->pxSkipPrevious[ uxLevel ];
+			pxSkipNext = pxItemToRemove->pxSkipNext[ uxLevel ];
+
+			if( pxSkipPrevious == NULL )
+			{
+				pxList->pxSkipHead[ uxLevel ] = pxSkipNext;
+			}
+			else
+			{
+				pxSkipPrevious->pxSkipNext[ uxLevel ] = pxSkipNext;
+			}
+
+			if( pxSkipNext != NULL )
+			{
+				pxSkipNext->pxSkipPrevious[ uxLevel ] = pxSkipPrevious;
+			}
+		}
+
+		pxItemToRemove->uxSkipLevels = ( UBaseType_t ) 0U;
+	}
+	#endif /* configUSE_SKIP_LIST */
+
 	/* Only used during decision coverage testing. */
 	mtCOVERAGE_TEST_DELAY();
 
@@ -238,3 +430,29 @@ List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_SKIP_LIST == 1 )
+
+	static UBaseType_t prvSkipListRandomLevels( void )
+	{
+	uint32_t ulRandom = ulSkipListRandomState;
+	UBaseType_t uxLevels = ( UBaseType_t ) 0U;
+
+		/* xorshift32. */
+		ulRandom ^= ulRandom << 13;
+		ulRandom ^= ulRandom >> 17;
+		ulRandom ^= ulRandom << 5;
+		ulSkipListRandomState = ulRandom;
+
+		/* Count the low order groups of listSKIP_LIST_FANOUT_BITS zero bits. */
+		while( ( uxLevels < ( UBaseType_t ) configSKIP_LIST_LEVELS ) && ( ( ulRandom & listSKIP_LIST_FANOUT_MASK ) == 0UL ) )
+		{
+			uxLevels++;
+			ulRandom >>= listSKIP_LIST_FANOUT_BITS;
+		}
+
+		return uxLevels;
+	}
+
+#endif /* configUSE_SKIP_LIST */
+/*-----------------------------------------------------------*/
+
@@ -186,6 +186,11 @@ struct xLIST_ITEM
 	struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;	/*< Pointer to the previous ListItem_t in the list. */
 	void * pvOwner;										/*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
 	void * configLIST_VOLATILE pvContainer;				/*< Pointer to the list in which this list item is placed (if any). */
+	#if( configUSE_SKIP_LIST == 1 )
+		struct xLIST_ITEM * configLIST_VOLATILE pxSkipNext[ configSKIP_LIST_LEVELS ];		/*< Pointer to the next item on each skip list level the item is on, or NULL at the end of a level. */
+		struct xLIST_ITEM * configLIST_VOLATILE pxSkipPrevious[ configSKIP_LIST_LEVELS ];	/*< Pointer to the previous item on each skip list level the item is on, or NULL at the start of a level. */
+		UBaseType_t uxSkipLevels;						/*< The number of skip list levels the item is on.  Zero if the item was inserted by vListInsertEnd(). */
+	#endif
 	listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE			/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 };
 typedef struct xLIST_ITEM ListItem_t;					/* For some reason lint wants this as two separate definitions. */
@@ -208,6 +213,9 @@ typedef struct xLIST
 	configLIST_VOLATILE UBaseType_t uxNumberOfItems;
 	ListItem_t * configLIST_VOLATILE pxIndex;			/*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
 	MiniListItem_t xListEnd;							/*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+	#if( configUSE_SKIP_LIST == 1 )
+		ListItem_t * configLIST_VOLATILE pxSkipHead[ configSKIP_LIST_LEVELS ];	/*< The first item on each skip list level, or NULL if the level is empty.  Used by vListInsert() to skip over runs of lower valued items. */
+	#endif
 	listSECOND_LIST_INTEGRITY_CHECK_VALUE				/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
@@ -399,6 +407,9 @@ void vListInitialiseItem( ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
 /*
  * Insert a list item into a list.  The item will be inserted into the list in
  * a position determined by its item value (descending item value order).
+ * Items with equal values are kept in the order in which they were inserted.
+ * If configUSE_SKIP_LIST is set to 1 the insertion position is found in
+ * logarithmic rather than linear time.
  *
  * @param pxList The list into which the item is to be inserted.
  *
@@ -430,6 +441,25 @@ void vListInsert( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIV
  */
 void vListInsertEnd( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
 
+/*
+ * Insert a list item into a list immediately before another item, for lists
+ * that are kept in an order the caller determines.  Passing the list end
+ * marker (see listGET_END_MARKER) as pxPosition places the item at the end of
+ * the list.  The item value is not used, and the item is not indexed when
+ * configUSE_SKIP_LIST is set to 1.
+ *
+ * @param pxList The list into which the item is to be inserted.
+ *
+ * @param pxPosition The item, already in pxList, that the new item is to be
+ * placed before.
+ *
+ * @param pxNewListItem The list item to be inserted into the list.
+ *
+ * \page vListInsertBefore vListInsertBefore
+ * \ingroup LinkedList
+ */
+void vListInsertBefore( List_t * const pxList, ListItem_t * const pxPosition, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
 /*
  * Remove an item from a list.  The list item has a pointer to the list that
  * it is in, so only the list item need be passed into the function.
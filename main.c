@@ -1,13 +1,35 @@
 // HEADER FILES
 #include <stdio.h>
-#include <conio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#ifdef _WIN32
+#include <conio.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#define _strdup strdup
+#endif
+
 #include "FreeRTOS.h"
 #include "FreeRTOSConfig.h"
 #include "task.h"
 #include "timers.h"
 #include "queue.h"
+#include "croutine.h"
+#include "cpu_profiler.h"
+#include "trace_recorder.h"
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#elif defined(_WIN32)
+// COMPILERS WITHOUT C11 ATOMICS, SUCH AS OLDER VERSIONS OF MSVC. WINDOWS.H IS INCLUDED BY PORTMACRO.H
+typedef volatile LONG atomic_int;
+#define atomic_load(object) InterlockedCompareExchange((object), 0, 0)
+#define atomic_store(object, value) ((void)InterlockedExchange((object), (value)))
+#else
+#error main.c requires C11 atomics
+#endif
 
 // DEFINITIONS
 #define MAX_PARAMETERS 6
@@ -21,15 +43,69 @@
 #define IMAGE_CAPTURE_TIME  pdMS_TO_TICKS( 1000 )
 #define IMAGE_READ_OUT_TIME pdMS_TO_TICKS( 1000 )
 
+// COMMAND IDS SENT TO THE CAMERA BY ITS OWN TIMERS, OUTSIDE THE RANGE OF THE I2C COMMAND IDS
+#define CAMERA_CAPTURE_COMPLETED  256
+#define CAMERA_READ_OUT_COMPLETED 257
+
+// SUBSYSTEMS THAT SEND REQUESTS TO THE CAMERA (THE SAME VALUES AS THE COLOR OF THEIR OUTPUT).
+// A REQUEST CARRIES ITS REQUESTER IN PARAMETER 0, AND THE RESPONSE IS RETURNED TO THAT TASK ONLY
+#define OBC_REQUESTER  0
+#define PDPU_REQUESTER 1
+#define NUMBER_OF_REQUESTERS 2
+
+// NOTIFICATION INDEX AT WHICH THE CAMERA RETURNS ITS RESPONSES (SEE configTASK_NOTIFICATION_ARRAY_ENTRIES)
+#define I2C_RESPONSE_NOTIFICATION 1
+
+#if ( configTASK_NOTIFICATION_ARRAY_ENTRIES <= I2C_RESPONSE_NOTIFICATION )
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be large enough to hold I2C_RESPONSE_NOTIFICATION
+#endif
+
 #define MONITOR_IMAGE_CAPTURE_PERIOD pdMS_TO_TICKS ( 500 )
 #define MAX_WAIT_TIME_FOR_IMAGE_CAPTURE_COMPLETION pdMS_TO_TICKS( 2000 )
 
+// CPU PROFILER SAMPLE PERIOD (ONLY USED WHEN RUN TIME STATS ARE GENERATED)
+#define CPU_PROFILER_PERIOD pdMS_TO_TICKS( 1000 )
+
+// HOUSEKEEPING SENSORS, SAMPLED BY CO-ROUTINES OF THE IDLE TASK (ONLY USED WHEN CO-ROUTINES ARE ENABLED)
+#define NUMBER_OF_SENSORS 128
+#define SENSOR_PERIOD pdMS_TO_TICKS( 1000 )
+#define SENSOR_GROUPS 10
+#define SENSOR_QUEUE_LENGTH 8
+#define SENSOR_TYPES 3
+
+// SIMULATED INTERRUPT USED BY THE CONSOLE (0 AND 1 ARE USED BY THE KERNEL)
+#define CONSOLE_INTERRUPT_NUMBER 3
+#define CONSOLE_LINE_LENGTH 64
+
+// LENGTH OF THE QUEUES BETWEEN THE SUBSYSTEMS, AND OF THE CONSOLE QUEUE
+#define I2C_QUEUE_LENGTH 5
+#define CONSOLE_QUEUE_LENGTH 5
+
+// EVERY TASK, QUEUE, TIMER AND CO-ROUTINE OF THE APPLICATION IS STATICALLY ALLOCATED, SO NONE OF THEM USES THE HEAP
+#if( configSUPPORT_STATIC_ALLOCATION != 1 )
+	#error configSUPPORT_STATIC_ALLOCATION must be set to 1, as the application creates all of its objects statically
+#endif
+
 // Struct for I2C transfers of HyperSpectral Camera
 typedef struct I2C_Payload {
 	int Command_ID;
 	int Parameter[MAX_PARAMETERS];
 } I2C_Payload;
 
+// Reading passed from a housekeeping sensor to the collector
+typedef struct SensorReading {
+	uint16_t Sensor;
+	int16_t Value;
+} SensorReading;
+
+// Readings of one housekeeping sensor, as seen by the collector
+typedef struct SensorStats {
+	int16_t Latest;
+	int16_t Min;
+	int16_t Max;
+	uint32_t Samples;
+} SensorStats;
+
 // TASK FUNCTIONS
 void OBC(void);
 void HyperSpectralCamera(void);
@@ -97,34 +173,164 @@ int  IMAGING_PARAMETER();
 int  CURRENT_SESSION_ID();
 int  CURRENT_SESSION_SIZE();
 
+// RETURNS A RESPONSE OF THE CAMERA TO THE TASK THAT REQUESTED IT, AND WAITS FOR IT
+void sendCameraResponse(const I2C_Payload* response, int requester);
+int  receiveCameraResponse(I2C_Payload* response, int requester);
+
 // HELPER FOR REQUEST
 void printSubSystemStates(const int states[], int color);
 void printSessionInforamtion(const int states[], int color);
 
+// SIMULATED CONSOLE
+void startConsole(void);
+static uint32_t consoleInterruptHandler(void);
+
+// CPU USAGE OF EACH TASK, AS MEASURED BY THE PROFILER TASK
+void printCpuUsage(void);
+
+// RELEASE TIMING OF EACH PERIODIC TASK, AS MEASURED BY THE PERIOD MONITOR
+void printPeriodStats(void);
+
+// ENDS A SIMULATED IMAGE CAPTURE OR READ OUT OF THE CAMERA
+void cameraTimerCallback(TimerHandle_t timer);
+
+// HOUSEKEEPING SENSOR CO-ROUTINES, AND THE READINGS THEY COLLECTED
+void housekeepingSensor(CoRoutineHandle_t handle, UBaseType_t index);
+void housekeepingCollector(CoRoutineHandle_t handle, UBaseType_t index);
+void printSensorStats(void);
+
+// MEMORY OF THE STATICALLY ALLOCATED OBJECTS, AND HEAP IN USE
+void printMemoryUsage(void);
+
 
 // TASK HANDLERS
 TaskHandle_t HYPERSPECTRAL_CAMERA_TASK = NULL;
+TaskHandle_t LASER_TASK = NULL;
+TaskHandle_t CAMERA_REQUESTERS[NUMBER_OF_REQUESTERS] = { NULL, NULL };
+
+// LAST RESPONSE OF THE CAMERA TO EACH REQUESTER, READ WHEN ITS RESPONSE NOTIFICATION ARRIVES
+I2C_Payload CAMERA_RESPONSES[NUMBER_OF_REQUESTERS];
 
 // QUEUE HANDLES
-xQueueHandle I2C_OBC    = 0;
 xQueueHandle I2C_CAMERA = 0;
 xQueueHandle I2C_PDPU   = 0;
 xQueueHandle I2C_LASER  = 0;
+xQueueHandle CONSOLE_RX = 0;
+xQueueHandle SENSOR_QUEUE = 0;
+
+// TIMER HANDLES
+TimerHandle_t CAMERA_CAPTURE_TIMER  = NULL;
+TimerHandle_t CAMERA_READ_OUT_TIMER = NULL;
+
+// MEMORY OF THE TASKS, QUEUES, TIMERS AND CO-ROUTINES, SIZED AT COMPILE TIME SO THE STARTUP NEITHER ALLOCATES NOR CAN FAIL
+static struct {
+	StaticTask_t OBC, CAMERA, PDPU, LASER;
+} TASK_TCBS;
+
+static struct {
+	StackType_t OBC[configMINIMAL_STACK_SIZE];
+	StackType_t CAMERA[configMINIMAL_STACK_SIZE];
+	StackType_t PDPU[configMINIMAL_STACK_SIZE];
+	StackType_t LASER[configMINIMAL_STACK_SIZE];
+} TASK_STACKS;
+
+static struct {
+	StaticQueue_t I2C_CAMERA, I2C_PDPU, I2C_LASER, CONSOLE_RX;
+#if( configUSE_CO_ROUTINES == 1 )
+	StaticQueue_t SENSOR_QUEUE;
+#endif
+} QUEUE_BUFFERS;
+
+static struct {
+	uint8_t I2C_CAMERA[I2C_QUEUE_LENGTH * sizeof(I2C_Payload)];
+	uint8_t I2C_PDPU[I2C_QUEUE_LENGTH * sizeof(I2C_Payload)];
+	uint8_t I2C_LASER[I2C_QUEUE_LENGTH * sizeof(I2C_Payload)];
+	uint8_t CONSOLE_RX[CONSOLE_QUEUE_LENGTH * CONSOLE_LINE_LENGTH];
+#if( configUSE_CO_ROUTINES == 1 )
+	uint8_t SENSOR_QUEUE[SENSOR_QUEUE_LENGTH * sizeof(SensorReading)];
+#endif
+} QUEUE_STORAGE;
+
+static struct {
+	StaticTimer_t CAMERA_CAPTURE, CAMERA_READ_OUT;
+} TIMER_BUFFERS;
+
+#if( configUSE_CO_ROUTINES == 1 )
+// ONE CONTROL BLOCK PER SENSOR, AND ONE FOR THE COLLECTOR
+static CRCB_t SENSOR_COROUTINES[NUMBER_OF_SENSORS + 1];
+#endif
+
+// LINE READ BY THE CONSOLE THREAD, WAITING TO BE PASSED TO THE OBC
+static char console_line[CONSOLE_LINE_LENGTH];
+static atomic_int console_line_pending = 0;
 
 // MAIN FUNCTION
-int main(void) {
+int main(int argc, char* argv[]) {
+
+	int arg;
+
+	(void)argv;
+
+	for (arg = 1; arg + 1 < argc; arg += 2) {
+#if( configUSE_JOURNAL == 1 )
+		// --record FILE SAVES THE TIMING OF THE RUN AND ITS CONSOLE INPUT, --replay FILE RUNS IT AGAIN EXACTLY
+		if (strcmp(argv[arg], "--record") == 0 || strcmp(argv[arg], "--replay") == 0) {
+			if (xPortJournalOpen(argv[arg + 1], strcmp(argv[arg], "--replay") == 0) != pdPASS) {
+				printf("Cannot open journal %s\n", argv[arg + 1]);
+				return 1;
+			}
+		}
+#endif
+#if( configUSE_TRACE_RECORDER == 1 )
+		// --trace FILE RECORDS THE SCHEDULING OF THE RUN, SEE trace_to_json.c
+		if (strcmp(argv[arg], "--trace") == 0) {
+			if (xTraceRecorderStart(argv[arg + 1], pdMS_TO_TICKS(100), tskIDLE_PRIORITY+1) != pdPASS) {
+				printf("Cannot open trace %s\n", argv[arg + 1]);
+				return 1;
+			}
+		}
+#endif
+	}
+
+	// CREATE THE QUEUES
+	I2C_CAMERA = xQueueCreateStatic(I2C_QUEUE_LENGTH, sizeof(I2C_Payload), QUEUE_STORAGE.I2C_CAMERA, &QUEUE_BUFFERS.I2C_CAMERA);
+	I2C_PDPU   = xQueueCreateStatic(I2C_QUEUE_LENGTH, sizeof(I2C_Payload), QUEUE_STORAGE.I2C_PDPU,   &QUEUE_BUFFERS.I2C_PDPU);
+	I2C_LASER  = xQueueCreateStatic(I2C_QUEUE_LENGTH, sizeof(I2C_Payload), QUEUE_STORAGE.I2C_LASER,  &QUEUE_BUFFERS.I2C_LASER);
+	CONSOLE_RX = xQueueCreateStatic(CONSOLE_QUEUE_LENGTH, CONSOLE_LINE_LENGTH, QUEUE_STORAGE.CONSOLE_RX, &QUEUE_BUFFERS.CONSOLE_RX);
+
+	// NAME THE QUEUES FOR THE DEBUGGER AND THE TRACE
+	vQueueAddToRegistry(I2C_CAMERA, "I2C_CAMERA");
+	vQueueAddToRegistry(I2C_PDPU,   "I2C_PDPU");
+	vQueueAddToRegistry(I2C_LASER,  "I2C_LASER");
+	vQueueAddToRegistry(CONSOLE_RX, "CONSOLE_RX");
 
-	// CREATE THE QUEUE OF SIZE 1
-	I2C_OBC    = xQueueCreate(5, sizeof(I2C_Payload));
-	I2C_CAMERA = xQueueCreate(5, sizeof(I2C_Payload));
-	I2C_PDPU   = xQueueCreate(5, sizeof(I2C_Payload));
-	I2C_LASER  = xQueueCreate(5, sizeof(I2C_Payload));
+	// ONE SHOT TIMERS, WHOSE ID IS THE COMMAND THEY SEND TO THE CAMERA WHEN THEY EXPIRE
+	CAMERA_CAPTURE_TIMER  = xTimerCreateStatic("CAPTURE",  IMAGE_CAPTURE_TIME,  pdFALSE, (void*)(intptr_t)CAMERA_CAPTURE_COMPLETED,  cameraTimerCallback, &TIMER_BUFFERS.CAMERA_CAPTURE);
+	CAMERA_READ_OUT_TIMER = xTimerCreateStatic("READ OUT", IMAGE_READ_OUT_TIME, pdFALSE, (void*)(intptr_t)CAMERA_READ_OUT_COMPLETED, cameraTimerCallback, &TIMER_BUFFERS.CAMERA_READ_OUT);
+
+	vPortSetInterruptHandler(CONSOLE_INTERRUPT_NUMBER, consoleInterruptHandler);
+
+#if( configUSE_CO_ROUTINES == 1 )
+	// EACH SENSOR ONLY COSTS A CO-ROUTINE CONTROL BLOCK, AS THE CO-ROUTINES SHARE THE STACK OF THE IDLE TASK
+	SENSOR_QUEUE = xQueueCreateStatic(SENSOR_QUEUE_LENGTH, sizeof(SensorReading), QUEUE_STORAGE.SENSOR_QUEUE, &QUEUE_BUFFERS.SENSOR_QUEUE);
+
+	for (UBaseType_t sensor = 0; sensor < NUMBER_OF_SENSORS; ++sensor)
+		xCoRoutineCreateStatic(housekeepingSensor, 0, sensor, &SENSOR_COROUTINES[sensor]);
+
+	// THE COLLECTOR HAS THE HIGHER PRIORITY, SO THE QUEUE IS EMPTIED BEFORE THE NEXT SENSOR RUNS
+	xCoRoutineCreateStatic(housekeepingCollector, 1, 0, &SENSOR_COROUTINES[NUMBER_OF_SENSORS]);
+#endif
 
 	// TASK CREATION
-	xTaskCreate(OBC,                 "OBC",    configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+1, NULL); //tskIDLE_PRIORITY
-	xTaskCreate(HyperSpectralCamera, "CAMERA", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+3, NULL);
-	xTaskCreate(PDPU,                "PDPU",   configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+2, NULL);
-	xTaskCreate(Laser,               "LASER",  configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+3, NULL);
+	CAMERA_REQUESTERS[OBC_REQUESTER]  = xTaskCreateStatic(OBC,                 "OBC",    configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+1, TASK_STACKS.OBC,    &TASK_TCBS.OBC); //tskIDLE_PRIORITY
+	HYPERSPECTRAL_CAMERA_TASK         = xTaskCreateStatic(HyperSpectralCamera, "CAMERA", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+3, TASK_STACKS.CAMERA, &TASK_TCBS.CAMERA);
+	CAMERA_REQUESTERS[PDPU_REQUESTER] = xTaskCreateStatic(PDPU,                "PDPU",   configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+2, TASK_STACKS.PDPU,   &TASK_TCBS.PDPU);
+	LASER_TASK                        = xTaskCreateStatic(Laser,               "LASER",  configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY+3, TASK_STACKS.LASER,  &TASK_TCBS.LASER);
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	// THE PROFILER ONLY RUNS BRIEFLY EACH PERIOD, SO IT CAN HAVE THE HIGHEST PRIORITY AND SAMPLE ON TIME
+	xCpuProfilerStart(CPU_PROFILER_PERIOD, configMAX_PRIORITIES-1);
+#endif
 
 	vTaskStartScheduler();
 
@@ -132,6 +338,314 @@ int main(void) {
 	return 0;
 }
 
+/*
+*
+* SIMULATED CONSOLE
+*
+* STDIN IS READ BY A HOST THREAD, WHICH PASSES EACH LINE TO THE OBC THROUGH A
+* SIMULATED INTERRUPT - LIKE A UART RECEIVE INTERRUPT ON THE REAL HARDWARE. THE
+* OBC TASK IS THEREFORE BLOCKED WHILE WAITING FOR A COMMAND, RATHER THAN RUNNING
+* INSIDE FGETS, SO THE SIMULATOR CAN IDLE.
+*
+*/
+
+#ifdef _WIN32
+static DWORD WINAPI consoleThread(LPVOID parameter)
+#else
+static void* consoleThread(void* parameter)
+#endif
+{
+	(void)parameter;
+
+	for (;;) {
+		// END OF INPUT (E.G. A HEADLESS RUN FROM A SCRIPT) TURNS THE OBC OFF
+		if (fgets(console_line, sizeof(console_line), stdin) == NULL)
+			strcpy(console_line, "EXIT\n");
+
+		// THE LINE IS PUBLISHED TO THE INTERRUPT HANDLER BY THE STORE
+		atomic_store(&console_line_pending, 1);
+
+		// WAIT UNTIL THE INTERRUPT HANDLER HAS QUEUED THE LINE, RETRYING IF THE QUEUE WAS FULL
+		while (atomic_load(&console_line_pending)) {
+			vPortGenerateSimulatedInterrupt(CONSOLE_INTERRUPT_NUMBER);
+#ifdef _WIN32
+			Sleep(1);
+#else
+			usleep(1000);
+#endif
+		}
+	}
+
+	return 0;
+}
+
+void startConsole(void) {
+	// A REPLAYED RUN TAKES ITS CONSOLE LINES FROM THE JOURNAL
+	if (portJOURNAL_REPLAYING())
+		return;
+
+#ifdef _WIN32
+	CreateThread(NULL, 0, consoleThread, NULL, 0, NULL);
+#else
+	pthread_t console_thread;
+
+	pthread_create(&console_thread, NULL, consoleThread, NULL);
+	pthread_detach(console_thread);
+#endif
+}
+
+static uint32_t consoleInterruptHandler(void) {
+	BaseType_t higher_priority_task_woken = pdFALSE;
+	int pending = atomic_load(&console_line_pending);
+	char line[CONSOLE_LINE_LENGTH];
+
+	// THE CONSOLE THREAD IS NOT A TASK, SO WHAT IT PASSED IS RECORDED IN THE JOURNAL (OR TAKEN FROM IT WHEN REPLAYING)
+	if (pending)
+		memcpy(line, console_line, sizeof(line));
+
+	portJOURNAL_DATA(&pending, sizeof(pending));
+
+	if (pending) {
+		portJOURNAL_DATA(line, sizeof(line));
+
+		// ONLY CLEARED ONCE THE LINE HAS BEEN COPIED, AS THE CONSOLE THREAD THEN READS THE NEXT ONE INTO THE BUFFER
+		if (xQueueSendFromISR(CONSOLE_RX, line, &higher_priority_task_woken) == pdPASS)
+			atomic_store(&console_line_pending, 0);
+	}
+
+	return higher_priority_task_woken;
+}
+
+/*
+*
+* CPU USAGE
+*
+* THE PROFILER TASK ONLY PUBLISHES THE NUMBERS, SO THEY ARE FORMATTED HERE BY
+* THE OBC, OUTSIDE OF THE KERNEL AND THE PROFILER.
+*
+*/
+
+void printCpuUsage(void) {
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	static CpuProfilerSnapshot_t snapshot;
+	const char* states[] = { "running", "ready", "blocked", "suspended", "deleted" };
+
+	if (xCpuProfilerGetSnapshot(&snapshot) == pdFALSE) {
+		printf("No CPU usage sample yet, try again in a second.\n");
+		return;
+	}
+
+	setGreenTextColor();
+	printf("%-*s %-9s %8s %10s %12s %12s\n", configMAX_TASK_NAME_LEN, "TASK", "STATE", "CPU %", "SWITCHES", "RUN (us)", "BLOCKED (us)");
+
+	for (UBaseType_t i = 0; i < snapshot.uxNumberOfTasks; ++i) {
+		const CpuProfilerTaskStats_t* task = &snapshot.xTasks[i];
+
+		printf("%-*s %-9s %5u.%02u %10u %12llu %12llu\n", configMAX_TASK_NAME_LEN, task->pcTaskName,
+			states[task->eCurrentState],
+			(unsigned)(task->ulCpuPercentTimes100 / 100), (unsigned)(task->ulCpuPercentTimes100 % 100),
+			(unsigned)task->ulSwitchIns,
+			(unsigned long long)(task->ulRunTime / 1000), (unsigned long long)(task->ulBlockedTime / 1000));
+	}
+
+	resetTextColor();
+#else
+	printf("Build with configGENERATE_RUN_TIME_STATS set to 1 to measure CPU usage.\n");
+#endif
+}
+
+void printPeriodStats(void) {
+#if( configUSE_PERIOD_MONITOR == 1 )
+	static TaskStatus_t tasks[16];
+	TaskPeriodStats_t stats;
+	UBaseType_t numberOfTasks = uxTaskGetSystemState(tasks, sizeof(tasks) / sizeof(tasks[0]), NULL);
+
+	setGreenTextColor();
+	printf("%-*s %10s %10s %10s %18s %18s\n", configMAX_TASK_NAME_LEN, "TASK", "RELEASES", "OVERRUNS", "MISSES", "WORST START (us)", "WORST RESPONSE (us)");
+
+	for (UBaseType_t i = 0; i < numberOfTasks; ++i) {
+		vTaskGetPeriodStats(tasks[i].xHandle, &stats);
+
+		// Only the tasks that run periodically are released.
+		if (stats.ulReleases == 0)
+			continue;
+
+		printf("%-*s %10u %10u %10u %18llu %18llu\n", configMAX_TASK_NAME_LEN, tasks[i].pcTaskName,
+			(unsigned)stats.ulReleases, (unsigned)stats.ulOverruns, (unsigned)stats.ulDeadlineMisses,
+			(unsigned long long)(stats.ulWorstStartLatency / 1000), (unsigned long long)(stats.ulWorstResponseTime / 1000));
+
+		// The histogram buckets that counted a release, by their upper bound.
+		for (int bucket = 0; bucket < configPERIOD_MONITOR_BUCKETS; ++bucket) {
+			if (stats.ulStartLatencyHistogram[bucket] == 0 && stats.ulResponseTimeHistogram[bucket] == 0)
+				continue;
+
+			unsigned long long limit = (1ULL << (configPERIOD_MONITOR_RESOLUTION_BITS + bucket)) / 1000;
+
+			if (bucket == configPERIOD_MONITOR_BUCKETS - 1)
+				printf("%*s >= %6llu us %19s %18u %18u\n", configMAX_TASK_NAME_LEN, "", limit / 2, "",
+					(unsigned)stats.ulStartLatencyHistogram[bucket], (unsigned)stats.ulResponseTimeHistogram[bucket]);
+			else
+				printf("%*s  < %6llu us %19s %18u %18u\n", configMAX_TASK_NAME_LEN, "", limit, "",
+					(unsigned)stats.ulStartLatencyHistogram[bucket], (unsigned)stats.ulResponseTimeHistogram[bucket]);
+		}
+	}
+
+	resetTextColor();
+#else
+	printf("Build with configUSE_PERIOD_MONITOR set to 1 to monitor periodic tasks.\n");
+#endif
+}
+
+/*
+*
+* HOUSEKEEPING SENSORS
+*
+* THE TEMPERATURE, CURRENT AND STAR TRACKER SENSORS ARE SAMPLED BY ONE
+* CO-ROUTINE EACH, WHICH PASSES ITS READING TO THE COLLECTOR CO-ROUTINE THROUGH
+* A QUEUE. A CO-ROUTINE DOES NOT KEEP ITS LOCAL VARIABLES WHILE IT IS BLOCKED,
+* SO WHAT IT NEEDS ACROSS A BLOCKING CALL IS KEPT IN ARRAYS INDEXED BY SENSOR.
+*
+*/
+
+#if( configUSE_CO_ROUTINES == 1 )
+static SensorReading sensor_readings[NUMBER_OF_SENSORS];
+static SensorStats sensor_stats[NUMBER_OF_SENSORS];
+static uint32_t sensor_samples_dropped = 0;
+
+static int16_t sampleSensor(UBaseType_t index) {
+	// TEMPERATURE (0.1 C), CURRENT (mA) AND STAR TRACKER ATTITUDE ERROR (ARCSEC)
+	static const int16_t nominal[SENSOR_TYPES] = { 200, 450, 0 };
+
+	return (int16_t)(nominal[index % SENSOR_TYPES] + (int)((index * 37 + sensor_stats[index].Samples * 11) % 21) - 10);
+}
+
+void housekeepingSensor(CoRoutineHandle_t handle, UBaseType_t index) {
+	BaseType_t result;
+
+	crSTART(handle);
+
+	// SPREAD THE SENSORS ACROSS THE PERIOD IN A FEW GROUPS, SO THE QUEUE IS NOT FLOODED BY ALL OF THEM AT ONCE
+	// BUT THE IDLE TASK STILL HAS WHOLE TICKS BETWEEN THE GROUPS IN WHICH TO SLEEP
+	crDELAY(handle, (TickType_t)((index % SENSOR_GROUPS) * (SENSOR_PERIOD / SENSOR_GROUPS)));
+
+	for (;;) {
+		sensor_readings[index].Sensor = (uint16_t)index;
+		sensor_readings[index].Value = sampleSensor(index);
+
+		crQUEUE_SEND(handle, SENSOR_QUEUE, &sensor_readings[index], SENSOR_PERIOD, &result);
+
+		if (result != pdPASS)
+			++sensor_samples_dropped;
+
+		crDELAY(handle, SENSOR_PERIOD);
+	}
+
+	crEND();
+}
+
+void housekeepingCollector(CoRoutineHandle_t handle, UBaseType_t index) {
+	static SensorReading reading;
+	BaseType_t result;
+
+	(void)index;
+
+	crSTART(handle);
+
+	for (;;) {
+		crQUEUE_RECEIVE(handle, SENSOR_QUEUE, &reading, SENSOR_PERIOD, &result);
+
+		if (result == pdPASS) {
+			SensorStats* stats = &sensor_stats[reading.Sensor];
+
+			if (stats->Samples == 0 || reading.Value < stats->Min)
+				stats->Min = reading.Value;
+			if (stats->Samples == 0 || reading.Value > stats->Max)
+				stats->Max = reading.Value;
+
+			stats->Latest = reading.Value;
+			++stats->Samples;
+		}
+	}
+
+	crEND();
+}
+#endif
+
+void printSensorStats(void) {
+#if( configUSE_CO_ROUTINES == 1 )
+	const char* types[SENSOR_TYPES] = { "temp (0.1C)", "current (mA)", "star (arcsec)" };
+	int sensors, sampled, latest, min, max;
+	uint32_t samples;
+
+	setGreenTextColor();
+	printf("%-14s %8s %8s %8s %8s %10s\n", "SENSOR", "COUNT", "AVERAGE", "MIN", "MAX", "SAMPLES");
+
+	for (int type = 0; type < SENSOR_TYPES; ++type) {
+		sensors = sampled = latest = 0;
+		samples = 0;
+		min = INT16_MAX;
+		max = INT16_MIN;
+
+		for (int sensor = type; sensor < NUMBER_OF_SENSORS; sensor += SENSOR_TYPES) {
+			const SensorStats* stats = &sensor_stats[sensor];
+
+			++sensors;
+			samples += stats->Samples;
+
+			// SENSORS THAT HAVE NOT BEEN SAMPLED YET ARE ONLY COUNTED
+			if (stats->Samples == 0)
+				continue;
+
+			++sampled;
+			latest += stats->Latest;
+			if (stats->Min < min)
+				min = stats->Min;
+			if (stats->Max > max)
+				max = stats->Max;
+		}
+
+		if (sampled == 0)
+			printf("%-14s %8d %8s %8s %8s %10u\n", types[type], sensors, "-", "-", "-", (unsigned)samples);
+		else
+			printf("%-14s %8d %8d %8d %8d %10u\n", types[type], sensors, latest / sampled, min, max, (unsigned)samples);
+	}
+
+	printf("%u samples dropped because the collector was late.\n", (unsigned)sensor_samples_dropped);
+	resetTextColor();
+#else
+	printf("Build with configUSE_CO_ROUTINES set to 1 to sample the housekeeping sensors.\n");
+#endif
+}
+
+void printMemoryUsage(void) {
+	size_t total = sizeof(TASK_TCBS) + sizeof(TASK_STACKS) + sizeof(QUEUE_BUFFERS) + sizeof(QUEUE_STORAGE) + sizeof(TIMER_BUFFERS);
+
+	setGreenTextColor();
+	printf("%-14s %8s\n", "OBJECTS", "BYTES");
+	printf("%-14s %8u\n", "tasks", (unsigned)(sizeof(TASK_TCBS) + sizeof(TASK_STACKS)));
+	printf("%-14s %8u\n", "queues", (unsigned)(sizeof(QUEUE_BUFFERS) + sizeof(QUEUE_STORAGE)));
+	printf("%-14s %8u\n", "timers", (unsigned)sizeof(TIMER_BUFFERS));
+#if( configUSE_CO_ROUTINES == 1 )
+	printf("%-14s %8u\n", "co-routines", (unsigned)sizeof(SENSOR_COROUTINES));
+	total += sizeof(SENSOR_COROUTINES);
+#endif
+	printf("%-14s %8u\n", "total", (unsigned)total);
+
+	// THE APPLICATION ALLOCATES NOTHING, SO ANY HEAP IN USE WAS ALLOCATED BY A DIAGNOSTIC OF THE KERNEL.
+	// THE HEAP IS ONLY INITIALISED BY ITS FIRST ALLOCATION, UNTIL WHEN IT REPORTS NO FREE BYTES AT ALL
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	if (xPortGetMinimumEverFreeHeapSize() == 0)
+		printf("No heap has been used since boot.\n");
+	else
+		printf("%u of %u bytes of heap in use, at most %u since boot.\n",
+			(unsigned)(configTOTAL_HEAP_SIZE - xPortGetFreeHeapSize()), (unsigned)configTOTAL_HEAP_SIZE,
+			(unsigned)(configTOTAL_HEAP_SIZE - xPortGetMinimumEverFreeHeapSize()));
+#else
+	printf("No heap, as configSUPPORT_DYNAMIC_ALLOCATION is 0.\n");
+#endif
+	resetTextColor();
+}
+
 void print_I2C_payload(const I2C_Payload p) {
 	printf("Command ID : 0x%X\n", p.Command_ID);
 	for (int i = 0; i < MAX_PARAMETERS; ++i)
@@ -164,17 +678,36 @@ void OBC(void) {
 	printf("On Board Computer (OBC) STARTING...\n");
 	printf("Type help to see the available commands.\n");
 
+	// THE CONSOLE CAN ONLY GENERATE INTERRUPTS ONCE THE SCHEDULER IS RUNNING
+	startConsole();
+
 	for (;;) {
 		printf("Type a command for OBC to execute : ");
-		fgets(command_name, sizeof(command_name), stdin);
+		fflush(stdout);
+		xQueueReceive(CONSOLE_RX, command_name, portMAX_DELAY);
 
 
 		if (strcmp(command_name, "EXIT\n") == 0) {
 			setBlueTextColor();
 			printf("OBC TURING OFF...\n");
 			resetTextColor();
+#if( configUSE_TRACE_RECORDER == 1 )
+			vTraceRecorderStop();
+#endif
 			exit(0);
 		}
+		if (strcmp(command_name, "cpu\n") == 0) {
+			printCpuUsage();
+		}
+		if (strcmp(command_name, "period\n") == 0) {
+			printPeriodStats();
+		}
+		if (strcmp(command_name, "sensors\n") == 0) {
+			printSensorStats();
+		}
+		if (strcmp(command_name, "memory\n") == 0) {
+			printMemoryUsage();
+		}
 		if (strcmp(command_name, "help\n") == 0) {
 
 			setBlueTextColor();
@@ -184,6 +717,16 @@ void OBC(void) {
 			printf("\n\tEnter EXIT to close the OBC.");
 			printf("\n");
 
+			setBlueTextColor();
+			printf("\nDiagnostic commands:");
+
+			setGreenTextColor();
+			printf("\n\tEnter cpu to show the CPU usage of each task over the last second.");
+			printf("\n\tEnter period to show the release timing of each periodic task.");
+			printf("\n\tEnter sensors to show the readings of the housekeeping sensors.");
+			printf("\n\tEnter memory to show the memory of the tasks, queues, timers and co-routines, and the heap in use.");
+			printf("\n");
+
 			setBlueTextColor();
 			printf("\nRequired commands for image capturing:");
 
@@ -417,13 +960,15 @@ void cameraCaptureImage() {
 
 	SUBSYSTEM_STATES(states, 0);
 
+	// BLOCK BETWEEN POLLS, SO THE TICK COUNT CAN JUMP AHEAD WHEN VIRTUAL TIME IS USED
 	while (states[3] == 2) {
+		vTaskDelay(MONITOR_IMAGE_CAPTURE_PERIOD);
+		SUBSYSTEM_STATES(states, 0);
+
 		current_tick_time = xTaskGetTickCount();
 		time_passed = current_tick_time - starting_tick_time;
 
-		if (time_passed % MONITOR_IMAGE_CAPTURE_PERIOD == 0)
-			SUBSYSTEM_STATES(states, 0);
-		if (time_passed == MAX_WAIT_TIME_FOR_IMAGE_CAPTURE_COMPLETION)
+		if (time_passed >= MAX_WAIT_TIME_FOR_IMAGE_CAPTURE_COMPLETION)
 			break;
 	}
 
@@ -543,11 +1088,6 @@ void HyperSpectralCamera(void) {
 	int start_range = 0;
 	int stop_range  = MAX_NUMBER_OF_LINES;
 
-	// TIME INFORMATION FOR IMAGE CAPTURE SIMULATION
-	TickType_t starting_tick_time = xTaskGetTickCount();;
-	TickType_t current_tick_time; 
-	TickType_t time_passed;
-
 	for (;;) {
 		received_command = xQueueReceive(I2C_CAMERA, &rx_payload, portMAX_DELAY);
 		if (received_command) {
@@ -568,6 +1108,9 @@ void HyperSpectralCamera(void) {
 				capture_state  = 0; 
 				read_out_state = 0;
 
+				xTimerStop(CAMERA_CAPTURE_TIMER, portMAX_DELAY);
+				xTimerStop(CAMERA_READ_OUT_TIMER, portMAX_DELAY);
+
 				session_close_error[session_id] = 1;
 				storage_error[session_id]       = 0;	
 				total_bytes[session_id]		    = 0;	
@@ -589,13 +1132,16 @@ void HyperSpectralCamera(void) {
 				capture_state  = 0;
 				read_out_state = 0;
 
+				xTimerStop(CAMERA_CAPTURE_TIMER, portMAX_DELAY);
+				xTimerStop(CAMERA_READ_OUT_TIMER, portMAX_DELAY);
+
 				session_close_error[session_id] = 0;
 				printf("HyperSpectral Camera closing the session with ID: %d\n", session_id);
 			}
 			if (command_id == 3) {		// 0x03 READ OUT SESSION
 				read_out_state = 1;
 				read_out_session_id = rx_payload.Parameter[0];
-				starting_tick_time = xTaskGetTickCount();
+				xTimerReset(CAMERA_READ_OUT_TIMER, portMAX_DELAY);
 				printf("HyperSpectral Camera iniating image read out\n");
 			}
 			if (command_id == 4) {		// 0x04 DELETE SESSION
@@ -667,7 +1213,7 @@ void HyperSpectralCamera(void) {
 			}						// Active			   // Configured	    // Enabled
 			if (command_id == 39 && session_state == 2 && config_state == 1 && sensor_state == 1) {		// 0x27 CAPTURE IMAGE
 				capture_state = 2;
-				starting_tick_time = xTaskGetTickCount();
+				xTimerReset(CAMERA_CAPTURE_TIMER, portMAX_DELAY);
 				printf("HyperSpectral Camera starting image capture\n");
 			}
 			// REQUESTS
@@ -680,7 +1226,7 @@ void HyperSpectralCamera(void) {
 				tx_payload.Parameter[4] = read_out_state;
 
 				printf("Sending SubSystem States response\n");
-				xQueueSend(I2C_OBC, &tx_payload, portMAX_DELAY);
+				sendCameraResponse(&tx_payload, rx_payload.Parameter[0]);
 			}
 			if (command_id == 133) {	// 0x85 SESSION INFORMATION
 				tx_payload.Command_ID = 133;
@@ -690,37 +1236,34 @@ void HyperSpectralCamera(void) {
 				tx_payload.Parameter[3] = used_bytes[session_id];
 
 				printf("Sending Session Information response\n");
-				xQueueSend(I2C_OBC, &tx_payload, portMAX_DELAY);
+				sendCameraResponse(&tx_payload, rx_payload.Parameter[0]);
 			}
 			if (command_id == 134) {	// 0x86 CURRENT SESSION ID
 				tx_payload.Command_ID = 134;
 				tx_payload.Parameter[0] = session_id;
 				printf("Sending Session_ID : %d to OBC\n", session_id);
-				xQueueSend(I2C_OBC, &tx_payload, portMAX_DELAY);
+				sendCameraResponse(&tx_payload, rx_payload.Parameter[0]);
 			}
 			if (command_id == 135) {	// 0x87 CURRENT SESSION SIZE
 				tx_payload.Command_ID = 135;
 				tx_payload.Parameter[0] = session_size;
 				printf("Sending  current Session Size : %d to OBC\n", session_size);
-				xQueueSend(I2C_OBC, &tx_payload, portMAX_DELAY);
+				sendCameraResponse(&tx_payload, rx_payload.Parameter[0]);
 			}
 			if (command_id == 137) {	// 0x89 IMAGING PARAMETER
 				tx_payload.Command_ID = 137;
 				tx_payload.Parameter[0] = imaging_parameters[imaging_index];
 				printf("Sending imaging parameter value : %d to OBC\n", imaging_parameters[imaging_index]);
-				xQueueSend(I2C_OBC, &tx_payload, portMAX_DELAY);
+				sendCameraResponse(&tx_payload, rx_payload.Parameter[0]);
 			}
 		}
 
 		// Simulate image capture. 
-		// The imager will count for a predifined number of ticks after which we consider that the image is captured.
+		// The capture timer expires a predifined number of ticks after the capture started, after which we consider that the image is captured.
 		if (capture_state == 2) {
 			setGreenTextColor();
 
-			current_tick_time = xTaskGetTickCount();
-			time_passed = current_tick_time - starting_tick_time;
-
-			if (time_passed > IMAGE_CAPTURE_TIME) {
+			if (command_id == CAMERA_CAPTURE_COMPLETED) {
 				capture_state = 0;
 
 				// STORE DATA FOR EACH LINE
@@ -738,14 +1281,11 @@ void HyperSpectralCamera(void) {
 		}
 
 		// Simulate image download. 
-		// The imager will count for a predifined number of ticks after which we consider that the image is captured.
+		// The read out timer expires a predifined number of ticks after the read out started, after which we consider that the image is downloaded.
 		if (read_out_state == 1) {
 			setGreenTextColor();
 
-			current_tick_time = xTaskGetTickCount();
-			time_passed = current_tick_time - starting_tick_time;
-
-			if (time_passed > IMAGE_CAPTURE_TIME) {
+			if (command_id == CAMERA_READ_OUT_COMPLETED) {
 
 				read_out_state = 0;
 
@@ -769,6 +1309,16 @@ void HyperSpectralCamera(void) {
 	}
 }
 
+void cameraTimerCallback(TimerHandle_t timer) {
+	I2C_Payload completed;
+
+	completed.Command_ID = (int)(intptr_t)pvTimerGetTimerID(timer);
+
+	// THE TIMER SERVICE TASK MUST NOT BLOCK, SO IF THE CAMERA'S QUEUE IS FULL THE TIMER IS RESTARTED TO TRY AGAIN
+	if (xQueueSend(I2C_CAMERA, &completed, 0) != pdPASS)
+		xTimerReset(timer, 0);
+}
+
 /*
 * 
 * HYPESPECTRAL CAMERA COMMAND TRANSACTIONS
@@ -916,13 +1466,14 @@ int CURRENT_SESSION_ID() {
 
 	I2C_Payload CURRENT_SESSION_ID;
 	CURRENT_SESSION_ID.Command_ID = 134;
+	CURRENT_SESSION_ID.Parameter[0] = OBC_REQUESTER;
 	printCommandID("CURRENT SESSION ID", CURRENT_SESSION_ID.Command_ID, 0);
 
 	if (!xQueueSend(I2C_CAMERA, &CURRENT_SESSION_ID, portMAX_DELAY)) {
 		printf("\nOBC FAILED TO SEND COMMAND x%x TO THE HYPERSPECTRAL CAMERA\n", CURRENT_SESSION_ID.Command_ID);
 	}
 	else {
-		if (xQueueReceive(I2C_OBC, &CURRENT_SESSION_ID, portMAX_DELAY))
+		if (receiveCameraResponse(&CURRENT_SESSION_ID, OBC_REQUESTER))
 			session_id = CURRENT_SESSION_ID.Parameter[0];
 	}
 
@@ -934,13 +1485,14 @@ int CURRENT_SESSION_SIZE() {
 
 	I2C_Payload payload;
 	payload.Command_ID = 135;
+	payload.Parameter[0] = OBC_REQUESTER;
 	printCommandID("CURRENT SESSION SIZE", payload.Command_ID, 0);
 
 	if (!xQueueSend(I2C_CAMERA, &payload, portMAX_DELAY)) {
 		printf("\nOBC FAILED TO SEND COMMAND x%x TO THE HYPERSPECTRAL CAMERA\n", payload.Command_ID);
 	}
 	else {
-		if (xQueueReceive(I2C_OBC, &payload, portMAX_DELAY))
+		if (receiveCameraResponse(&payload, OBC_REQUESTER))
 			session_size = payload.Parameter[0];
 	}
 
@@ -973,13 +1525,14 @@ int  IMAGING_PARAMETER() {
 
 	I2C_Payload payload;
 	payload.Command_ID = 137;	// 0x89
+	payload.Parameter[0] = OBC_REQUESTER;
 	printCommandID("IMAGING PARAMETER", payload.Command_ID, 0);
 
 	if (!xQueueSend(I2C_CAMERA, &payload, portMAX_DELAY)) {
 		printf("OBC FAILED TO SEND COMMAND 0x%x TO THE HYPERSPECTRAL CAMERA\n", payload.Command_ID);
 	}
 	else {
-		if (xQueueReceive(I2C_OBC, &payload, portMAX_DELAY)) {
+		if (receiveCameraResponse(&payload, OBC_REQUESTER)) {
 			// Read the value of the imaging parameter that the hyperspectral camera returned.
 			imaging_parameter = payload.Parameter[0];
 		}
@@ -992,13 +1545,14 @@ void SUBSYSTEM_STATES(int states[], int color) {
 
 	I2C_Payload payload;
 	payload.Command_ID = 129;	// 0x81
+	payload.Parameter[0] = color;
 	printCommandID("SUBSYSTEMS STATES" ,payload.Command_ID, color);
 
 	if (!xQueueSend(I2C_CAMERA, &payload, portMAX_DELAY)) {
 		printf("OBC FAILED TO SEND COMMAND 0x%x TO THE HYPERSPECTRAL CAMERA\n", payload.Command_ID);
 	}
 	else {
-		if (xQueueReceive(I2C_OBC, &payload, portMAX_DELAY)) {
+		if (receiveCameraResponse(&payload, color)) {
 			// Read the states that the hyperspectral camera returned.
 			for(int i = 0; i < SUBSYSTEM_STATES_RETURN_PARAMETERS; ++i)
 				states[i] = payload.Parameter[i];
@@ -1012,13 +1566,14 @@ void SESSION_INFORMATION(int states[], int color) {
 
 	I2C_Payload payload;
 	payload.Command_ID = 133;	// 0x85
+	payload.Parameter[0] = color;
 	printCommandID("SESSION INFORMATION", payload.Command_ID, color);
 
 	if (!xQueueSend(I2C_CAMERA, &payload, portMAX_DELAY)) {
 		printf("OBC FAILED TO SEND COMMAND 0x%x TO THE HYPERSPECTRAL CAMERA\n", payload.Command_ID);
 	}
 	else {
-		if (xQueueReceive(I2C_OBC, &payload, portMAX_DELAY)) {
+		if (receiveCameraResponse(&payload, color)) {
 			// Read the states that the hyperspectral camera returned.
 			for (int i = 0; i < SESSION_INFORAMTION_RETURN_PARAMETERS; ++i)
 				states[i] = payload.Parameter[i];
@@ -1028,6 +1583,35 @@ void SESSION_INFORMATION(int states[], int color) {
 	}
 }
 
+void sendCameraResponse(const I2C_Payload* response, int requester) {
+	if (requester < 0 || requester >= NUMBER_OF_REQUESTERS || CAMERA_REQUESTERS[requester] == NULL) {
+		printf("HyperSpectral Camera dropped response 0x%x to unknown requester %d\n", response->Command_ID, requester);
+		return;
+	}
+
+	// EACH REQUESTER HAS ITS OWN RESPONSE, SO THE OBC AND THE PDPU NEVER RECEIVE EACH OTHER'S.
+	// THE NOTIFICATION CARRIES THE COMMAND ID, SO A REQUESTER CAN TELL WHICH REQUEST WAS ANSWERED
+	CAMERA_RESPONSES[requester] = *response;
+	xTaskNotifyIndexed(CAMERA_REQUESTERS[requester], I2C_RESPONSE_NOTIFICATION, (uint32_t)response->Command_ID, eSetValueWithOverwrite);
+}
+
+int receiveCameraResponse(I2C_Payload* response, int requester) {
+	uint32_t command_id;
+	const int request_id = response->Command_ID;
+
+	// WAITING AT ITS OWN INDEX LEAVES THE DEFAULT NOTIFICATION OF THE TASK TO ANY OTHER USE
+	if (!xTaskNotifyWaitIndexed(I2C_RESPONSE_NOTIFICATION, 0, 0, &command_id, portMAX_DELAY))
+		return 0;
+
+	*response = CAMERA_RESPONSES[requester];
+	if ((int)command_id != request_id) {
+		printf("RECEIVED RESPONSE 0x%x TO REQUEST 0x%x\n", (unsigned int)command_id, request_id);
+		return 0;
+	}
+
+	return 1;
+}
+
 void printSubSystemStates(const int states[], int color) {
 	char* session = "";
 	char* config  = "";
@@ -1216,12 +1800,13 @@ void PDPU(void) {
 				SUBSYSTEM_STATES(sub_states, 1);
 
 				while (sub_states[4] == 1) {
+					vTaskDelay(MONITOR_IMAGE_CAPTURE_PERIOD);
+					SUBSYSTEM_STATES(sub_states, 1);
+
 					current_tick_time = xTaskGetTickCount();
 					time_passed = current_tick_time - start_tick_time;
 
-					if (time_passed % MONITOR_IMAGE_CAPTURE_PERIOD == 0)
-						SUBSYSTEM_STATES(sub_states, 1);
-					if (time_passed == MAX_WAIT_TIME_FOR_IMAGE_CAPTURE_COMPLETION)
+					if (time_passed >= MAX_WAIT_TIME_FOR_IMAGE_CAPTURE_COMPLETION)
 						break;
 				}
 			}
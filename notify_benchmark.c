@@ -0,0 +1,311 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A benchmark of the request/response round trip between two tasks, as used
+ * by the OBC and the PDPU to request data from the camera in main.c.  A
+ * requester sends each request to a server through a queue, as the camera's
+ * commands are sent, then blocks until the server has returned the response.
+ * The response is returned in one of two ways:
+ *
+ * + Through a queue of the requester, which the response is copied into and
+ *   out of.
+ *
+ * + By writing it to a mailbox of the requester then notifying the requester
+ *   at index nbRESPONSE_INDEX, with the command ID as the notification value.
+ *   The requester waits at that index only, so its default notification
+ *   (index 0, used by stream buffers) is left free.
+ *
+ * For each the benchmark prints the FreeRTOS heap used per requester for
+ * its responses, the host time per round trip, and the host time the server
+ * spends returning each response.  Each round trip includes two context
+ * switches, which take most of its time on the host, so the time to return
+ * the response is the part that differs between the two.  The notification array
+ * is part of the TCB, so it uses no heap, but each index adds
+ * sizeof( uint32_t ) + sizeof( uint8_t ) bytes to every TCB.
+ *
+ * The benchmark is built in place of main.c:
+ *
+ *   gcc -O2 -I. notify_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o notify_benchmark -lpthread
+ *   ./notify_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#define nbRESPONSE_INDEX		( 1 )
+
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES <= nbRESPONSE_INDEX )
+	#error The benchmark must be built with configTASK_NOTIFICATION_ARRAY_ENTRIES of at least 2.
+#endif
+
+#define nbROUND_TRIPS			( 20000UL )
+#define nbRUNS					( 3 )
+
+/* The server has the higher priority, as the camera has in main.c. */
+#define nbREQUESTER_PRIORITY	( tskIDLE_PRIORITY + 1 )
+#define nbSERVER_PRIORITY		( tskIDLE_PRIORITY + 2 )
+
+/* How the server returns its responses. */
+#define nbRESPOND_BY_QUEUE			( 0 )
+#define nbRESPOND_BY_NOTIFICATION	( 1 )
+
+/* A request or response, the same size as the I2C payload of main.c. */
+typedef struct REQUEST_PAYLOAD
+{
+	int iCommandID;
+	int iParameter[ 5 ];
+} Payload_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs each way of returning the responses nbRUNS times, prints the results
+ * and exits.
+ */
+static void prvRequesterTask( void *pvParameters );
+
+/*
+ * Answers each request, in the way given by the request.
+ */
+static void prvServerTask( void *pvParameters );
+
+/*
+ * The nanoseconds per round trip of nbROUND_TRIPS requests.
+ */
+static double prvTimeRoundTrips( int iRespondBy, double *pdResponseTime );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t xRequester = NULL;
+static QueueHandle_t xRequestQueue = NULL, xResponseQueue = NULL;
+
+/* The response returned with a notification. */
+static Payload_t xResponseMailbox;
+
+/* The host nanoseconds the server has spent returning responses. */
+static double dResponseTime = 0.0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xRequestQueue = xQueueCreate( 5, sizeof( Payload_t ) );
+
+	xTaskCreate( prvServerTask, "SERVER", configMINIMAL_STACK_SIZE, NULL, nbSERVER_PRIORITY, NULL );
+	xTaskCreate( prvRequesterTask, "REQUEST", configMINIMAL_STACK_SIZE, NULL, nbREQUESTER_PRIORITY, &xRequester );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRequesterTask( void *pvParameters )
+{
+double dQueueTime = 1e30, dNotificationTime = 1e30, dTime;
+double dQueueResponse = 1e30, dNotificationResponse = 1e30, dResponse;
+size_t xFreeBefore, xQueueBytes;
+int iRun;
+
+	( void ) pvParameters;
+
+	xFreeBefore = xPortGetFreeHeapSize();
+	xResponseQueue = xQueueCreate( 1, sizeof( Payload_t ) );
+	xQueueBytes = xFreeBefore - xPortGetFreeHeapSize();
+
+	/* The best of the runs, so the results are not disturbed by the host. */
+	for( iRun = 0; iRun < nbRUNS; iRun++ )
+	{
+		dTime = prvTimeRoundTrips( nbRESPOND_BY_QUEUE, &dResponse );
+		if( dTime < dQueueTime )
+		{
+			dQueueTime = dTime;
+		}
+		if( dResponse < dQueueResponse )
+		{
+			dQueueResponse = dResponse;
+		}
+
+		dTime = prvTimeRoundTrips( nbRESPOND_BY_NOTIFICATION, &dResponse );
+		if( dTime < dNotificationTime )
+		{
+			dNotificationTime = dTime;
+		}
+		if( dResponse < dNotificationResponse )
+		{
+			dNotificationResponse = dResponse;
+		}
+	}
+
+	printf( "%lu round trips, best of %d runs, %u notification indexes of %u bytes in each TCB\n\n",
+		( unsigned long ) nbROUND_TRIPS, nbRUNS, ( unsigned ) configTASK_NOTIFICATION_ARRAY_ENTRIES,
+		( unsigned ) ( sizeof( uint32_t ) + sizeof( uint8_t ) ) );
+	printf( "Response by     Heap (bytes per requester)   Round trip (ns)   Return response (ns)\n" );
+	printf( "Queue           %-28u %-17.0f %.0f\n", ( unsigned ) xQueueBytes, dQueueTime, dQueueResponse );
+	printf( "Notification    %-28u %-17.0f %.0f\n", 0U, dNotificationTime, dNotificationResponse );
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvServerTask( void *pvParameters )
+{
+Payload_t xRequest, xResponse;
+double dStart;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xQueueReceive( xRequestQueue, &xRequest, portMAX_DELAY ) == pdPASS )
+		{
+			xResponse.iCommandID = xRequest.iCommandID;
+			xResponse.iParameter[ 0 ] = xRequest.iParameter[ 1 ] + 1;
+			dStart = prvNanoseconds();
+
+			if( xRequest.iParameter[ 0 ] == nbRESPOND_BY_QUEUE )
+			{
+				xQueueSend( xResponseQueue, &xResponse, portMAX_DELAY );
+			}
+			else
+			{
+				xResponseMailbox = xResponse;
+				xTaskNotifyIndexed( xRequester, nbRESPONSE_INDEX, ( uint32_t ) xResponse.iCommandID, eSetValueWithOverwrite );
+			}
+
+			/* The requester has the lower priority, so does not run until the
+			server blocks again. */
+			dResponseTime += prvNanoseconds() - dStart;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeRoundTrips( int iRespondBy, double *pdResponseTime )
+{
+Payload_t xRequest, xResponse;
+uint32_t ulRoundTrip, ulCommandID;
+double dStart;
+
+	xRequest.iParameter[ 0 ] = iRespondBy;
+	dResponseTime = 0.0;
+	dStart = prvNanoseconds();
+
+	for( ulRoundTrip = 0; ulRoundTrip < nbROUND_TRIPS; ulRoundTrip++ )
+	{
+		xRequest.iCommandID = ( int ) ( ulRoundTrip & 0xffUL );
+		xRequest.iParameter[ 1 ] = ( int ) ulRoundTrip;
+		xQueueSend( xRequestQueue, &xRequest, portMAX_DELAY );
+
+		if( iRespondBy == nbRESPOND_BY_QUEUE )
+		{
+			xQueueReceive( xResponseQueue, &xResponse, portMAX_DELAY );
+		}
+		else
+		{
+			xTaskNotifyWaitIndexed( nbRESPONSE_INDEX, 0, 0, &ulCommandID, portMAX_DELAY );
+			xResponse = xResponseMailbox;
+			configASSERT( ( int ) ulCommandID == xRequest.iCommandID );
+		}
+
+		if( xResponse.iParameter[ 0 ] != xRequest.iParameter[ 1 ] + 1 )
+		{
+			printf( "Round trip %lu received the wrong response\n", ( unsigned long ) ulRoundTrip );
+			exit( 1 );
+		}
+	}
+
+	*pdResponseTime = dResponseTime / ( double ) nbROUND_TRIPS;
+	return ( prvNanoseconds() - dStart ) / ( double ) nbROUND_TRIPS;
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,279 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A benchmark of context switches between tasks, to compare the thread per
+ * task backend of the POSIX port (port_posix.c) with the fiber backend
+ * (port_posix_fiber.c, built with configUSE_FIBERS set to 1).  Two tasks of the
+ * same priority pass control back and forth in two ways:
+ *
+ * + Yield - each task calls taskYIELD() ppbYIELDS times, so each call switches
+ *   to the other task.  The time per switch is printed.
+ *
+ * + Queue - the ping task sends a value to the pong task through one queue,
+ *   and the pong task returns it incremented through another, ppbROUND_TRIPS
+ *   times.  Each round trip blocks each task once, so it takes two switches,
+ *   and the time per round trip is printed.
+ *
+ * The benchmark is built in place of main.c, once for each backend:
+ *
+ *   gcc -O2 -I. pingpong_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o pingpong_benchmark -lpthread
+ *   ./pingpong_benchmark
+ *   gcc -O2 -I. -DconfigUSE_FIBERS=1 pingpong_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o pingpong_benchmark -lpthread
+ *   ./pingpong_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+
+#define ppbYIELDS				( 20000UL )
+#define ppbROUND_TRIPS			( 20000UL )
+#define ppbRUNS					( 3 )
+
+#define ppbBENCHMARK_PRIORITY	( tskIDLE_PRIORITY + 2 )
+#define ppbPLAYER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Times each way of passing control, prints the results and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * The two players of the yield ping-pong, and the ping and pong tasks of the
+ * queue ping-pong.  Each gives xPlayersDone then deletes itself when it has
+ * finished.
+ */
+static void prvYieldTask( void *pvParameters );
+static void prvPingTask( void *pvParameters );
+static void prvPongTask( void *pvParameters );
+
+/*
+ * The host nanoseconds taken by the fastest of ppbRUNS runs of two tasks
+ * running pxFirstTask and pxSecondTask.
+ */
+static double prvTimePlayers( TaskFunction_t pxFirstTask, TaskFunction_t pxSecondTask );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t xPlayersDone = NULL;
+static QueueHandle_t xPingQueue = NULL, xPongQueue = NULL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xPlayersDone = xSemaphoreCreateCounting( 2, 0 );
+	xPingQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+	xPongQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+	configASSERT( xPlayersDone && xPingQueue && xPongQueue );
+
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, ppbBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+double dYield, dQueue;
+
+	( void ) pvParameters;
+
+	dYield = prvTimePlayers( prvYieldTask, prvYieldTask ) / ( double ) ( ppbYIELDS * 2UL );
+	dQueue = prvTimePlayers( prvPingTask, prvPongTask ) / ( double ) ppbROUND_TRIPS;
+
+	printf( "%s backend, best of %d runs\n\n", ( configUSE_FIBERS == 1 ) ? "Fiber" : "Thread", ppbRUNS );
+	printf( "Yield switch (ns)   Queue round trip (ns)\n" );
+	printf( "%-19.0f %.0f\n", dYield, dQueue );
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void *pvParameters )
+{
+uint32_t ulYield;
+
+	( void ) pvParameters;
+
+	for( ulYield = 0; ulYield < ppbYIELDS; ulYield++ )
+	{
+		taskYIELD();
+	}
+
+	xSemaphoreGive( xPlayersDone );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPingTask( void *pvParameters )
+{
+uint32_t ulRoundTrip, ulValue;
+
+	( void ) pvParameters;
+
+	for( ulRoundTrip = 0; ulRoundTrip < ppbROUND_TRIPS; ulRoundTrip++ )
+	{
+		xQueueSend( xPingQueue, &ulRoundTrip, portMAX_DELAY );
+		xQueueReceive( xPongQueue, &ulValue, portMAX_DELAY );
+
+		if( ulValue != ulRoundTrip + 1UL )
+		{
+			printf( "Round trip %lu returned %lu\n", ( unsigned long ) ulRoundTrip, ( unsigned long ) ulValue );
+			exit( 1 );
+		}
+	}
+
+	xSemaphoreGive( xPlayersDone );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPongTask( void *pvParameters )
+{
+uint32_t ulRoundTrip, ulValue;
+
+	( void ) pvParameters;
+
+	for( ulRoundTrip = 0; ulRoundTrip < ppbROUND_TRIPS; ulRoundTrip++ )
+	{
+		xQueueReceive( xPingQueue, &ulValue, portMAX_DELAY );
+		ulValue++;
+		xQueueSend( xPongQueue, &ulValue, portMAX_DELAY );
+	}
+
+	xSemaphoreGive( xPlayersDone );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimePlayers( TaskFunction_t pxFirstTask, TaskFunction_t pxSecondTask )
+{
+int iRun;
+double dStart, dTime, dFastest = 0.0;
+
+	/* The fastest run is the one least disturbed by the host. */
+	for( iRun = 0; iRun < ppbRUNS; iRun++ )
+	{
+		dStart = prvNanoseconds();
+
+		/* The players have the lower priority, so they only start once this
+		task blocks. */
+		if( ( xTaskCreate( pxFirstTask, "PLAYER1", configMINIMAL_STACK_SIZE, NULL, ppbPLAYER_PRIORITY, NULL ) != pdPASS ) ||
+			( xTaskCreate( pxSecondTask, "PLAYER2", configMINIMAL_STACK_SIZE, NULL, ppbPLAYER_PRIORITY, NULL ) != pdPASS ) )
+		{
+			printf( "Could not create the players\n" );
+			exit( 1 );
+		}
+
+		xSemaphoreTake( xPlayersDone, portMAX_DELAY );
+		xSemaphoreTake( xPlayersDone, portMAX_DELAY );
+
+		dTime = prvNanoseconds() - dStart;
+
+		if( ( iRun == 0 ) || ( dTime < dFastest ) )
+		{
+			dFastest = dTime;
+		}
+
+		/* Let the idle task free the players' stacks. */
+		vTaskDelay( 2 );
+	}
+
+	return dFastest;
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
@@ -67,6 +67,10 @@
     1 tab == 4 spaces!
 */
 
+/* This port is built when the simulator is compiled on Windows.  The POSIX
+simulator port in port_posix.c is used on other hosts. */
+#ifdef _WIN32
+
 /* Standard includes. */
 #include <stdio.h>
 
@@ -74,6 +78,14 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if( configNUM_CORES > 1 )
+	#error The Windows simulator port only supports a single core.  Set configNUM_CORES to 1.
+#endif
+
+#if( configUSE_FIBERS != 0 )
+	#error The Windows simulator port runs each task in its own thread.  Set configUSE_FIBERS to 0.
+#endif
+
 #ifdef __GNUC__
 	#include "mmsystem.h"
 #else
@@ -172,53 +184,64 @@ extern void *pxCurrentTCB;
 /* Used to ensure nothing is processed during the startup sequence. */
 static BaseType_t xPortRunning = pdFALSE;
 
+/* The number of tick periods the simulated timer waits before it generates the
+next tick - one, unless the idle task is sleeping with ticks suppressed.  An
+event is used to make the timer start waiting again when it is changed.  Both
+are protected by the interrupt event mutex.  The length of a tick period in
+milliseconds is set before the scheduler starts. */
+static volatile uint32_t ulTimerTickPeriods = 1UL;
+static void *pvTimerEvent = NULL;
+static DWORD dwTimerPeriod = ( DWORD ) portTICK_PERIOD_MS;
+
+/* While the idle task sleeps with ticks suppressed, the simulated interrupt
+processing thread signals this event each time it processes interrupts. */
+static volatile BaseType_t xIdleTaskSleeping = pdFALSE;
+static void *pvIdleTaskWakeEvent = NULL;
+
 /*-----------------------------------------------------------*/
 
 static DWORD WINAPI prvSimulatedPeripheralTimer( LPVOID lpParameter )
 {
-TickType_t xMinimumWindowsBlockTime;
-TIMECAPS xTimeCaps;
-
-	/* Set the timer resolution to the maximum possible. */
-	if( timeGetDevCaps( &xTimeCaps, sizeof( xTimeCaps ) ) == MMSYSERR_NOERROR )
-	{
-		xMinimumWindowsBlockTime = ( TickType_t ) xTimeCaps.wPeriodMin;
-		timeBeginPeriod( xTimeCaps.wPeriodMin );
-
-		/* Register an exit handler so the timeBeginPeriod() function can be
-		matched with a timeEndPeriod() when the application exits. */
-		SetConsoleCtrlHandler( prvEndProcess, TRUE );
-	}
-	else
-	{
-		xMinimumWindowsBlockTime = ( TickType_t ) 20;
-	}
+DWORD dwWaitTime;
 
 	/* Just to prevent compiler warnings. */
 	( void ) lpParameter;
 
 	for( ;; )
 	{
+		WaitForSingleObject( pvInterruptEventMutex, INFINITE );
+		dwWaitTime = ( DWORD ) ulTimerTickPeriods * dwTimerPeriod;
+		ReleaseMutex( pvInterruptEventMutex );
+
 		/* Wait until the timer expires and we can access the simulated interrupt
 		variables.  *NOTE* this is not a 'real time' way of generating tick
 		events as the next wake time should be relative to the previous wake
-		time, not the time that Sleep() is called.  It is done this way to
+		time, not the time that the wait started.  It is done this way to
 		prevent overruns in this very non real time simulated/emulated
-		environment. */
-		if( portTICK_PERIOD_MS < xMinimumWindowsBlockTime )
+		environment.  If the idle task changes the number of tick periods to
+		wait the wait starts again. */
+		if( WaitForSingleObject( pvTimerEvent, dwWaitTime ) == WAIT_OBJECT_0 )
 		{
-			Sleep( xMinimumWindowsBlockTime );
-		}
-		else
-		{
-			Sleep( portTICK_PERIOD_MS );
+			continue;
 		}
 
 		configASSERT( xPortRunning );
 
 		WaitForSingleObject( pvInterruptEventMutex, INFINITE );
 
-		/* The timer has expired, generate the simulated tick event. */
+		/* The idle task changed the number of tick periods to wait after the
+		wait timed out but before the mutex was obtained, so the wait starts
+		again instead. */
+		if( WaitForSingleObject( pvTimerEvent, 0 ) == WAIT_OBJECT_0 )
+		{
+			ReleaseMutex( pvInterruptEventMutex );
+			continue;
+		}
+
+		/* The timer has expired, generate the simulated tick event.  If ticks
+		were suppressed this is the tick that unblocks a task, and the idle task
+		sees the number of periods is back to one. */
+		ulTimerTickPeriods = 1UL;
 		ulPendingInterrupts |= ( 1 << portINTERRUPT_TICK );
 
 		/* The interrupt is now pending - notify the simulated interrupt
@@ -298,6 +321,7 @@ BaseType_t xPortStartScheduler( void )
 void *pvHandle;
 int32_t lSuccess = pdPASS;
 xThreadState *pxThreadState;
+TIMECAPS xTimeCaps;
 
 	/* Install the interrupt handlers used by the scheduler itself. */
 	vPortSetInterruptHandler( portINTERRUPT_YIELD, prvProcessYieldInterrupt );
@@ -307,8 +331,10 @@ xThreadState *pxThreadState;
 	threads. */
 	pvInterruptEventMutex = CreateMutex( NULL, FALSE, NULL );
 	pvInterruptEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+	pvTimerEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
+	pvIdleTaskWakeEvent = CreateEvent( NULL, FALSE, FALSE, NULL );
 
-	if( ( pvInterruptEventMutex == NULL ) || ( pvInterruptEvent == NULL ) )
+	if( ( pvInterruptEventMutex == NULL ) || ( pvInterruptEvent == NULL ) || ( pvTimerEvent == NULL ) || ( pvIdleTaskWakeEvent == NULL ) )
 	{
 		lSuccess = pdFAIL;
 	}
@@ -334,6 +360,26 @@ xThreadState *pxThreadState;
 
 	if( lSuccess == pdPASS )
 	{
+		/* Set the timer resolution to the maximum possible.  The simulated
+		timer cannot wait for less than the minimum resolution. */
+		if( timeGetDevCaps( &xTimeCaps, sizeof( xTimeCaps ) ) == MMSYSERR_NOERROR )
+		{
+			if( portTICK_PERIOD_MS < ( TickType_t ) xTimeCaps.wPeriodMin )
+			{
+				dwTimerPeriod = ( DWORD ) xTimeCaps.wPeriodMin;
+			}
+
+			timeBeginPeriod( xTimeCaps.wPeriodMin );
+
+			/* Register an exit handler so the timeBeginPeriod() function can
+			be matched with a timeEndPeriod() when the application exits. */
+			SetConsoleCtrlHandler( prvEndProcess, TRUE );
+		}
+		else if( portTICK_PERIOD_MS < ( TickType_t ) 20 )
+		{
+			dwTimerPeriod = ( DWORD ) 20;
+		}
+
 		/* Start the thread that simulates the timer peripheral to generate
 		tick interrupts.  The priority is set below that of the simulated
 		interrupt handler so the interrupt event mutex is used for the
@@ -467,6 +513,14 @@ CONTEXT xContext;
 			}
 		}
 
+		/* The scheduler is suspended while the idle task sleeps, so it is
+		still the task in the Running state, and must correct the tick count
+		before any task it was sleeping for can run. */
+		if( xIdleTaskSleeping != pdFALSE )
+		{
+			SetEvent( pvIdleTaskWakeEvent );
+		}
+
 		ReleaseMutex( pvInterruptEventMutex );
 	}
 }
@@ -658,3 +712,130 @@ int32_t lMutexNeedsReleasing;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+		/* Called by the idle task, with the scheduler suspended, when no other
+		task is able to run for at least xExpectedIdleTime ticks. */
+		#if( configUSE_VIRTUAL_TIME == 1 )
+		{
+			/* Holding the interrupt event mutex prevents ticks being processed
+			while the tick count is corrected. */
+			vPortEnterCritical();
+			{
+				/* Only jump if a task is waiting for a timeout, and nothing was
+				made ready between the scheduler being suspended and the
+				critical section being entered. */
+				if( eTaskConfirmSleepModeStatus() == eStandardSleep )
+				{
+					/* Jump to the tick before the next task unblocks, then
+					pend the tick that unblocks it.  The pended tick is
+					processed as soon as the critical section is exited, and
+					is held as a pended tick by the kernel until the idle task
+					resumes the scheduler. */
+					vTaskStepTick( xExpectedIdleTime - ( TickType_t ) 1 );
+					ulPendingInterrupts |= ( 1 << portINTERRUPT_TICK );
+				}
+			}
+			vPortExitCritical();
+		}
+		#else
+		{
+		DWORD dwSleepStart = 0;
+		TickType_t xSuppressedTicks;
+		BaseType_t xSleep = pdFALSE;
+
+			vPortEnterCritical();
+			{
+				/* The timer waits for up to 0x7fffffff milliseconds.  If it
+				expires with nothing to do the idle task just sleeps again. */
+				if( xExpectedIdleTime > ( TickType_t ) ( 0x7fffffffUL / dwTimerPeriod ) )
+				{
+					xExpectedIdleTime = ( TickType_t ) ( 0x7fffffffUL / dwTimerPeriod );
+				}
+
+				/* Don't sleep if a task was made ready after the scheduler was
+				suspended, or if an interrupt is already pending. */
+				if( ( eTaskConfirmSleepModeStatus() != eAbortSleep ) && ( ulPendingInterrupts == 0UL ) )
+				{
+					/* Make the simulated timer wait until the tick that
+					unblocks the next task, so the ticks in between are not
+					generated. */
+					ulTimerTickPeriods = ( uint32_t ) xExpectedIdleTime;
+					SetEvent( pvTimerEvent );
+					dwSleepStart = timeGetTime();
+
+					ResetEvent( pvIdleTaskWakeEvent );
+					xIdleTaskSleeping = pdTRUE;
+					xSleep = pdTRUE;
+				}
+			}
+			vPortExitCritical();
+
+			if( xSleep != pdFALSE )
+			{
+				/* Sleep until that tick, or any other simulated interrupt, has
+				been processed.  The mutex cannot be held while sleeping, as
+				the interrupts are processed by another thread, but with the
+				scheduler suspended the interrupts cannot switch tasks. */
+				WaitForSingleObject( pvIdleTaskWakeEvent, INFINITE );
+
+				vPortEnterCritical();
+				{
+					xIdleTaskSleeping = pdFALSE;
+
+					if( ulTimerTickPeriods == 1UL )
+					{
+						/* The timer expired, so all the suppressed ticks have
+						elapsed, and the tick it generated unblocks the task. */
+						xSuppressedTicks = xExpectedIdleTime - ( TickType_t ) 1;
+					}
+					else
+					{
+						/* Woken early by another interrupt.  Count the tick
+						periods that have passed, and restart the timer from
+						now. */
+						xSuppressedTicks = ( TickType_t ) ( ( timeGetTime() - dwSleepStart ) / dwTimerPeriod );
+
+						if( xSuppressedTicks > ( xExpectedIdleTime - ( TickType_t ) 1 ) )
+						{
+							xSuppressedTicks = xExpectedIdleTime - ( TickType_t ) 1;
+						}
+
+						ulTimerTickPeriods = 1UL;
+						SetEvent( pvTimerEvent );
+					}
+
+					vTaskStepTick( xSuppressedTicks );
+				}
+				vPortExitCritical();
+			}
+		}
+		#endif /* configUSE_VIRTUAL_TIME */
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetRunTimeCounterValue( void )
+{
+static LARGE_INTEGER xFrequency = { 0 };
+LARGE_INTEGER xCount;
+
+	/* The performance counter frequency is fixed at boot, so only needs
+	reading once.  The count is split into whole seconds and the remainder
+	so converting it to nanoseconds cannot overflow. */
+	if( xFrequency.QuadPart == 0 )
+	{
+		QueryPerformanceFrequency( &xFrequency );
+	}
+
+	QueryPerformanceCounter( &xCount );
+
+	return ( ( uint64_t ) ( xCount.QuadPart / xFrequency.QuadPart ) * 1000000000ULL ) +
+		   ( ( ( uint64_t ) ( xCount.QuadPart % xFrequency.QuadPart ) * 1000000000ULL ) / ( uint64_t ) xFrequency.QuadPart );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* _WIN32 */
@@ -0,0 +1,2221 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* This port is built when the simulator is compiled on a POSIX host such as
+Linux.  The Win32 simulator port in port.c is used on Windows. */
+#ifndef _WIN32
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <limits.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined( __linux__ )
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+#endif
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The multiple core simulation is implemented by port_posix_smp.c, and the
+simulation that runs all the tasks on one thread by port_posix_fiber.c. */
+#if( ( configNUM_CORES == 1 ) && ( configUSE_FIBERS == 0 ) )
+
+#define portMAX_INTERRUPTS				( 256UL )
+#define portPENDING_WORDS				( portMAX_INTERRUPTS / 32UL ) /* The number of uint32_t bit maps needed to hold a bit per interrupt. */
+#define portINTERRUPTS_UNMASKED			( ( UBaseType_t ) portINTERRUPT_PRIORITY_LEVELS ) /* An interrupt mask value that masks nothing, and the active priority when no handler is executing. */
+#define portNO_CRITICAL_NESTING 		( ( uint32_t ) 0 )
+#define portNANO_SECONDS_PER_SECOND		( 1000000000L )
+#define portTICK_PERIOD_NS				( portNANO_SECONDS_PER_SECOND / configTICK_RATE_HZ )
+
+/* The signal sent to the thread of the task in the Running state to stop it
+while simulated interrupts are processed.  This is the POSIX equivalent of the
+SuspendThread()/GetThreadContext() pair used by the Win32 port. */
+#define portSUSPEND_SIGNAL				SIGUSR1
+
+/* The signal sent to a parked thread when its task enters the Running state -
+the equivalent of ResumeThread().  It is blocked in every task thread other
+than while the thread is parked in sigsuspend(), so it is never lost. */
+#define portRESUME_SIGNAL				SIGUSR2
+
+/* The journal modes, and the kinds of record held in the journal.  Events are
+timed by counting sync points rather than by host time.  A sync point is where
+the task in the Running state exits its outermost critical section, or yields,
+and is the only place interrupts raised by the timer and other peripheral
+threads are delivered while a journal is open - so a run replayed from the
+journal sees every interrupt at the same point in its instruction stream as the
+run that was recorded.  Each record is the number of sync points since the
+previous record, the kind of record, and a value - the interrupt number, the
+number of ticks stepped, the number of the task selected to run, or the number
+of bytes of data that follow the record.  The numbers are written seven bits to
+a byte, so most records are three bytes long. */
+#define portJOURNAL_OFF					( 0 )
+#define portJOURNAL_RECORD				( 1 )
+#define portJOURNAL_REPLAY				( 2 )
+
+#define portJOURNAL_KIND_INTERRUPT		( ( uint8_t ) 0 )
+#define portJOURNAL_KIND_STEP			( ( uint8_t ) 1 )
+#define portJOURNAL_KIND_SWITCH			( ( uint8_t ) 2 )
+#define portJOURNAL_KIND_DATA			( ( uint8_t ) 3 )
+#define portJOURNAL_KIND_END			( ( uint8_t ) 0xff ) /* Never written - marks the end of the journal being replayed. */
+
+#define portJOURNAL_BUFFER_SIZE			( 4096U )
+#define portJOURNAL_MAX_RECORD_SIZE		( 16U ) /* A ten byte sync point count, a kind byte and a five byte value. */
+#define portJOURNAL_MAGIC				"FRJ1"
+
+/*-----------------------------------------------------------*/
+
+/* The POSIX simulator runs each task in a thread.  As with the Win32 port the
+task stack is only used to hold an xThreadState structure, which maps the task
+handle to the thread that executes the task.  Only the thread whose xRunning
+member is pdTRUE is permitted to execute task code - all the other threads are
+parked in sigsuspend(). */
+typedef struct
+{
+	/* Handle of the thread that executes the task. */
+	pthread_t xThread;
+
+	/* Set by the simulated interrupt processing thread when the task enters
+	the Running state, and cleared when it leaves the Running state.  Both the
+	task and the simulated interrupt processing thread can clear it - whichever
+	thread clears it is responsible for the task stopping.  It is set to a
+	different non-zero value each time the task is resumed, so the task can
+	tell if it was stopped and resumed between reading and clearing it. */
+	_Atomic BaseType_t xRunning;
+
+	/* Set when the thread has exited, or has been asked to exit. */
+	volatile BaseType_t xClosed;
+
+	/* The task function and its parameter, executed once the thread first
+	runs. */
+	TaskFunction_t pxCode;
+	void *pvParameters;
+
+	#if( configUSE_JOURNAL == 1 )
+		/* Identifies the task in the journal.  Tasks are numbered in the order
+		they are created, which is the same each time the application runs. */
+		UBaseType_t uxJournalNumber;
+	#endif
+
+} xThreadState;
+
+/*
+ * Created as a high priority thread in the Win32 port, this function waits for
+ * an absolute time to simulate a tick interrupt being generated on an embedded
+ * target.
+ */
+static void *prvSimulatedPeripheralTimer( void *pvParameter );
+
+/*
+ * Helpers for the CLOCK_MONOTONIC times used by the simulated timer.
+ */
+static void prvAddNanoSeconds( struct timespec *pxTime, uint64_t ullNanoSeconds );
+static int64_t prvNanoSecondsBetween( const struct timespec *pxStart, const struct timespec *pxEnd );
+
+/*
+ * The simulated interrupt controller.  Waits for simulated interrupts to be
+ * raised, then runs their handlers in priority order.
+ */
+static void prvProcessSimulatedInterrupts( void );
+
+/*
+ * Run the handlers of the pending interrupts that are more urgent than both
+ * the handler already executing (if any) and the current interrupt mask, most
+ * urgent first.  Called recursively to nest a more urgent handler inside a
+ * less urgent one.
+ */
+static void prvServiceInterrupts( void );
+
+/*
+ * Clear and return the lowest numbered interrupt pending at priority
+ * ulPriority, if there is one.
+ */
+static BaseType_t prvTakeInterrupt( uint32_t ulPriority, uint32_t *pulInterruptNumber );
+
+/*
+ * Stop the thread of the task in the Running state, if it has not already
+ * stopped itself, so it does not execute in parallel with the simulated
+ * interrupt handlers.  Returns pdTRUE if this call stopped the thread.
+ */
+static BaseType_t prvStopRunningThread( void );
+
+/*
+ * Set a simulated interrupt pending, and wake any thread waiting in
+ * prvWaitForPendingInterrupt().  Does not take a lock, so can be called from
+ * any thread at any time.
+ */
+static void prvRaiseInterrupt( uint32_t ulInterruptNumber );
+
+/*
+ * Raise an interrupt on behalf of a thread that simulates a peripheral,
+ * including the timer thread.  While a journal is recorded the interrupt is
+ * latched, to be raised at the next sync point, and while a journal is replayed
+ * it is ignored as the journal raises the interrupts instead.
+ */
+static void prvRaisePeripheralInterrupt( uint32_t ulInterruptNumber );
+
+/*
+ * Returns pdTRUE if ulInterruptNumber is pending.  Only used to suppress ticks
+ * in real time.
+ */
+#if( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_VIRTUAL_TIME != 1 ) )
+	static BaseType_t prvInterruptIsPending( uint32_t ulInterruptNumber );
+#endif
+
+/*
+ * Block until at least one simulated interrupt is pending.
+ */
+static void prvWaitForPendingInterrupt( void );
+
+/*
+ * Called after a thread other than the simulated interrupt processing thread
+ * has released the interrupt event mutex, to let the simulated interrupt
+ * processing thread know it can now process interrupts that are less urgent
+ * than configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ */
+static void prvInterruptEventMutexReleased( void );
+
+/*
+ * Wait until *pulValue is no longer ulValue, or until woken by prvWakeAll().
+ * May return early, so callers test the condition they are waiting for again.
+ */
+static void prvWaitForChange( _Atomic uint32_t *pulValue, uint32_t ulValue );
+
+/*
+ * Wake all the threads waiting in prvWaitForChange() for pulValue to change.
+ */
+static void prvWakeAll( _Atomic uint32_t *pulValue );
+
+/*
+ * Interrupt handlers used by the kernel itself.  These are executed from the
+ * simulated interrupt handler thread.
+ */
+static uint32_t prvProcessYieldInterrupt( void );
+static uint32_t prvProcessTickInterrupt( void );
+
+/*
+ * Create the mutex, semaphore and signal handler shared by all the threads.
+ * Executed once, before the first task thread is created.
+ */
+static void prvCreateSimulatedInterruptObjects( void );
+
+/*
+ * The entry point of every task thread.  Waits to be selected to run for the
+ * first time before calling the task function.
+ */
+static void *prvTaskThreadEntry( void *pvParameter );
+
+/*
+ * Park the calling task thread until it is selected to enter the Running
+ * state again.
+ */
+static void prvWaitUntilRunning( xThreadState *pxThreadState );
+
+/*
+ * Executed in the context of the Running task thread when portSUSPEND_SIGNAL
+ * is received.  Acknowledges the signal, then parks the thread.
+ */
+static void prvSuspendSignalHandler( int iSignal );
+
+/*
+ * portRESUME_SIGNAL only has to interrupt sigsuspend(), so its handler does
+ * nothing.
+ */
+static void prvResumeSignalHandler( int iSignal );
+
+/*
+ * Mark the thread of the task that is entering the Running state as running
+ * and wake it.
+ */
+static void prvResumeThread( xThreadState *pxThreadState );
+
+/*
+ * Called by a task thread with a critical nesting count of zero, which does not
+ * hold the interrupt event mutex, when at least one simulated interrupt may be
+ * pending.  The task does not return until the interrupts have been processed
+ * and the task has been selected to run again - just as an interrupt on a real
+ * target preempts the instruction stream immediately.
+ */
+static void prvWaitForInterruptProcessing( void );
+
+#if( configUSE_JOURNAL == 1 )
+
+	/*
+	 * Record a peripheral interrupt to be raised at the next sync point, and
+	 * wait for one to be recorded.
+	 */
+	static void prvLatchInterrupt( uint32_t ulInterruptNumber );
+	static void prvWaitForLatchedInterrupt( void );
+
+	/*
+	 * Returns pdTRUE if ulInterruptNumber is latched.  Only used to suppress
+	 * ticks in real time.
+	 */
+	#if( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_VIRTUAL_TIME != 1 ) )
+		static BaseType_t prvInterruptIsLatched( uint32_t ulInterruptNumber );
+	#endif
+
+	/*
+	 * Called by the task in the Running state at the end of its outermost
+	 * critical section, while it still holds the interrupt event mutex.  Raises
+	 * the peripheral interrupts latched since the previous sync point, noting
+	 * them in the journal, or raises the interrupts the journal being replayed
+	 * says were raised at this sync point.
+	 */
+	static void prvJournalSyncPoint( void );
+
+	/*
+	 * Returns pdTRUE if interrupts are to be raised at the next sync point.
+	 */
+	static BaseType_t prvJournalInterruptsDue( void );
+
+	/*
+	 * vPortGenerateSimulatedInterrupt() when a journal is open and the caller
+	 * is not the simulated interrupt processing thread.
+	 */
+	static void prvJournalGenerateInterrupt( uint32_t ulInterruptNumber );
+
+	/*
+	 * Note the task selected by vTaskSwitchContext() in the journal, or check
+	 * it is the task the journal being replayed says was selected.
+	 */
+	static void prvJournalSwitchContext( void );
+
+	/*
+	 * Write a record, and the data that follows a portJOURNAL_KIND_DATA record, to
+	 * the journal buffer, and write the buffer to the journal file.
+	 */
+	static void prvJournalWrite( uint8_t ucKind, uint32_t ulValue );
+	static void prvJournalWriteBytes( const void *pvData, size_t xLength );
+	static void prvJournalFlush( void );
+
+	/*
+	 * Read the next record of the journal being replayed into ullNextRecordTime,
+	 * ucNextRecordKind and ulNextRecordValue, and read the data that follows a
+	 * portJOURNAL_KIND_DATA record.
+	 */
+	static void prvJournalReadNext( void );
+	static BaseType_t prvJournalReadBytes( void *pvData, size_t xLength );
+
+	/*
+	 * Returns pdTRUE if the next record of the journal being replayed is of
+	 * kind ucKind, and is due at the current sync point.  If it is not then the
+	 * replay has either reached the end of the journal, in which case the
+	 * simulation continues in real time, or has diverged from the recording.
+	 */
+	static BaseType_t prvJournalExpect( uint8_t ucKind, const char *pcWhat );
+
+	/*
+	 * Stop replaying the journal, and let the peripheral threads raise
+	 * interrupts again.
+	 */
+	static void prvJournalReplayComplete( void );
+
+	/*
+	 * Registered with atexit() so the end of the journal is written to the
+	 * file.
+	 */
+	static void prvJournalClose( void );
+
+#endif /* configUSE_JOURNAL */
+
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts waiting to be processed.  There is a bit map for each
+interrupt priority, in which each bit represents one interrupt, and bit n of
+ulPendingPriorities is set when an interrupt is pending at priority n - so the
+most urgent pending interrupt is found by looking for the lowest set bit in
+each in turn.  Interrupts are raised with an atomic OR, so raising an interrupt
+does not require a lock.  Only the simulated interrupt processing thread clears
+the bits. */
+static _Atomic uint32_t ulPendingInterrupts[ portINTERRUPT_PRIORITY_LEVELS ][ portPENDING_WORDS ];
+static _Atomic uint32_t ulPendingPriorities = 0UL;
+
+/* The priority of each interrupt, from 0 (the most urgent) to
+portINTERRUPT_PRIORITY_LEVELS - 1 (the least urgent). */
+static _Atomic uint8_t ucInterruptPriority[ portMAX_INTERRUPTS ];
+
+/* Incremented each time an interrupt more urgent than
+configMAX_SYSCALL_INTERRUPT_PRIORITY is raised, and each time the interrupt
+event mutex is released while an interrupt is pending.  The simulated interrupt
+processing thread waits for it to change when a critical section stops it
+processing the pending interrupts. */
+static _Atomic uint32_t ulInterruptEvents = 0UL;
+
+/* The number of threads waiting in prvWaitForPendingInterrupt() - the
+simulated interrupt processing thread, and the idle task while it sleeps in
+vPortSuppressTicksAndSleep() - and whether the simulated interrupt processing
+thread is waiting for ulInterruptEvents to change.  Let the threads that change
+them skip the wake up when nothing is waiting. */
+static atomic_int lPendingInterruptWaiters = 0;
+static atomic_int lInterruptEventWaiters = 0;
+
+#if !defined( __linux__ )
+	/* Used to wake waiting threads on hosts that do not have futexes.  The
+	mutex is only taken to wait and to wake. */
+	static pthread_mutex_t xPendingInterruptMutex = PTHREAD_MUTEX_INITIALIZER;
+	static pthread_cond_t xPendingInterruptEvent = PTHREAD_COND_INITIALIZER;
+#endif
+
+/* The equivalent of the BASEPRI register on an ARM Cortex-M: interrupts with a
+priority equal to or less urgent than uxInterruptMask are masked.  Only used by
+the simulated interrupt processing thread, as masking by a task is implemented
+by the task holding the interrupt event mutex. */
+static UBaseType_t uxInterruptMask = portINTERRUPTS_UNMASKED;
+
+/* The priority of the interrupt handler being executed, or
+portINTERRUPTS_UNMASKED if no handler is being executed.  Only a more urgent
+interrupt can preempt the handler. */
+static UBaseType_t uxActivePriority = portINTERRUPTS_UNMASKED;
+
+/* Set when an interrupt handler returns a non-zero value, so a context switch
+is needed once all the pending interrupts have been processed. */
+static BaseType_t xSwitchRequired = pdFALSE;
+
+/* pdTRUE in the simulated interrupt processing thread, which is the thread
+that calls xPortStartScheduler(). */
+static __thread BaseType_t xIsInterruptThread = pdFALSE;
+
+/* Recursive mutex held for the entire duration of a critical section, as in
+the Win32 port, and by the simulated interrupt processing thread while it
+processes interrupts - so interrupts are (simulated) disabled while it is
+held. */
+static pthread_mutex_t xInterruptEventMutex;
+
+/* The time at which the simulated timer next generates a tick, and the
+condition broadcast when vPortSuppressTicksAndSleep() changes that time.  Both
+are protected by xTimerMutex, which the timer thread only releases while it
+waits. */
+static struct timespec xNextTickTime;
+static pthread_cond_t xTimerEvent;
+static pthread_mutex_t xTimerMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Posted by a task thread from prvSuspendSignalHandler() once it has stopped
+executing task code. */
+static sem_t xSuspendAcknowledge;
+
+/* Ensures the objects above are only created once. */
+static pthread_once_t xSimulatedInterruptObjectsOnce = PTHREAD_ONCE_INIT;
+static BaseType_t xSimulatedInterruptObjectsCreated = pdFALSE;
+
+/* The critical nesting count for the currently executing task.  This is
+initialised to a non-zero value so interrupts do not become enabled during
+the initialisation phase. */
+static uint32_t ulCriticalNesting = 9999UL;
+
+/* Handlers for all the simulated software interrupts.  The first two positions
+are used for the Yield and Tick interrupts so are handled slightly differently,
+all the other interrupts can be user defined. */
+static uint32_t (*ulIsrHandler[ portMAX_INTERRUPTS ])( void ) = { 0 };
+
+/* Pointer to the TCB of the currently executing task. */
+extern void *pxCurrentTCB;
+
+/* Used to ensure nothing is processed during the startup sequence. */
+static BaseType_t xPortRunning = pdFALSE;
+
+/* The thread state of the task executed by the calling thread, or NULL if the
+calling thread is not a task thread (the simulated interrupt processing thread,
+the timer thread, or a thread created by the application to simulate a
+peripheral). */
+static __thread xThreadState *pxThreadStateOfThisThread = NULL;
+
+/* portJOURNAL_RECORD or portJOURNAL_REPLAY while a journal is open - see
+xPortJournalOpen(). */
+static volatile BaseType_t xJournalMode = portJOURNAL_OFF;
+
+#if( configUSE_JOURNAL == 1 )
+
+	/* The peripheral interrupts latched while a journal is recorded, waiting
+	for the next sync point.  Bit n of ulLatchedWords is set when an interrupt
+	is latched in ulLatchedInterrupts[ n ]. */
+	static _Atomic uint32_t ulLatchedInterrupts[ portPENDING_WORDS ];
+	static _Atomic uint32_t ulLatchedWords = 0UL;
+
+	/* The journal file, and the buffer through which it is written or read.
+	The journal is only accessed by the task in the Running state, or by the
+	simulated interrupt processing thread while that task is stopped, so it is
+	not otherwise protected. */
+	static int iJournalFile = -1;
+	static uint8_t ucJournalBuffer[ portJOURNAL_BUFFER_SIZE ];
+	static size_t xJournalBufferLength = 0U, xJournalBufferIndex = 0U;
+
+	/* The number of sync points passed, which is the clock against which
+	records are timed, and the sync point count of the last record written or
+	read. */
+	static uint64_t ullJournalTime = 0ULL, ullJournalRecordTime = 0ULL;
+
+	/* The next record of the journal being replayed. */
+	static uint64_t ullNextRecordTime = 0ULL;
+	static uint8_t ucNextRecordKind = portJOURNAL_KIND_END;
+	static uint32_t ulNextRecordValue = 0UL;
+
+	/* The number of tasks created, used to number them, and the number of
+	context switches written to or matched with the journal. */
+	static UBaseType_t uxTasksCreated = 0U;
+	static uint32_t ulJournalSwitches = 0UL;
+
+#endif /* configUSE_JOURNAL */
+
+/*-----------------------------------------------------------*/
+
+static void *prvSimulatedPeripheralTimer( void *pvParameter )
+{
+struct timespec xTimeNow;
+
+	/* Just to prevent compiler warnings. */
+	( void ) pvParameter;
+
+	/* The mutex is only released while waiting for the next tick time. */
+	pthread_mutex_lock( &xTimerMutex );
+
+	for( ;; )
+	{
+		/* Unlike the Win32 port the next tick time is relative to the previous
+		tick time, so the tick does not drift with the scheduling latency of
+		the host. */
+		prvAddNanoSeconds( &xNextTickTime, portTICK_PERIOD_NS );
+
+		/* Wait for the next tick time.  If vPortSuppressTicksAndSleep() moves
+		the tick time while this thread is waiting then xTimerEvent is
+		broadcast, and the wait is restarted with the new time. */
+		while( pthread_cond_timedwait( &xTimerEvent, &xTimerMutex, &xNextTickTime ) != ETIMEDOUT )
+		{
+			/* Woken before the tick time, wait again. */
+		}
+
+		/* If the host did not run this thread for more than a tick period then
+		drop the missed ticks rather than generating a burst of them - this is
+		a simulated environment, not a real time one. */
+		clock_gettime( CLOCK_MONOTONIC, &xTimeNow );
+		if( prvNanoSecondsBetween( &xNextTickTime, &xTimeNow ) > portTICK_PERIOD_NS )
+		{
+			xNextTickTime = xTimeNow;
+		}
+
+		configASSERT( xPortRunning );
+
+		/* The timer has expired, generate the simulated tick event.  The
+		simulated interrupt handler thread cannot obtain the interrupt event
+		mutex, and so cannot process the interrupt, until any critical section
+		has been exited. */
+		prvRaisePeripheralInterrupt( portINTERRUPT_TICK );
+	}
+
+	/* Should never reach here. */
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddNanoSeconds( struct timespec *pxTime, uint64_t ullNanoSeconds )
+{
+	pxTime->tv_sec += ( time_t ) ( ullNanoSeconds / ( uint64_t ) portNANO_SECONDS_PER_SECOND );
+	pxTime->tv_nsec += ( long ) ( ullNanoSeconds % ( uint64_t ) portNANO_SECONDS_PER_SECOND );
+
+	if( pxTime->tv_nsec >= portNANO_SECONDS_PER_SECOND )
+	{
+		pxTime->tv_nsec -= portNANO_SECONDS_PER_SECOND;
+		pxTime->tv_sec++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int64_t prvNanoSecondsBetween( const struct timespec *pxStart, const struct timespec *pxEnd )
+{
+	return ( ( int64_t ) ( pxEnd->tv_sec - pxStart->tv_sec ) * portNANO_SECONDS_PER_SECOND ) + ( int64_t ) ( pxEnd->tv_nsec - pxStart->tv_nsec );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRaiseInterrupt( uint32_t ulInterruptNumber )
+{
+uint32_t ulPriority = ( uint32_t ) atomic_load( &( ucInterruptPriority[ ulInterruptNumber ] ) );
+uint32_t ulPriorityBit = 1UL << ulPriority;
+
+	atomic_fetch_or( &( ulPendingInterrupts[ ulPriority ][ ulInterruptNumber / 32UL ] ), ( uint32_t ) ( 1UL << ( ulInterruptNumber % 32UL ) ) );
+
+	/* Only the interrupt that makes ulPendingPriorities non-zero has to wake a
+	waiting thread - a waiting thread does not take the interrupts, so any
+	raised after it was woken are still pending when it looks.  The waiter
+	count is read after the interrupt is set, and incremented by a waiting
+	thread before it tests ulPendingPriorities, so a wake up cannot be lost.
+
+	A task that raises a masked interrupt from within a critical section, as
+	xTaskNotifyWait() does to yield, leaves the wake up to
+	prvInterruptEventMutexReleased().  Waking the simulated interrupt processing
+	thread now would only see it fail to obtain the mutex and wait again. */
+	if( ( atomic_fetch_or( &ulPendingPriorities, ulPriorityBit ) == 0UL ) && ( atomic_load( &lPendingInterruptWaiters ) != 0 ) )
+	{
+		if( ( pxThreadStateOfThisThread == NULL ) || ( ulCriticalNesting == portNO_CRITICAL_NESTING ) || ( ulPriority < ( uint32_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY ) )
+		{
+			prvWakeAll( &ulPendingPriorities );
+		}
+	}
+
+	/* Interrupts more urgent than configMAX_SYSCALL_INTERRUPT_PRIORITY are
+	not masked by critical sections, so must also wake the simulated interrupt
+	processing thread if it is waiting for a critical section to end. */
+	if( ulPriority < ( uint32_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY )
+	{
+		atomic_fetch_add( &ulInterruptEvents, 1UL );
+
+		if( atomic_load( &lInterruptEventWaiters ) != 0 )
+		{
+			prvWakeAll( &ulInterruptEvents );
+		}
+
+		/* The interrupt that made ulPendingPriorities non-zero may have left
+		its wake up to the end of a critical section, which this interrupt
+		does not wait for. */
+		if( atomic_load( &lPendingInterruptWaiters ) != 0 )
+		{
+			prvWakeAll( &ulPendingPriorities );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRaisePeripheralInterrupt( uint32_t ulInterruptNumber )
+{
+	#if( configUSE_JOURNAL == 1 )
+	{
+		if( xJournalMode == portJOURNAL_RECORD )
+		{
+			prvLatchInterrupt( ulInterruptNumber );
+		}
+		else if( xJournalMode == portJOURNAL_OFF )
+		{
+			prvRaiseInterrupt( ulInterruptNumber );
+		}
+		else
+		{
+			/* The interrupts are raised from the journal being replayed. */
+		}
+	}
+	#else
+	{
+		prvRaiseInterrupt( ulInterruptNumber );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_VIRTUAL_TIME != 1 ) )
+
+	static BaseType_t prvInterruptIsPending( uint32_t ulInterruptNumber )
+	{
+	uint32_t ulPriority = ( uint32_t ) atomic_load( &( ucInterruptPriority[ ulInterruptNumber ] ) );
+
+		return ( ( atomic_load( &( ulPendingInterrupts[ ulPriority ][ ulInterruptNumber / 32UL ] ) ) & ( 1UL << ( ulInterruptNumber % 32UL ) ) ) != 0UL ) ? pdTRUE : pdFALSE;
+	}
+
+#endif /* configUSE_TICKLESS_IDLE, configUSE_VIRTUAL_TIME */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeInterrupt( uint32_t ulPriority, uint32_t *pulInterruptNumber )
+{
+uint32_t ulWord, ulPending;
+
+	for( ;; )
+	{
+		for( ulWord = 0UL; ulWord < portPENDING_WORDS; ulWord++ )
+		{
+			ulPending = atomic_load( &( ulPendingInterrupts[ ulPriority ][ ulWord ] ) );
+
+			if( ulPending != 0UL )
+			{
+				/* This is the only thread that clears the bits, so the bit
+				found is still set. */
+				ulPending &= ~( ulPending - 1UL );
+				atomic_fetch_and( &( ulPendingInterrupts[ ulPriority ][ ulWord ] ), ~ulPending );
+				*pulInterruptNumber = ( ulWord * 32UL ) + ( uint32_t ) __builtin_ctz( ulPending );
+				return pdTRUE;
+			}
+		}
+
+		/* Nothing is pending at this priority, so clear its bit in
+		ulPendingPriorities.  An interrupt raised between the bit maps being
+		read and the bit being cleared sets the bit again after the bit has
+		been cleared, so look again before giving up. */
+		atomic_fetch_and( &ulPendingPriorities, ~( 1UL << ulPriority ) );
+
+		for( ulWord = 0UL; ulWord < portPENDING_WORDS; ulWord++ )
+		{
+			if( atomic_load( &( ulPendingInterrupts[ ulPriority ][ ulWord ] ) ) != 0UL )
+			{
+				break;
+			}
+		}
+
+		if( ulWord == portPENDING_WORDS )
+		{
+			return pdFALSE;
+		}
+
+		atomic_fetch_or( &ulPendingPriorities, 1UL << ulPriority );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForPendingInterrupt( void )
+{
+	atomic_fetch_add( &lPendingInterruptWaiters, 1 );
+
+	while( atomic_load( &ulPendingPriorities ) == 0UL )
+	{
+		prvWaitForChange( &ulPendingPriorities, 0UL );
+	}
+
+	atomic_fetch_sub( &lPendingInterruptWaiters, 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptEventMutexReleased( void )
+{
+	if( atomic_load( &ulPendingPriorities ) != 0UL )
+	{
+		atomic_fetch_add( &ulInterruptEvents, 1UL );
+
+		if( atomic_load( &lInterruptEventWaiters ) != 0 )
+		{
+			prvWakeAll( &ulInterruptEvents );
+		}
+
+		/* Wake a thread that prvRaiseInterrupt() did not wake because the
+		interrupt was raised within the critical section just exited. */
+		if( atomic_load( &lPendingInterruptWaiters ) != 0 )
+		{
+			prvWakeAll( &ulPendingPriorities );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForChange( _Atomic uint32_t *pulValue, uint32_t ulValue )
+{
+	#if defined( __linux__ )
+	{
+		/* The futex only sleeps if *pulValue is still ulValue, so a change
+		made after the caller tested it is not missed. */
+		syscall( SYS_futex, pulValue, FUTEX_WAIT_PRIVATE, ulValue, NULL, NULL, 0 );
+	}
+	#else
+	{
+		pthread_mutex_lock( &xPendingInterruptMutex );
+
+		if( atomic_load( pulValue ) == ulValue )
+		{
+			pthread_cond_wait( &xPendingInterruptEvent, &xPendingInterruptMutex );
+		}
+
+		pthread_mutex_unlock( &xPendingInterruptMutex );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeAll( _Atomic uint32_t *pulValue )
+{
+	#if defined( __linux__ )
+	{
+		syscall( SYS_futex, pulValue, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0 );
+	}
+	#else
+	{
+		/* All the waiters share one condition variable. */
+		( void ) pulValue;
+		pthread_mutex_lock( &xPendingInterruptMutex );
+		pthread_cond_broadcast( &xPendingInterruptEvent );
+		pthread_mutex_unlock( &xPendingInterruptMutex );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateSimulatedInterruptObjects( void )
+{
+pthread_mutexattr_t xMutexAttributes;
+pthread_condattr_t xConditionAttributes;
+struct sigaction xSignalAction;
+uint32_t ulInterruptNumber;
+
+	/* Every interrupt has the same priority as the kernel's own interrupts
+	until vPortSetInterruptPriority() is called. */
+	for( ulInterruptNumber = 0UL; ulInterruptNumber < portMAX_INTERRUPTS; ulInterruptNumber++ )
+	{
+		atomic_init( &( ucInterruptPriority[ ulInterruptNumber ] ), ( uint8_t ) configKERNEL_INTERRUPT_PRIORITY );
+	}
+
+	/* The mutex must be recursive as critical sections nest. */
+	pthread_mutexattr_init( &xMutexAttributes );
+	pthread_mutexattr_settype( &xMutexAttributes, PTHREAD_MUTEX_RECURSIVE );
+	pthread_mutex_init( &xInterruptEventMutex, &xMutexAttributes );
+	pthread_mutexattr_destroy( &xMutexAttributes );
+
+	/* The simulated timer waits for absolute CLOCK_MONOTONIC times, so is not
+	affected by changes to the wall clock time. */
+	pthread_condattr_init( &xConditionAttributes );
+	pthread_condattr_setclock( &xConditionAttributes, CLOCK_MONOTONIC );
+	pthread_cond_init( &xTimerEvent, &xConditionAttributes );
+	pthread_condattr_destroy( &xConditionAttributes );
+
+	sem_init( &xSuspendAcknowledge, 0, 0 );
+
+	/* SA_RESTART ensures system calls made by a task, such as a write() to
+	the console made by printf(), are resumed when the task runs again. */
+	memset( &xSignalAction, 0, sizeof( xSignalAction ) );
+	xSignalAction.sa_handler = prvSuspendSignalHandler;
+	xSignalAction.sa_flags = SA_RESTART;
+	sigemptyset( &xSignalAction.sa_mask );
+	sigaddset( &xSignalAction.sa_mask, portRESUME_SIGNAL );
+	sigaction( portSUSPEND_SIGNAL, &xSignalAction, NULL );
+
+	xSignalAction.sa_handler = prvResumeSignalHandler;
+	sigaction( portRESUME_SIGNAL, &xSignalAction, NULL );
+
+	xSimulatedInterruptObjectsCreated = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTaskThreadEntry( void *pvParameter )
+{
+xThreadState *pxThreadState = ( xThreadState * ) pvParameter;
+sigset_t xSignals;
+
+	pxThreadStateOfThisThread = pxThreadState;
+
+	/* portSUSPEND_SIGNAL was blocked by pxPortInitialiseStack() until the
+	thread knew its own thread state.  portRESUME_SIGNAL remains blocked. */
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portSUSPEND_SIGNAL );
+	pthread_sigmask( SIG_UNBLOCK, &xSignals, NULL );
+
+	/* Don't start executing the task until the scheduler selects it. */
+	prvWaitUntilRunning( pxThreadState );
+
+	pxThreadState->pxCode( pxThreadState->pvParameters );
+
+	/* Tasks must not attempt to return from their implementing function. */
+	configASSERT( pdFALSE );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitUntilRunning( xThreadState *pxThreadState )
+{
+sigset_t xWaitSignals;
+
+	/* Wait with the current signal mask, less portRESUME_SIGNAL.  A resume
+	signal sent before the thread got as far as waiting is held pending, and
+	one can be left pending if the thread was selected to run then switched
+	out again before it waited - so the xRunning flag is the authority and the
+	signal is just the wake up mechanism.
+
+	portSUSPEND_SIGNAL is also removed from the mask as it is blocked when this
+	is called from prvSuspendSignalHandler().  The thread can be selected to
+	run, then stopped again by the next simulated interrupt, before it has
+	returned from the handler - in which case the second suspend signal must
+	still be acknowledged.  It is then handled by a nested call to the
+	handler. */
+	pthread_sigmask( SIG_BLOCK, NULL, &xWaitSignals );
+	sigdelset( &xWaitSignals, portRESUME_SIGNAL );
+	sigdelset( &xWaitSignals, portSUSPEND_SIGNAL );
+
+	while( atomic_load( &( pxThreadState->xRunning ) ) == pdFALSE )
+	{
+		sigsuspend( &xWaitSignals );
+
+		if( pxThreadState->xClosed != pdFALSE )
+		{
+			/* The task was deleted while this thread was parked - see
+			vPortDeleteThread(). */
+			pthread_exit( NULL );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendSignalHandler( int iSignal )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+int iSavedErrno = errno;
+
+	( void ) iSignal;
+
+	/* Let the simulated interrupt processing thread know this thread is no
+	longer executing task code, then wait to be selected again. */
+	sem_post( &xSuspendAcknowledge );
+	prvWaitUntilRunning( pxThreadState );
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeSignalHandler( int iSignal )
+{
+	( void ) iSignal;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeThread( xThreadState *pxThreadState )
+{
+static BaseType_t xResumeCount = 0;
+
+	/* Only called by the simulated interrupt processing thread. */
+	xResumeCount++;
+	if( xResumeCount == pdFALSE )
+	{
+		xResumeCount++;
+	}
+
+	atomic_store( &( pxThreadState->xRunning ), xResumeCount );
+	pthread_kill( pxThreadState->xThread, portRESUME_SIGNAL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForInterruptProcessing( void )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+BaseType_t xRunning;
+
+	for( ;; )
+	{
+		xRunning = atomic_load( &( pxThreadState->xRunning ) );
+
+		if( atomic_load( &ulPendingPriorities ) == 0UL )
+		{
+			/* The simulated interrupt processing thread has already stopped
+			this thread, processed the interrupts, and selected it to run
+			again. */
+			break;
+		}
+		else if( ( xRunning == pdFALSE ) || ( atomic_compare_exchange_strong( &( pxThreadState->xRunning ), &xRunning, pdFALSE ) != pdFALSE ) )
+		{
+			/* Either the simulated interrupt processing thread has cleared
+			xRunning and sent portSUSPEND_SIGNAL, which is handled when this
+			thread parks, or this thread cleared xRunning itself so will not be
+			signalled.  An interrupt is pending, so the simulated interrupt
+			processing thread has already been woken. */
+			prvWaitUntilRunning( pxThreadState );
+			break;
+		}
+		else
+		{
+			/* Stopped and resumed again between reading xRunning and
+			ulPendingPriorities, so the interrupts seen pending may since have
+			been processed.  Look again. */
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+xThreadState *pxThreadState = NULL;
+int8_t *pcTopOfStack = ( int8_t * ) pxTopOfStack;
+sigset_t xSignals, xOldSignals;
+int iResult;
+
+	( void ) pthread_once( &xSimulatedInterruptObjectsOnce, prvCreateSimulatedInterruptObjects );
+
+	/* In this simulated case a stack is not initialised, but instead a thread
+	is created that will execute the task being created.  The thread handles
+	the context switching itself.  The xThreadState object is placed onto
+	the stack that was created for the task - so the stack buffer is still
+	used, just not in the conventional way.  It will not be used for anything
+	other than holding this structure. */
+	pxThreadState = ( xThreadState * ) ( pcTopOfStack - sizeof( xThreadState ) );
+	pxThreadState->pxCode = pxCode;
+	pxThreadState->pvParameters = pvParameters;
+	atomic_init( &( pxThreadState->xRunning ), pdFALSE );
+	pxThreadState->xClosed = pdFALSE;
+
+	#if( configUSE_JOURNAL == 1 )
+	{
+		pxThreadState->uxJournalNumber = uxTasksCreated++;
+	}
+	#endif
+
+	/* Create the thread itself.  It parks itself until it is selected to run
+	by the simulated interrupt processing thread.  The thread inherits a mask
+	that blocks portSUSPEND_SIGNAL so the signal cannot be handled before the
+	thread has recorded its thread state. */
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portSUSPEND_SIGNAL );
+	sigaddset( &xSignals, portRESUME_SIGNAL );
+	pthread_sigmask( SIG_BLOCK, &xSignals, &xOldSignals );
+	iResult = pthread_create( &( pxThreadState->xThread ), NULL, prvTaskThreadEntry, pxThreadState );
+	pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+	configASSERT( iResult == 0 ); /* See comment where pthread_join() is called. */
+	( void ) iResult;
+
+	return ( StackType_t * ) pxThreadState;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+pthread_t xTimerThread;
+int32_t lSuccess = pdPASS;
+
+	/* Install the interrupt handlers used by the scheduler itself. */
+	vPortSetInterruptHandler( portINTERRUPT_YIELD, prvProcessYieldInterrupt );
+	vPortSetInterruptHandler( portINTERRUPT_TICK, prvProcessTickInterrupt );
+
+	/* Create the mutex, semaphore and signal handler used to synchronise all
+	the threads, if no task has done so already. */
+	( void ) pthread_once( &xSimulatedInterruptObjectsOnce, prvCreateSimulatedInterruptObjects );
+
+	/* Start the thread that simulates the timer peripheral to generate tick
+	interrupts.  The first tick time is set here, rather than by the thread,
+	as the idle task can run before the thread does. */
+	clock_gettime( CLOCK_MONOTONIC, &xNextTickTime );
+	if( pthread_create( &xTimerThread, NULL, prvSimulatedPeripheralTimer, NULL ) != 0 )
+	{
+		lSuccess = pdFAIL;
+	}
+
+	if( lSuccess == pdPASS )
+	{
+		ulCriticalNesting = portNO_CRITICAL_NESTING;
+		xIsInterruptThread = pdTRUE;
+
+		/* Handle all simulated interrupts - including yield requests and
+		simulated ticks.  The task selected by vTaskStartScheduler() is
+		started when the first tick is processed. */
+		prvProcessSimulatedInterrupts();
+	}
+
+	/* Would not expect to return from prvProcessSimulatedInterrupts(), so should
+	not get here. */
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvProcessYieldInterrupt( void )
+{
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvProcessTickInterrupt( void )
+{
+uint32_t ulSwitchRequired;
+
+	/* Process the tick itself. */
+	configASSERT( xPortRunning );
+	ulSwitchRequired = ( uint32_t ) xTaskIncrementTick();
+
+	return ulSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessSimulatedInterrupts( void )
+{
+uint32_t ulEvents;
+
+	/* Create a pending tick to ensure the first task is started as soon as
+	this thread waits. */
+	prvRaiseInterrupt( portINTERRUPT_TICK );
+
+	xPortRunning = pdTRUE;
+
+	for(;;)
+	{
+		/* Wait for an interrupt without holding the mutex. */
+		prvWaitForPendingInterrupt();
+
+		/* Read before trying the mutex, so the mutex being released after the
+		attempt to obtain it fails is not missed. */
+		ulEvents = atomic_load( &ulInterruptEvents );
+
+		if( pthread_mutex_trylock( &xInterruptEventMutex ) == 0 )
+		{
+			/* No task is in a critical section, so all the pending interrupts
+			can be processed, most urgent first. */
+			prvStopRunningThread();
+
+			xSwitchRequired = pdFALSE;
+			prvServiceInterrupts();
+
+			if( xSwitchRequired != pdFALSE )
+			{
+				/* Select the next task to run. */
+				vTaskSwitchContext();
+
+				#if( configUSE_JOURNAL == 1 )
+				{
+					if( xJournalMode != portJOURNAL_OFF )
+					{
+						prvJournalSwitchContext();
+					}
+				}
+				#endif
+			}
+
+			/* Let the thread of the task now in the Running state continue.
+			This is the thread that was stopped above if no context switch
+			occurred. */
+			prvResumeThread( ( xThreadState * ) *( ( size_t * ) pxCurrentTCB ) );
+			pthread_mutex_unlock( &xInterruptEventMutex );
+		}
+		else if( ( ( atomic_load( &ulPendingPriorities ) & ( uint32_t ) ( ( 1ULL << configMAX_SYSCALL_INTERRUPT_PRIORITY ) - 1ULL ) ) != 0UL ) && ( xJournalMode == portJOURNAL_OFF ) )
+		{
+			/* A task is in a critical section, which only masks interrupts at
+			configMAX_SYSCALL_INTERRUPT_PRIORITY and less urgent, and a more
+			urgent interrupt is pending.  Preempt the task to run it, then let
+			the task finish the critical section.  The task does not need to be
+			restarted if it had already stopped itself.  Not done while a
+			journal is open, as where the task stopped would then depend on
+			host timing. */
+			if( prvStopRunningThread() != pdFALSE )
+			{
+				xSwitchRequired = pdFALSE;
+				uxInterruptMask = ( UBaseType_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY;
+				prvServiceInterrupts();
+				uxInterruptMask = portINTERRUPTS_UNMASKED;
+
+				/* These handlers must not use the FreeRTOS API, so should not
+				need a context switch - but if one does then perform it once the
+				critical section has been exited. */
+				if( xSwitchRequired != pdFALSE )
+				{
+					prvRaiseInterrupt( portINTERRUPT_YIELD );
+				}
+
+				prvResumeThread( ( xThreadState * ) *( ( size_t * ) pxCurrentTCB ) );
+			}
+		}
+		else
+		{
+			/* Only masked interrupts are pending.  Wait for the critical
+			section to end, or for a more urgent interrupt. */
+			atomic_store( &lInterruptEventWaiters, 1 );
+			prvWaitForChange( &ulInterruptEvents, ulEvents );
+			atomic_store( &lInterruptEventWaiters, 0 );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvServiceInterrupts( void )
+{
+UBaseType_t uxPreemptedPriority = uxActivePriority, uxLimit;
+uint32_t ulPriorities, ulPriority, ulInterruptNumber;
+
+	for( ;; )
+	{
+		/* Only interrupts more urgent than both the handler that is executing
+		and the interrupt mask can be taken. */
+		uxLimit = ( uxPreemptedPriority < uxInterruptMask ) ? uxPreemptedPriority : uxInterruptMask;
+		ulPriorities = atomic_load( &ulPendingPriorities ) & ( uint32_t ) ( ( 1ULL << uxLimit ) - 1ULL );
+
+		if( ulPriorities == 0UL )
+		{
+			break;
+		}
+
+		/* Find the most urgent priority at which an interrupt is pending. */
+		ulPriority = ( uint32_t ) __builtin_ctz( ulPriorities );
+
+		if( prvTakeInterrupt( ulPriority, &ulInterruptNumber ) != pdFALSE )
+		{
+			if( ulIsrHandler[ ulInterruptNumber ] != NULL )
+			{
+				/* Run the actual handler.  It can be preempted by a more
+				urgent interrupt when it calls back into the port. */
+				uxActivePriority = ( UBaseType_t ) ulPriority;
+
+				if( ulIsrHandler[ ulInterruptNumber ]() != pdFALSE )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+
+				uxActivePriority = uxPreemptedPriority;
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvStopRunningThread( void )
+{
+xThreadState *pxThreadState = ( xThreadState * ) *( ( size_t * ) pxCurrentTCB );
+BaseType_t xWasRunning = pdFALSE;
+
+	if( atomic_exchange( &( pxThreadState->xRunning ), pdFALSE ) != pdFALSE )
+	{
+		pthread_kill( pxThreadState->xThread, portSUSPEND_SIGNAL );
+
+		while( sem_wait( &xSuspendAcknowledge ) != 0 )
+		{
+			/* Interrupted by a signal, wait again. */
+		}
+
+		xWasRunning = pdTRUE;
+	}
+
+	return xWasRunning;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDeleteThread( void *pvTaskToDelete )
+{
+xThreadState *pxThreadState;
+int iErrorCode;
+
+	/* Remove compiler warnings if configASSERT() is not defined. */
+	( void ) iErrorCode;
+
+	/* Find the thread state of the task being deleted. */
+	pxThreadState = ( xThreadState * ) ( *( size_t *) pvTaskToDelete );
+
+	/* Check that the thread is still valid, it might have been closed by
+	vPortCloseRunningThread() - which will be the case if the task associated
+	with the thread originally deleted itself rather than being deleted by a
+	different task. */
+	if( pxThreadState->xClosed == pdFALSE )
+	{
+		/* The task is not in the Running state, so its thread is parked, or
+		about to park, in prvWaitUntilRunning() - neither of which requires
+		the interrupt event mutex.  Wake it so it exits, then wait for it to
+		do so as its xThreadState is about to be freed along with the task
+		stack.  As with the Win32 port this is not a nice way to terminate a
+		thread - a thread that was stopped part way through a C library call
+		may leave a C library lock held. */
+		pxThreadState->xClosed = pdTRUE;
+		pthread_kill( pxThreadState->xThread, portRESUME_SIGNAL );
+
+		iErrorCode = pthread_join( pxThreadState->xThread, NULL );
+		configASSERT( iErrorCode == 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortCloseRunningThread( void *pvTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+xThreadState *pxThreadState;
+
+	/* Find the thread state of the task being deleted. */
+	pxThreadState = ( xThreadState * ) ( *( size_t *) pvTaskToDelete );
+
+	/* This function will not return, therefore a yield is set as pending to
+	ensure a context switch occurs away from this thread as soon as the
+	critical section is exited below. */
+	*pxPendYield = pdTRUE;
+	prvRaiseInterrupt( portINTERRUPT_YIELD );
+
+	/* Mark the thread associated with this task as invalid so
+	vPortDeleteThread() does not try to terminate it, and as not running so
+	the simulated interrupt processing thread does not try to stop it. */
+	pxThreadState->xClosed = pdTRUE;
+	atomic_store( &( pxThreadState->xRunning ), pdFALSE );
+	pthread_detach( pthread_self() );
+
+	/* This is called from a critical section, which must be exited before the
+	thread stops.  The mutex is released once for each nesting level as it
+	would otherwise be left locked by a thread that no longer exists. */
+	while( ulCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		ulCriticalNesting--;
+		pthread_mutex_unlock( &xInterruptEventMutex );
+	}
+
+	prvInterruptEventMutexReleased();
+
+	pthread_exit( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* This function IS NOT TESTED! */
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber )
+{
+	configASSERT( xPortRunning );
+
+	#if( configUSE_JOURNAL == 1 )
+	{
+		/* While a journal is open only the simulated interrupt processing
+		thread raises interrupts directly. */
+		if( ( xJournalMode != portJOURNAL_OFF ) && ( xIsInterruptThread == pdFALSE ) && ( ulInterruptNumber < portMAX_INTERRUPTS ) )
+		{
+			prvJournalGenerateInterrupt( ulInterruptNumber );
+			return;
+		}
+	}
+	#endif
+
+	if( ( ulInterruptNumber < portMAX_INTERRUPTS ) && ( xSimulatedInterruptObjectsCreated != pdFALSE ) )
+	{
+		/* Raising the interrupt does not need the interrupt event mutex.
+		The simulated interrupt processing thread cannot process it until any
+		critical section has been exited, unless it is more urgent than
+		configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+		prvRaiseInterrupt( ulInterruptNumber );
+
+		/* An interrupt raised by a handler preempts that handler straight
+		away if it is more urgent, as it would on the hardware. */
+		if( ( xIsInterruptThread != pdFALSE ) && ( uxActivePriority != portINTERRUPTS_UNMASKED ) )
+		{
+			prvServiceInterrupts();
+		}
+
+		/* The simulated interrupt is now held pending, but don't wait for it
+		to be processed if this call is within a critical section.  It is
+		possible for this to be in a critical section as calls to wait for
+		mutexes are accumulative.  Only the task in the Running state changes
+		the critical nesting count, so it can be read here without the
+		mutex. */
+		if( ( pxThreadStateOfThisThread != NULL ) && ( ulCriticalNesting == portNO_CRITICAL_NESTING ) )
+		{
+			/* Called by a task, which must not continue until the interrupt
+			has been processed. */
+			prvWaitForInterruptProcessing();
+		}
+		else
+		{
+			/* Called from a simulated interrupt handler, from a thread that
+			simulates a peripheral, or from within a critical section. */
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t (*pvHandler)( void ) )
+{
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		if( xSimulatedInterruptObjectsCreated != pdFALSE )
+		{
+			pthread_mutex_lock( &xInterruptEventMutex );
+			ulIsrHandler[ ulInterruptNumber ] = pvHandler;
+			pthread_mutex_unlock( &xInterruptEventMutex );
+			prvInterruptEventMutexReleased();
+		}
+		else
+		{
+			ulIsrHandler[ ulInterruptNumber ] = pvHandler;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptPriority( uint32_t ulInterruptNumber, uint32_t ulPriority )
+{
+	/* The kernel's own interrupts use the FreeRTOS API, so must not be more
+	urgent than configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+	configASSERT( ulPriority < ( uint32_t ) portINTERRUPT_PRIORITY_LEVELS );
+	configASSERT( ( ulInterruptNumber > portINTERRUPT_TICK ) || ( ulPriority >= ( uint32_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY ) );
+
+	/* The priorities are initialised with the other shared objects, which may
+	not have been created yet. */
+	( void ) pthread_once( &xSimulatedInterruptObjectsOnce, prvCreateSimulatedInterruptObjects );
+
+	if( ( ulInterruptNumber < portMAX_INTERRUPTS ) && ( ulPriority < ( uint32_t ) portINTERRUPT_PRIORITY_LEVELS ) )
+	{
+		/* An interrupt that is already pending is processed at its old
+		priority. */
+		atomic_store( &( ucInterruptPriority[ ulInterruptNumber ] ), ( uint8_t ) ulPriority );
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMaskFromISR( void )
+{
+UBaseType_t uxPreviousMask = uxInterruptMask;
+
+	/* Only interrupt handlers mask interrupts this way - a task calling a
+	FromISR function is left to its critical sections, as in the Win32
+	port. */
+	if( xIsInterruptThread != pdFALSE )
+	{
+		if( uxInterruptMask > ( UBaseType_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY )
+		{
+			uxInterruptMask = ( UBaseType_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY;
+		}
+	}
+
+	return uxPreviousMask;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMaskFromISR( UBaseType_t uxNewMask )
+{
+	if( xIsInterruptThread != pdFALSE )
+	{
+		uxInterruptMask = uxNewMask;
+
+		/* Lowering the mask lets a more urgent interrupt that was raised while
+		it was masked preempt the handler that is executing. */
+		if( uxActivePriority != portINTERRUPTS_UNMASKED )
+		{
+			prvServiceInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortValidateInterruptPriority( void )
+{
+	/* Interrupts that are more urgent than configMAX_SYSCALL_INTERRUPT_PRIORITY
+	are not masked by critical sections, so their handlers must not call
+	FreeRTOS API functions. */
+	if( ( xIsInterruptThread != pdFALSE ) && ( uxActivePriority != portINTERRUPTS_UNMASKED ) )
+	{
+		configASSERT( uxActivePriority >= ( UBaseType_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	if( xPortRunning == pdTRUE )
+	{
+		/* The interrupt event mutex is held for the entire critical section,
+		effectively disabling (simulated) interrupts. */
+		pthread_mutex_lock( &xInterruptEventMutex );
+		ulCriticalNesting++;
+	}
+	else
+	{
+		ulCriticalNesting++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	/* The interrupt event mutex should already be held by this thread as it was
+	obtained on entry to the critical section. */
+	if( ulCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		ulCriticalNesting--;
+
+		if( xPortRunning == pdTRUE )
+		{
+			#if( configUSE_JOURNAL == 1 )
+			{
+				/* The end of a task's outermost critical section is a sync
+				point.  The mutex is still held, so the interrupts raised here
+				cannot be processed before the journal has been written. */
+				if( ( ulCriticalNesting == portNO_CRITICAL_NESTING ) && ( pxThreadStateOfThisThread != NULL ) && ( xJournalMode != portJOURNAL_OFF ) )
+				{
+					prvJournalSyncPoint();
+				}
+			}
+			#endif
+
+			pthread_mutex_unlock( &xInterruptEventMutex );
+
+			if( ulCriticalNesting == portNO_CRITICAL_NESTING )
+			{
+				prvInterruptEventMutexReleased();
+
+				/* Were any interrupts set to pending while interrupts were
+				(simulated) disabled?  If so, and this is a task, then the task
+				must not continue until they have been processed. */
+				if( ( pxThreadStateOfThisThread != NULL ) && ( atomic_load( &ulPendingPriorities ) != 0UL ) )
+				{
+					prvWaitForInterruptProcessing();
+				}
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_JOURNAL == 1 )
+
+	BaseType_t xPortJournalOpen( const char *pcFileName, BaseType_t xReplay )
+	{
+	char cMagic[ sizeof( portJOURNAL_MAGIC ) - 1U ];
+	BaseType_t xReturn = pdFAIL;
+
+		/* The journal must be opened before the scheduler is started, so every
+		interrupt is journaled. */
+		configASSERT( xPortRunning == pdFALSE );
+		configASSERT( iJournalFile < 0 );
+
+		if( xReplay != pdFALSE )
+		{
+			iJournalFile = open( pcFileName, O_RDONLY );
+
+			if( iJournalFile >= 0 )
+			{
+				if( ( prvJournalReadBytes( cMagic, sizeof( cMagic ) ) != pdFALSE ) && ( memcmp( cMagic, portJOURNAL_MAGIC, sizeof( cMagic ) ) == 0 ) )
+				{
+					xJournalMode = portJOURNAL_REPLAY;
+					prvJournalReadNext();
+					xReturn = pdPASS;
+				}
+				else
+				{
+					close( iJournalFile );
+					iJournalFile = -1;
+				}
+			}
+		}
+		else
+		{
+			iJournalFile = open( pcFileName, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+			if( iJournalFile >= 0 )
+			{
+				xJournalMode = portJOURNAL_RECORD;
+				prvJournalWriteBytes( portJOURNAL_MAGIC, sizeof( cMagic ) );
+				xReturn = pdPASS;
+			}
+		}
+
+		if( xReturn == pdPASS )
+		{
+			atexit( prvJournalClose );
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xPortJournalReplaying( void )
+	{
+		return ( xJournalMode == portJOURNAL_REPLAY ) ? pdTRUE : pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortJournalData( void *pvData, size_t xLength )
+	{
+		/* Only one thread at a time can access the journal - see the comment
+		where iJournalFile is defined. */
+		configASSERT( ( xIsInterruptThread != pdFALSE ) || ( ulCriticalNesting != portNO_CRITICAL_NESTING ) || ( xPortRunning == pdFALSE ) );
+
+		if( xJournalMode == portJOURNAL_RECORD )
+		{
+			prvJournalWrite( portJOURNAL_KIND_DATA, ( uint32_t ) xLength );
+			prvJournalWriteBytes( pvData, xLength );
+		}
+		else if( xJournalMode == portJOURNAL_REPLAY )
+		{
+			/* Overwrite the data with the data that was recorded. */
+			if( prvJournalExpect( portJOURNAL_KIND_DATA, "host data" ) != pdFALSE )
+			{
+				if( ( ulNextRecordValue != ( uint32_t ) xLength ) || ( prvJournalReadBytes( pvData, xLength ) == pdFALSE ) )
+				{
+					fprintf( stderr, "Journal replay diverged at sync point %llu: the host data does not match the journal.\n", ( unsigned long long ) ullJournalTime );
+					configASSERT( pdFALSE );
+				}
+
+				prvJournalReadNext();
+			}
+		}
+		else
+		{
+			/* No journal is open, so the data is used as it is. */
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvLatchInterrupt( uint32_t ulInterruptNumber )
+	{
+		atomic_fetch_or( &( ulLatchedInterrupts[ ulInterruptNumber / 32UL ] ), ( uint32_t ) ( 1UL << ( ulInterruptNumber % 32UL ) ) );
+
+		if( atomic_fetch_or( &ulLatchedWords, ( uint32_t ) ( 1UL << ( ulInterruptNumber / 32UL ) ) ) == 0UL )
+		{
+			prvWakeAll( &ulLatchedWords );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	#if( ( configUSE_TICKLESS_IDLE != 0 ) && ( configUSE_VIRTUAL_TIME != 1 ) )
+
+		static BaseType_t prvInterruptIsLatched( uint32_t ulInterruptNumber )
+		{
+			return ( ( atomic_load( &( ulLatchedInterrupts[ ulInterruptNumber / 32UL ] ) ) & ( 1UL << ( ulInterruptNumber % 32UL ) ) ) != 0UL ) ? pdTRUE : pdFALSE;
+		}
+
+	#endif /* configUSE_TICKLESS_IDLE, configUSE_VIRTUAL_TIME */
+	/*-----------------------------------------------------------*/
+
+	static void prvWaitForLatchedInterrupt( void )
+	{
+		while( atomic_load( &ulLatchedWords ) == 0UL )
+		{
+			prvWaitForChange( &ulLatchedWords, 0UL );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalSyncPoint( void )
+	{
+	uint32_t ulWords, ulWord, ulLatched, ulInterruptNumber;
+
+		ullJournalTime++;
+
+		if( xJournalMode == portJOURNAL_RECORD )
+		{
+			/* Raise the latched interrupts, lowest number first.  An interrupt
+			latched while they are being taken is either taken too, or left
+			latched for the next sync point. */
+			ulWords = atomic_exchange( &ulLatchedWords, 0UL );
+
+			while( ulWords != 0UL )
+			{
+				ulWord = ( uint32_t ) __builtin_ctz( ulWords );
+				ulWords &= ulWords - 1UL;
+				ulLatched = atomic_exchange( &( ulLatchedInterrupts[ ulWord ] ), 0UL );
+
+				while( ulLatched != 0UL )
+				{
+					ulInterruptNumber = ( ulWord * 32UL ) + ( uint32_t ) __builtin_ctz( ulLatched );
+					ulLatched &= ulLatched - 1UL;
+
+					prvJournalWrite( portJOURNAL_KIND_INTERRUPT, ulInterruptNumber );
+					prvRaiseInterrupt( ulInterruptNumber );
+				}
+			}
+		}
+		else
+		{
+			while( prvJournalExpect( portJOURNAL_KIND_INTERRUPT, NULL ) != pdFALSE )
+			{
+				prvRaiseInterrupt( ulNextRecordValue );
+				prvJournalReadNext();
+			}
+
+			/* Any other record due by now should have been read when the
+			event it records happened. */
+			if( ( xJournalMode == portJOURNAL_REPLAY ) && ( ucNextRecordKind != portJOURNAL_KIND_END ) && ( ullNextRecordTime < ullJournalTime ) )
+			{
+				fprintf( stderr, "Journal replay diverged at sync point %llu: an event recorded at sync point %llu did not happen.\n", ( unsigned long long ) ullJournalTime, ( unsigned long long ) ullNextRecordTime );
+				configASSERT( pdFALSE );
+			}
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvJournalInterruptsDue( void )
+	{
+	BaseType_t xReturn;
+
+		if( xJournalMode == portJOURNAL_RECORD )
+		{
+			xReturn = ( atomic_load( &ulLatchedWords ) != 0UL ) ? pdTRUE : pdFALSE;
+		}
+		else
+		{
+			/* Also pdTRUE if the end of the journal has been reached, or a
+			record is overdue, so prvJournalSyncPoint() can report it. */
+			if( ( ucNextRecordKind == portJOURNAL_KIND_END ) || ( ullNextRecordTime <= ullJournalTime ) )
+			{
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = ( ( ucNextRecordKind == portJOURNAL_KIND_INTERRUPT ) && ( ullNextRecordTime == ( ullJournalTime + 1ULL ) ) ) ? pdTRUE : pdFALSE;
+			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalGenerateInterrupt( uint32_t ulInterruptNumber )
+	{
+		if( pxThreadStateOfThisThread == NULL )
+		{
+			/* A peripheral thread, which runs in parallel with the tasks. */
+			prvRaisePeripheralInterrupt( ulInterruptNumber );
+		}
+		else if( ulCriticalNesting == portNO_CRITICAL_NESTING )
+		{
+			/* A task that is not in a critical section, so this is a sync
+			point. */
+			if( prvJournalInterruptsDue() == pdFALSE )
+			{
+				/* Usually nothing else is raised at the sync point, so the
+				interrupt event mutex is not needed - the simulated interrupt
+				processing thread does not access the journal while a task is
+				running outside a critical section.  Taking the mutex straight
+				after the task was resumed would usually mean waiting for the
+				simulated interrupt processing thread to release it. */
+				ullJournalTime++;
+				prvRaiseInterrupt( ulInterruptNumber );
+				prvWaitForInterruptProcessing();
+			}
+			else
+			{
+				/* Raise the interrupt from a critical section, so it is
+				processed along with the interrupts raised at the sync point
+				that ends the critical section. */
+				vPortEnterCritical();
+				prvRaiseInterrupt( ulInterruptNumber );
+				vPortExitCritical();
+			}
+		}
+		else
+		{
+			/* A task within a critical section.  The interrupt is processed
+			at the sync point that ends the critical section. */
+			prvRaiseInterrupt( ulInterruptNumber );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalSwitchContext( void )
+	{
+	UBaseType_t uxTaskNumber = ( ( xThreadState * ) *( ( size_t * ) pxCurrentTCB ) )->uxJournalNumber;
+
+		if( xJournalMode == portJOURNAL_RECORD )
+		{
+			prvJournalWrite( portJOURNAL_KIND_SWITCH, ( uint32_t ) uxTaskNumber );
+			ulJournalSwitches++;
+		}
+		else if( prvJournalExpect( portJOURNAL_KIND_SWITCH, "a context switch" ) != pdFALSE )
+		{
+			if( ulNextRecordValue != ( uint32_t ) uxTaskNumber )
+			{
+				fprintf( stderr, "Journal replay diverged at sync point %llu: task %u was selected to run, not task %u.\n", ( unsigned long long ) ullJournalTime, ( unsigned ) uxTaskNumber, ( unsigned ) ulNextRecordValue );
+				configASSERT( pdFALSE );
+			}
+
+			ulJournalSwitches++;
+			prvJournalReadNext();
+		}
+		else
+		{
+			/* The end of the journal was reached. */
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalWrite( uint8_t ucKind, uint32_t ulValue )
+	{
+	uint64_t ullNumber = ullJournalTime - ullJournalRecordTime;
+
+		if( xJournalBufferLength > ( portJOURNAL_BUFFER_SIZE - portJOURNAL_MAX_RECORD_SIZE ) )
+		{
+			prvJournalFlush();
+		}
+
+		ullJournalRecordTime = ullJournalTime;
+
+		/* The sync point count, then the kind, then the value - each number
+		seven bits to a byte, least significant first, with the top bit set in
+		all but the last byte. */
+		while( ullNumber >= 0x80ULL )
+		{
+			ucJournalBuffer[ xJournalBufferLength++ ] = ( uint8_t ) ( ullNumber | 0x80ULL );
+			ullNumber >>= 7;
+		}
+		ucJournalBuffer[ xJournalBufferLength++ ] = ( uint8_t ) ullNumber;
+
+		ucJournalBuffer[ xJournalBufferLength++ ] = ucKind;
+
+		while( ulValue >= 0x80UL )
+		{
+			ucJournalBuffer[ xJournalBufferLength++ ] = ( uint8_t ) ( ulValue | 0x80UL );
+			ulValue >>= 7;
+		}
+		ucJournalBuffer[ xJournalBufferLength++ ] = ( uint8_t ) ulValue;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalWriteBytes( const void *pvData, size_t xLength )
+	{
+	const uint8_t *pucData = ( const uint8_t * ) pvData;
+	size_t xBytes;
+
+		while( xLength > 0U )
+		{
+			if( xJournalBufferLength == portJOURNAL_BUFFER_SIZE )
+			{
+				prvJournalFlush();
+			}
+
+			xBytes = portJOURNAL_BUFFER_SIZE - xJournalBufferLength;
+			if( xBytes > xLength )
+			{
+				xBytes = xLength;
+			}
+
+			memcpy( &( ucJournalBuffer[ xJournalBufferLength ] ), pucData, xBytes );
+			xJournalBufferLength += xBytes;
+			pucData += xBytes;
+			xLength -= xBytes;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalFlush( void )
+	{
+	size_t xWritten = 0U;
+	ssize_t xResult;
+
+		/* The journal is written whenever the buffer fills and whenever the
+		idle task sleeps, so it can be streamed to disk without blocking the
+		tasks for long. */
+		while( xWritten < xJournalBufferLength )
+		{
+			xResult = write( iJournalFile, &( ucJournalBuffer[ xWritten ] ), xJournalBufferLength - xWritten );
+
+			if( xResult > 0 )
+			{
+				xWritten += ( size_t ) xResult;
+			}
+			else if( errno != EINTR )
+			{
+				fprintf( stderr, "Journal could not be written (%s).\n", strerror( errno ) );
+				break;
+			}
+		}
+
+		xJournalBufferLength = 0U;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvJournalReadBytes( void *pvData, size_t xLength )
+	{
+	uint8_t *pucData = ( uint8_t * ) pvData;
+	ssize_t xResult;
+	BaseType_t xReturn = pdTRUE;
+
+		while( ( xLength > 0U ) && ( xReturn != pdFALSE ) )
+		{
+			if( xJournalBufferIndex == xJournalBufferLength )
+			{
+				do
+				{
+					xResult = read( iJournalFile, ucJournalBuffer, portJOURNAL_BUFFER_SIZE );
+				} while( ( xResult < 0 ) && ( errno == EINTR ) );
+
+				xJournalBufferIndex = 0U;
+				xJournalBufferLength = ( xResult > 0 ) ? ( size_t ) xResult : 0U;
+
+				if( xJournalBufferLength == 0U )
+				{
+					xReturn = pdFALSE;
+				}
+			}
+			else
+			{
+				*pucData++ = ucJournalBuffer[ xJournalBufferIndex++ ];
+				xLength--;
+			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalReadNext( void )
+	{
+	uint64_t ullNumber[ 2 ];
+	uint8_t ucByte = 0U, ucKind = portJOURNAL_KIND_END;
+	BaseType_t xNumber, xShift, xComplete = pdTRUE;
+
+		/* The sync point count, then the kind, then the value - as written by
+		prvJournalWrite(). */
+		for( xNumber = 0; ( xNumber < 2 ) && ( xComplete != pdFALSE ); xNumber++ )
+		{
+			ullNumber[ xNumber ] = 0ULL;
+			xShift = 0;
+
+			do
+			{
+				xComplete = prvJournalReadBytes( &ucByte, sizeof( ucByte ) );
+				ullNumber[ xNumber ] |= ( uint64_t ) ( ucByte & 0x7fU ) << xShift;
+				xShift += 7;
+			} while( ( xComplete != pdFALSE ) && ( ( ucByte & 0x80U ) != 0U ) && ( xShift < 64 ) );
+
+			if( ( xComplete != pdFALSE ) && ( xNumber == 0 ) )
+			{
+				xComplete = prvJournalReadBytes( &ucKind, sizeof( ucKind ) );
+			}
+		}
+
+		if( xComplete != pdFALSE )
+		{
+			ullJournalRecordTime += ullNumber[ 0 ];
+			ullNextRecordTime = ullJournalRecordTime;
+			ucNextRecordKind = ucKind;
+			ulNextRecordValue = ( uint32_t ) ullNumber[ 1 ];
+		}
+		else
+		{
+			ucNextRecordKind = portJOURNAL_KIND_END;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvJournalExpect( uint8_t ucKind, const char *pcWhat )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		if( xJournalMode == portJOURNAL_REPLAY )
+		{
+			if( ucNextRecordKind == portJOURNAL_KIND_END )
+			{
+				prvJournalReplayComplete();
+			}
+			else if( ( ucNextRecordKind == ucKind ) && ( ullNextRecordTime == ullJournalTime ) )
+			{
+				xReturn = pdTRUE;
+			}
+			else if( pcWhat != NULL )
+			{
+				fprintf( stderr, "Journal replay diverged at sync point %llu: %s was not recorded here.\n", ( unsigned long long ) ullJournalTime, pcWhat );
+				configASSERT( pdFALSE );
+			}
+			else
+			{
+				/* The event is optional. */
+			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalReplayComplete( void )
+	{
+		fprintf( stderr, "Journal replay complete: %lu context switches matched in %llu sync points.  Continuing in real time.\n", ( unsigned long ) ulJournalSwitches, ( unsigned long long ) ullJournalTime );
+
+		/* From the next tick on the timer and peripheral threads raise
+		interrupts directly again. */
+		xJournalMode = portJOURNAL_OFF;
+		close( iJournalFile );
+		iJournalFile = -1;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvJournalClose( void )
+	{
+		if( xJournalMode == portJOURNAL_RECORD )
+		{
+			prvJournalFlush();
+			close( iJournalFile );
+			fprintf( stderr, "Journal recorded: %lu context switches in %llu sync points.\n", ( unsigned long ) ulJournalSwitches, ( unsigned long long ) ullJournalTime );
+		}
+		else if( xJournalMode == portJOURNAL_REPLAY )
+		{
+			fprintf( stderr, "Journal replayed: %lu context switches matched in %llu sync points.\n", ( unsigned long ) ulJournalSwitches, ( unsigned long long ) ullJournalTime );
+		}
+		else
+		{
+			/* The replay already reached the end of the journal. */
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_JOURNAL */
+
+void vPortWaitForInterrupt( void )
+{
+	/* Called by the idle task each time round its loop, so the host thread
+	sleeps until the next simulated interrupt rather than spinning - as a WFI
+	instruction would - whether or not ticks are suppressed.  The interrupt is
+	processed when the critical section is exited. */
+	#if( configUSE_JOURNAL == 1 )
+	if( xJournalMode != portJOURNAL_OFF )
+	{
+		/* The idle task does not otherwise call into the port when it has
+		nothing to do, so while a journal is open this makes the sync point at
+		which the interrupt that ends the wait is raised.  While recording, wait
+		for that interrupt to be latched first. */
+		vPortEnterCritical();
+		{
+			if( ( xJournalMode == portJOURNAL_RECORD ) && ( atomic_load( &ulLatchedWords ) == 0UL ) )
+			{
+				prvJournalFlush();
+				prvWaitForLatchedInterrupt();
+			}
+		}
+		vPortExitCritical();
+	}
+	else
+	#endif /* configUSE_JOURNAL */
+	{
+		vPortEnterCritical();
+		{
+			prvWaitForPendingInterrupt();
+		}
+		vPortExitCritical();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+		/* Called by the idle task, with the scheduler suspended, when no other
+		task is able to run for at least xExpectedIdleTime ticks. */
+		#if( configUSE_VIRTUAL_TIME == 1 )
+		{
+			/* Holding the interrupt event mutex prevents ticks being processed
+			while the tick count is corrected. */
+			vPortEnterCritical();
+			{
+				/* Only jump if a task is waiting for a timeout, and nothing was
+				made ready between the scheduler being suspended and the
+				critical section being entered. */
+				if( eTaskConfirmSleepModeStatus() == eStandardSleep )
+				{
+					/* Jump to the tick before the next task unblocks, then
+					pend the tick that unblocks it.  The pended tick is
+					processed as soon as the critical section is exited, and
+					is held as a pended tick by the kernel until the idle task
+					resumes the scheduler. */
+					vTaskStepTick( xExpectedIdleTime - ( TickType_t ) 1 );
+					prvRaiseInterrupt( portINTERRUPT_TICK );
+				}
+			}
+			vPortExitCritical();
+		}
+		#else
+		{
+		struct timespec xFirstSuppressedTick, xTimeNow;
+		int64_t llSleepTime;
+		uint64_t ullElapsedTicks;
+		TickType_t xSuppressedTicks;
+		BaseType_t xInterruptPending, xTickPending;
+
+			#if( configUSE_64_BIT_TICKS == 1 )
+			{
+				/* If no task is waiting for a timeout the expected idle time is
+				close to 2^64 ticks, which would overflow the sleep time in
+				nanoseconds and the step recorded in the journal.  If the
+				shorter sleep expires with nothing to do the idle task just
+				sleeps again. */
+				if( xExpectedIdleTime > ( TickType_t ) UINT32_MAX )
+				{
+					xExpectedIdleTime = ( TickType_t ) UINT32_MAX;
+				}
+			}
+			#endif
+
+			/* Holding the interrupt event mutex prevents interrupts being
+			processed while the tick count is corrected. */
+			vPortEnterCritical();
+			{
+				/* Holding the timer mutex prevents the simulated timer
+				generating a tick while the tick time is changed. */
+				pthread_mutex_lock( &xTimerMutex );
+
+				xInterruptPending = ( atomic_load( &ulPendingPriorities ) != 0UL ) ? pdTRUE : pdFALSE;
+
+				#if( configUSE_JOURNAL == 1 )
+				{
+					if( xJournalMode == portJOURNAL_REPLAY )
+					{
+						/* The idle task does not sleep, but moves the tick
+						count on by as many ticks as it slept for when the
+						journal was recorded, if it slept at all. */
+						xInterruptPending = pdTRUE;
+
+						if( prvJournalExpect( portJOURNAL_KIND_STEP, NULL ) != pdFALSE )
+						{
+							vTaskStepTick( ( TickType_t ) ulNextRecordValue );
+							prvJournalReadNext();
+						}
+					}
+					else if( ( xJournalMode == portJOURNAL_RECORD ) && ( atomic_load( &ulLatchedWords ) != 0UL ) )
+					{
+						xInterruptPending = pdTRUE;
+					}
+				}
+				#endif
+
+				/* Don't sleep if a task was made ready after the scheduler was
+				suspended, or if an interrupt is already pending. */
+				if( ( xInterruptPending == pdFALSE ) && ( eTaskConfirmSleepModeStatus() != eAbortSleep ) )
+				{
+					/* Move the next tick time to the tick that unblocks the
+					next task, so the ticks in between are not generated.  If
+					no task is waiting for a timeout then xExpectedIdleTime is
+					the maximum possible delay, and the timer will not expire in
+					practice. */
+					xFirstSuppressedTick = xNextTickTime;
+					prvAddNanoSeconds( &xNextTickTime, ( uint64_t ) ( xExpectedIdleTime - ( TickType_t ) 1 ) * ( uint64_t ) portTICK_PERIOD_NS );
+					pthread_cond_broadcast( &xTimerEvent );
+					pthread_mutex_unlock( &xTimerMutex );
+
+					/* Sleep until that tick, or any other simulated interrupt,
+					is pending.  The interrupt event mutex is held while
+					waiting, so the simulated interrupt processing thread does
+					not run until this task has corrected the tick count.  While
+					a journal is recorded the interrupts are latched rather than
+					pending. */
+					#if( configUSE_JOURNAL == 1 )
+					if( xJournalMode == portJOURNAL_RECORD )
+					{
+						prvJournalFlush();
+						prvWaitForLatchedInterrupt();
+					}
+					else
+					#endif
+					{
+						prvWaitForPendingInterrupt();
+					}
+
+					/* The timer thread holds the timer mutex while it generates
+					a tick, so once the mutex is held the tick is either pending
+					or has not been generated. */
+					pthread_mutex_lock( &xTimerMutex );
+
+					xTickPending = prvInterruptIsPending( portINTERRUPT_TICK );
+
+					#if( configUSE_JOURNAL == 1 )
+					{
+						if( xJournalMode == portJOURNAL_RECORD )
+						{
+							xTickPending = prvInterruptIsLatched( portINTERRUPT_TICK );
+						}
+					}
+					#endif
+
+					if( xTickPending != pdFALSE )
+					{
+						/* The timer expired, so all the suppressed ticks have
+						elapsed, and the pending tick unblocks the task. */
+						xSuppressedTicks = xExpectedIdleTime - ( TickType_t ) 1;
+					}
+					else
+					{
+						/* Woken early by another interrupt.  Count the tick
+						times that have passed. */
+						clock_gettime( CLOCK_MONOTONIC, &xTimeNow );
+						llSleepTime = prvNanoSecondsBetween( &xFirstSuppressedTick, &xTimeNow );
+
+						if( llSleepTime < 0 )
+						{
+							ullElapsedTicks = 0ULL;
+						}
+						else
+						{
+							ullElapsedTicks = ( ( uint64_t ) llSleepTime / ( uint64_t ) portTICK_PERIOD_NS ) + 1ULL;
+						}
+
+						if( ullElapsedTicks < ( uint64_t ) ( xExpectedIdleTime - ( TickType_t ) 1 ) )
+						{
+							/* Restart the timer from the first tick time that
+							has not yet passed. */
+							xSuppressedTicks = ( TickType_t ) ullElapsedTicks;
+							xNextTickTime = xFirstSuppressedTick;
+							prvAddNanoSeconds( &xNextTickTime, ullElapsedTicks * ( uint64_t ) portTICK_PERIOD_NS );
+							pthread_cond_broadcast( &xTimerEvent );
+						}
+						else
+						{
+							/* The timer expired but has not yet obtained the
+							mutex - it will generate the unblocking tick. */
+							xSuppressedTicks = xExpectedIdleTime - ( TickType_t ) 1;
+						}
+					}
+
+					vTaskStepTick( xSuppressedTicks );
+
+					#if( configUSE_JOURNAL == 1 )
+					{
+						if( xJournalMode == portJOURNAL_RECORD )
+						{
+							prvJournalWrite( portJOURNAL_KIND_STEP, ( uint32_t ) xSuppressedTicks );
+						}
+					}
+					#endif
+				}
+
+				pthread_mutex_unlock( &xTimerMutex );
+			}
+			vPortExitCritical();
+		}
+		#endif /* configUSE_VIRTUAL_TIME */
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#endif /* configNUM_CORES, configUSE_FIBERS */
+
+#endif /* _WIN32 */
@@ -0,0 +1,894 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* This port is built when the simulator is compiled on a POSIX host with
+configUSE_FIBERS set to 1.  The POSIX port that runs each task in its own thread
+is in port_posix.c, and the Win32 port in port.c. */
+#ifndef _WIN32
+
+/* Needed for the register names used to read the interrupted program counter.
+Must be defined before any header is included. */
+#ifndef _GNU_SOURCE
+	#define _GNU_SOURCE
+#endif
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <ucontext.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_FIBERS == 1 )
+
+#define portMAX_INTERRUPTS				( ( uint32_t ) sizeof( uint32_t ) * 8UL ) /* The number of bits in an uint32_t. */
+#define portNO_CRITICAL_NESTING 		( ( UBaseType_t ) 0 )
+#define portNANO_SECONDS_PER_SECOND		( 1000000000L )
+#define portTICK_PERIOD_NS				( portNANO_SECONDS_PER_SECOND / configTICK_RATE_HZ )
+
+/* The critical nesting count used while simulated interrupts are processed, so
+an interrupt signal received by a handler is held pending rather than
+processed recursively. */
+#define portINTERRUPT_NESTING			( ( UBaseType_t ) 1 )
+
+/* The signal sent to the scheduler thread by the simulated timer, and by any
+other thread that generates a simulated interrupt. */
+#define portINTERRUPT_SIGNAL			SIGUSR1
+
+/* The size of the host stack allocated to each task.  The task, and any host
+library code the task calls, runs on this stack - so it is much larger than the
+stack allocated by the kernel, which this port does not use.  Host memory is
+only committed as the stack grows into it.  The lowest page is a guard page, so
+a task that overflows its stack faults rather than corrupting memory. */
+#ifndef portFIBER_STACK_SIZE
+	#define portFIBER_STACK_SIZE		( ( size_t ) 256 * ( size_t ) 1024 )
+#endif
+
+/* Set to 1 on hosts where the program counter of the interrupted code can be
+read by the signal handler, so interrupts that arrive while a task is executing
+host library code can be deferred - see prvInterruptedApplicationCode(). */
+#if defined( __linux__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) || defined( __aarch64__ ) )
+	#define portDEFER_HOST_CODE_INTERRUPTS	1
+#else
+	#define portDEFER_HOST_CODE_INTERRUPTS	0
+#endif
+
+/* How long after an interrupt is deferred the signal handler runs again to see
+if the task has returned to application code. */
+#define portDEFERRED_INTERRUPT_RETRY_NS	( 50000L )
+
+/* Not defined by older C libraries. */
+#ifndef sigev_notify_thread_id
+	#define sigev_notify_thread_id		_sigev_un._tid
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* All the tasks run on the one host thread that started the scheduler, each in
+its own user space context, or fiber.  A context switch is a swapcontext() call
+made by that thread, rather than stopping one host thread and starting another
+as port_posix.c does, so it is much faster.  As with the other ports the task
+handle maps to the fiber state through the pxTopOfStack member of the TCB. */
+typedef struct
+{
+	/* The host context of the task, saved while the task is not in the Running
+	state. */
+	ucontext_t xContext;
+
+	/* errno belongs to the host thread, so is saved and restored with the rest
+	of the context of the task. */
+	int iErrno;
+
+	/* The host memory that holds the stack of the task and this structure. */
+	void *pvMemory;
+
+	/* The task function and its parameter, executed when the task first
+	runs. */
+	TaskFunction_t pxCode;
+	void *pvParameters;
+
+} xFiberState;
+
+/*
+ * Waits for an absolute time to simulate a tick interrupt being generated on
+ * an embedded target.
+ */
+static void *prvSimulatedPeripheralTimer( void *pvParameter );
+
+/*
+ * Helpers for the CLOCK_MONOTONIC times used by the simulated timer.
+ */
+static void prvAddNanoSeconds( struct timespec *pxTime, uint64_t ullNanoSeconds );
+static int64_t prvNanoSecondsBetween( const struct timespec *pxStart, const struct timespec *pxEnd );
+
+/*
+ * Process all the simulated interrupts - each represented by a bit in the
+ * ulPendingInterrupts variable - then switch to the fiber of the task selected
+ * to run.  Called by the task in the Running state with interrupts enabled,
+ * either directly or from the interrupt signal handler.  Does not return until
+ * the calling task is selected to run again.
+ */
+static void prvProcessSimulatedInterrupts( void );
+
+/*
+ * Save the context of the running task and switch to the fiber of another
+ * task.  Returns when the calling task runs again.
+ */
+static void prvSwitchFiber( xFiberState *pxNextFiberState );
+
+/*
+ * Interrupt handlers used by the kernel itself.  These are executed by the
+ * task in the Running state when it processes the simulated interrupts.
+ */
+static uint32_t prvProcessYieldInterrupt( void );
+static uint32_t prvProcessTickInterrupt( void );
+
+/*
+ * The entry point of every fiber.
+ */
+static void prvFiberEntry( void );
+
+/*
+ * Executed by the scheduler thread when portINTERRUPT_SIGNAL is received.
+ * This is the simulated equivalent of the interrupt entry on a real target.
+ */
+static void prvInterruptSignalHandler( int iSignal, siginfo_t *pxInformation, void *pvContext );
+
+/*
+ * Returns pdTRUE if the signal described by pvContext interrupted code that is
+ * part of the application executable, rather than code in a host library.
+ */
+#if( portDEFER_HOST_CODE_INTERRUPTS == 1 )
+	static BaseType_t prvInterruptedApplicationCode( void *pvContext );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts waiting to be processed.  This is a bit mask where each
+bit represents one interrupt, so a maximum of 32 interrupts can be simulated.
+It is atomic as the simulated timer and peripheral threads set bits in it. */
+static _Atomic uint32_t ulPendingInterrupts = 0UL;
+
+/* The critical nesting count for the currently executing task.  All the tasks
+run on one thread, so setting this to non-zero is all that is needed to
+disable (simulated) interrupts - the signal handler only processes interrupts
+when it is zero.  It is initialised to a non-zero value so interrupts do not
+become enabled during the initialisation phase. */
+static volatile UBaseType_t uxCriticalNesting = 9999UL;
+
+/* Handlers for all the simulated software interrupts.  The first two positions
+are used for the Yield and Tick interrupts so are handled slightly differently,
+all the other interrupts can be user defined. */
+static uint32_t (*ulIsrHandler[ portMAX_INTERRUPTS ])( void ) = { 0 };
+
+/* Pointer to the TCB of the currently executing task. */
+extern void *pxCurrentTCB;
+
+/* The fiber that is executing, which is not necessarily the fiber of
+pxCurrentTCB while simulated interrupts are being processed. */
+static xFiberState * volatile pxRunningFiberState = NULL;
+
+/* The context of the scheduler thread before the first task started. */
+static ucontext_t xSchedulerContext;
+
+/* The thread that started the scheduler, which executes all the tasks. */
+static pthread_t xSchedulerThread;
+
+/* Used to ensure nothing is processed during the startup sequence. */
+static volatile BaseType_t xPortRunning = pdFALSE;
+
+/* The time at which the simulated timer next generates a tick, and the
+condition broadcast when vPortSuppressTicksAndSleep() changes that time.  Both
+are protected by xTimerMutex, which the timer thread only releases while it
+waits. */
+static struct timespec xNextTickTime;
+static pthread_cond_t xTimerEvent;
+static pthread_mutex_t xTimerMutex = PTHREAD_MUTEX_INITIALIZER;
+
+#if( portDEFER_HOST_CODE_INTERRUPTS == 1 )
+
+	/* The code of the application executable, as defined by the linker. */
+	extern const char __executable_start[];
+	extern const char etext[];
+
+	/* A one shot timer that sends portINTERRUPT_SIGNAL to the scheduler thread
+	after an interrupt has been deferred. */
+	static timer_t xRetryTimer;
+	static BaseType_t xRetryTimerCreated = pdFALSE;
+
+#endif /* portDEFER_HOST_CODE_INTERRUPTS */
+
+/*-----------------------------------------------------------*/
+
+static void *prvSimulatedPeripheralTimer( void *pvParameter )
+{
+struct timespec xTimeNow;
+
+	/* Just to prevent compiler warnings. */
+	( void ) pvParameter;
+
+	/* The mutex is only released while waiting for the next tick time. */
+	pthread_mutex_lock( &xTimerMutex );
+
+	for( ;; )
+	{
+		/* The next tick time is relative to the previous tick time, so the
+		tick does not drift with the scheduling latency of the host. */
+		prvAddNanoSeconds( &xNextTickTime, portTICK_PERIOD_NS );
+
+		/* Wait for the next tick time.  If vPortSuppressTicksAndSleep() moves
+		the tick time while this thread is waiting then xTimerEvent is
+		broadcast, and the wait is restarted with the new time. */
+		while( pthread_cond_timedwait( &xTimerEvent, &xTimerMutex, &xNextTickTime ) != ETIMEDOUT )
+		{
+			/* Woken before the tick time, wait again. */
+		}
+
+		/* Drop ticks missed while the host did not run this thread, rather
+		than generating a burst of them. */
+		clock_gettime( CLOCK_MONOTONIC, &xTimeNow );
+		if( prvNanoSecondsBetween( &xNextTickTime, &xTimeNow ) > portTICK_PERIOD_NS )
+		{
+			xNextTickTime = xTimeNow;
+		}
+
+		configASSERT( xPortRunning );
+
+		/* Generate the simulated tick event. */
+		atomic_fetch_or( &ulPendingInterrupts, ( uint32_t ) ( 1UL << portINTERRUPT_TICK ) );
+		pthread_kill( xSchedulerThread, portINTERRUPT_SIGNAL );
+	}
+
+	/* Should never reach here. */
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddNanoSeconds( struct timespec *pxTime, uint64_t ullNanoSeconds )
+{
+	pxTime->tv_sec += ( time_t ) ( ullNanoSeconds / ( uint64_t ) portNANO_SECONDS_PER_SECOND );
+	pxTime->tv_nsec += ( long ) ( ullNanoSeconds % ( uint64_t ) portNANO_SECONDS_PER_SECOND );
+
+	if( pxTime->tv_nsec >= portNANO_SECONDS_PER_SECOND )
+	{
+		pxTime->tv_nsec -= portNANO_SECONDS_PER_SECOND;
+		pxTime->tv_sec++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int64_t prvNanoSecondsBetween( const struct timespec *pxStart, const struct timespec *pxEnd )
+{
+	return ( ( int64_t ) ( pxEnd->tv_sec - pxStart->tv_sec ) * portNANO_SECONDS_PER_SECOND ) + ( int64_t ) ( pxEnd->tv_nsec - pxStart->tv_nsec );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFiberEntry( void )
+{
+xFiberState *pxFiberState = pxRunningFiberState;
+
+	/* A task starts from within the interrupt processing that selected it, so
+	complete that processing before calling the task function. */
+	uxCriticalNesting = portNO_CRITICAL_NESTING;
+	atomic_signal_fence( memory_order_seq_cst );
+
+	if( atomic_load( &ulPendingInterrupts ) != 0UL )
+	{
+		prvProcessSimulatedInterrupts();
+	}
+
+	pxFiberState->pxCode( pxFiberState->pvParameters );
+
+	/* Tasks must not attempt to return from their implementing function. */
+	configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+#if( portDEFER_HOST_CODE_INTERRUPTS == 1 )
+
+	static BaseType_t prvInterruptedApplicationCode( void *pvContext )
+	{
+	const ucontext_t *pxContext = ( const ucontext_t * ) pvContext;
+	const char *pcProgramCounter;
+
+		/* A task must not be switched out while it is executing host library
+		code, as it may hold a host lock (the stdio and heap locks for example)
+		that the next task would then try to take on the same thread.  Only the
+		application executable is known to be safe, as the kernel code it
+		contains protects itself with critical sections. */
+		#if defined( __x86_64__ )
+			pcProgramCounter = ( const char * ) pxContext->uc_mcontext.gregs[ REG_RIP ];
+		#elif defined( __i386__ )
+			pcProgramCounter = ( const char * ) pxContext->uc_mcontext.gregs[ REG_EIP ];
+		#else
+			pcProgramCounter = ( const char * ) pxContext->uc_mcontext.pc;
+		#endif
+
+		return ( ( pcProgramCounter >= __executable_start ) && ( pcProgramCounter < etext ) ) ? pdTRUE : pdFALSE;
+	}
+
+#endif /* portDEFER_HOST_CODE_INTERRUPTS */
+/*-----------------------------------------------------------*/
+
+static void prvInterruptSignalHandler( int iSignal, siginfo_t *pxInformation, void *pvContext )
+{
+	( void ) iSignal;
+	( void ) pxInformation;
+
+	/* If interrupts are disabled then the interrupt is left pending, and is
+	processed when the critical section is exited. */
+	if( ( uxCriticalNesting == portNO_CRITICAL_NESTING ) && ( xPortRunning != pdFALSE ) && ( atomic_load( &ulPendingInterrupts ) != 0UL ) )
+	{
+		#if( portDEFER_HOST_CODE_INTERRUPTS == 1 )
+		{
+		const struct itimerspec xRetryTime = { { 0, 0 }, { 0, portDEFERRED_INTERRUPT_RETRY_NS } };
+
+			if( prvInterruptedApplicationCode( pvContext ) == pdFALSE )
+			{
+				/* The task is inside a host library call.  Look again shortly,
+				so a task that makes host library calls in a loop is still
+				interrupted soon after it returns to its own code.  A task
+				that spends a long time in a single call delays interrupts for
+				that time. */
+				if( xRetryTimerCreated != pdFALSE )
+				{
+					timer_settime( xRetryTimer, 0, &xRetryTime, NULL );
+				}
+
+				return;
+			}
+		}
+		#else
+		{
+			( void ) pvContext;
+		}
+		#endif /* portDEFER_HOST_CODE_INTERRUPTS */
+
+		prvProcessSimulatedInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+xFiberState *pxFiberState;
+char *pcMemory;
+size_t xPageSize;
+
+	/* The stack allocated by the kernel is not used - see the definition of
+	portFIBER_STACK_SIZE. */
+	( void ) pxTopOfStack;
+
+	xPageSize = ( size_t ) sysconf( _SC_PAGESIZE );
+	pcMemory = ( char * ) mmap( NULL, portFIBER_STACK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+	configASSERT( pcMemory != ( char * ) MAP_FAILED );
+	( void ) mprotect( pcMemory, xPageSize, PROT_NONE );
+
+	/* The fiber state is held at the top of the memory, above the stack. */
+	pxFiberState = ( xFiberState * ) ( ( ( size_t ) ( pcMemory + portFIBER_STACK_SIZE ) - sizeof( xFiberState ) ) & ~( ( size_t ) 63 ) );
+	pxFiberState->pvMemory = pcMemory;
+	pxFiberState->pxCode = pxCode;
+	pxFiberState->pvParameters = pvParameters;
+	pxFiberState->iErrno = 0;
+
+	/* The task starts in prvFiberEntry() with the signal mask of the thread
+	that created it, less portINTERRUPT_SIGNAL. */
+	getcontext( &( pxFiberState->xContext ) );
+	pxFiberState->xContext.uc_stack.ss_sp = pcMemory + xPageSize;
+	pxFiberState->xContext.uc_stack.ss_size = ( size_t ) ( ( char * ) pxFiberState - pcMemory ) - xPageSize;
+	pxFiberState->xContext.uc_link = NULL;
+	sigdelset( &( pxFiberState->xContext.uc_sigmask ), portINTERRUPT_SIGNAL );
+	makecontext( &( pxFiberState->xContext ), prvFiberEntry, 0 );
+
+	return ( StackType_t * ) pxFiberState;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+pthread_t xTimerThread;
+pthread_condattr_t xConditionAttributes;
+struct sigaction xSignalAction;
+sigset_t xSignals, xOldSignals;
+xFiberState *pxFiberState;
+int32_t lSuccess = pdPASS;
+
+	/* Install the interrupt handlers used by the scheduler itself. */
+	vPortSetInterruptHandler( portINTERRUPT_YIELD, prvProcessYieldInterrupt );
+	vPortSetInterruptHandler( portINTERRUPT_TICK, prvProcessTickInterrupt );
+
+	xSchedulerThread = pthread_self();
+
+	/* SA_RESTART ensures system calls made by a task, such as a write() to the
+	console made by printf(), are resumed after the signal has been
+	handled. */
+	memset( &xSignalAction, 0, sizeof( xSignalAction ) );
+	xSignalAction.sa_sigaction = prvInterruptSignalHandler;
+	xSignalAction.sa_flags = SA_SIGINFO | SA_RESTART;
+	sigemptyset( &xSignalAction.sa_mask );
+	sigaction( portINTERRUPT_SIGNAL, &xSignalAction, NULL );
+
+	#if( portDEFER_HOST_CODE_INTERRUPTS == 1 )
+	{
+	struct sigevent xRetryEvent;
+
+		/* Unlike pthread_kill() the timer signals a thread by its kernel thread
+		ID. */
+		memset( &xRetryEvent, 0, sizeof( xRetryEvent ) );
+		xRetryEvent.sigev_notify = SIGEV_THREAD_ID;
+		xRetryEvent.sigev_signo = portINTERRUPT_SIGNAL;
+		xRetryEvent.sigev_notify_thread_id = ( pid_t ) syscall( SYS_gettid );
+
+		if( timer_create( CLOCK_MONOTONIC, &xRetryEvent, &xRetryTimer ) == 0 )
+		{
+			xRetryTimerCreated = pdTRUE;
+		}
+	}
+	#endif /* portDEFER_HOST_CODE_INTERRUPTS */
+
+	/* The simulated timer waits for absolute CLOCK_MONOTONIC times, so is not
+	affected by changes to the wall clock time. */
+	pthread_condattr_init( &xConditionAttributes );
+	pthread_condattr_setclock( &xConditionAttributes, CLOCK_MONOTONIC );
+	pthread_cond_init( &xTimerEvent, &xConditionAttributes );
+	pthread_condattr_destroy( &xConditionAttributes );
+
+	/* Start the thread that simulates the timer peripheral to generate tick
+	interrupts.  It is created with portINTERRUPT_SIGNAL blocked, although the
+	signal is only ever sent to the scheduler thread. */
+	clock_gettime( CLOCK_MONOTONIC, &xNextTickTime );
+	xPortRunning = pdTRUE;
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portINTERRUPT_SIGNAL );
+	pthread_sigmask( SIG_BLOCK, &xSignals, &xOldSignals );
+	if( pthread_create( &xTimerThread, NULL, prvSimulatedPeripheralTimer, NULL ) != 0 )
+	{
+		lSuccess = pdFAIL;
+	}
+	pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+
+	if( lSuccess == pdPASS )
+	{
+		/* Start the task selected by vTaskStartScheduler().  Interrupts are
+		enabled by prvFiberEntry().  As in port_posix.c the first tick is
+		pended immediately. */
+		atomic_fetch_or( &ulPendingInterrupts, ( uint32_t ) ( 1UL << portINTERRUPT_TICK ) );
+		pxFiberState = ( xFiberState * ) *( ( size_t * ) pxCurrentTCB );
+		pxRunningFiberState = pxFiberState;
+		swapcontext( &xSchedulerContext, &( pxFiberState->xContext ) );
+	}
+
+	/* Would not expect to return from swapcontext(), so should not get
+	here. */
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvProcessYieldInterrupt( void )
+{
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvProcessTickInterrupt( void )
+{
+uint32_t ulSwitchRequired;
+
+	/* Process the tick itself. */
+	configASSERT( xPortRunning );
+	ulSwitchRequired = ( uint32_t ) xTaskIncrementTick();
+
+	return ulSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessSimulatedInterrupts( void )
+{
+uint32_t ulPending, ulSwitchRequired, i;
+xFiberState *pxFiberState;
+
+	do
+	{
+		/* Simulated interrupts are disabled while they are processed, so a
+		signal received now leaves its interrupt pending for the loop below. */
+		uxCriticalNesting = portINTERRUPT_NESTING;
+		atomic_signal_fence( memory_order_seq_cst );
+
+		/* Take all the pending interrupts at once, as other threads can set
+		more at any time.  Any set while the handlers run are processed by the
+		next iteration. */
+		while( ( ulPending = atomic_exchange( &ulPendingInterrupts, 0UL ) ) != 0UL )
+		{
+			/* Used to indicate whether the simulated interrupt processing has
+			necessitated a context switch to another task. */
+			ulSwitchRequired = pdFALSE;
+
+			for( i = 0; i < portMAX_INTERRUPTS; i++ )
+			{
+				/* Is the simulated interrupt pending, and is a handler
+				installed? */
+				if( ( ( ulPending & ( 1UL << i ) ) != 0UL ) && ( ulIsrHandler[ i ] != NULL ) )
+				{
+					/* Run the actual handler. */
+					if( ulIsrHandler[ i ]() != pdFALSE )
+					{
+						ulSwitchRequired = pdTRUE;
+					}
+				}
+			}
+
+			if( ulSwitchRequired != pdFALSE )
+			{
+				/* Select the next task to run. */
+				vTaskSwitchContext();
+			}
+		}
+
+		/* Switch to the fiber of the task now in the Running state.  This
+		returns when the calling task is selected to run again, at which point
+		the task that switched back to it has already processed the
+		interrupts. */
+		pxFiberState = ( xFiberState * ) *( ( size_t * ) pxCurrentTCB );
+		if( pxFiberState != pxRunningFiberState )
+		{
+			prvSwitchFiber( pxFiberState );
+		}
+
+		atomic_signal_fence( memory_order_seq_cst );
+		uxCriticalNesting = portNO_CRITICAL_NESTING;
+
+		/* An interrupt raised after the pending interrupts were last taken
+		would otherwise not be processed until the next signal. */
+	} while( atomic_load( &ulPendingInterrupts ) != 0UL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchFiber( xFiberState *pxNextFiberState )
+{
+xFiberState *pxThisFiberState = pxRunningFiberState;
+
+	pxThisFiberState->iErrno = errno;
+	pxRunningFiberState = pxNextFiberState;
+
+	swapcontext( &( pxThisFiberState->xContext ), &( pxNextFiberState->xContext ) );
+
+	errno = pxThisFiberState->iErrno;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDeleteThread( void *pvTaskToDelete )
+{
+xFiberState *pxFiberState;
+
+	/* Find the fiber state of the task being deleted. */
+	pxFiberState = ( xFiberState * ) ( *( size_t *) pvTaskToDelete );
+
+	/* The task is not in the Running state, so nothing is executing on its
+	stack.  This is also the case for a task that deleted itself, as the idle
+	task frees a deleted task only after it has switched away.  The fiber
+	state is held in the memory being freed. */
+	configASSERT( pxFiberState != pxRunningFiberState );
+	munmap( pxFiberState->pvMemory, portFIBER_STACK_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+void vPortCloseRunningThread( void *pvTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+	( void ) pvTaskToDelete;
+
+	/* The task cannot free the stack it is executing on, so it just switches
+	away as soon as the critical section from which this is called is exited.
+	The task is not in any list, so is never switched back to, and
+	vPortDeleteThread() frees its stack when the idle task cleans it up. */
+	*pxPendYield = pdTRUE;
+	atomic_fetch_or( &ulPendingInterrupts, ( uint32_t ) ( 1UL << portINTERRUPT_YIELD ) );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* This function IS NOT TESTED! */
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber )
+{
+	configASSERT( xPortRunning );
+
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		atomic_fetch_or( &ulPendingInterrupts, ( uint32_t ) ( 1UL << ulInterruptNumber ) );
+
+		if( pthread_equal( pthread_self(), xSchedulerThread ) == 0 )
+		{
+			/* Called from a thread that simulates a peripheral, so interrupt
+			the scheduler thread. */
+			pthread_kill( xSchedulerThread, portINTERRUPT_SIGNAL );
+		}
+		else if( uxCriticalNesting == portNO_CRITICAL_NESTING )
+		{
+			/* Called by a task, which must not continue until the interrupt
+			has been processed. */
+			prvProcessSimulatedInterrupts();
+		}
+		else
+		{
+			/* Called from a simulated interrupt handler, or from within a
+			critical section.  The interrupt is processed when the handler
+			returns or the critical section is exited. */
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t (*pvHandler)( void ) )
+{
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		ulIsrHandler[ ulInterruptNumber ] = pvHandler;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	/* Only the scheduler thread executes kernel code, so incrementing the
+	nesting count is enough to stop the signal handler processing
+	interrupts. */
+	uxCriticalNesting++;
+	atomic_signal_fence( memory_order_seq_cst );
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( uxCriticalNesting > portNO_CRITICAL_NESTING )
+	{
+		atomic_signal_fence( memory_order_seq_cst );
+		uxCriticalNesting--;
+
+		/* Were any interrupts set to pending while interrupts were
+		(simulated) disabled?  If so the task must not continue until they
+		have been processed. */
+		if( ( uxCriticalNesting == portNO_CRITICAL_NESTING ) && ( xPortRunning != pdFALSE ) && ( atomic_load( &ulPendingInterrupts ) != 0UL ) )
+		{
+			prvProcessSimulatedInterrupts();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortWaitForInterrupt( void )
+{
+sigset_t xSignals, xOldSignals;
+
+	/* As port_posix.c.  portINTERRUPT_SIGNAL is blocked until the thread
+	sleeps, so an interrupt raised after ulPendingInterrupts has been tested
+	still wakes it. */
+	vPortEnterCritical();
+	{
+		sigemptyset( &xSignals );
+		sigaddset( &xSignals, portINTERRUPT_SIGNAL );
+		pthread_sigmask( SIG_BLOCK, &xSignals, &xOldSignals );
+
+		while( atomic_load( &ulPendingInterrupts ) == 0UL )
+		{
+			sigsuspend( &xOldSignals );
+		}
+
+		pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+	}
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+		/* Called by the idle task, with the scheduler suspended, when no other
+		task is able to run for at least xExpectedIdleTime ticks. */
+		#if( configUSE_VIRTUAL_TIME == 1 )
+		{
+			vPortEnterCritical();
+			{
+				/* As port_posix.c. */
+				if( eTaskConfirmSleepModeStatus() == eStandardSleep )
+				{
+					vTaskStepTick( xExpectedIdleTime - ( TickType_t ) 1 );
+					atomic_fetch_or( &ulPendingInterrupts, ( uint32_t ) ( 1UL << portINTERRUPT_TICK ) );
+				}
+			}
+			vPortExitCritical();
+		}
+		#else
+		{
+		struct timespec xFirstSuppressedTick, xTimeNow;
+		int64_t llSleepTime;
+		uint64_t ullElapsedTicks;
+		TickType_t xSuppressedTicks;
+		sigset_t xSignals, xOldSignals;
+
+			#if( configUSE_64_BIT_TICKS == 1 )
+			{
+				/* As port_posix.c. */
+				if( xExpectedIdleTime > ( TickType_t ) UINT32_MAX )
+				{
+					xExpectedIdleTime = ( TickType_t ) UINT32_MAX;
+				}
+			}
+			#endif
+
+			vPortEnterCritical();
+			{
+				/* portINTERRUPT_SIGNAL is blocked until the thread sleeps, so
+				an interrupt raised after ulPendingInterrupts has been tested
+				still wakes it. */
+				sigemptyset( &xSignals );
+				sigaddset( &xSignals, portINTERRUPT_SIGNAL );
+				pthread_sigmask( SIG_BLOCK, &xSignals, &xOldSignals );
+
+				/* Holding the timer mutex prevents the simulated timer
+				generating a tick while the tick time is changed. */
+				pthread_mutex_lock( &xTimerMutex );
+
+				/* Don't sleep if a task was made ready after the scheduler was
+				suspended, or if an interrupt is already pending. */
+				if( ( eTaskConfirmSleepModeStatus() != eAbortSleep ) && ( atomic_load( &ulPendingInterrupts ) == 0UL ) )
+				{
+					/* Move the next tick time to the tick that unblocks the
+					next task, so the ticks in between are not generated. */
+					xFirstSuppressedTick = xNextTickTime;
+					prvAddNanoSeconds( &xNextTickTime, ( uint64_t ) ( xExpectedIdleTime - ( TickType_t ) 1 ) * ( uint64_t ) portTICK_PERIOD_NS );
+					pthread_cond_broadcast( &xTimerEvent );
+					pthread_mutex_unlock( &xTimerMutex );
+
+					/* Sleep until that tick, or any other simulated interrupt,
+					is pending.  The critical nesting count stops the signal
+					handler processing the interrupt until this task has
+					corrected the tick count. */
+					while( atomic_load( &ulPendingInterrupts ) == 0UL )
+					{
+						sigsuspend( &xOldSignals );
+					}
+
+					/* The timer thread holds the mutex while it generates a
+					tick, so once the mutex is held the tick is either pending
+					or has not been generated. */
+					pthread_mutex_lock( &xTimerMutex );
+
+					if( ( atomic_load( &ulPendingInterrupts ) & ( 1UL << portINTERRUPT_TICK ) ) != 0UL )
+					{
+						/* The timer expired, so all the suppressed ticks have
+						elapsed, and the pending tick unblocks the task. */
+						xSuppressedTicks = xExpectedIdleTime - ( TickType_t ) 1;
+					}
+					else
+					{
+						/* Woken early by another interrupt.  Count the tick
+						times that have passed. */
+						clock_gettime( CLOCK_MONOTONIC, &xTimeNow );
+						llSleepTime = prvNanoSecondsBetween( &xFirstSuppressedTick, &xTimeNow );
+
+						if( llSleepTime < 0 )
+						{
+							ullElapsedTicks = 0ULL;
+						}
+						else
+						{
+							ullElapsedTicks = ( ( uint64_t ) llSleepTime / ( uint64_t ) portTICK_PERIOD_NS ) + 1ULL;
+						}
+
+						if( ullElapsedTicks < ( uint64_t ) ( xExpectedIdleTime - ( TickType_t ) 1 ) )
+						{
+							/* Restart the timer from the first tick time that
+							has not yet passed. */
+							xSuppressedTicks = ( TickType_t ) ullElapsedTicks;
+							xNextTickTime = xFirstSuppressedTick;
+							prvAddNanoSeconds( &xNextTickTime, ullElapsedTicks * ( uint64_t ) portTICK_PERIOD_NS );
+							pthread_cond_broadcast( &xTimerEvent );
+						}
+						else
+						{
+							/* The timer expired but has not yet obtained the
+							mutex - it will generate the unblocking tick. */
+							xSuppressedTicks = xExpectedIdleTime - ( TickType_t ) 1;
+						}
+					}
+
+					vTaskStepTick( xSuppressedTicks );
+				}
+
+				pthread_mutex_unlock( &xTimerMutex );
+				pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+			}
+			vPortExitCritical();
+		}
+		#endif /* configUSE_VIRTUAL_TIME */
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_FIBERS */
+
+#endif /* _WIN32 */
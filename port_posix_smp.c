@@ -0,0 +1,1007 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* This port is built when the simulator is compiled on a POSIX host with
+configNUM_CORES set to more than 1.  The single core POSIX port is in
+port_posix.c, and the Win32 port in port.c. */
+#ifndef _WIN32
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <stdatomic.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configNUM_CORES > 1 )
+
+#define portMAX_INTERRUPTS				( ( uint32_t ) sizeof( uint32_t ) * 8UL ) /* The number of bits in an uint32_t. */
+#define portNO_CRITICAL_NESTING 		( ( UBaseType_t ) 0 )
+#define portNANO_SECONDS_PER_SECOND		( 1000000000L )
+#define portTICK_PERIOD_NS				( portNANO_SECONDS_PER_SECOND / configTICK_RATE_HZ )
+
+/* The signals used to stop and restart task threads, as in port_posix.c. */
+#define portSUSPEND_SIGNAL				SIGUSR1
+#define portRESUME_SIGNAL				SIGUSR2
+
+/* The number of times a spin lock is polled before the spinning thread gives
+the rest of its time slice to the thread holding the lock.  The simulator
+must also run on hosts with fewer CPUs than simulated cores. */
+#define portSPIN_COUNT					( 64 )
+
+/* Passed to prvRaiseInterrupt() to raise an interrupt on the calling core. */
+#define portCALLING_CORE				( ( BaseType_t ) -1 )
+
+/*-----------------------------------------------------------*/
+
+/* As in port_posix.c each task is executed by a thread, and the task stack is
+only used to hold an xThreadState structure.  Only the threads whose xRunning
+member is pdTRUE - one per core - are permitted to execute task code. */
+typedef struct
+{
+	/* Handle of the thread that executes the task. */
+	pthread_t xThread;
+
+	/* Set by the simulated interrupt processing thread of a core when the task
+	enters the Running state on that core, and cleared when it leaves the
+	Running state. */
+	volatile BaseType_t xRunning;
+
+	/* Set when the thread has exited, or has been asked to exit. */
+	volatile BaseType_t xClosed;
+
+	/* The core the task last ran on.  Only changes while the thread is
+	parked. */
+	volatile BaseType_t xCoreID;
+
+	/* The critical nesting count of the task.  Each core runs a task at the
+	same time, so unlike port_posix.c the count cannot be a single variable.
+	While it is non-zero simulated interrupts are disabled on the core running
+	the task, so the simulated interrupt processing thread of that core will
+	not stop the thread. */
+	_Atomic UBaseType_t uxCriticalNesting;
+
+	/* The task function and its parameter, executed once the thread first
+	runs. */
+	TaskFunction_t pxCode;
+	void *pvParameters;
+
+} xThreadState;
+
+/* A recursive spin lock.  Spin locks are used rather than mutexes as they are
+held by task threads that can be stopped by portSUSPEND_SIGNAL, which is not
+safe while a pthread mutex is held. */
+typedef struct
+{
+	atomic_int iLocked;
+	_Atomic( const void * ) pvOwner;
+	UBaseType_t uxNesting;
+} xSpinLock;
+
+/*
+ * Waits for an absolute time to simulate a tick interrupt being generated on
+ * an embedded target.  Tick interrupts are always handled by core 0.
+ */
+static void *prvSimulatedPeripheralTimer( void *pvParameter );
+
+/*
+ * Helpers for the CLOCK_MONOTONIC times used by the simulated timer.
+ */
+static void prvAddNanoSeconds( struct timespec *pxTime, uint64_t ullNanoSeconds );
+static int64_t prvNanoSecondsBetween( const struct timespec *pxStart, const struct timespec *pxEnd );
+
+/*
+ * The simulated interrupt processing thread of a core.  Core 0 uses the
+ * thread that started the scheduler.  Processes the interrupts pending on the
+ * core, each represented by a bit in ulPendingInterrupts[ xCoreID ].
+ */
+static void *prvProcessSimulatedInterrupts( void *pvCoreID );
+
+/*
+ * Interrupt handlers used by the kernel itself.
+ */
+static uint32_t prvProcessYieldInterrupt( void );
+static uint32_t prvProcessTickInterrupt( void );
+
+/*
+ * Create the semaphore, conditions and signal handlers shared by all the
+ * threads.  Executed once, before the first task thread is created.
+ */
+static void prvCreateSimulatedInterruptObjects( void );
+
+/*
+ * Task thread entry point, parking and signal handling, as in port_posix.c.
+ */
+static void *prvTaskThreadEntry( void *pvParameter );
+static void prvWaitUntilRunning( xThreadState *pxThreadState );
+static void prvSuspendSignalHandler( int iSignal );
+static void prvResumeSignalHandler( int iSignal );
+static void prvResumeThread( xThreadState *pxThreadState, BaseType_t xCoreID );
+
+/*
+ * Take and give a recursive spin lock.
+ */
+static void prvSpinLockTake( xSpinLock *pxLock );
+static void prvSpinLockGive( xSpinLock *pxLock );
+
+/*
+ * Set the interrupt pending on a core and wake the core's simulated interrupt
+ * processing thread.  If xCoreID is portCALLING_CORE then the interrupt is
+ * raised on the core of the calling thread.  A task thread that has
+ * interrupts enabled does not return until the interrupts pending on its core
+ * have been processed.
+ */
+static void prvRaiseInterrupt( BaseType_t xCoreID, uint32_t ulInterruptNumber );
+static void prvWakeCore( BaseType_t xCoreID );
+
+/*
+ * Called by a task thread with a critical nesting count of zero.  If an
+ * interrupt is pending on the task's core the thread is parked until the
+ * interrupts have been processed and the task is selected to run again.
+ */
+static void prvYieldToPendingInterrupts( void );
+
+/*
+ * Called by a task thread that holds the ISR lock, with a critical nesting
+ * count of zero.  Releases the lock and parks the thread until the core has
+ * processed its interrupts and selected the task to run again.
+ */
+static void prvWaitForInterruptProcessing( void );
+
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts waiting to be processed by each core.  Each bit
+represents one interrupt, so a maximum of 32 interrupts can be simulated. */
+static _Atomic uint32_t ulPendingInterrupts[ configNUM_CORES ];
+
+/* Broadcast to wake the simulated interrupt processing thread of a core.
+Always broadcast with xCoreEventMutex held so a wake up cannot be lost between
+a processing thread testing its wait condition and waiting. */
+static pthread_cond_t xCoreEvent[ configNUM_CORES ];
+static pthread_mutex_t xCoreEventMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* The kernel locks.  A task thread in a critical section holds both - the
+task lock first.  The simulated interrupt processing thread of a core holds
+the ISR lock while it processes interrupts, so interrupt handlers cannot run
+in parallel with a critical section on any core.  vTaskSuspendAll() also holds
+the task lock, so a task on another core cannot enter a critical section while
+the scheduler is suspended, but interrupts can still be processed. */
+static xSpinLock xTaskLock;
+static xSpinLock xIsrLock;
+
+/* Posted by a task thread from prvSuspendSignalHandler() once it has stopped
+executing task code.  Only the holder of the ISR lock stops threads, so one
+semaphore is shared by all the cores. */
+static sem_t xSuspendAcknowledge;
+
+/* Ensures the objects above are only created once. */
+static pthread_once_t xSimulatedInterruptObjectsOnce = PTHREAD_ONCE_INIT;
+static BaseType_t xSimulatedInterruptObjectsCreated = pdFALSE;
+
+/* Handlers for all the simulated software interrupts.  The first two positions
+are used for the Yield and Tick interrupts so are handled slightly differently,
+all the other interrupts can be user defined. */
+static uint32_t (*ulIsrHandler[ portMAX_INTERRUPTS ])( void ) = { 0 };
+
+/* Pointers to the TCBs of the tasks running on each core. */
+extern void * volatile pxCurrentTCBs[ configNUM_CORES ];
+
+/* Used to ensure nothing is processed during the startup sequence. */
+static volatile BaseType_t xPortRunning = pdFALSE;
+
+/* The thread state of the task executed by the calling thread, or NULL if the
+calling thread is not a task thread. */
+static __thread xThreadState *pxThreadStateOfThisThread = NULL;
+
+/* The core of the calling thread if it is not a task thread.  Set by the
+simulated interrupt processing threads - all other threads that are not task
+threads are treated as part of core 0. */
+static __thread BaseType_t xCoreIDOfThisThread = 0;
+
+/* Identifies the calling thread as the owner of a spin lock. */
+static __thread char cThreadIdentity;
+
+/*-----------------------------------------------------------*/
+
+static void *prvSimulatedPeripheralTimer( void *pvParameter )
+{
+struct timespec xNextTickTime, xTimeNow;
+
+	/* Just to prevent compiler warnings. */
+	( void ) pvParameter;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNextTickTime );
+
+	for( ;; )
+	{
+		/* The next tick time is relative to the previous tick time, so the
+		tick does not drift with the scheduling latency of the host. */
+		prvAddNanoSeconds( &xNextTickTime, portTICK_PERIOD_NS );
+
+		while( clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &xNextTickTime, NULL ) != 0 )
+		{
+			/* Interrupted by a signal, wait again. */
+		}
+
+		/* Drop ticks missed while the host did not run this thread, rather
+		than generating a burst of them. */
+		clock_gettime( CLOCK_MONOTONIC, &xTimeNow );
+		if( prvNanoSecondsBetween( &xNextTickTime, &xTimeNow ) > portTICK_PERIOD_NS )
+		{
+			xNextTickTime = xTimeNow;
+		}
+
+		configASSERT( xPortRunning );
+
+		/* Generate the simulated tick event on core 0. */
+		atomic_fetch_or( &( ulPendingInterrupts[ 0 ] ), ( uint32_t ) ( 1UL << portINTERRUPT_TICK ) );
+		prvWakeCore( 0 );
+	}
+
+	/* Should never reach here. */
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddNanoSeconds( struct timespec *pxTime, uint64_t ullNanoSeconds )
+{
+	pxTime->tv_sec += ( time_t ) ( ullNanoSeconds / ( uint64_t ) portNANO_SECONDS_PER_SECOND );
+	pxTime->tv_nsec += ( long ) ( ullNanoSeconds % ( uint64_t ) portNANO_SECONDS_PER_SECOND );
+
+	if( pxTime->tv_nsec >= portNANO_SECONDS_PER_SECOND )
+	{
+		pxTime->tv_nsec -= portNANO_SECONDS_PER_SECOND;
+		pxTime->tv_sec++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static int64_t prvNanoSecondsBetween( const struct timespec *pxStart, const struct timespec *pxEnd )
+{
+	return ( ( int64_t ) ( pxEnd->tv_sec - pxStart->tv_sec ) * portNANO_SECONDS_PER_SECOND ) + ( int64_t ) ( pxEnd->tv_nsec - pxStart->tv_nsec );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateSimulatedInterruptObjects( void )
+{
+struct sigaction xSignalAction;
+BaseType_t xCoreID;
+
+	for( xCoreID = 0; xCoreID < configNUM_CORES; xCoreID++ )
+	{
+		atomic_init( &( ulPendingInterrupts[ xCoreID ] ), 0UL );
+		pthread_cond_init( &( xCoreEvent[ xCoreID ] ), NULL );
+	}
+
+	atomic_init( &( xTaskLock.iLocked ), 0 );
+	atomic_init( &( xTaskLock.pvOwner ), NULL );
+	xTaskLock.uxNesting = 0;
+	atomic_init( &( xIsrLock.iLocked ), 0 );
+	atomic_init( &( xIsrLock.pvOwner ), NULL );
+	xIsrLock.uxNesting = 0;
+
+	sem_init( &xSuspendAcknowledge, 0, 0 );
+
+	/* As port_posix.c. */
+	memset( &xSignalAction, 0, sizeof( xSignalAction ) );
+	xSignalAction.sa_handler = prvSuspendSignalHandler;
+	xSignalAction.sa_flags = SA_RESTART;
+	sigemptyset( &xSignalAction.sa_mask );
+	sigaddset( &xSignalAction.sa_mask, portRESUME_SIGNAL );
+	sigaction( portSUSPEND_SIGNAL, &xSignalAction, NULL );
+
+	xSignalAction.sa_handler = prvResumeSignalHandler;
+	sigaction( portRESUME_SIGNAL, &xSignalAction, NULL );
+
+	xSimulatedInterruptObjectsCreated = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTaskThreadEntry( void *pvParameter )
+{
+xThreadState *pxThreadState = ( xThreadState * ) pvParameter;
+sigset_t xSignals;
+
+	pxThreadStateOfThisThread = pxThreadState;
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portSUSPEND_SIGNAL );
+	pthread_sigmask( SIG_UNBLOCK, &xSignals, NULL );
+
+	/* Don't start executing the task until a core selects it. */
+	prvWaitUntilRunning( pxThreadState );
+
+	pxThreadState->pxCode( pxThreadState->pvParameters );
+
+	/* Tasks must not attempt to return from their implementing function. */
+	configASSERT( pdFALSE );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitUntilRunning( xThreadState *pxThreadState )
+{
+sigset_t xWaitSignals;
+
+	/* See the comments in port_posix.c. */
+	pthread_sigmask( SIG_BLOCK, NULL, &xWaitSignals );
+	sigdelset( &xWaitSignals, portRESUME_SIGNAL );
+	sigdelset( &xWaitSignals, portSUSPEND_SIGNAL );
+
+	while( pxThreadState->xRunning == pdFALSE )
+	{
+		sigsuspend( &xWaitSignals );
+
+		if( pxThreadState->xClosed != pdFALSE )
+		{
+			pthread_exit( NULL );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendSignalHandler( int iSignal )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+int iSavedErrno = errno;
+
+	( void ) iSignal;
+
+	sem_post( &xSuspendAcknowledge );
+	prvWaitUntilRunning( pxThreadState );
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeSignalHandler( int iSignal )
+{
+	( void ) iSignal;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResumeThread( xThreadState *pxThreadState, BaseType_t xCoreID )
+{
+	pxThreadState->xCoreID = xCoreID;
+	pxThreadState->xRunning = pdTRUE;
+	pthread_kill( pxThreadState->xThread, portRESUME_SIGNAL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpinLockTake( xSpinLock *pxLock )
+{
+const void *pvThisThread = &cThreadIdentity;
+uint32_t ulSpins = 0UL;
+
+	if( atomic_load_explicit( &( pxLock->pvOwner ), memory_order_relaxed ) == pvThisThread )
+	{
+		/* Already held by this thread. */
+		pxLock->uxNesting++;
+	}
+	else
+	{
+		while( atomic_exchange_explicit( &( pxLock->iLocked ), 1, memory_order_acquire ) != 0 )
+		{
+			while( atomic_load_explicit( &( pxLock->iLocked ), memory_order_relaxed ) != 0 )
+			{
+				if( ++ulSpins >= ( uint32_t ) portSPIN_COUNT )
+				{
+					sched_yield();
+					ulSpins = 0UL;
+				}
+			}
+		}
+
+		atomic_store_explicit( &( pxLock->pvOwner ), pvThisThread, memory_order_relaxed );
+		pxLock->uxNesting = 1;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSpinLockGive( xSpinLock *pxLock )
+{
+	configASSERT( atomic_load_explicit( &( pxLock->pvOwner ), memory_order_relaxed ) == &cThreadIdentity );
+
+	pxLock->uxNesting--;
+
+	if( pxLock->uxNesting == 0 )
+	{
+		atomic_store_explicit( &( pxLock->pvOwner ), NULL, memory_order_relaxed );
+		atomic_store_explicit( &( pxLock->iLocked ), 0, memory_order_release );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWakeCore( BaseType_t xCoreID )
+{
+	pthread_mutex_lock( &xCoreEventMutex );
+	pthread_cond_broadcast( &( xCoreEvent[ xCoreID ] ) );
+	pthread_mutex_unlock( &xCoreEventMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRaiseInterrupt( BaseType_t xCoreID, uint32_t ulInterruptNumber )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+UBaseType_t uxNesting;
+
+	if( pxThreadState != NULL )
+	{
+		/* Disable interrupts so the task cannot move to another core between
+		reading its core number and setting the interrupt pending. */
+		uxNesting = atomic_fetch_add( &( pxThreadState->uxCriticalNesting ), 1 );
+
+		if( xCoreID == portCALLING_CORE )
+		{
+			xCoreID = pxThreadState->xCoreID;
+		}
+
+		atomic_fetch_or( &( ulPendingInterrupts[ xCoreID ] ), ( uint32_t ) ( 1UL << ulInterruptNumber ) );
+		prvWakeCore( xCoreID );
+
+		atomic_fetch_sub( &( pxThreadState->uxCriticalNesting ), 1 );
+
+		/* As in port_posix.c, a task that raises an interrupt on its own core
+		with interrupts enabled does not continue until it is processed.  If
+		interrupts are disabled it is processed when they are enabled again. */
+		if( uxNesting == portNO_CRITICAL_NESTING )
+		{
+			prvYieldToPendingInterrupts();
+		}
+	}
+	else
+	{
+		/* Called from a simulated interrupt handler, or from a thread that
+		simulates a peripheral. */
+		if( xCoreID == portCALLING_CORE )
+		{
+			xCoreID = xCoreIDOfThisThread;
+		}
+
+		atomic_fetch_or( &( ulPendingInterrupts[ xCoreID ] ), ( uint32_t ) ( 1UL << ulInterruptNumber ) );
+		prvWakeCore( xCoreID );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldToPendingInterrupts( void )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+
+	/* The simulated interrupt processing thread cannot hold the ISR lock at
+	the same time, so while it is held the task's core cannot change and the
+	pending interrupts cannot be cleared. */
+	prvSpinLockTake( &xIsrLock );
+
+	if( atomic_load( &( ulPendingInterrupts[ pxThreadState->xCoreID ] ) ) != 0UL )
+	{
+		/* Releases the ISR lock. */
+		prvWaitForInterruptProcessing();
+	}
+	else
+	{
+		prvSpinLockGive( &xIsrLock );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitForInterruptProcessing( void )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+const BaseType_t xCoreID = pxThreadState->xCoreID;
+
+	/* This thread has stopped executing task code of its own accord, so the
+	simulated interrupt processing thread does not need to signal it. */
+	pxThreadState->xRunning = pdFALSE;
+	prvSpinLockGive( &xIsrLock );
+	prvWakeCore( xCoreID );
+
+	prvWaitUntilRunning( pxThreadState );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+xThreadState *pxThreadState = NULL;
+int8_t *pcTopOfStack = ( int8_t * ) pxTopOfStack;
+sigset_t xSignals, xOldSignals;
+int iResult;
+
+	( void ) pthread_once( &xSimulatedInterruptObjectsOnce, prvCreateSimulatedInterruptObjects );
+
+	/* See the comments in port_posix.c. */
+	pxThreadState = ( xThreadState * ) ( pcTopOfStack - sizeof( xThreadState ) );
+	pxThreadState->pxCode = pxCode;
+	pxThreadState->pvParameters = pvParameters;
+	pxThreadState->xRunning = pdFALSE;
+	pxThreadState->xClosed = pdFALSE;
+	pxThreadState->xCoreID = 0;
+	atomic_init( &( pxThreadState->uxCriticalNesting ), portNO_CRITICAL_NESTING );
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, portSUSPEND_SIGNAL );
+	sigaddset( &xSignals, portRESUME_SIGNAL );
+	pthread_sigmask( SIG_BLOCK, &xSignals, &xOldSignals );
+	iResult = pthread_create( &( pxThreadState->xThread ), NULL, prvTaskThreadEntry, pxThreadState );
+	pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+	configASSERT( iResult == 0 );
+	( void ) iResult;
+
+	return ( StackType_t * ) pxThreadState;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+pthread_t xThread;
+BaseType_t xCoreID;
+int32_t lSuccess = pdPASS;
+
+	/* Install the interrupt handlers used by the scheduler itself. */
+	vPortSetInterruptHandler( portINTERRUPT_YIELD, prvProcessYieldInterrupt );
+	vPortSetInterruptHandler( portINTERRUPT_TICK, prvProcessTickInterrupt );
+
+	( void ) pthread_once( &xSimulatedInterruptObjectsOnce, prvCreateSimulatedInterruptObjects );
+
+	xPortRunning = pdTRUE;
+
+	/* Start the thread that simulates the timer peripheral, then a simulated
+	interrupt processing thread for each core other than core 0. */
+	if( pthread_create( &xThread, NULL, prvSimulatedPeripheralTimer, NULL ) != 0 )
+	{
+		lSuccess = pdFAIL;
+	}
+
+	for( xCoreID = 1; ( xCoreID < configNUM_CORES ) && ( lSuccess == pdPASS ); xCoreID++ )
+	{
+		if( pthread_create( &xThread, NULL, prvProcessSimulatedInterrupts, ( void * ) ( size_t ) xCoreID ) != 0 )
+		{
+			lSuccess = pdFAIL;
+		}
+	}
+
+	if( lSuccess == pdPASS )
+	{
+		/* This thread processes the interrupts of core 0. */
+		( void ) prvProcessSimulatedInterrupts( ( void * ) ( size_t ) 0 );
+	}
+
+	/* Would not expect to return from prvProcessSimulatedInterrupts(), so should
+	not get here. */
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvProcessYieldInterrupt( void )
+{
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvProcessTickInterrupt( void )
+{
+uint32_t ulSwitchRequired;
+
+	/* Process the tick itself.  xTaskIncrementTick() interrupts any other
+	core that has to switch context as a result. */
+	configASSERT( xPortRunning );
+	ulSwitchRequired = ( uint32_t ) xTaskIncrementTick();
+
+	return ulSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvProcessSimulatedInterrupts( void *pvCoreID )
+{
+const BaseType_t xCoreID = ( BaseType_t ) ( size_t ) pvCoreID;
+uint32_t ulSwitchRequired, ulInterrupts, i;
+xThreadState *pxThreadState;
+
+	xCoreIDOfThisThread = xCoreID;
+
+	/* Start the task vTaskStartScheduler() selected to run on this core. */
+	prvSpinLockTake( &xIsrLock );
+	prvResumeThread( ( xThreadState * ) *( ( size_t * ) pxCurrentTCBs[ xCoreID ] ), xCoreID );
+	prvSpinLockGive( &xIsrLock );
+
+	pthread_mutex_lock( &xCoreEventMutex );
+
+	for( ;; )
+	{
+		/* Only this thread changes the task running on this core, so the
+		thread state can be read without holding a lock.  Interrupts are not
+		processed while they are disabled by the running task. */
+		pxThreadState = ( xThreadState * ) *( ( size_t * ) pxCurrentTCBs[ xCoreID ] );
+
+		while( ( atomic_load( &( ulPendingInterrupts[ xCoreID ] ) ) == 0UL ) ||
+			   ( ( pxThreadState->xRunning != pdFALSE ) && ( atomic_load( &( pxThreadState->uxCriticalNesting ) ) != portNO_CRITICAL_NESTING ) ) )
+		{
+			pthread_cond_wait( &( xCoreEvent[ xCoreID ] ), &xCoreEventMutex );
+		}
+
+		pthread_mutex_unlock( &xCoreEventMutex );
+
+		/* Interrupt handlers run with the ISR lock held, so they are not
+		executed in parallel with a critical section on another core, or with
+		the interrupt handlers of another core. */
+		prvSpinLockTake( &xIsrLock );
+
+		/* Stop the task running on this core, if it has not already stopped
+		itself.  The task can disable interrupts after the test above, in
+		which case it must be left running.  It can also do so after the test
+		below and before the signal arrives, so the test is repeated once the
+		thread has stopped. */
+		if( pxThreadState->xRunning != pdFALSE )
+		{
+			if( atomic_load( &( pxThreadState->uxCriticalNesting ) ) != portNO_CRITICAL_NESTING )
+			{
+				prvSpinLockGive( &xIsrLock );
+				pthread_mutex_lock( &xCoreEventMutex );
+				continue;
+			}
+
+			pxThreadState->xRunning = pdFALSE;
+			pthread_kill( pxThreadState->xThread, portSUSPEND_SIGNAL );
+
+			while( sem_wait( &xSuspendAcknowledge ) != 0 )
+			{
+				/* Interrupted by a signal, wait again. */
+			}
+
+			if( atomic_load( &( pxThreadState->uxCriticalNesting ) ) != portNO_CRITICAL_NESTING )
+			{
+				prvResumeThread( pxThreadState, xCoreID );
+				prvSpinLockGive( &xIsrLock );
+				pthread_mutex_lock( &xCoreEventMutex );
+				continue;
+			}
+		}
+
+		/* Take all the interrupts pending on this core.  Any raised while the
+		handlers execute are processed on the next iteration. */
+		ulInterrupts = atomic_exchange( &( ulPendingInterrupts[ xCoreID ] ), 0UL );
+		ulSwitchRequired = pdFALSE;
+
+		for( i = 0; i < portMAX_INTERRUPTS; i++ )
+		{
+			if( ( ulInterrupts & ( 1UL << i ) ) != 0UL )
+			{
+				if( ulIsrHandler[ i ] != NULL )
+				{
+					if( ulIsrHandler[ i ]() != pdFALSE )
+					{
+						ulSwitchRequired |= ( 1 << i );
+					}
+				}
+			}
+		}
+
+		if( ulSwitchRequired != pdFALSE )
+		{
+			/* Select the next task to run on this core. */
+			vTaskSwitchContext();
+		}
+
+		/* Let the thread of the task now running on this core continue. */
+		prvResumeThread( ( xThreadState * ) *( ( size_t * ) pxCurrentTCBs[ xCoreID ] ), xCoreID );
+		prvSpinLockGive( &xIsrLock );
+
+		pthread_mutex_lock( &xCoreEventMutex );
+	}
+
+	/* Should never reach here. */
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDeleteThread( void *pvTaskToDelete )
+{
+xThreadState *pxThreadState;
+int iErrorCode;
+
+	/* Remove compiler warnings if configASSERT() is not defined. */
+	( void ) iErrorCode;
+
+	pxThreadState = ( xThreadState * ) ( *( size_t *) pvTaskToDelete );
+
+	/* The kernel only frees a task that is not running on any core, so its
+	thread is parked.  See the comments in port_posix.c. */
+	if( pxThreadState->xClosed == pdFALSE )
+	{
+		pxThreadState->xClosed = pdTRUE;
+		pthread_kill( pxThreadState->xThread, portRESUME_SIGNAL );
+
+		iErrorCode = pthread_join( pxThreadState->xThread, NULL );
+		configASSERT( iErrorCode == 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortCloseRunningThread( void *pvTaskToDelete, volatile BaseType_t *pxPendYield )
+{
+xThreadState *pxThreadState;
+BaseType_t xCoreID;
+
+	pxThreadState = ( xThreadState * ) ( *( size_t *) pvTaskToDelete );
+	xCoreID = pxThreadState->xCoreID;
+
+	/* This function will not return, so the core must switch to another task
+	as soon as the critical section is exited below. */
+	*pxPendYield = pdTRUE;
+	atomic_fetch_or( &( ulPendingInterrupts[ xCoreID ] ), ( uint32_t ) ( 1UL << portINTERRUPT_YIELD ) );
+
+	pxThreadState->xClosed = pdTRUE;
+	pxThreadState->xRunning = pdFALSE;
+	pthread_detach( pthread_self() );
+
+	/* This is called from a critical section.  The locks are released once
+	for each nesting level as they would otherwise be left held by a thread
+	that no longer exists. */
+	while( atomic_load( &( pxThreadState->uxCriticalNesting ) ) > portNO_CRITICAL_NESTING )
+	{
+		prvSpinLockGive( &xIsrLock );
+		prvSpinLockGive( &xTaskLock );
+		atomic_fetch_sub( &( pxThreadState->uxCriticalNesting ), 1 );
+	}
+
+	prvWakeCore( xCoreID );
+
+	pthread_exit( NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* This function IS NOT TESTED! */
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber )
+{
+	configASSERT( xPortRunning );
+
+	if( ( ulInterruptNumber < portMAX_INTERRUPTS ) && ( xSimulatedInterruptObjectsCreated != pdFALSE ) )
+	{
+		/* A yield is a request to switch context on the calling core.  All
+		other interrupts are routed to core 0. */
+		if( ulInterruptNumber == portINTERRUPT_YIELD )
+		{
+			prvRaiseInterrupt( portCALLING_CORE, ulInterruptNumber );
+		}
+		else
+		{
+			prvRaiseInterrupt( 0, ulInterruptNumber );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldCore( BaseType_t xCoreID )
+{
+	configASSERT( xCoreID < configNUM_CORES );
+
+	if( xPortRunning != pdFALSE )
+	{
+		prvRaiseInterrupt( xCoreID, portINTERRUPT_YIELD );
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortGetCoreID( void )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+BaseType_t xReturn;
+
+	if( pxThreadState != NULL )
+	{
+		xReturn = pxThreadState->xCoreID;
+	}
+	else
+	{
+		xReturn = xCoreIDOfThisThread;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t (*pvHandler)( void ) )
+{
+	if( ulInterruptNumber < portMAX_INTERRUPTS )
+	{
+		vPortEnterCritical();
+		ulIsrHandler[ ulInterruptNumber ] = pvHandler;
+		vPortExitCritical();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+
+	if( xPortRunning == pdTRUE )
+	{
+		if( pxThreadState == NULL )
+		{
+			/* Interrupt handlers and peripheral threads only need to exclude
+			critical sections and the interrupt handlers of other cores. */
+			prvSpinLockTake( &xIsrLock );
+		}
+		else if( atomic_load( &( pxThreadState->uxCriticalNesting ) ) == portNO_CRITICAL_NESTING )
+		{
+			for( ;; )
+			{
+				/* Disable interrupts before taking the locks, so the task is
+				not stopped while it holds them. */
+				atomic_store( &( pxThreadState->uxCriticalNesting ), 1 );
+				prvSpinLockTake( &xTaskLock );
+				prvSpinLockTake( &xIsrLock );
+
+				/* Another core might have suspended or deleted this task, or
+				selected a higher priority task to run on this core, while
+				this thread was waiting for the locks.  If so the task must
+				not continue until this core has switched context. */
+				if( atomic_load( &( ulPendingInterrupts[ pxThreadState->xCoreID ] ) ) == 0UL )
+				{
+					break;
+				}
+
+				prvSpinLockGive( &xIsrLock );
+				prvSpinLockGive( &xTaskLock );
+				atomic_store( &( pxThreadState->uxCriticalNesting ), portNO_CRITICAL_NESTING );
+				prvYieldToPendingInterrupts();
+			}
+		}
+		else
+		{
+			atomic_fetch_add( &( pxThreadState->uxCriticalNesting ), 1 );
+			prvSpinLockTake( &xTaskLock );
+			prvSpinLockTake( &xIsrLock );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+
+	if( xPortRunning == pdTRUE )
+	{
+		if( pxThreadState == NULL )
+		{
+			prvSpinLockGive( &xIsrLock );
+		}
+		else if( atomic_load( &( pxThreadState->uxCriticalNesting ) ) > portNO_CRITICAL_NESTING )
+		{
+			prvSpinLockGive( &xIsrLock );
+			prvSpinLockGive( &xTaskLock );
+
+			/* Were any interrupts set pending on this core while interrupts
+			were disabled?  If so the task must not continue until they have
+			been processed. */
+			if( atomic_fetch_sub( &( pxThreadState->uxCriticalNesting ), 1 ) == 1 )
+			{
+				if( atomic_load( &( ulPendingInterrupts[ pxThreadState->xCoreID ] ) ) != 0UL )
+				{
+					prvYieldToPendingInterrupts();
+				}
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTaskLock( void )
+{
+	if( ( xPortRunning == pdTRUE ) && ( pxThreadStateOfThisThread != NULL ) )
+	{
+		prvSpinLockTake( &xTaskLock );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortReleaseTaskLock( void )
+{
+	if( ( xPortRunning == pdTRUE ) && ( pxThreadStateOfThisThread != NULL ) )
+	{
+		prvSpinLockGive( &xTaskLock );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortWaitForInterrupt( void )
+{
+xThreadState *pxThreadState = pxThreadStateOfThisThread;
+
+	/* Called by the idle tasks.  Park the thread until the next interrupt on
+	this core has been processed, rather than spinning. */
+	if( ( xPortRunning == pdTRUE ) && ( pxThreadState != NULL ) && ( atomic_load( &( pxThreadState->uxCriticalNesting ) ) == portNO_CRITICAL_NESTING ) )
+	{
+		prvSpinLockTake( &xIsrLock );
+		prvWaitForInterruptProcessing();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configNUM_CORES */
+
+#endif /* _WIN32 */
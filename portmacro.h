@@ -70,7 +70,9 @@
 #ifndef PORTMACRO_H
 #define PORTMACRO_H
 
-#include <Windows.h>
+#ifdef _WIN32
+	#include <Windows.h>
+#endif
 
 /******************************************************************************
 	Defines
@@ -93,6 +95,17 @@ typedef unsigned long UBaseType_t;
 #if( configUSE_16_BIT_TICKS == 1 )
     typedef uint16_t TickType_t;
     #define portMAX_DELAY ( TickType_t ) 0xffff
+#elif( configUSE_64_BIT_TICKS == 1 )
+    typedef uint64_t TickType_t;
+    #define portMAX_DELAY ( TickType_t ) 0xffffffffffffffffULL
+
+    /* The tick count never overflows (see configUSE_64_BIT_TICKS), and can
+    still be read with a single load, but only on a 64-bit host. */
+    #if defined( __LP64__ ) || defined( _WIN64 )
+        #define portTICK_TYPE_IS_ATOMIC 1
+    #else
+        #error configUSE_64_BIT_TICKS can only be set to 1 on a 64-bit host.
+    #endif
 #else
     typedef uint32_t TickType_t;
     #define portMAX_DELAY ( TickType_t ) 0xffffffffUL
@@ -134,6 +147,121 @@ void vPortExitCritical( void );
 #define portENTER_CRITICAL()		vPortEnterCritical()
 #define portEXIT_CRITICAL()			vPortExitCritical()
 
+/* Multiple core (SMP) simulation support.  Each core runs its tasks on its own
+host thread, and has its own simulated interrupt handler thread. */
+#ifndef configNUM_CORES
+	#define configNUM_CORES 1
+#endif
+
+#if( configNUM_CORES > 1 )
+	BaseType_t xPortGetCoreID( void );
+	void vPortYieldCore( BaseType_t xCoreID );
+	void vPortGetTaskLock( void );
+	void vPortReleaseTaskLock( void );
+	void vPortWaitForInterrupt( void );
+
+	#define portGET_CORE_ID()			xPortGetCoreID()
+	#define portYIELD_CORE( xCoreID )	vPortYieldCore( ( xCoreID ) )
+	#define portGET_TASK_LOCK()			vPortGetTaskLock()
+	#define portRELEASE_TASK_LOCK()		vPortReleaseTaskLock()
+	#define portWAIT_FOR_INTERRUPT()	vPortWaitForInterrupt()
+#endif /* configNUM_CORES */
+
+/* Tickless idle/virtual time support. */
+#ifndef configUSE_VIRTUAL_TIME
+	#define configUSE_VIRTUAL_TIME 0
+#endif
+
+#if( ( configUSE_VIRTUAL_TIME == 1 ) && ( configUSE_TICKLESS_IDLE == 0 ) )
+	#error configUSE_TICKLESS_IDLE must be set to 1 when configUSE_VIRTUAL_TIME is set to 1 as the tick count is moved forward from the idle task.
+#endif
+
+/* Fiber (single host thread) support. */
+#ifndef configUSE_FIBERS
+	#define configUSE_FIBERS 0
+#endif
+
+#if( ( configUSE_FIBERS != 0 ) && ( configNUM_CORES > 1 ) )
+	#error configUSE_FIBERS cannot be used when configNUM_CORES is greater than 1 as all the tasks run on a single host thread.
+#endif
+
+/* Record and replay support. */
+#ifndef configUSE_JOURNAL
+	#define configUSE_JOURNAL 0
+#endif
+
+#if( configUSE_JOURNAL == 1 )
+	#if defined( _WIN32 ) || ( configNUM_CORES > 1 ) || ( configUSE_FIBERS != 0 )
+		#error configUSE_JOURNAL can only be set to 1 in the POSIX port that runs each task in its own thread on a single core.
+	#endif
+
+	/*
+	 * Record the run to pcFileName, or replay the run recorded in it if xReplay
+	 * is pdTRUE.  Must be called before the scheduler is started.  Returns
+	 * pdPASS if the file could be opened.
+	 */
+	BaseType_t xPortJournalOpen( const char *pcFileName, BaseType_t xReplay );
+
+	/*
+	 * Write xLength bytes of host data, such as a line read from stdin, to the
+	 * journal being recorded, or overwrite them with the bytes recorded in the
+	 * journal being replayed.  Must be called from a simulated interrupt handler
+	 * or from within a critical section.
+	 */
+	void vPortJournalData( void *pvData, size_t xLength );
+	BaseType_t xPortJournalReplaying( void );
+
+	#define portJOURNAL_DATA( pvData, xLength )	vPortJournalData( ( pvData ), ( xLength ) )
+	#define portJOURNAL_REPLAYING()				xPortJournalReplaying()
+#else
+	#define portJOURNAL_DATA( pvData, xLength )
+	#define portJOURNAL_REPLAYING()				pdFALSE
+#endif /* configUSE_JOURNAL */
+
+/* The idle task of the single core POSIX ports sleeps until the next simulated
+interrupt, rather than spinning, even when ticks are not suppressed. */
+#if !defined( _WIN32 ) && ( configNUM_CORES == 1 )
+	void vPortWaitForInterrupt( void );
+
+	#define portWAIT_FOR_INTERRUPT()	vPortWaitForInterrupt()
+#endif
+
+/* A count of nanoseconds of host time, from the host's monotonic clock.  It is
+used as the run time stats clock and to timestamp trace events.  It keeps
+measuring host time when configUSE_VIRTUAL_TIME is 1, so time that is skipped
+over by the tick count is not counted. */
+#ifdef _WIN32
+	uint64_t ullPortGetRunTimeCounterValue( void );
+#else
+	#include <time.h>
+
+	static portINLINE uint64_t ullPortGetRunTimeCounterValue( void )
+	{
+	struct timespec xNow;
+
+		clock_gettime( CLOCK_MONOTONIC, &xNow );
+		return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+	}
+#endif
+
+/* Run time stats support.  configRUN_TIME_COUNTER_TYPE should be set to
+uint64_t, as a 32-bit count of nanoseconds overflows after 4.3 seconds. */
+#ifndef configGENERATE_RUN_TIME_STATS
+	#define configGENERATE_RUN_TIME_STATS 0
+#endif
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	/* The counter is never 0, as the kernel uses 0 to mean a task is not
+	blocked, and needs no configuration. */
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+	#define portGET_RUN_TIME_COUNTER_VALUE()	( ( configRUN_TIME_COUNTER_TYPE ) ullPortGetRunTimeCounterValue() )
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+#if( configUSE_TICKLESS_IDLE != 0 )
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
 	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
 #endif
@@ -141,27 +269,79 @@ void vPortExitCritical( void );
 #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
 
 	/* Check the configuration. */
-	#if( configMAX_PRIORITIES > 32 )
-		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+	#if( configMAX_PRIORITIES > 1024 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
 	#endif
 
-	/* Store/clear the ready priorities in a bit map. */
-	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
-	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
-
-
-	/*-----------------------------------------------------------*/
-
-	#ifdef __GNUC__
-		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )	\
+	/* The index of the most significant set bit in a non-zero 32-bit word. */
+	#if defined( __GNUC__ ) && defined( _WIN32 )
+		#define portGET_HIGHEST_SET_BIT( uxBit, ulBits )						\
 			__asm volatile(	"bsr %1, %0\n\t" 									\
-							:"=r"(uxTopPriority) : "rm"(uxReadyPriorities) : "cc" )
+							:"=r"(uxBit) : "rm"(ulBits) : "cc" )
+	#elif defined( __GNUC__ )
+		/* POSIX hosts are not necessarily x86, so use the compiler builtin. */
+		#define portGET_HIGHEST_SET_BIT( uxBit, ulBits ) uxBit = ( 31UL - ( UBaseType_t ) __builtin_clz( ( uint32_t ) ( ulBits ) ) )
 	#else
 		/* BitScanReverse returns the bit position of the most significant '1'
 		in the word. */
-		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) _BitScanReverse( ( DWORD * ) &( uxTopPriority ), ( uxReadyPriorities ) )
+		#define portGET_HIGHEST_SET_BIT( uxBit, ulBits ) _BitScanReverse( ( DWORD * ) &( uxBit ), ( ulBits ) )
 	#endif /* __GNUC__ */
 
+	/*-----------------------------------------------------------*/
+
+	#if( configMAX_PRIORITIES <= 32 )
+
+		/* Store/clear the ready priorities in a bit map. */
+		#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+		#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+		/* Only the low 32 bits of the bitmap are used. */
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) portGET_HIGHEST_SET_BIT( uxTopPriority, uxReadyPriorities )
+
+	#else
+
+		/* More priorities than there are bits in a word are held in a two level
+		bit map.  Each word of ulPriorities holds the ready bits of a group of
+		32 priorities, and a bit in ulGroups is set when the word for its group
+		is not zero, so the highest ready priority is found with two bit scans
+		however many priorities there are.  The kernel declares
+		uxTopReadyPriority with this type. */
+		#define portREADY_PRIORITY_GROUPS	( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+		typedef struct PORT_READY_PRIORITIES
+		{
+			uint32_t ulGroups;
+			uint32_t ulPriorities[ portREADY_PRIORITY_GROUPS ];
+		} PortReadyPriorities_t;
+
+		#define portREADY_PRIORITIES_TYPE PortReadyPriorities_t
+
+		#define portRECORD_READY_PRIORITY( uxPriority, xReadyPriorities )									\
+		{																									\
+			( xReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 31UL ) );	\
+			( xReadyPriorities ).ulGroups |= ( 1UL << ( ( uxPriority ) >> 5 ) );							\
+		}
+
+		#define portRESET_READY_PRIORITY( uxPriority, xReadyPriorities )									\
+		{																									\
+			( xReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 31UL ) );	\
+			if( ( xReadyPriorities ).ulPriorities[ ( uxPriority ) >> 5 ] == 0UL )							\
+			{																								\
+				( xReadyPriorities ).ulGroups &= ~( 1UL << ( ( uxPriority ) >> 5 ) );						\
+			}																								\
+		}
+
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, xReadyPriorities )									\
+		{																									\
+		UBaseType_t uxGroup, uxBit;																			\
+																											\
+			portGET_HIGHEST_SET_BIT( uxGroup, ( xReadyPriorities ).ulGroups );								\
+			portGET_HIGHEST_SET_BIT( uxBit, ( xReadyPriorities ).ulPriorities[ uxGroup ] );					\
+			( uxTopPriority ) = ( uxGroup << 5 ) + uxBit;													\
+		}
+
+	#endif /* configMAX_PRIORITIES */
+
 #endif /* taskRECORD_READY_PRIORITY */
 
 #ifndef __GNUC__
@@ -185,14 +365,54 @@ void vPortGenerateSimulatedInterrupt( uint32_t ulInterruptNumber );
 
 /*
  * Install an interrupt handler to be called by the simulated interrupt handler
- * thread.  The interrupt number must be above any used by the kernel itself
- * (at the time of writing the kernel was using interrupt numbers 0, 1, and 2
- * as defined above).  The number must also be lower than 32.
+ * thread (the thread that started the scheduler in the POSIX port).  The
+ * interrupt number must be above any used by the kernel itself (at the time of
+ * writing the kernel was using interrupt numbers 0, 1, and 2 as defined above).
+ * The number must also be lower than 32 (256 in the POSIX port).
  *
  * Interrupt handler functions must return a non-zero value if executing the
  * handler resulted in a task switch being required.
  */
 void vPortSetInterruptHandler( uint32_t ulInterruptNumber, uint32_t (*pvHandler)( void ) );
 
+/* Simulated interrupt priorities.  Only the POSIX port that runs each task in
+its own thread, on a single core, models an interrupt controller with
+priorities. */
+#if !defined( _WIN32 ) && ( configNUM_CORES == 1 ) && ( configUSE_FIBERS == 0 )
+
+	/* Priority 0 is the most urgent. */
+	#define portINTERRUPT_PRIORITY_LEVELS	16
+
+	#ifndef configKERNEL_INTERRUPT_PRIORITY
+		#define configKERNEL_INTERRUPT_PRIORITY ( portINTERRUPT_PRIORITY_LEVELS - 1 )
+	#endif
+
+	/* By default critical sections mask every interrupt, as in the other
+	ports. */
+	#ifndef configMAX_SYSCALL_INTERRUPT_PRIORITY
+		#define configMAX_SYSCALL_INTERRUPT_PRIORITY 0
+	#endif
+
+	#if( ( configKERNEL_INTERRUPT_PRIORITY >= portINTERRUPT_PRIORITY_LEVELS ) || ( configMAX_SYSCALL_INTERRUPT_PRIORITY > configKERNEL_INTERRUPT_PRIORITY ) )
+		#error configKERNEL_INTERRUPT_PRIORITY must be less than portINTERRUPT_PRIORITY_LEVELS, and configMAX_SYSCALL_INTERRUPT_PRIORITY must not be more than configKERNEL_INTERRUPT_PRIORITY.
+	#endif
+
+	/*
+	 * Set the priority of a simulated interrupt, from 0 (the most urgent) to
+	 * portINTERRUPT_PRIORITY_LEVELS - 1.  Interrupts default to
+	 * configKERNEL_INTERRUPT_PRIORITY.
+	 */
+	void vPortSetInterruptPriority( uint32_t ulInterruptNumber, uint32_t ulPriority );
+
+	UBaseType_t uxPortSetInterruptMaskFromISR( void );
+	void vPortClearInterruptMaskFromISR( UBaseType_t uxNewMask );
+	void vPortValidateInterruptPriority( void );
+
+	#define portSET_INTERRUPT_MASK_FROM_ISR()			uxPortSetInterruptMaskFromISR()
+	#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )		vPortClearInterruptMaskFromISR( ( x ) )
+	#define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()	vPortValidateInterruptPriority()
+
+#endif /* _WIN32, configNUM_CORES, configUSE_FIBERS */
+
 #endif
 
@@ -0,0 +1,175 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A benchmark of the selection of the highest priority ready task, built with
+ * different numbers of priorities and with and without port optimised task
+ * selection.  A single task repeatedly raises its priority to the highest
+ * priority and lowers it back to priority 1.  Lowering the priority yields, so
+ * the scheduler must find the highest priority ready task again.  The generic
+ * selection does this by testing every empty ready list between the highest
+ * priority and priority 1.  The port optimised selection needs one bit scan,
+ * or two when configMAX_PRIORITIES is greater than 32 and the port uses a two
+ * level bit map.
+ *
+ * The benchmark is built in place of main.c, for example:
+ *
+ *   gcc -O2 -I. -DconfigUSE_FIBERS=1 -DconfigMAX_PRIORITIES=256 -DconfigUSE_PORT_OPTIMISED_TASK_SELECTION=0 priority_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o priority_benchmark -lpthread
+ *   ./priority_benchmark
+ *
+ * The task yields to itself, so no context is switched and the time measured
+ * is mostly that of vTaskPrioritySet() and the selection.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define prioITERATIONS			( 1000000UL )
+#define prioRUNS				( 5 )
+
+#define prioHIGH_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define prioLOW_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Raises and lowers its own priority prioITERATIONS times for each run, times
+ * the runs, then prints the fastest and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, prioLOW_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+uint32_t ulIteration;
+int iRun;
+double dStart, dTime, dFastest = 0.0;
+
+	( void ) pvParameters;
+
+	/* The fastest run is the one least disturbed by the host. */
+	for( iRun = 0; iRun < prioRUNS; iRun++ )
+	{
+		dStart = prvNanoseconds();
+
+		for( ulIteration = 0; ulIteration < prioITERATIONS; ulIteration++ )
+		{
+			/* Raising the priority records the highest priority as ready.
+			Lowering it again yields, and the selection has to find priority 1
+			from there. */
+			vTaskPrioritySet( NULL, prioHIGH_PRIORITY );
+			vTaskPrioritySet( NULL, prioLOW_PRIORITY );
+		}
+
+		dTime = prvNanoseconds() - dStart;
+
+		if( ( iRun == 0 ) || ( dTime < dFastest ) )
+		{
+			dFastest = dTime;
+		}
+	}
+
+	printf( "%lu priorities, %s selection: %.1f ns per iteration\n", ( unsigned long ) configMAX_PRIORITIES,
+			( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) ? "port optimised" : "generic", dFastest / ( double ) prioITERATIONS );
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
@@ -114,6 +114,27 @@ zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME		 ( ( TickType_t ) 0U )
 
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+	/* Bits set in ucZeroCopyState while a task holds a pointer into the queue
+	storage area obtained from xQueueSendReserve() or xQueueReceiveAcquire(). */
+	#define queueZERO_COPY_SEND_RESERVED		( ( uint8_t ) 0x01U )
+	#define queueZERO_COPY_RECEIVE_ACQUIRED		( ( uint8_t ) 0x02U )
+
+	/* While a slot is reserved nothing else can be written to the queue, as
+	anything sent to the back would be received after the uncommitted slot, and
+	anything sent to the front or overwritten could land in it.  While an item
+	is acquired it cannot be received again, and sending to the front or
+	overwriting would write into it, but sending to the back is safe because the
+	acquired item is still counted in uxMessagesWaiting. */
+	#define queueSEND_IS_BLOCKED( pxQueue, xCopyPosition ) ( ( ( ( pxQueue )->ucZeroCopyState & queueZERO_COPY_SEND_RESERVED ) != ( uint8_t ) 0U ) || ( ( ( ( pxQueue )->ucZeroCopyState & queueZERO_COPY_RECEIVE_ACQUIRED ) != ( uint8_t ) 0U ) && ( ( xCopyPosition ) != queueSEND_TO_BACK ) ) )
+	#define queueRECEIVE_IS_BLOCKED( pxQueue ) ( ( ( pxQueue )->ucZeroCopyState & queueZERO_COPY_RECEIVE_ACQUIRED ) != ( uint8_t ) 0U )
+	#define queueZERO_COPY_IN_PROGRESS( pxQueue ) ( ( pxQueue )->ucZeroCopyState != ( uint8_t ) 0U )
+#else
+	#define queueSEND_IS_BLOCKED( pxQueue, xCopyPosition ) ( pdFALSE )
+	#define queueRECEIVE_IS_BLOCKED( pxQueue ) ( pdFALSE )
+	#define queueZERO_COPY_IN_PROGRESS( pxQueue ) ( pdFALSE )
+#endif
+
 #if( configUSE_PREEMPTION == 0 )
 	/* If the cooperative scheduler is being used then a yield should not be
 	performed just because a higher priority task has been woken. */
@@ -149,6 +170,10 @@ typedef struct QueueDefinition
 	volatile int8_t cRxLock;		/*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 	volatile int8_t cTxLock;		/*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 
+	#if( configUSE_QUEUE_ZERO_COPY == 1 )
+		uint8_t ucZeroCopyState;	/*< queueZERO_COPY_SEND_RESERVED is set while the slot at pcWriteTo is reserved, queueZERO_COPY_RECEIVE_ACQUIRED while the item after u.pcReadFrom is acquired. */
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
 	#endif
@@ -291,6 +316,13 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		pxQueue->cRxLock = queueUNLOCKED;
 		pxQueue->cTxLock = queueUNLOCKED;
 
+		#if( configUSE_QUEUE_ZERO_COPY == 1 )
+		{
+			/* Any outstanding reservation or acquisition is discarded. */
+			pxQueue->ucZeroCopyState = ( uint8_t ) 0U;
+		}
+		#endif
+
 		if( xNewQueue == pdFALSE )
 		{
 			/* If there are tasks blocked waiting to read from the queue, then
@@ -403,7 +435,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		}
 
-		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes );
+		pxNewQueue = ( Queue_t * ) configQUEUE_MALLOC( sizeof( Queue_t ) + xQueueSizeInBytes );
 
 		if( pxNewQueue != NULL )
 		{
@@ -747,7 +779,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			highest priority task wanting to access the queue.  If the head item
 			in the queue is to be overwritten then it does not matter if the
 			queue is full. */
-			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+			if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) ) && ( queueSEND_IS_BLOCKED( pxQueue, xCopyPosition ) == pdFALSE ) )
 			{
 				traceQUEUE_SEND( pxQueue );
 				xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
@@ -951,7 +983,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	post). */
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+		if( ( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) ) && ( queueSEND_IS_BLOCKED( pxQueue, xCopyPosition ) == pdFALSE ) )
 		{
 			const int8_t cTxLock = pxQueue->cTxLock;
 
@@ -1261,7 +1293,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 			/* Is there data in the queue now?  To be running the calling task
 			must be the highest priority task wanting to access the queue. */
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_BLOCKED( pxQueue ) == pdFALSE ) )
 			{
 				/* Remember the read position in case the queue is only being
 				peeked. */
@@ -1461,7 +1493,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
 		/* Cannot block in an ISR, so check there is data available. */
-		if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+		if( ( uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_BLOCKED( pxQueue ) == pdFALSE ) )
 		{
 			const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -1552,7 +1584,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
 		/* Cannot block in an ISR, so check there is data available. */
-		if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+		if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_BLOCKED( pxQueue ) == pdFALSE ) )
 		{
 			traceQUEUE_PEEK_FROM_ISR( pxQueue );
 
@@ -1576,6 +1608,752 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	BaseType_t xQueueSendReserve( QueueHandle_t xQueue, void ** const ppvItem, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( ppvItem );
+
+		/* Semaphores and mutexes have no storage to hand out. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/* The blocking logic is the same as xQueueGenericSend() when sending
+		to the back of the queue, but the item is not copied and no task is
+		unblocked until xQueueSendCommit() is called. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( queueSEND_IS_BLOCKED( pxQueue, queueSEND_TO_BACK ) == pdFALSE ) )
+				{
+					/* The slot at pcWriteTo is the one the next item sent to
+					the back of the queue would be copied into. */
+					pxQueue->ucZeroCopyState |= queueZERO_COPY_SEND_RESERVED;
+					*ppvItem = ( void * ) pxQueue->pcWriteTo;
+
+					taskEXIT_CRITICAL();
+					return pdPASS;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was full and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_SEND_FAILED( pxQueue );
+						return errQUEUE_FULL;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return errQUEUE_FULL;
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	BaseType_t xQueueSendCommit( QueueHandle_t xQueue )
+	{
+	BaseType_t xReturn, xYieldRequired = pdFALSE;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			if( ( pxQueue->ucZeroCopyState & queueZERO_COPY_SEND_RESERVED ) != ( uint8_t ) 0U )
+			{
+				traceQUEUE_SEND( pxQueue );
+
+				/* The item is already in place, so just make it visible to
+				receivers as prvCopyDataToQueue() would have done. */
+				pxQueue->pcWriteTo += pxQueue->uxItemSize;
+				if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+				{
+					pxQueue->pcWriteTo = pxQueue->pcHead;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxQueue->uxMessagesWaiting++;
+				pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueZERO_COPY_SEND_RESERVED;
+
+				#if ( configUSE_QUEUE_SETS == 1 )
+				{
+					if( pxQueue->pxQueueSetContainer != NULL )
+					{
+						xYieldRequired = prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK );
+					}
+					else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#else /* configUSE_QUEUE_SETS */
+				{
+					/* If there was a task waiting for data to arrive on the
+					queue then unblock it now. */
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+					{
+						xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_QUEUE_SETS */
+
+				/* Tasks that tried to send while the slot was reserved treated
+				the queue as full, so unblock one of them if there is now room
+				for it. */
+				if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xYieldRequired != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				/* There is no reserved slot to commit. */
+				xReturn = pdFAIL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		configASSERT( xReturn == pdPASS );
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	BaseType_t xQueueReceiveAcquire( QueueHandle_t xQueue, void ** const ppvItem, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE;
+	TimeOut_t xTimeOut;
+	int8_t *pcItem;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( ppvItem );
+
+		/* Semaphores and mutexes have no storage to hand out. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/* The blocking logic is the same as xQueueGenericReceive(), but the
+		item is not copied and is not removed from the queue, so no task is
+		unblocked, until xQueueReceiveRelease() is called. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_BLOCKED( pxQueue ) == pdFALSE ) )
+				{
+					/* The oldest item is in the slot after u.pcReadFrom, which
+					is left unchanged until the item is released. */
+					pcItem = pxQueue->u.pcReadFrom + pxQueue->uxItemSize;
+					if( pcItem >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+					{
+						pcItem = pxQueue->pcHead;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					pxQueue->ucZeroCopyState |= queueZERO_COPY_RECEIVE_ACQUIRED;
+					*ppvItem = ( void * ) pcItem;
+
+					taskEXIT_CRITICAL();
+					return pdPASS;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was empty and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return errQUEUE_EMPTY;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return errQUEUE_EMPTY;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_ZERO_COPY == 1 )
+
+	BaseType_t xQueueReceiveRelease( QueueHandle_t xQueue )
+	{
+	BaseType_t xReturn, xYieldRequired = pdFALSE;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+
+		taskENTER_CRITICAL();
+		{
+			if( ( pxQueue->ucZeroCopyState & queueZERO_COPY_RECEIVE_ACQUIRED ) != ( uint8_t ) 0U )
+			{
+				traceQUEUE_RECEIVE( pxQueue );
+
+				/* Remove the item as prvCopyDataFromQueue() followed by
+				xQueueGenericReceive() would have done. */
+				pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
+				if( pxQueue->u.pcReadFrom >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+				{
+					pxQueue->u.pcReadFrom = pxQueue->pcHead;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxQueue->uxMessagesWaiting--;
+				pxQueue->ucZeroCopyState &= ( uint8_t ) ~queueZERO_COPY_RECEIVE_ACQUIRED;
+
+				/* There is now space in the queue, and tasks that tried to
+				send to the front of the queue while the item was acquired
+				treated the queue as full. */
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Tasks that tried to receive while the item was acquired
+				treated the queue as empty, so unblock one of them if there is
+				another item for it. */
+				if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xYieldRequired != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				/* There is no acquired item to release. */
+				xReturn = pdFAIL;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		configASSERT( xReturn == pdPASS );
+		return xReturn;
+	}
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCHING == 1 )
+
+	BaseType_t xQueueSendMany( QueueHandle_t xQueue, const void * const pvItemsToQueue, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+	TimeOut_t xTimeOut;
+	UBaseType_t uxItemsSent = ( UBaseType_t ) 0U, uxItemsToSend;
+	const int8_t *pcNextItem = ( const int8_t * ) pvItemsToQueue;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvItemsToQueue == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+
+		/* Semaphores and mutexes must be given one at a time. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/* The blocking logic is the same as xQueueGenericSend() when sending
+		to the back of the queue, except that each time the task runs it sends
+		as many of the remaining items as there is room for under a single
+		critical section, and only blocks again if there are items left. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				xYieldRequired = pdFALSE;
+
+				if( queueSEND_IS_BLOCKED( pxQueue, queueSEND_TO_BACK ) == pdFALSE )
+				{
+					uxItemsToSend = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+					if( uxItemsToSend > ( uxItemCount - uxItemsSent ) )
+					{
+						uxItemsToSend = uxItemCount - uxItemsSent;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					uxItemsToSend = ( UBaseType_t ) 0U;
+				}
+
+				while( uxItemsToSend > ( UBaseType_t ) 0U )
+				{
+					traceQUEUE_SEND( pxQueue );
+					( void ) prvCopyDataToQueue( pxQueue, pcNextItem, queueSEND_TO_BACK );
+					pcNextItem += pxQueue->uxItemSize;
+					uxItemsSent++;
+					uxItemsToSend--;
+
+					/* Unblock one waiting task per item sent, exactly as the
+					same number of calls to xQueueSend() would have done. */
+					#if ( configUSE_QUEUE_SETS == 1 )
+					{
+						if( pxQueue->pxQueueSetContainer != NULL )
+						{
+							if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+						{
+							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#else /* configUSE_QUEUE_SETS */
+					{
+						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+						{
+							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_QUEUE_SETS */
+				}
+
+				if( xYieldRequired != pdFALSE )
+				{
+					/* The yield is held pending until the critical section is
+					exited. */
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( uxItemsSent == uxItemCount )
+				{
+					taskEXIT_CRITICAL();
+					return ( BaseType_t ) uxItemsSent;
+				}
+				else if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					/* The queue is full and no block time is specified (or the
+					block time has expired) so return the number of items
+					that were sent. */
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return ( BaseType_t ) uxItemsSent;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					/* The block time applies to the call as a whole, not to
+					each item. */
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueFull( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* The timeout has expired. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return ( BaseType_t ) uxItemsSent;
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_QUEUE_BATCHING == 1 )
+
+	BaseType_t xQueueReceiveMany( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItemCount, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired = pdFALSE;
+	TimeOut_t xTimeOut;
+	UBaseType_t uxItemsReceived, x;
+	int8_t *pcNextItem = ( int8_t * ) pvBuffer;
+	Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( !( ( pvBuffer == NULL ) && ( uxMaxItemCount != ( UBaseType_t ) 0U ) ) );
+
+		/* Semaphores and mutexes must be taken one at a time. */
+		configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/* The blocking logic is the same as xQueueGenericReceive().  The task
+		only blocks while the queue is empty, and receives every item that is
+		available, up to uxMaxItemCount, as soon as there is at least one. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( queueRECEIVE_IS_BLOCKED( pxQueue ) == pdFALSE ) )
+				{
+					uxItemsReceived = pxQueue->uxMessagesWaiting;
+					if( uxItemsReceived > uxMaxItemCount )
+					{
+						uxItemsReceived = uxMaxItemCount;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					for( x = ( UBaseType_t ) 0U; x < uxItemsReceived; x++ )
+					{
+						traceQUEUE_RECEIVE( pxQueue );
+						prvCopyDataFromQueue( pxQueue, pcNextItem );
+						pcNextItem += pxQueue->uxItemSize;
+						pxQueue->uxMessagesWaiting--;
+
+						/* Unblock one waiting task per item received, exactly as
+						the same number of calls to xQueueReceive() would have
+						done. */
+						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+						{
+							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+							{
+								xYieldRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+
+					if( xYieldRequired != pdFALSE )
+					{
+						queueYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					taskEXIT_CRITICAL();
+					return ( BaseType_t ) uxItemsReceived;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* The queue was empty and no block time is specified (or
+						the block time has expired) so leave now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return 0;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					prvUnlockQueue( pxQueue );
+
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					/* Try again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+				{
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+
+#endif /* configUSE_QUEUE_BATCHING */
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
 {
 UBaseType_t uxReturn;
@@ -1639,7 +2417,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	{
 		/* The queue can only have been allocated dynamically - free it
 		again. */
-		vPortFree( pxQueue );
+		configQUEUE_FREE( pxQueue );
 	}
 	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 	{
@@ -1647,7 +2425,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		check before attempting to free the memory. */
 		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
 		{
-			vPortFree( pxQueue );
+			configQUEUE_FREE( pxQueue );
 		}
 		else
 		{
@@ -1917,7 +2695,8 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == ( UBaseType_t )  0 )
+		/* An acquired item cannot be received by another task. */
+		if( ( pxQueue->uxMessagesWaiting == ( UBaseType_t )  0 ) || ( queueRECEIVE_IS_BLOCKED( pxQueue ) != pdFALSE ) )
 		{
 			xReturn = pdTRUE;
 		}
@@ -1956,7 +2735,10 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		/* Tasks that cannot send because of an outstanding reservation or
+		acquisition must block rather than poll, and are unblocked again by
+		xQueueSendCommit() or xQueueReceiveRelease(). */
+		if( ( pxQueue->uxMessagesWaiting == pxQueue->uxLength ) || ( queueZERO_COPY_IN_PROGRESS( pxQueue ) != pdFALSE ) )
 		{
 			xReturn = pdTRUE;
 		}
@@ -1058,6 +1058,259 @@ UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue ) PRIVILEGED_FUNC
  */
 void vQueueDelete( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendReserve(
+								QueueHandle_t xQueue,
+								void **ppvItem,
+								TickType_t xTicksToWait
+							);
+ </pre>
+ *
+ * Reserve the slot in the queue storage area that the next item sent to the
+ * back of the queue would be copied into, so the item can be written in place
+ * instead of being built in a separate buffer and then copied by
+ * xQueueSend().  The item does not become available to receivers until
+ * xQueueSendCommit() is called.
+ *
+ * Only one slot can be reserved in a queue at a time.  Until the reservation
+ * is committed other attempts to send to the queue, from tasks or interrupts,
+ * behave as if the queue were full.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It must not be used on a semaphore or mutex, or
+ * from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue in which the slot is to be reserved.
+ *
+ * @param ppvItem Set to point to the reserved slot, which is uxItemSize bytes
+ * long.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for a slot to become free, exactly as for xQueueSend().
+ *
+ * @return pdPASS if a slot was reserved, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+   <pre>
+ void vAProducerTask( void *pvParameters )
+ {
+ struct AMessage *pxMessage;
+
+	for( ;; )
+	{
+		if( xQueueSendReserve( xQueue, ( void ** ) &pxMessage, portMAX_DELAY ) == pdPASS )
+		{
+			// Fill in the message directly in the queue storage area.
+			pxMessage->ucMessageID = 0xab;
+			xQueueSendCommit( xQueue );
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendReserve xQueueSendReserve
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendReserve( QueueHandle_t xQueue, void ** const ppvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>BaseType_t xQueueSendCommit( QueueHandle_t xQueue );</pre>
+ *
+ * Post the item written into the slot reserved by xQueueSendReserve() to the
+ * back of the queue.  A task blocked on the queue is unblocked exactly as if
+ * the item had been sent by xQueueSend().  The pointer obtained from
+ * xQueueSendReserve() must not be used after this call.
+ *
+ * @param xQueue The handle to the queue in which the slot was reserved.
+ *
+ * @return pdPASS if the item was posted, or pdFAIL if no slot was reserved.
+ *
+ * \defgroup xQueueSendCommit xQueueSendCommit
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveAcquire(
+									QueueHandle_t xQueue,
+									void **ppvItem,
+									TickType_t xTicksToWait
+								);
+ </pre>
+ *
+ * Obtain a pointer to the item at the front of a queue, so the item can be
+ * read in place instead of being copied out by xQueueReceive().  The item
+ * remains in the queue, and its slot cannot be reused, until
+ * xQueueReceiveRelease() is called.
+ *
+ * Only one item can be acquired from a queue at a time.  Until it is released
+ * other attempts to receive from or peek the queue behave as if the queue were
+ * empty, and attempts to send to the front of or overwrite the queue behave as
+ * if the queue were full.  Items can still be sent to the back of the queue.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It must not be used on a semaphore or mutex, or
+ * from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the item is to be acquired.
+ *
+ * @param ppvItem Set to point to the acquired item, which is uxItemSize bytes
+ * long.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item, exactly as for xQueueReceive().
+ *
+ * @return pdPASS if an item was acquired, otherwise errQUEUE_EMPTY.
+ *
+ * Example usage:
+   <pre>
+ void vAConsumerTask( void *pvParameters )
+ {
+ struct AMessage *pxMessage;
+
+	for( ;; )
+	{
+		if( xQueueReceiveAcquire( xQueue, ( void ** ) &pxMessage, portMAX_DELAY ) == pdPASS )
+		{
+			// Process the message where it is in the queue storage area.
+			vProcessMessage( pxMessage );
+			xQueueReceiveRelease( xQueue );
+		}
+	}
+ }
+ </pre>
+ * \defgroup xQueueReceiveAcquire xQueueReceiveAcquire
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveAcquire( QueueHandle_t xQueue, void ** const ppvItem, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>BaseType_t xQueueReceiveRelease( QueueHandle_t xQueue );</pre>
+ *
+ * Remove the item acquired by xQueueReceiveAcquire() from the queue.  A task
+ * blocked on the queue is unblocked exactly as if the item had been received
+ * by xQueueReceive().  The pointer obtained from xQueueReceiveAcquire() must
+ * not be used after this call.
+ *
+ * @param xQueue The handle to the queue from which the item was acquired.
+ *
+ * @return pdPASS if the item was removed, or pdFAIL if no item was acquired.
+ *
+ * \defgroup xQueueReceiveRelease xQueueReceiveRelease
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMany(
+							QueueHandle_t xQueue,
+							const void *pvItemsToQueue,
+							UBaseType_t uxItemCount,
+							TickType_t xTicksToWait
+						);
+ </pre>
+ *
+ * Post an array of items to the back of a queue.  As many of the items as
+ * there is room for are copied into the queue under a single critical section,
+ * rather than one critical section per item as when xQueueSend() is called in
+ * a loop.  Tasks blocked on the queue are unblocked exactly as if each item had
+ * been sent by xQueueSend().
+ *
+ * If the queue does not have room for all the items the calling task blocks
+ * until there is room for more, then continues, until either all the items
+ * have been sent or xTicksToWait has expired.  The items that were sent before
+ * the block time expired remain in the queue, in order, and the number of them
+ * is returned.
+ *
+ * configUSE_QUEUE_BATCHING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It must not be used on a semaphore or mutex, or
+ * from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItemsToQueue A pointer to uxItemCount items, stored contiguously,
+ * each of the size defined when the queue was created.
+ *
+ * @param uxItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block in
+ * total waiting for room for all the items.  The call will return immediately
+ * after sending the items there is room for if this is set to 0.
+ *
+ * @return The number of items posted, which is less than uxItemCount only if
+ * the block time expired.
+ *
+ * Example usage:
+   <pre>
+ void vATask( void *pvParameters )
+ {
+ struct AMessage xMessages[ 8 ];
+
+	// ... Fill in the messages.
+
+	// Send all eight messages, blocking for no more than 10 ticks in total.
+	if( xQueueSendMany( xQueue, xMessages, 8, ( TickType_t ) 10 ) != 8 )
+	{
+		// Only some of the messages were sent before the block time expired.
+	}
+ }
+ </pre>
+ * \defgroup xQueueSendMany xQueueSendMany
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMany( QueueHandle_t xQueue, const void * const pvItemsToQueue, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveMany(
+								QueueHandle_t xQueue,
+								void *pvBuffer,
+								UBaseType_t uxMaxItemCount,
+								TickType_t xTicksToWait
+							);
+ </pre>
+ *
+ * Receive up to uxMaxItemCount items from a queue into an array.  All the
+ * items are copied out of the queue under a single critical section.  Tasks
+ * blocked on the queue are unblocked exactly as if each item had been received
+ * by xQueueReceive().
+ *
+ * The calling task only blocks while the queue is empty.  As soon as at least
+ * one item is available every available item, up to uxMaxItemCount, is
+ * received and the function returns - it does not wait for uxMaxItemCount items
+ * to arrive.
+ *
+ * configUSE_QUEUE_BATCHING must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  It must not be used on a semaphore or mutex, or
+ * from an interrupt service routine.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxMaxItemCount
+ * items.
+ *
+ * @param uxMaxItemCount The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item should the queue be empty at the time of the call.
+ *
+ * @return The number of items received, which is 0 if the block time expired
+ * before any item was available.
+ *
+ * \defgroup xQueueReceiveMany xQueueReceiveMany
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMany( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>
@@ -0,0 +1,357 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A benchmark of xQueueSendMany() and xQueueReceiveMany() against the same
+ * items sent and received one at a time with xQueueSend() and xQueueReceive().
+ * For each batch size in qbBATCH_SIZES[] the benchmark task sends a batch of
+ * items of qbITEM_SIZE bytes to a queue, then receives them back, either with
+ * one call per item or with one call per batch, and prints the time per item.
+ * The times are those of the fastest of qbRUNS runs.  Every item carries a
+ * sequence number, which is checked as it is received.
+ *
+ * The batching functions are then checked where the queue has less room than
+ * is asked for:
+ *
+ * + Sending qbPARTIAL_ITEMS items to an empty queue of qbPARTIAL_LENGTH items,
+ *   with nothing receiving, returns qbPARTIAL_LENGTH once qbPARTIAL_BLOCK_TIME
+ *   ticks have passed, and the items sent are the first ones, in order.
+ *
+ * + The same send while a lower priority task receives qbPARTIAL_RECEIVED
+ *   items part way through continues once the task has made room, and
+ *   returns qbPARTIAL_LENGTH + qbPARTIAL_RECEIVED.
+ *
+ * + Receiving from an empty queue returns 0 once its block time has passed.
+ *
+ * The benchmark is built in place of main.c with the batching functions
+ * included:
+ *
+ *   gcc -O2 -I. -DconfigUSE_QUEUE_BATCHING=1 queue_batch_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o queue_batch_benchmark -lpthread
+ *   ./queue_batch_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#if( configUSE_QUEUE_BATCHING != 1 )
+	#error The benchmark must be built with configUSE_QUEUE_BATCHING set to 1.
+#endif
+
+#define qbMAX_BATCH				( 64 )
+#define qbITEMS					( 256000UL )
+#define qbRUNS					( 5 )
+
+/* The partial send checks. */
+#define qbPARTIAL_LENGTH		( 4 )
+#define qbPARTIAL_ITEMS			( 10 )
+#define qbPARTIAL_RECEIVED		( 3 )
+#define qbPARTIAL_BLOCK_TIME	( ( TickType_t ) 20 )
+
+#define qbBENCHMARK_PRIORITY	( tskIDLE_PRIORITY + 2 )
+
+/* An item, the same size as the I2C payload of main.c plus its command ID. */
+typedef struct BATCH_ITEM
+{
+	uint32_t ulSequence;
+	uint8_t ucPayload[ 24 ];
+} Item_t;
+
+#define qbITEM_SIZE				( sizeof( Item_t ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Times each batch size, checks the partial sends, prints the results and
+ * exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * The nanoseconds per item of the fastest of qbRUNS runs, each of which sends
+ * and receives qbITEMS items in batches of uxBatch.  The items are sent and
+ * received one at a time if xBatched is pdFALSE.
+ */
+static double prvTimeBatches( UBaseType_t uxBatch, BaseType_t xBatched );
+
+/*
+ * Checks the sends and receives that cannot complete, as described at the top
+ * of this file.
+ */
+static void prvCheckPartialSends( void );
+
+/*
+ * Receives qbPARTIAL_RECEIVED items from xPartialQueue once the benchmark task
+ * has blocked, then deletes itself.
+ */
+static void prvPartialReceiverTask( void *pvParameters );
+
+/*
+ * Stops the benchmark with a message if xPassed is pdFALSE.
+ */
+static void prvCheck( BaseType_t xPassed, const char *pcWhat );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static const UBaseType_t qbBATCH_SIZES[] = { 1, 4, 16, 64 };
+
+static QueueHandle_t xQueue = NULL, xPartialQueue = NULL;
+
+/* The items sent and received, and those taken by prvPartialReceiverTask(). */
+static Item_t xSent[ qbMAX_BATCH ], xReceived[ qbMAX_BATCH ];
+static Item_t xPartialReceived[ qbPARTIAL_RECEIVED ];
+static volatile BaseType_t xPartialReceivedCount = 0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xQueue = xQueueCreate( qbMAX_BATCH, qbITEM_SIZE );
+	xPartialQueue = xQueueCreate( qbPARTIAL_LENGTH, qbITEM_SIZE );
+	configASSERT( xQueue && xPartialQueue );
+
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, qbBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+double dSingle, dBatched;
+size_t xSize;
+
+	( void ) pvParameters;
+
+	printf( "%lu items of %u bytes sent then received in batches, best of %d runs\n\n", ( unsigned long ) qbITEMS, ( unsigned ) qbITEM_SIZE, qbRUNS );
+	printf( "Batch   xQueueSend/Receive (ns per item)   xQueueSendMany/ReceiveMany (ns per item)\n" );
+
+	for( xSize = 0; xSize < ( sizeof( qbBATCH_SIZES ) / sizeof( qbBATCH_SIZES[ 0 ] ) ); xSize++ )
+	{
+		dSingle = prvTimeBatches( qbBATCH_SIZES[ xSize ], pdFALSE );
+		dBatched = prvTimeBatches( qbBATCH_SIZES[ xSize ], pdTRUE );
+
+		printf( "%5u   %34.1f   %40.1f\n", ( unsigned ) qbBATCH_SIZES[ xSize ], dSingle, dBatched );
+	}
+
+	prvCheckPartialSends();
+	printf( "\nPartial send and receive checks passed\n" );
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeBatches( UBaseType_t uxBatch, BaseType_t xBatched )
+{
+uint32_t ulSequence = 0, ulExpected = 0;
+UBaseType_t uxItem;
+double dStart, dTime, dFastest = 1e30;
+int iRun;
+
+	for( iRun = 0; iRun < qbRUNS; iRun++ )
+	{
+		dStart = prvNanoseconds();
+
+		while( ulExpected < ( ( uint32_t ) ( iRun + 1 ) * qbITEMS ) )
+		{
+			for( uxItem = 0; uxItem < uxBatch; uxItem++ )
+			{
+				xSent[ uxItem ].ulSequence = ulSequence++;
+			}
+
+			if( xBatched != pdFALSE )
+			{
+				prvCheck( xQueueSendMany( xQueue, xSent, uxBatch, portMAX_DELAY ) == ( BaseType_t ) uxBatch, "xQueueSendMany() sent the whole batch" );
+				prvCheck( xQueueReceiveMany( xQueue, xReceived, uxBatch, portMAX_DELAY ) == ( BaseType_t ) uxBatch, "xQueueReceiveMany() received the whole batch" );
+			}
+			else
+			{
+				for( uxItem = 0; uxItem < uxBatch; uxItem++ )
+				{
+					xQueueSend( xQueue, &( xSent[ uxItem ] ), portMAX_DELAY );
+				}
+
+				for( uxItem = 0; uxItem < uxBatch; uxItem++ )
+				{
+					xQueueReceive( xQueue, &( xReceived[ uxItem ] ), portMAX_DELAY );
+				}
+			}
+
+			for( uxItem = 0; uxItem < uxBatch; uxItem++ )
+			{
+				prvCheck( xReceived[ uxItem ].ulSequence == ulExpected++, "The items were received in the order they were sent" );
+			}
+		}
+
+		dTime = ( prvNanoseconds() - dStart ) / ( double ) qbITEMS;
+
+		if( dTime < dFastest )
+		{
+			dFastest = dTime;
+		}
+	}
+
+	return dFastest;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckPartialSends( void )
+{
+Item_t xItems[ qbPARTIAL_ITEMS ];
+BaseType_t xItem, xCount;
+TickType_t xStart;
+
+	for( xItem = 0; xItem < qbPARTIAL_ITEMS; xItem++ )
+	{
+		xItems[ xItem ].ulSequence = ( uint32_t ) xItem;
+	}
+
+	/* Nothing receives, so only the first qbPARTIAL_LENGTH items fit. */
+	xStart = xTaskGetTickCount();
+	xCount = xQueueSendMany( xPartialQueue, xItems, qbPARTIAL_ITEMS, qbPARTIAL_BLOCK_TIME );
+	prvCheck( xCount == qbPARTIAL_LENGTH, "xQueueSendMany() returned the number of items that fitted" );
+	prvCheck( ( xTaskGetTickCount() - xStart ) >= qbPARTIAL_BLOCK_TIME, "xQueueSendMany() blocked for its block time" );
+
+	xCount = xQueueReceiveMany( xPartialQueue, xReceived, qbMAX_BATCH, 0 );
+	prvCheck( xCount == qbPARTIAL_LENGTH, "xQueueReceiveMany() received every queued item" );
+
+	for( xItem = 0; xItem < xCount; xItem++ )
+	{
+		prvCheck( xReceived[ xItem ].ulSequence == ( uint32_t ) xItem, "The items sent before the timeout were the first, in order" );
+	}
+
+	/* The lower priority task only runs once this task has filled the queue
+	and blocked.  It makes room for qbPARTIAL_RECEIVED more items. */
+	xTaskCreate( prvPartialReceiverTask, "RECEIVE", configMINIMAL_STACK_SIZE, NULL, qbBENCHMARK_PRIORITY - 1, NULL );
+
+	xCount = xQueueSendMany( xPartialQueue, xItems, qbPARTIAL_ITEMS, qbPARTIAL_BLOCK_TIME );
+	prvCheck( xCount == ( qbPARTIAL_LENGTH + qbPARTIAL_RECEIVED ), "xQueueSendMany() continued after room was made" );
+	prvCheck( xPartialReceivedCount == qbPARTIAL_RECEIVED, "The receiving task took its items" );
+
+	for( xItem = 0; xItem < qbPARTIAL_RECEIVED; xItem++ )
+	{
+		prvCheck( xPartialReceived[ xItem ].ulSequence == ( uint32_t ) xItem, "The receiving task took the first items" );
+	}
+
+	xCount = xQueueReceiveMany( xPartialQueue, xReceived, qbMAX_BATCH, 0 );
+	prvCheck( xCount == qbPARTIAL_LENGTH, "The queue was left full" );
+
+	for( xItem = 0; xItem < xCount; xItem++ )
+	{
+		prvCheck( xReceived[ xItem ].ulSequence == ( uint32_t ) ( xItem + qbPARTIAL_RECEIVED ), "The queued items followed those received, in order" );
+	}
+
+	/* The queue is now empty. */
+	xStart = xTaskGetTickCount();
+	prvCheck( xQueueReceiveMany( xPartialQueue, xReceived, qbMAX_BATCH, qbPARTIAL_BLOCK_TIME ) == 0, "xQueueReceiveMany() returned 0 from an empty queue" );
+	prvCheck( ( xTaskGetTickCount() - xStart ) >= qbPARTIAL_BLOCK_TIME, "xQueueReceiveMany() blocked for its block time" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPartialReceiverTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	xPartialReceivedCount = xQueueReceiveMany( xPartialQueue, xPartialReceived, qbPARTIAL_RECEIVED, 0 );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheck( BaseType_t xPassed, const char *pcWhat )
+{
+	if( xPassed == pdFALSE )
+	{
+		printf( "FAILED: %s\n", pcWhat );
+		exit( 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,210 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A benchmark of vListInsert() on lists of different lengths, to find the
+ * length above which the skip list index (configUSE_SKIP_LIST) pays off.
+ * slbLENGTHS[] sets the list lengths.  For each length a randomly chosen item
+ * is removed from the list and inserted again with a new random value, and
+ * the time per remove and insert is printed.
+ *
+ * Without the index vListInsert() walks the list to find the insertion point,
+ * so the time grows with the length of the list.  With the index it descends
+ * the skip list levels, so the time grows with the logarithm of the length,
+ * but each insert and remove also has to link and unlink the item on its
+ * levels, which costs more on short lists.  The crossover is the length at
+ * which the two builds take the same time.
+ *
+ * Only list.c is exercised, so the scheduler is not started.  The benchmark is
+ * built in place of main.c, once without and once with the index, for example:
+ *
+ *   gcc -O2 -I. skip_list_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o skip_list_benchmark -lpthread
+ *   ./skip_list_benchmark
+ *   gcc -O2 -I. -DconfigUSE_SKIP_LIST=1 skip_list_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o skip_list_benchmark -lpthread
+ *   ./skip_list_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "list.h"
+
+#define slbMAX_LENGTH			( 4096UL )
+#define slbITERATIONS			( 1000000UL )
+#define slbRUNS					( 5 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The nanoseconds per remove and insert of the fastest of slbRUNS runs on a
+ * list of ulLength items.
+ */
+static double prvTimeList( uint32_t ulLength );
+
+/*
+ * A pseudo random sequence used to choose the items and their values.
+ */
+static uint32_t prvRandom( void );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static const uint32_t slbLENGTHS[] = { 2UL, 4UL, 8UL, 16UL, 32UL, 48UL, 64UL, 96UL, 128UL, 256UL, 1024UL, 4096UL };
+
+static List_t xBenchmarkList;
+static ListItem_t xListItems[ slbMAX_LENGTH ];
+
+static uint32_t ulRandomState = 1UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+size_t x;
+
+	printf( "Skip list index %s\n", ( configUSE_SKIP_LIST == 1 ) ? "on" : "off" );
+	printf( "List length  ns per remove and insert\n" );
+
+	for( x = 0; x < sizeof( slbLENGTHS ) / sizeof( slbLENGTHS[ 0 ] ); x++ )
+	{
+		printf( "%-12lu %.1f\n", ( unsigned long ) slbLENGTHS[ x ], prvTimeList( slbLENGTHS[ x ] ) );
+	}
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeList( uint32_t ulLength )
+{
+uint32_t ulIteration, ulItem;
+ListItem_t *pxItem;
+int iRun;
+double dStart, dTime, dFastest = 0.0;
+
+	ulRandomState = 1UL;
+	vListInitialise( &xBenchmarkList );
+
+	for( ulItem = 0; ulItem < ulLength; ulItem++ )
+	{
+		vListInitialiseItem( &( xListItems[ ulItem ] ) );
+		listSET_LIST_ITEM_VALUE( &( xListItems[ ulItem ] ), ( TickType_t ) prvRandom() );
+		vListInsert( &xBenchmarkList, &( xListItems[ ulItem ] ) );
+	}
+
+	/* The fastest run is the one least disturbed by the host. */
+	for( iRun = 0; iRun < slbRUNS; iRun++ )
+	{
+		dStart = prvNanoseconds();
+
+		for( ulIteration = 0; ulIteration < slbITERATIONS; ulIteration++ )
+		{
+			pxItem = &( xListItems[ prvRandom() % ulLength ] );
+			( void ) uxListRemove( pxItem );
+			listSET_LIST_ITEM_VALUE( pxItem, ( TickType_t ) prvRandom() );
+			vListInsert( &xBenchmarkList, pxItem );
+		}
+
+		dTime = prvNanoseconds() - dStart;
+
+		if( ( iRun == 0 ) || ( dTime < dFastest ) )
+		{
+			dFastest = dTime;
+		}
+	}
+
+	return dFastest / ( double ) slbITERATIONS;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+	/* xorshift32. */
+	ulRandomState ^= ulRandomState << 13;
+	ulRandomState ^= ulRandomState >> 17;
+	ulRandomState ^= ulRandomState << 5;
+	return ulRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
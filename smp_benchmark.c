@@ -0,0 +1,271 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A benchmark of how the throughput of the simulated cores scales with
+ * configNUM_CORES.  smbWORKERS tasks of the same priority share smbSTEPS steps
+ * of a linear congruential generator, each doing smbSTEPS / smbWORKERS of them,
+ * in two ways:
+ *
+ * + Independent - the workers share nothing, so with one host CPU per core
+ *   the throughput should grow in proportion to the number of cores.
+ *
+ * + Shared - every smbBATCH steps each worker adds its result to a shared
+ *   total in a critical section, so the cores also contend for the critical
+ *   section spinlock.
+ *
+ * The steps per second of each are printed.  The scaling is found by building
+ * the benchmark in place of main.c for 1, 2, 3 and 4 cores and comparing the
+ * results:
+ *
+ *   gcc -O2 -I. -DconfigNUM_CORES=1 smp_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o smp_benchmark -lpthread
+ *   ./smp_benchmark
+ *
+ * then again with -DconfigNUM_CORES=2, 3 and 4.  Each simulated core runs its
+ * task on its own host thread, so the cores only run at the same time when the
+ * host has at least configNUM_CORES CPUs.  With fewer the host threads take
+ * turns, the throughput stays flat, and the benchmark says so - the results
+ * then show the overhead of the SMP scheduler, not its scaling.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define smbWORKERS				( 4UL )
+#define smbSTEPS				( 400000000UL )
+#define smbBATCH				( 1000UL )
+#define smbRUNS					( 3 )
+
+#define smbBENCHMARK_PRIORITY	( tskIDLE_PRIORITY + 2 )
+#define smbWORKER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/* The ways the workers run. */
+#define smbINDEPENDENT			( 0 )
+#define smbSHARED				( 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Times each way of running the workers, prints the results and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Does its share of the steps, then gives xWorkersDone and deletes itself.
+ */
+static void prvWorkerTask( void *pvParameters );
+
+/*
+ * The steps per second of the fastest of smbRUNS runs of the workers.
+ */
+static double prvTimeWorkers( int iWay );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t xWorkersDone = NULL;
+
+/* How the workers run, and the total they add to when they share it. */
+static int iWorkerWay = smbINDEPENDENT;
+static volatile uint32_t ulSharedTotal = 0UL;
+
+/* Stops the independent work being optimised away. */
+static volatile uint32_t ulResults[ smbWORKERS ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xWorkersDone = xSemaphoreCreateCounting( smbWORKERS, 0 );
+	configASSERT( xWorkersDone );
+
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, smbBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+long lHostCPUs = sysconf( _SC_NPROCESSORS_ONLN );
+
+	( void ) pvParameters;
+
+	printf( "%u simulated cores on %ld host CPUs, %lu workers sharing %lu steps, best of %d runs\n", ( unsigned ) configNUM_CORES,
+			lHostCPUs, ( unsigned long ) smbWORKERS, ( unsigned long ) smbSTEPS, smbRUNS );
+
+	if( lHostCPUs < ( long ) configNUM_CORES )
+	{
+		printf( "The host has fewer CPUs than simulated cores, so the cores take turns and the results do not show scaling\n" );
+	}
+
+	printf( "\nWorkers        Million steps per second\n" );
+	printf( "Independent    %.0f\n", prvTimeWorkers( smbINDEPENDENT ) / 1e6 );
+	printf( "Shared         %.0f\n", prvTimeWorkers( smbSHARED ) / 1e6 );
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+uint32_t ulWorker = ( uint32_t ) ( uintptr_t ) pvParameters;
+uint32_t ulState = ulWorker + 1UL, ulStep, ulBatchStart = 0UL;
+
+	for( ulStep = 0; ulStep < ( smbSTEPS / smbWORKERS ); ulStep++ )
+	{
+		ulState = ( ulState * 1664525UL ) + 1013904223UL;
+
+		if( ( iWorkerWay == smbSHARED ) && ( ( ulStep % smbBATCH ) == ( smbBATCH - 1UL ) ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				ulSharedTotal += ulState - ulBatchStart;
+			}
+			taskEXIT_CRITICAL();
+
+			ulBatchStart = ulState;
+		}
+	}
+
+	ulResults[ ulWorker ] = ulState;
+
+	xSemaphoreGive( xWorkersDone );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeWorkers( int iWay )
+{
+uint32_t ulWorker;
+int iRun;
+double dStart, dTime, dFastest = 0.0;
+
+	iWorkerWay = iWay;
+
+	/* The fastest run is the one least disturbed by the host. */
+	for( iRun = 0; iRun < smbRUNS; iRun++ )
+	{
+		dStart = prvNanoseconds();
+
+		/* The workers have the lower priority, so they only start once this
+		task blocks. */
+		for( ulWorker = 0; ulWorker < smbWORKERS; ulWorker++ )
+		{
+			if( xTaskCreate( prvWorkerTask, "WORKER", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ulWorker, smbWORKER_PRIORITY, NULL ) != pdPASS )
+			{
+				printf( "Could not create the workers\n" );
+				exit( 1 );
+			}
+		}
+
+		for( ulWorker = 0; ulWorker < smbWORKERS; ulWorker++ )
+		{
+			xSemaphoreTake( xWorkersDone, portMAX_DELAY );
+		}
+
+		dTime = prvNanoseconds() - dStart;
+
+		if( ( iRun == 0 ) || ( dTime < dFastest ) )
+		{
+			dFastest = dTime;
+		}
+
+		/* Let the idle task free the workers' stacks. */
+		vTaskDelay( 2 );
+	}
+
+	return ( double ) smbSTEPS / ( dFastest / 1e9 );
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
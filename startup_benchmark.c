@@ -0,0 +1,412 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A benchmark of the time taken to create the objects the application creates
+ * at startup - four tasks, four queues, two timers and an event group - from
+ * statically allocated memory and from the FreeRTOS heap.  Each startup is
+ * repeated sbSTARTUPS times, deleting the objects in between, and the time to
+ * create each kind of object is recorded separately:
+ *
+ * + Statically, with xTaskCreateStatic(), xQueueCreateStatic(),
+ *   xTimerCreateStatic() and xEventGroupCreateStatic(), as main.c does.
+ *
+ * + Dynamically, with xTaskCreate(), xQueueCreate(), xTimerCreate() and
+ *   xEventGroupCreate(), from a heap that is otherwise empty.
+ *
+ * + Dynamically, from a heap that holds sbFRAGMENTS small free blocks, left by
+ *   earlier allocations, that are too small for any of the objects.  heap_4.c
+ *   returns the first free block that is large enough, so every allocation
+ *   walks past them - the time depends on what was allocated and freed before.
+ *
+ * For each the benchmark prints the median and 99th percentile time, so the
+ * spread shows how far the startup time varies, and the heap used by one
+ * startup.  Creating a task also creates the host fiber or thread that runs
+ * it, which takes most of the time of a task on the host but does not exist
+ * on a target, so the tasks are best compared with the fiber build below.
+ *
+ * The benchmark is built in place of main.c:
+ *
+ *   gcc -O2 -I. -DconfigUSE_FIBERS=1 startup_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o startup_benchmark -lpthread
+ *   ./startup_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "event_groups.h"
+
+#if( ( configSUPPORT_STATIC_ALLOCATION != 1 ) || ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+	#error The benchmark must be built with both configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION set to 1.
+#endif
+
+#define sbSTARTUPS				( 1000 )
+#define sbFRAGMENTS				( 256 )
+#define sbFRAGMENT_SIZE			( 16 )
+
+/* The objects of one startup, as created by main.c. */
+#define sbTASKS					( 4 )
+#define sbQUEUES				( 4 )
+#define sbQUEUE_LENGTH			( 5 )
+#define sbITEM_SIZE				( 24 )
+#define sbTIMERS				( 2 )
+
+/* The created tasks never run, as they are deleted before the benchmark task
+next blocks. */
+#define sbTASK_PRIORITY			( tskIDLE_PRIORITY + 1 )
+#define sbBENCHMARK_PRIORITY	( configTIMER_TASK_PRIORITY - 1 )
+
+/* How the objects are created. */
+#define sbSTATIC				( 0 )
+#define sbDYNAMIC				( 1 )
+#define sbDYNAMIC_FRAGMENTED	( 2 )
+#define sbMODES					( 3 )
+
+/* The kinds of object, each of which is timed separately. */
+#define sbKIND_TASKS			( 0 )
+#define sbKIND_QUEUES			( 1 )
+#define sbKIND_TIMERS			( 2 )
+#define sbKIND_EVENT_GROUP		( 3 )
+#define sbKINDS					( 4 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the startups for each mode in turn, prints the results and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Create the objects of one startup, recording the nanoseconds taken to create
+ * each kind in pdTimes[], then delete them again.
+ */
+static void prvStartup( int iMode, double pdTimes[ sbKINDS ] );
+
+/*
+ * The created tasks and timers do nothing.
+ */
+static void prvSuspendedTask( void *pvParameters );
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/*
+ * The value below which ulPercent percent of the sorted times lie.
+ */
+static double prvPercentile( double *pdTimes, uint32_t ulPercent );
+static int prvCompareTimes( const void *pvA, const void *pvB );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static const char * const pcModeNames[ sbMODES ] = { "Static", "Dynamic", "Fragmented" };
+static const char * const pcKindNames[ sbKINDS ] = { "4 tasks", "4 queues", "2 timers", "event group" };
+
+/* The memory of the statically created objects. */
+static StaticTask_t xTaskBuffers[ sbTASKS ];
+static StackType_t uxTaskStacks[ sbTASKS ][ configMINIMAL_STACK_SIZE ];
+static StaticQueue_t xQueueBuffers[ sbQUEUES ];
+static uint8_t ucQueueStorage[ sbQUEUES ][ sbQUEUE_LENGTH * sbITEM_SIZE ];
+static StaticTimer_t xTimerBuffers[ sbTIMERS ];
+static StaticEventGroup_t xEventGroupBuffer;
+
+/* The time taken by every startup, for each mode and kind of object. */
+static double dTimes[ sbMODES ][ sbKINDS ][ sbSTARTUPS ];
+
+/* The heap used by one startup in each mode. */
+static size_t xHeapUsed[ sbMODES ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, sbBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+void *pvFragments[ sbFRAGMENTS ];
+double dStartup[ sbKINDS ];
+int iMode, iKind, iStartup, iFragment;
+
+	( void ) pvParameters;
+
+	for( iMode = 0; iMode < sbMODES; iMode++ )
+	{
+		if( iMode == sbDYNAMIC_FRAGMENTED )
+		{
+			/* Free every other block, so the free blocks cannot be merged. */
+			for( iFragment = 0; iFragment < sbFRAGMENTS; iFragment++ )
+			{
+				pvFragments[ iFragment ] = pvPortMalloc( sbFRAGMENT_SIZE );
+				configASSERT( pvFragments[ iFragment ] );
+			}
+
+			for( iFragment = 0; iFragment < sbFRAGMENTS; iFragment += 2 )
+			{
+				vPortFree( pvFragments[ iFragment ] );
+			}
+		}
+
+		for( iStartup = 0; iStartup < sbSTARTUPS; iStartup++ )
+		{
+			prvStartup( iMode, dStartup );
+
+			for( iKind = 0; iKind < sbKINDS; iKind++ )
+			{
+				dTimes[ iMode ][ iKind ][ iStartup ] = dStartup[ iKind ];
+			}
+		}
+	}
+
+	printf( "%d startups, %d free blocks of %d bytes in the fragmented heap\n\n", sbSTARTUPS, sbFRAGMENTS / 2, sbFRAGMENT_SIZE );
+	printf( "                Median (ns)                        99th percentile (ns)\n" );
+	printf( "Object          Static    Dynamic   Fragmented     Static    Dynamic   Fragmented\n" );
+
+	for( iKind = 0; iKind < sbKINDS; iKind++ )
+	{
+		printf( "%-15s", pcKindNames[ iKind ] );
+
+		for( iMode = 0; iMode < sbMODES; iMode++ )
+		{
+			printf( " %-9.0f", prvPercentile( dTimes[ iMode ][ iKind ], 50UL ) );
+		}
+
+		printf( "    " );
+
+		for( iMode = 0; iMode < sbMODES; iMode++ )
+		{
+			printf( " %-9.0f", prvPercentile( dTimes[ iMode ][ iKind ], 99UL ) );
+		}
+
+		printf( "\n" );
+	}
+
+	printf( "\nHeap used by one startup:" );
+
+	for( iMode = 0; iMode < sbMODES; iMode++ )
+	{
+		printf( " %s %u bytes%s", pcModeNames[ iMode ], ( unsigned ) xHeapUsed[ iMode ], ( iMode < ( sbMODES - 1 ) ) ? "," : "\n" );
+	}
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartup( int iMode, double pdTimes[ sbKINDS ] )
+{
+TaskHandle_t xTasks[ sbTASKS ];
+QueueHandle_t xQueues[ sbQUEUES ];
+TimerHandle_t xTimers[ sbTIMERS ];
+EventGroupHandle_t xEventGroup;
+size_t xFreeBefore;
+double dStart;
+int x;
+
+	xFreeBefore = xPortGetFreeHeapSize();
+
+	dStart = prvNanoseconds();
+	for( x = 0; x < sbTASKS; x++ )
+	{
+		if( iMode == sbSTATIC )
+		{
+			xTasks[ x ] = xTaskCreateStatic( prvSuspendedTask, "TASK", configMINIMAL_STACK_SIZE, NULL, sbTASK_PRIORITY, uxTaskStacks[ x ], &( xTaskBuffers[ x ] ) );
+		}
+		else
+		{
+			xTaskCreate( prvSuspendedTask, "TASK", configMINIMAL_STACK_SIZE, NULL, sbTASK_PRIORITY, &( xTasks[ x ] ) );
+		}
+	}
+	pdTimes[ sbKIND_TASKS ] = prvNanoseconds() - dStart;
+
+	dStart = prvNanoseconds();
+	for( x = 0; x < sbQUEUES; x++ )
+	{
+		if( iMode == sbSTATIC )
+		{
+			xQueues[ x ] = xQueueCreateStatic( sbQUEUE_LENGTH, sbITEM_SIZE, ucQueueStorage[ x ], &( xQueueBuffers[ x ] ) );
+		}
+		else
+		{
+			xQueues[ x ] = xQueueCreate( sbQUEUE_LENGTH, sbITEM_SIZE );
+		}
+	}
+	pdTimes[ sbKIND_QUEUES ] = prvNanoseconds() - dStart;
+
+	dStart = prvNanoseconds();
+	for( x = 0; x < sbTIMERS; x++ )
+	{
+		if( iMode == sbSTATIC )
+		{
+			xTimers[ x ] = xTimerCreateStatic( "TIMER", pdMS_TO_TICKS( 1000 ), pdFALSE, NULL, prvTimerCallback, &( xTimerBuffers[ x ] ) );
+		}
+		else
+		{
+			xTimers[ x ] = xTimerCreate( "TIMER", pdMS_TO_TICKS( 1000 ), pdFALSE, NULL, prvTimerCallback );
+		}
+	}
+	pdTimes[ sbKIND_TIMERS ] = prvNanoseconds() - dStart;
+
+	dStart = prvNanoseconds();
+	if( iMode == sbSTATIC )
+	{
+		xEventGroup = xEventGroupCreateStatic( &xEventGroupBuffer );
+	}
+	else
+	{
+		xEventGroup = xEventGroupCreate();
+	}
+	pdTimes[ sbKIND_EVENT_GROUP ] = prvNanoseconds() - dStart;
+
+	xHeapUsed[ iMode ] = xFreeBefore - xPortGetFreeHeapSize();
+
+	/* The memory of the deleted tasks is freed, or can be reused, once the
+	idle task has run.  The timers are deleted by the timer service task,
+	which has the higher priority, so straight away. */
+	for( x = 0; x < sbTASKS; x++ )
+	{
+		configASSERT( xTasks[ x ] );
+		vTaskDelete( xTasks[ x ] );
+	}
+
+	for( x = 0; x < sbQUEUES; x++ )
+	{
+		configASSERT( xQueues[ x ] );
+		vQueueDelete( xQueues[ x ] );
+	}
+
+	for( x = 0; x < sbTIMERS; x++ )
+	{
+		configASSERT( xTimers[ x ] );
+		xTimerDelete( xTimers[ x ], portMAX_DELAY );
+	}
+
+	configASSERT( xEventGroup );
+	vEventGroupDelete( xEventGroup );
+
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSuspendedTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
+
+static double prvPercentile( double *pdTimes, uint32_t ulPercent )
+{
+	qsort( pdTimes, sbSTARTUPS, sizeof( double ), prvCompareTimes );
+	return pdTimes[ ( ( sbSTARTUPS - 1 ) * ulPercent ) / 100UL ];
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareTimes( const void *pvA, const void *pvB )
+{
+double dA = *( ( const double * ) pvA ), dB = *( ( const double * ) pvB );
+
+	return ( dA > dB ) - ( dA < dB );
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
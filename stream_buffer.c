@@ -0,0 +1,788 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if( configUSE_TASK_NOTIFICATIONS != 1 )
+	#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
+#endif
+
+/* The head index is only written by the writer and the tail index is only
+written by the reader.  Each side publishes its own index with release
+semantics after copying the data, and reads the other side's index with acquire
+semantics before copying, so the data itself is never accessed by both sides
+at once.  A full fence is needed where a task registers itself as a waiter and
+then re-checks the buffer, and where the other side publishes an index and then
+checks for a waiter, so at least one of the two sees the other. */
+#if defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L ) && !defined( __STDC_NO_ATOMICS__ )
+
+	#include <stdatomic.h>
+
+	typedef _Atomic size_t sbIndex_t;
+	typedef _Atomic( TaskHandle_t ) sbWaiter_t;
+
+	#define sbLOAD_ACQUIRE( x )				atomic_load_explicit( &( x ), memory_order_acquire )
+	#define sbLOAD_RELAXED( x )				atomic_load_explicit( &( x ), memory_order_relaxed )
+	#define sbSTORE_RELEASE( x, xValue )	atomic_store_explicit( &( x ), ( xValue ), memory_order_release )
+	#define sbEXCHANGE( x, xValue )			atomic_exchange_explicit( &( x ), ( xValue ), memory_order_acq_rel )
+	#define sbFULL_FENCE()					atomic_thread_fence( memory_order_seq_cst )
+
+#elif defined( _WIN32 )
+
+	/* Compilers without C11 atomics, such as older versions of MSVC.  Windows.h
+	has already been included by portmacro.h.  Aligned volatile accesses are
+	atomic on the targets Windows runs on, and MSVC gives them acquire and
+	release semantics on x86 and x64. */
+	typedef volatile size_t sbIndex_t;
+	typedef TaskHandle_t volatile sbWaiter_t;
+
+	#define sbLOAD_ACQUIRE( x )				( x )
+	#define sbLOAD_RELAXED( x )				( x )
+	#define sbSTORE_RELEASE( x, xValue )	( ( x ) = ( xValue ) )
+	#define sbEXCHANGE( x, xValue )			( ( TaskHandle_t ) InterlockedExchangePointer( ( PVOID volatile * ) &( x ), ( xValue ) ) )
+	#define sbFULL_FENCE()					MemoryBarrier()
+
+#else
+	#error stream_buffer.c requires C11 atomics
+#endif
+
+/* Bits used in ucFlags. */
+#define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 )
+#define sbFLAGS_IS_STATICALLY_ALLOCATED	( ( uint8_t ) 2 )
+
+/* The type used to hold the length of each message in a message buffer. */
+typedef size_t MessageLength_t;
+#define sbBYTES_TO_STORE_MESSAGE_LENGTH	( sizeof( MessageLength_t ) )
+
+typedef struct xSTREAM_BUFFER /*lint !e9058 Style convention uses tag. */
+{
+	sbIndex_t xHead;						/*< Index of the next byte to write.  Only updated by the writer. */
+	sbIndex_t xTail;						/*< Index of the next byte to read.  Only updated by the reader. */
+	size_t xLength;							/*< The size of the storage area.  One byte is always left free so a full buffer can be told from an empty one. */
+	size_t xTriggerLevelBytes;				/*< The number of bytes that must be in the buffer before a blocked reader is unblocked. */
+	sbWaiter_t xTaskWaitingToReceive;		/*< The reader, while it is blocked waiting for data. */
+	sbWaiter_t xTaskWaitingToSend;			/*< The writer, while it is blocked waiting for space. */
+	uint8_t *pucBuffer;						/*< The storage area, which is allocated directly after the structure unless the buffer was created statically. */
+	uint8_t ucFlags;
+} StreamBuffer_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called after a StreamBuffer_t structure has been allocated either statically
+ * or dynamically to fill in the structure's members.
+ */
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer, uint8_t * const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer );
+
+/*
+ * The number of bytes between xTail and xHead.
+ */
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xHead, size_t xTail );
+
+/*
+ * Copy xCount bytes into the buffer starting at xHead, wrapping at the end of
+ * the storage area.  Returns the index following the last byte written.
+ */
+static size_t prvWriteBytes( StreamBuffer_t * const pxStreamBuffer, size_t xHead, const uint8_t *pucData, size_t xCount );
+
+/*
+ * Copy xCount bytes out of the buffer starting at xTail, wrapping at the end
+ * of the storage area.  Returns the index following the last byte read.
+ */
+static size_t prvReadBytes( const StreamBuffer_t * const pxStreamBuffer, size_t xTail, uint8_t *pucData, size_t xCount );
+
+/*
+ * Write as much of the data as there is space for (or, for a message buffer,
+ * the whole message or nothing) without blocking, then unblock the reader if
+ * it is waiting and enough data is now available.
+ */
+static size_t prvWriteToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken, BaseType_t xFromISR );
+
+/*
+ * Read as much data as is available (or, for a message buffer, the next
+ * message if it fits in xBufferLengthBytes) without blocking, then unblock the
+ * writer if it is waiting for space.
+ */
+static size_t prvReadFromBuffer( StreamBuffer_t * const pxStreamBuffer, uint8_t *pucData, size_t xBufferLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken, BaseType_t xFromISR );
+
+/*
+ * Unblock the task registered in *pxWaiter, if any.  The caller has already
+ * published the index that the waiting task is waiting on.
+ */
+static void prvNotifyWaiter( sbWaiter_t * const pxWaiter, BaseType_t * const pxHigherPriorityTaskWoken, BaseType_t xFromISR );
+
+/*
+ * Register the calling task in *pxWaiter.  The caller must re-check the buffer
+ * after this returns, and only block if it still has to.
+ */
+static void prvRegisterWaiter( sbWaiter_t * const pxWaiter );
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
+	{
+	StreamBuffer_t *pxStreamBuffer;
+
+		/* The structure and its storage area are allocated in one block.  The
+		extra byte means xBufferSizeBytes bytes can be held at once. */
+		pxStreamBuffer = ( StreamBuffer_t * ) pvPortMalloc( sizeof( StreamBuffer_t ) + xBufferSizeBytes + ( size_t ) 1 ); /*lint !e9079 MISRA exception as the casts are only redundant for some paths. */
+
+		if( pxStreamBuffer != NULL )
+		{
+			prvInitialiseNewStreamBuffer( pxStreamBuffer, ( ( uint8_t * ) pxStreamBuffer ) + sizeof( StreamBuffer_t ), xBufferSizeBytes, xTriggerLevelBytes, xIsMessageBuffer ); /*lint !e9016 Pointer arithmetic allowed on char types. */
+		}
+		else
+		{
+			traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+		}
+
+		return ( StreamBufferHandle_t ) pxStreamBuffer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer, uint8_t * const pucStreamBufferStorageArea, StaticStreamBuffer_t * const pxStaticStreamBuffer )
+	{
+	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) pxStaticStreamBuffer; /*lint !e740 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+
+		/* The StaticStreamBuffer_t structure and the storage area, which must
+		be xBufferSizeBytes + 1 bytes long, must be supplied. */
+		configASSERT( pucStreamBufferStorageArea != NULL );
+		configASSERT( pxStaticStreamBuffer != NULL );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticStreamBuffer_t equals the size of the real
+			stream buffer structure. */
+			volatile size_t xSize = sizeof( StaticStreamBuffer_t );
+			configASSERT( xSize == sizeof( StreamBuffer_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
+		prvInitialiseNewStreamBuffer( pxStreamBuffer, pucStreamBufferStorageArea, xBufferSizeBytes, xTriggerLevelBytes, xIsMessageBuffer );
+
+		/* Note the buffer was allocated statically in case it is later
+		deleted. */
+		pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
+
+		return ( StreamBufferHandle_t ) pxStreamBuffer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer, uint8_t * const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
+{
+	if( xIsMessageBuffer != pdFALSE )
+	{
+		/* A message buffer must be able to hold at least one length prefix
+		and one byte of data, and its reader is unblocked by any message. */
+		configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		xTriggerLevelBytes = ( size_t ) 1;
+	}
+	else
+	{
+		configASSERT( xBufferSizeBytes > ( size_t ) 0 );
+		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
+
+		if( xTriggerLevelBytes == ( size_t ) 0 )
+		{
+			xTriggerLevelBytes = ( size_t ) 1;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	sbSTORE_RELEASE( pxStreamBuffer->xHead, ( size_t ) 0 );
+	sbSTORE_RELEASE( pxStreamBuffer->xTail, ( size_t ) 0 );
+	pxStreamBuffer->xLength = xBufferSizeBytes + ( size_t ) 1;
+	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+	sbSTORE_RELEASE( pxStreamBuffer->xTaskWaitingToReceive, NULL );
+	sbSTORE_RELEASE( pxStreamBuffer->xTaskWaitingToSend, NULL );
+	pxStreamBuffer->pucBuffer = pucBuffer;
+	pxStreamBuffer->ucFlags = ( xIsMessageBuffer != pdFALSE ) ? sbFLAGS_IS_MESSAGE_BUFFER : ( uint8_t ) 0;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( sbLOAD_ACQUIRE( pxStreamBuffer->xTaskWaitingToReceive ) == NULL );
+	configASSERT( sbLOAD_ACQUIRE( pxStreamBuffer->xTaskWaitingToSend ) == NULL );
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		/* The buffer could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+		{
+			vPortFree( ( void * ) pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* The buffer must have been statically allocated, so there is no
+		memory to free. */
+		( void ) pxStreamBuffer;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+const uint8_t *pucData = ( const uint8_t * ) pvTxData;
+size_t xRequired, xSpace, xWritten = ( size_t ) 0;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( !( ( pvTxData == NULL ) && ( xDataLengthBytes != ( size_t ) 0 ) ) );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		/* A message that could never fit is rejected rather than blocking
+		until the block time expires. */
+		if( xDataLengthBytes > ( pxStreamBuffer->xLength - ( size_t ) 1 - sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+		{
+			traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+			return ( size_t ) 0;
+		}
+		else
+		{
+			xRequired = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+		}
+	}
+	else
+	{
+		/* Any space at all lets some of a stream be written. */
+		xRequired = ( size_t ) 1;
+	}
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		xWritten += prvWriteToBuffer( pxStreamBuffer, &( pucData[ xWritten ] ), xDataLengthBytes - xWritten, NULL, pdFALSE );
+
+		if( ( xWritten == xDataLengthBytes ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+
+		/* Register as the waiting writer before checking for space for the
+		last time, so space freed by the reader after the check is seen by
+		the reader as a writer that needs unblocking. */
+		prvRegisterWaiter( &( pxStreamBuffer->xTaskWaitingToSend ) );
+
+		xSpace = ( pxStreamBuffer->xLength - ( size_t ) 1 ) - prvBytesInBuffer( pxStreamBuffer, sbLOAD_RELAXED( pxStreamBuffer->xHead ), sbLOAD_ACQUIRE( pxStreamBuffer->xTail ) );
+
+		if( xSpace < xRequired )
+		{
+			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* If the reader has already taken the registration it will still
+		notify this task.  That leaves a notification pending, which at worst
+		causes one extra pass round this loop on a later call. */
+		( void ) sbEXCHANGE( pxStreamBuffer->xTaskWaitingToSend, NULL );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			/* Make one last attempt to write before returning. */
+			xTicksToWait = ( TickType_t ) 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	if( xWritten == ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+	}
+	else
+	{
+		traceSTREAM_BUFFER_SEND( xStreamBuffer, xWritten );
+	}
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+size_t xWritten;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( !( ( pvTxData == NULL ) && ( xDataLengthBytes != ( size_t ) 0 ) ) );
+
+	xWritten = prvWriteToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken, pdTRUE );
+
+	traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xWritten );
+
+	return xWritten;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+size_t xAvailable, xReceived;
+TimeOut_t xTimeOut;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( !( ( pvRxData == NULL ) && ( xBufferLengthBytes != ( size_t ) 0 ) ) );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	for( ;; )
+	{
+		xAvailable = prvBytesInBuffer( pxStreamBuffer, sbLOAD_ACQUIRE( pxStreamBuffer->xHead ), sbLOAD_RELAXED( pxStreamBuffer->xTail ) );
+
+		if( ( xAvailable >= pxStreamBuffer->xTriggerLevelBytes ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+		{
+			break;
+		}
+
+		/* As in xStreamBufferSend(), register before the final check. */
+		prvRegisterWaiter( &( pxStreamBuffer->xTaskWaitingToReceive ) );
+
+		xAvailable = prvBytesInBuffer( pxStreamBuffer, sbLOAD_ACQUIRE( pxStreamBuffer->xHead ), sbLOAD_RELAXED( pxStreamBuffer->xTail ) );
+
+		if( xAvailable < pxStreamBuffer->xTriggerLevelBytes )
+		{
+			traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) sbEXCHANGE( pxStreamBuffer->xTaskWaitingToReceive, NULL );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+		{
+			/* Receive whatever is available, even if it is below the trigger
+			level. */
+			xTicksToWait = ( TickType_t ) 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	if( xAvailable != ( size_t ) 0 )
+	{
+		xReceived = prvReadFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xBufferLengthBytes, NULL, pdFALSE );
+	}
+	else
+	{
+		xReceived = ( size_t ) 0;
+	}
+
+	if( xReceived == ( size_t ) 0 )
+	{
+		traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+	}
+	else
+	{
+		traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceived );
+	}
+
+	return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+size_t xReceived;
+
+	configASSERT( pxStreamBuffer );
+	configASSERT( !( ( pvRxData == NULL ) && ( xBufferLengthBytes != ( size_t ) 0 ) ) );
+
+	xReceived = prvReadFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken, pdTRUE );
+
+	traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceived );
+
+	return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	return prvBytesInBuffer( pxStreamBuffer, sbLOAD_ACQUIRE( pxStreamBuffer->xHead ), sbLOAD_ACQUIRE( pxStreamBuffer->xTail ) );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) xStreamBuffer;
+
+	configASSERT( pxStreamBuffer );
+
+	return ( pxStreamBuffer->xLength - ( size_t ) 1 ) - prvBytesInBuffer( pxStreamBuffer, sbLOAD_ACQUIRE( pxStreamBuffer->xHead ), sbLOAD_ACQUIRE( pxStreamBuffer->xTail ) );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken, BaseType_t xFromISR )
+{
+size_t xHead, xSpace, xCount;
+MessageLength_t xMessageLength;
+
+	/* Only the writer updates xHead, so it does not need acquire semantics.
+	The acquire load of xTail ensures the reader has finished copying out of
+	the space before it is reused. */
+	xHead = sbLOAD_RELAXED( pxStreamBuffer->xHead );
+	xSpace = ( pxStreamBuffer->xLength - ( size_t ) 1 ) - prvBytesInBuffer( pxStreamBuffer, xHead, sbLOAD_ACQUIRE( pxStreamBuffer->xTail ) );
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		if( xSpace >= ( xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+		{
+			xMessageLength = ( MessageLength_t ) xDataLengthBytes;
+			xHead = prvWriteBytes( pxStreamBuffer, xHead, ( const uint8_t * ) &xMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			xCount = xDataLengthBytes;
+		}
+		else
+		{
+			return ( size_t ) 0;
+		}
+	}
+	else
+	{
+		xCount = ( xDataLengthBytes < xSpace ) ? xDataLengthBytes : xSpace;
+
+		if( xCount == ( size_t ) 0 )
+		{
+			return ( size_t ) 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	xHead = prvWriteBytes( pxStreamBuffer, xHead, pucData, xCount );
+
+	/* Publish the data.  A message and its length prefix are published
+	together, so the reader never sees part of a message. */
+	sbSTORE_RELEASE( pxStreamBuffer->xHead, xHead );
+
+	if( prvBytesInBuffer( pxStreamBuffer, xHead, sbLOAD_ACQUIRE( pxStreamBuffer->xTail ) ) >= pxStreamBuffer->xTriggerLevelBytes )
+	{
+		prvNotifyWaiter( &( pxStreamBuffer->xTaskWaitingToReceive ), pxHigherPriorityTaskWoken, xFromISR );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadFromBuffer( StreamBuffer_t * const pxStreamBuffer, uint8_t *pucData, size_t xBufferLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken, BaseType_t xFromISR )
+{
+size_t xTail, xAvailable, xCount;
+MessageLength_t xMessageLength;
+
+	xTail = sbLOAD_RELAXED( pxStreamBuffer->xTail );
+	xAvailable = prvBytesInBuffer( pxStreamBuffer, sbLOAD_ACQUIRE( pxStreamBuffer->xHead ), xTail );
+
+	if( xAvailable == ( size_t ) 0 )
+	{
+		return ( size_t ) 0;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+	{
+		/* Read the length without consuming it, so a message that does not
+		fit in the caller's buffer is left where it is. */
+		( void ) prvReadBytes( pxStreamBuffer, xTail, ( uint8_t * ) &xMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+		if( ( size_t ) xMessageLength > xBufferLengthBytes )
+		{
+			return ( size_t ) 0;
+		}
+		else
+		{
+			xTail = prvReadBytes( pxStreamBuffer, xTail, NULL, sbBYTES_TO_STORE_MESSAGE_LENGTH );
+			xCount = ( size_t ) xMessageLength;
+		}
+	}
+	else
+	{
+		xCount = ( xBufferLengthBytes < xAvailable ) ? xBufferLengthBytes : xAvailable;
+	}
+
+	xTail = prvReadBytes( pxStreamBuffer, xTail, pucData, xCount );
+
+	/* Hand the space back to the writer. */
+	sbSTORE_RELEASE( pxStreamBuffer->xTail, xTail );
+
+	prvNotifyWaiter( &( pxStreamBuffer->xTaskWaitingToSend ), pxHigherPriorityTaskWoken, xFromISR );
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer, size_t xHead, size_t xTail )
+{
+	if( xHead >= xTail )
+	{
+		return xHead - xTail;
+	}
+	else
+	{
+		return ( pxStreamBuffer->xLength - xTail ) + xHead;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytes( StreamBuffer_t * const pxStreamBuffer, size_t xHead, const uint8_t *pucData, size_t xCount )
+{
+size_t xFirst;
+
+	/* Copy up to the end of the storage area, then wrap to the start. */
+	xFirst = pxStreamBuffer->xLength - xHead;
+
+	if( xFirst > xCount )
+	{
+		xFirst = xCount;
+	}
+
+	( void ) memcpy( ( void * ) &( pxStreamBuffer->pucBuffer[ xHead ] ), ( const void * ) pucData, xFirst );
+
+	if( xCount > xFirst )
+	{
+		( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirst ] ), xCount - xFirst );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xHead += xCount;
+
+	if( xHead >= pxStreamBuffer->xLength )
+	{
+		xHead -= pxStreamBuffer->xLength;
+	}
+
+	return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytes( const StreamBuffer_t * const pxStreamBuffer, size_t xTail, uint8_t *pucData, size_t xCount )
+{
+size_t xFirst;
+
+	/* pucData is NULL when the bytes are only being skipped. */
+	if( pucData != NULL )
+	{
+		xFirst = pxStreamBuffer->xLength - xTail;
+
+		if( xFirst > xCount )
+		{
+			xFirst = xCount;
+		}
+
+		( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirst );
+
+		if( xCount > xFirst )
+		{
+			( void ) memcpy( ( void * ) &( pucData[ xFirst ] ), ( const void * ) pxStreamBuffer->pucBuffer, xCount - xFirst );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xTail += xCount;
+
+	if( xTail >= pxStreamBuffer->xLength )
+	{
+		xTail -= pxStreamBuffer->xLength;
+	}
+
+	return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRegisterWaiter( sbWaiter_t * const pxWaiter )
+{
+	sbSTORE_RELEASE( *pxWaiter, xTaskGetCurrentTaskHandle() );
+
+	/* Pairs with the fence in prvNotifyWaiter(). */
+	sbFULL_FENCE();
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyWaiter( sbWaiter_t * const pxWaiter, BaseType_t * const pxHigherPriorityTaskWoken, BaseType_t xFromISR )
+{
+TaskHandle_t xTaskToNotify;
+
+	/* Pairs with the fence in prvRegisterWaiter().  Either the waiting task
+	sees the index that was just published, or this sees the waiting task. */
+	sbFULL_FENCE();
+
+	/* Nearly always NULL, so check before paying for the exchange. */
+	if( sbLOAD_RELAXED( *pxWaiter ) != NULL )
+	{
+		/* Taking the registration ensures the task is only notified once. */
+		xTaskToNotify = sbEXCHANGE( *pxWaiter, NULL );
+
+		if( xTaskToNotify != NULL )
+		{
+			if( xFromISR != pdFALSE )
+			{
+				( void ) xTaskGenericNotifyFromISR( xTaskToNotify, tskDEFAULT_INDEX_TO_NOTIFY, ( uint32_t ) 0, eNoAction, NULL, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				( void ) xTaskGenericNotify( xTaskToNotify, tskDEFAULT_INDEX_TO_NOTIFY, ( uint32_t ) 0, eNoAction, NULL );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+
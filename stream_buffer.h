@@ -0,0 +1,428 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include stream_buffer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Stream buffers pass a continuous stream of bytes from one task or interrupt
+ * to another.  Message buffers are stream buffers that pass discrete,
+ * variable length messages instead, each message being stored with a length
+ * prefix so the reader always receives whole messages.
+ *
+ * Unlike queues, stream and message buffers are designed for exactly one
+ * writer and exactly one reader.  The writer only ever updates the head of the
+ * ring buffer, and the reader only ever updates the tail, so data is passed
+ * without entering a critical section.  A critical section is only entered
+ * when a task has to block, or has to be unblocked, which is done using the
+ * task's direct to task notification rather than an event list.  If more than
+ * one task or interrupt writes to (or reads from) the same buffer then the
+ * writes (or reads) must be serialised by the application, for example by
+ * holding a mutex.
+ *
+ * A task that blocks on a stream or message buffer waits for its notification
+ * state to become pending, without changing its notification value, so it must
+ * not wait for a notification from any other source at the same time.
+ *
+ * \defgroup StreamBuffer
+ */
+
+/**
+ * stream_buffer.h
+ *
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns a StreamBufferHandle_t variable that can then
+ * be used as a parameter to xStreamBufferSend(), xStreamBufferReceive(), etc.
+ *
+ * \defgroup StreamBufferHandle_t StreamBufferHandle_t
+ * \ingroup StreamBuffer
+ */
+typedef void * StreamBufferHandle_t;
+
+/**
+ * stream_buffer.h
+ *
+ * Type by which message buffers are referenced.  Message buffers are stream
+ * buffers, so a MessageBufferHandle_t can be passed to any of the stream buffer
+ * functions.
+ *
+ * \defgroup MessageBufferHandle_t MessageBufferHandle_t
+ * \ingroup StreamBuffer
+ */
+typedef void * MessageBufferHandle_t;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ StreamBufferHandle_t xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ </pre>
+ *
+ * Creates a new stream buffer using dynamically allocated memory.
+ *
+ * @param xBufferSizeBytes The total number of bytes the stream buffer will be
+ * able to hold at any one time.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the stream
+ * buffer before a task that is blocked in xStreamBufferReceive() is unblocked.
+ * A value of 0 is treated as 1.  If the block time expires first the task
+ * receives however many bytes are available.
+ *
+ * @return The handle of the created stream buffer, or NULL if there was not
+ * enough heap memory to create it.
+ *
+ * \defgroup xStreamBufferCreate xStreamBufferCreate
+ * \ingroup StreamBuffer
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE )
+#endif
+
+/**
+ * stream_buffer.h
+ * <pre>
+ MessageBufferHandle_t xMessageBufferCreate( size_t xBufferSizeBytes );
+ </pre>
+ *
+ * Creates a new message buffer using dynamically allocated memory.  Each
+ * message is stored with a sizeof( size_t ) byte length prefix, so a message
+ * of n bytes uses n + sizeof( size_t ) bytes of the buffer.
+ *
+ * @param xBufferSizeBytes The total number of bytes, including length
+ * prefixes, the message buffer will be able to hold at any one time.
+ *
+ * @return The handle of the created message buffer, or NULL if there was not
+ * enough heap memory to create it.
+ *
+ * \defgroup xMessageBufferCreate xMessageBufferCreate
+ * \ingroup StreamBuffer
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	#define xMessageBufferCreate( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE )
+#endif
+
+/**
+ * stream_buffer.h
+ * <pre>
+ StreamBufferHandle_t xStreamBufferCreateStatic( size_t xBufferSizeBytes,
+												 size_t xTriggerLevelBytes,
+												 uint8_t *pucStreamBufferStorageArea,
+												 StaticStreamBuffer_t *pxStaticStreamBuffer );
+ </pre>
+ *
+ * Creates a new stream buffer using statically allocated memory, so no heap is
+ * used.  configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h
+ * for this macro to be available.
+ *
+ * @param xBufferSizeBytes The total number of bytes the stream buffer will be
+ * able to hold at any one time.
+ *
+ * @param xTriggerLevelBytes As for xStreamBufferCreate().
+ *
+ * @param pucStreamBufferStorageArea A uint8_t array of at least
+ * xBufferSizeBytes + 1 bytes, which the bytes sent to the stream buffer are
+ * copied into.
+ *
+ * @param pxStaticStreamBuffer A variable of type StaticStreamBuffer_t, which
+ * is used to hold the stream buffer's data structure.
+ *
+ * @return The handle of the created stream buffer.
+ *
+ * Example usage:
+   <pre>
+ #define STORAGE_SIZE_BYTES 100
+
+ static uint8_t ucStorageBuffer[ STORAGE_SIZE_BYTES + 1 ];
+ static StaticStreamBuffer_t xStreamBufferStruct;
+
+ void MyFunction( void )
+ {
+ StreamBufferHandle_t xStreamBuffer;
+
+	xStreamBuffer = xStreamBufferCreateStatic( STORAGE_SIZE_BYTES, 1, ucStorageBuffer, &xStreamBufferStruct );
+ }
+ </pre>
+ * \defgroup xStreamBufferCreateStatic xStreamBufferCreateStatic
+ * \ingroup StreamBuffer
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ) )
+#endif
+
+/**
+ * stream_buffer.h
+ * <pre>
+ MessageBufferHandle_t xMessageBufferCreateStatic( size_t xBufferSizeBytes,
+												   uint8_t *pucMessageBufferStorageArea,
+												   StaticMessageBuffer_t *pxStaticMessageBuffer );
+ </pre>
+ *
+ * Creates a new message buffer using statically allocated memory, so no heap
+ * is used.  configSUPPORT_STATIC_ALLOCATION must be set to 1 in
+ * FreeRTOSConfig.h for this macro to be available.
+ *
+ * @param xBufferSizeBytes The total number of bytes, including length
+ * prefixes, the message buffer will be able to hold at any one time.
+ *
+ * @param pucMessageBufferStorageArea A uint8_t array of at least
+ * xBufferSizeBytes + 1 bytes, which the messages and their length prefixes are
+ * copied into.
+ *
+ * @param pxStaticMessageBuffer A variable of type StaticMessageBuffer_t, which
+ * is used to hold the message buffer's data structure.
+ *
+ * @return The handle of the created message buffer.
+ *
+ * \defgroup xMessageBufferCreateStatic xMessageBufferCreateStatic
+ * \ingroup StreamBuffer
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ) )
+#endif
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
+						   const void *pvTxData,
+						   size_t xDataLengthBytes,
+						   TickType_t xTicksToWait );
+ </pre>
+ *
+ * Sends bytes to a stream buffer, or a message to a message buffer.
+ *
+ * For a stream buffer, as many bytes as there is space for are written
+ * immediately.  If there was not space for all of them the calling task blocks
+ * until the reader frees more space, and so on, until either all the bytes have
+ * been written or xTicksToWait has expired.  The bytes written before the block
+ * time expired remain in the buffer.
+ *
+ * For a message buffer, the message is only written if there is space for all
+ * of it, so the calling task blocks until there is space or xTicksToWait has
+ * expired.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param pvTxData A pointer to the bytes to send.
+ *
+ * @param xDataLengthBytes The number of bytes to send.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block in
+ * total waiting for space.
+ *
+ * @return The number of bytes written.  For a message buffer this is either
+ * xDataLengthBytes or 0.
+ *
+ * \defgroup xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBuffer
+ */
+size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xMessageBufferSend( xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait ) xStreamBufferSend( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
+								  const void *pvTxData,
+								  size_t xDataLengthBytes,
+								  BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xStreamBufferSend() that can be called from an interrupt
+ * service routine.  It never blocks, so writes as many bytes as there is space
+ * for (or, for a message buffer, the whole message or nothing).
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the data unblocked
+ * a task with a priority higher than the task that was interrupted, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of bytes written.
+ *
+ * \defgroup xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBuffer
+ */
+size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendFromISR( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
+							  void *pvRxData,
+							  size_t xBufferLengthBytes,
+							  TickType_t xTicksToWait );
+ </pre>
+ *
+ * Receives bytes from a stream buffer, or a message from a message buffer.
+ *
+ * For a stream buffer the calling task blocks until at least the trigger level
+ * number of bytes are available, then receives as many bytes as are available,
+ * up to xBufferLengthBytes.  If the block time expires first, whatever bytes
+ * are available are received.
+ *
+ * For a message buffer the calling task blocks until a message is available,
+ * then receives the whole message.  If the message is longer than
+ * xBufferLengthBytes it is left in the buffer and 0 is returned.
+ *
+ * @param xStreamBuffer The handle of the stream or message buffer.
+ *
+ * @param pvRxData A pointer to the buffer into which the bytes are copied.
+ *
+ * @param xBufferLengthBytes The size of the buffer pointed to by pvRxData.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for data.
+ *
+ * @return The number of bytes received.
+ *
+ * \defgroup xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBuffer
+ */
+size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) xStreamBufferReceive( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
+									 void *pvRxData,
+									 size_t xBufferLengthBytes,
+									 BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of xStreamBufferReceive() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if freeing space unblocked a
+ * task with a priority higher than the task that was interrupted, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of bytes received.
+ *
+ * \defgroup xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBuffer
+ */
+size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferReceiveFromISR( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer );
+ size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer );
+ </pre>
+ *
+ * Return the number of bytes, including message length prefixes, that are in
+ * the buffer, or that could be written to the buffer.  The result is only a
+ * snapshot if called by a task other than the reader or writer.
+ *
+ * \defgroup xStreamBufferBytesAvailable xStreamBufferBytesAvailable
+ * \ingroup StreamBuffer
+ */
+size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer );
+ </pre>
+ *
+ * Deletes a stream or message buffer.  No task may be blocked on the buffer.
+ * The memory of a buffer created with xStreamBufferCreateStatic() or
+ * xMessageBufferCreateStatic() is not freed, as it belongs to the application.
+ *
+ * \defgroup vStreamBufferDelete vStreamBufferDelete
+ * \ingroup StreamBuffer
+ */
+void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+#define vMessageBufferDelete( xMessageBuffer ) vStreamBufferDelete( ( StreamBufferHandle_t ) ( xMessageBuffer ) )
+
+/* Not public API functions. */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer, uint8_t * const pucStreamBufferStorageArea, StaticStreamBuffer_t * const pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STREAM_BUFFER_H */
+
@@ -0,0 +1,367 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A benchmark of a stream buffer, and of a message buffer, against a queue
+ * carrying the same bytes.  A producer task passes sbITEMS items of sbITEM_SIZE
+ * bytes to a consumer task through each primitive in turn:
+ *
+ * + Queue - a queue of sbBUFFER_ITEMS items of sbITEM_SIZE bytes, written with
+ *   xQueueSend() and read with xQueueReceive().
+ *
+ * + Stream buffer - a stream buffer of sbBUFFER_ITEMS * sbITEM_SIZE bytes,
+ *   written with xStreamBufferSend() and read with xStreamBufferReceive().  A
+ *   stream buffer can return part of an item, so the consumer receives until it
+ *   has a whole item.
+ *
+ * + Message buffer - a message buffer with room for sbBUFFER_ITEMS messages of
+ *   sbITEM_SIZE bytes, each with its length prefix.
+ *
+ * Each primitive is measured twice:
+ *
+ * + Throughput - the consumer has the same priority as the producer, so the
+ *   producer fills the buffer before the consumer drains it.  The time per item
+ *   and the bytes per second are printed.
+ *
+ * + Latency - the consumer has the higher priority, so it is unblocked by
+ *   every item.  Each item carries the host time at which it was sent, and the
+ *   mean and the largest time from the send to the consumer having the item
+ *   are printed.
+ *
+ * The throughput and the mean latency are those of the fastest of sbRUNS runs,
+ * and the largest latency is the largest seen in any run.  The queue enters a
+ * critical section for every send and receive, while the stream and message
+ * buffers only enter one to block or unblock a task.
+ *
+ * The benchmark is built in place of main.c, with stream_buffer.c added:
+ *
+ *   gcc -O2 -I. stream_buffer_benchmark.c stream_buffer.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o stream_buffer_benchmark -lpthread
+ *   ./stream_buffer_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+/* The producer waits at this index for the consumer to finish, as index 0 is
+used by the stream and message buffers. */
+#define sbDONE_INDEX			( 1 )
+
+#if( configTASK_NOTIFICATION_ARRAY_ENTRIES <= sbDONE_INDEX )
+	#error The benchmark must be built with configTASK_NOTIFICATION_ARRAY_ENTRIES of at least 2.
+#endif
+
+#define sbITEMS					( 200000UL )
+#define sbBUFFER_ITEMS			( 32UL )
+#define sbRUNS					( 3 )
+
+#define sbPRODUCER_PRIORITY		( tskIDLE_PRIORITY + 1 )
+
+/* The primitives. */
+#define sbQUEUE					( 0 )
+#define sbSTREAM_BUFFER			( 1 )
+#define sbMESSAGE_BUFFER		( 2 )
+
+/* An item, the same size as the I2C payload of main.c plus its command ID. */
+typedef struct BENCHMARK_ITEM
+{
+	double dSent;
+	uint32_t ulSequence;
+	uint8_t ucPayload[ 20 ];
+} Item_t;
+
+#define sbITEM_SIZE				( sizeof( Item_t ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The producer.  Measures each primitive, prints the results and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Receives sbITEMS items from the primitive being measured, then notifies the
+ * producer and deletes itself.
+ */
+static void prvConsumerTask( void *pvParameters );
+
+/*
+ * The nanoseconds per item of passing sbITEMS items through iPrimitive to a
+ * consumer of priority uxConsumerPriority.
+ */
+static double prvTimeItems( int iPrimitive, UBaseType_t uxConsumerPriority );
+
+/*
+ * Send and receive one item through iPrimitive.
+ */
+static void prvSendItem( int iPrimitive, const Item_t *pxItem );
+static void prvReceiveItem( int iPrimitive, Item_t *pxItem );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static const char * const pcPrimitiveNames[] = { "Queue", "Stream buffer", "Message buffer" };
+
+static TaskHandle_t xProducer = NULL;
+static QueueHandle_t xQueue = NULL;
+static StreamBufferHandle_t xStreamBuffer = NULL;
+static MessageBufferHandle_t xMessageBuffer = NULL;
+
+/* The primitive the consumer receives from, and the latencies it has seen. */
+static int iConsumerPrimitive = sbQUEUE;
+static double dLatencyTotal = 0.0, dLatencyLargest = 0.0;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xQueue = xQueueCreate( sbBUFFER_ITEMS, sbITEM_SIZE );
+	xStreamBuffer = xStreamBufferCreate( sbBUFFER_ITEMS * sbITEM_SIZE, sbITEM_SIZE );
+	xMessageBuffer = xMessageBufferCreate( sbBUFFER_ITEMS * ( sbITEM_SIZE + sizeof( size_t ) ) );
+	configASSERT( xQueue && xStreamBuffer && xMessageBuffer );
+
+	xTaskCreate( prvBenchmarkTask, "PRODUCE", configMINIMAL_STACK_SIZE, NULL, sbPRODUCER_PRIORITY, &xProducer );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+double dThroughput, dLatency, dLatencyLargestOfRuns, dTime;
+int iPrimitive, iRun;
+
+	( void ) pvParameters;
+
+	printf( "%lu items of %u bytes, best of %d runs\n\n", ( unsigned long ) sbITEMS, ( unsigned ) sbITEM_SIZE, sbRUNS );
+	printf( "Primitive        Throughput (ns per item, MB/s)   Latency (mean ns, largest ns)\n" );
+
+	for( iPrimitive = sbQUEUE; iPrimitive <= sbMESSAGE_BUFFER; iPrimitive++ )
+	{
+		dThroughput = 1e30;
+		dLatency = 1e30;
+		dLatencyLargestOfRuns = 0.0;
+
+		for( iRun = 0; iRun < sbRUNS; iRun++ )
+		{
+			dTime = prvTimeItems( iPrimitive, sbPRODUCER_PRIORITY );
+			if( dTime < dThroughput )
+			{
+				dThroughput = dTime;
+			}
+
+			( void ) prvTimeItems( iPrimitive, sbPRODUCER_PRIORITY + 1 );
+			if( ( dLatencyTotal / ( double ) sbITEMS ) < dLatency )
+			{
+				dLatency = dLatencyTotal / ( double ) sbITEMS;
+			}
+			if( dLatencyLargest > dLatencyLargestOfRuns )
+			{
+				dLatencyLargestOfRuns = dLatencyLargest;
+			}
+		}
+
+		printf( "%-16s %8.1f %8.0f                  %8.0f %10.0f\n", pcPrimitiveNames[ iPrimitive ],
+				dThroughput, ( ( double ) sbITEM_SIZE * 1000.0 ) / dThroughput, dLatency, dLatencyLargestOfRuns );
+	}
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void *pvParameters )
+{
+Item_t xItem;
+uint32_t ulItem;
+double dLatency;
+
+	( void ) pvParameters;
+
+	for( ulItem = 0; ulItem < sbITEMS; ulItem++ )
+	{
+		prvReceiveItem( iConsumerPrimitive, &xItem );
+		dLatency = prvNanoseconds() - xItem.dSent;
+
+		if( xItem.ulSequence != ulItem )
+		{
+			printf( "%s delivered item %lu in place of item %lu\n", pcPrimitiveNames[ iConsumerPrimitive ], ( unsigned long ) xItem.ulSequence, ( unsigned long ) ulItem );
+			exit( 1 );
+		}
+
+		dLatencyTotal += dLatency;
+		if( dLatency > dLatencyLargest )
+		{
+			dLatencyLargest = dLatency;
+		}
+	}
+
+	xTaskNotifyGiveIndexed( xProducer, sbDONE_INDEX );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeItems( int iPrimitive, UBaseType_t uxConsumerPriority )
+{
+Item_t xItem = { 0 };
+uint32_t ulItem;
+double dStart;
+
+	iConsumerPrimitive = iPrimitive;
+	dLatencyTotal = 0.0;
+	dLatencyLargest = 0.0;
+
+	if( xTaskCreate( prvConsumerTask, "CONSUME", configMINIMAL_STACK_SIZE, NULL, uxConsumerPriority, NULL ) != pdPASS )
+	{
+		printf( "Could not create the consumer task\n" );
+		exit( 1 );
+	}
+
+	dStart = prvNanoseconds();
+
+	for( ulItem = 0; ulItem < sbITEMS; ulItem++ )
+	{
+		xItem.ulSequence = ulItem;
+		xItem.dSent = prvNanoseconds();
+		prvSendItem( iPrimitive, &xItem );
+	}
+
+	ulTaskNotifyTakeIndexed( sbDONE_INDEX, pdTRUE, portMAX_DELAY );
+
+	return ( prvNanoseconds() - dStart ) / ( double ) sbITEMS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendItem( int iPrimitive, const Item_t *pxItem )
+{
+	switch( iPrimitive )
+	{
+		case sbQUEUE:
+			xQueueSend( xQueue, pxItem, portMAX_DELAY );
+			break;
+
+		case sbSTREAM_BUFFER:
+			/* Blocks until the whole item has been written. */
+			( void ) xStreamBufferSend( xStreamBuffer, pxItem, sbITEM_SIZE, portMAX_DELAY );
+			break;
+
+		default:
+			( void ) xMessageBufferSend( xMessageBuffer, pxItem, sbITEM_SIZE, portMAX_DELAY );
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveItem( int iPrimitive, Item_t *pxItem )
+{
+size_t xReceived = 0;
+
+	switch( iPrimitive )
+	{
+		case sbQUEUE:
+			xQueueReceive( xQueue, pxItem, portMAX_DELAY );
+			break;
+
+		case sbSTREAM_BUFFER:
+			/* The producer may have written only part of the item so far. */
+			while( xReceived < sbITEM_SIZE )
+			{
+				xReceived += xStreamBufferReceive( xStreamBuffer, ( uint8_t * ) pxItem + xReceived, sbITEM_SIZE - xReceived, portMAX_DELAY );
+			}
+			break;
+
+		default:
+			( void ) xMessageBufferReceive( xMessageBuffer, pxItem, sbITEM_SIZE, portMAX_DELAY );
+			break;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
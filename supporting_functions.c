@@ -75,8 +75,8 @@
  * terminal output can be wrapped in a critical section.
  *
  * 2) RTOS hook functions: vApplicationMallocFailedHook(), vApplicationIdleHook()
- * vApplicationIdleHook(), vApplicationStackOverflowHook() and
- * vApplicationTickHook().
+ * vApplicationIdleHook(), vApplicationStackOverflowHook(),
+ * vApplicationTickHook() and vApplicationDeadlineMissHook().
  *
  * These are functions that can optionally be defined by the application writer
  * in order to get notifications of events occurring with the executing
@@ -93,11 +93,21 @@
 
 /* Standard includes. */
 #include <stdio.h>
-#include <conio.h>
+
+/* Console key press detection. */
+#ifdef _WIN32
+	#include <conio.h>
+	#define prvKeyPressed()	_kbhit()
+#else
+	#include <sys/select.h>
+	#include <unistd.h>
+	static int prvKeyPressed( void );
+#endif
 
 /* FreeRTOS includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "croutine.h"
 
 /* If this variable is true then pressing a key will end the application.  Some
 examples set this to pdFALSE to allow key presses to be used by the
@@ -120,7 +130,7 @@ BaseType_t xKeyHit = pdFALSE;
 		/* Allow any key to stop the application. */
 		if( xKeyPressesStopApplication == pdTRUE )
 		{
-			xKeyHit = _kbhit();
+			xKeyHit = prvKeyPressed();
 		}
 	}
 	taskEXIT_CRITICAL();
@@ -148,7 +158,7 @@ void vPrintStringAndNumber( const char *pcString, uint32_t ulValue )
 	/* Allow any key to stop the application running. */
 	if( xKeyPressesStopApplication == pdTRUE )
 	{
-		if( _kbhit() )
+		if( prvKeyPressed() )
 		{
 			vTaskEndScheduler();
 		}
@@ -169,7 +179,7 @@ void vPrintTwoStrings( const char *pcString1, const char *pcString2 )
 	/* Allow any key to stop the application running. */
 	if( xKeyPressesStopApplication == pdTRUE )
 	{
-		if( _kbhit() )
+		if( prvKeyPressed() )
 		{
 			vTaskEndScheduler();
 		}
@@ -193,10 +203,7 @@ void vApplicationMallocFailedHook( void )
 }
 /*-----------------------------------------------------------*/
 
-/* An example vApplicationIdleHook() implementation is included here for
-completeness, but it is not actually built (it is excluded by the #if 0) as it
-is also defined by the examples that actually make use of the function. */
-#if 0
+#if( configUSE_IDLE_HOOK == 1 )
 	void vApplicationIdleHook( void )
 	{
 		/* vApplicationIdleHook() will only be called if configUSE_IDLE_HOOK is set
@@ -209,8 +216,17 @@ is also defined by the examples that actually make use of the function. */
 		because it is the responsibility of the idle task to clean up memory
 		allocated by the kernel to any task that has since been deleted.  More
 		information is provided in the book text. */
+
+		#if( configUSE_CO_ROUTINES == 1 )
+		{
+			/* Co-routines are run by the idle task.  Each call runs the highest
+			priority ready co-routine until it yields.  The idle task calls the
+			hook again straight away while co-routines remain ready. */
+			vCoRoutineSchedule();
+		}
+		#endif
 	}
-#endif /* 0 */
+#endif /* configUSE_IDLE_HOOK */
 /*-----------------------------------------------------------*/
 
 void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName )
@@ -236,6 +252,83 @@ void vApplicationTickHook( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_DEADLINE_MISS_HOOK == 1 )
+
+	void vApplicationDeadlineMissHook( TaskHandle_t xTask, TickType_t xDeadline )
+	{
+		/* vApplicationDeadlineMissHook() will only be called if
+		configUSE_DEADLINE_MISS_HOOK is set to 1 in FreeRTOSConfig.h.  It is
+		called by a periodic task that completes a release after the deadline of
+		the release, from the task itself, so unlike the tick hook it can use
+		any API function.  The late releases are also counted, see
+		vTaskGetPeriodStats(). */
+		vTaskSuspendAll();
+		{
+			printf( "At time %lu: %s missed its deadline of %lu\r\n", ( unsigned long ) xTaskGetTickCount(), pcTaskGetName( xTask ), ( unsigned long ) xDeadline );
+			fflush( stdout );
+		}
+		xTaskResumeAll();
+	}
+
+#endif /* configUSE_DEADLINE_MISS_HOOK */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+	{
+	/* The buffers must outlive this function, so are static. */
+	static StaticTask_t xIdleTaskTCB;
+	static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+		/* vApplicationGetIdleTaskMemory() will only be called if
+		configSUPPORT_STATIC_ALLOCATION is set to 1 in FreeRTOSConfig.h.  It
+		provides the memory used by the idle task, which is created when the
+		scheduler is started. */
+		*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+		*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+		*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+	}
+	/*-----------------------------------------------------------*/
+
+	#if( configNUM_CORES > 1 )
+
+		void vApplicationGetPassiveIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex )
+		{
+		static StaticTask_t xPassiveIdleTaskTCBs[ configNUM_CORES - 1 ];
+		static StackType_t uxPassiveIdleTaskStacks[ configNUM_CORES - 1 ][ configMINIMAL_STACK_SIZE ];
+
+			/* As vApplicationGetIdleTaskMemory(), but for the idle task of each
+			core other than the first, so xPassiveIdleTaskIndex is the core
+			number less one. */
+			*ppxIdleTaskTCBBuffer = &( xPassiveIdleTaskTCBs[ xPassiveIdleTaskIndex ] );
+			*ppxIdleTaskStackBuffer = uxPassiveIdleTaskStacks[ xPassiveIdleTaskIndex ];
+			*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+		}
+
+	#endif /* configNUM_CORES */
+	/*-----------------------------------------------------------*/
+
+	#if( configUSE_TIMERS == 1 )
+
+		void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+		{
+		static StaticTask_t xTimerTaskTCB;
+		static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+			/* As vApplicationGetIdleTaskMemory(), but for the timer service
+			task, which is created when the scheduler is started if
+			configUSE_TIMERS is set to 1. */
+			*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+			*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+			*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+		}
+
+	#endif /* configUSE_TIMERS */
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
 void vAssertCalled( uint32_t ulLine, const char * const pcFile )
 {
 /* The following two variables are just to ensure the parameters are not
@@ -261,3 +354,24 @@ volatile const char * const pcFileName = pcFile;
 }
 /*-----------------------------------------------------------*/
 
+#ifndef _WIN32
+
+	static int prvKeyPressed( void )
+	{
+	fd_set xReadSet;
+	struct timeval xNoWait = { 0, 0 };
+
+		/* When stdin is not a terminal the simulator is running headless, and
+		stdin carries commands rather than key presses. */
+		if( isatty( STDIN_FILENO ) == 0 )
+		{
+			return 0;
+		}
+
+		FD_ZERO( &xReadSet );
+		FD_SET( STDIN_FILENO, &xReadSet );
+
+		return select( STDIN_FILENO + 1, &xReadSet, NULL, NULL, &xNoWait ) > 0;
+	}
+
+#endif /* _WIN32 */
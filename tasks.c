@@ -82,6 +82,12 @@ task.h is included from an application file. */
 #include "timers.h"
 #include "StackMacros.h"
 
+#if ( configUSE_CO_ROUTINES == 1 )
+	/* The co-routines are scheduled from the idle hook, so the idle task needs
+	to know when the next one is ready. */
+	#include "croutine.h"
+#endif
+
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
 header files above, but not in this file, in order to generate the correct
@@ -106,11 +112,17 @@ functions but without including stdio.h here. */
 	#define taskYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
-/* Values that can be assigned to the ucNotifyState member of the TCB. */
+/* Values that can be assigned to the ucNotifyState members of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION	( ( uint8_t ) 0 )
 #define taskWAITING_NOTIFICATION		( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED		( ( uint8_t ) 2 )
 
+/* Values that can be assigned to the ucPeriodState member of the TCB. */
+#define taskPERIOD_IDLE					( ( uint8_t ) 0 )	/* Not running periodically, or between the completion of a release and blocking. */
+#define taskPERIOD_WAITING				( ( uint8_t ) 1 )	/* Blocked until the next release. */
+#define taskPERIOD_RELEASED				( ( uint8_t ) 2 )	/* Released but not yet run. */
+#define taskPERIOD_RUNNING				( ( uint8_t ) 3 )	/* Has run since the release, which it has not yet completed. */
+
 /*
  * The value used to fill the stack of a task when the task is created.  This
  * is used purely for checking the high water mark for tasks.
@@ -153,6 +165,43 @@ a statically allocated stack and a dynamically allocated TCB. */
 	#define static
 #endif
 
+/* Evaluates to pdTRUE if xTime1 is before xTime2.  Deadlines and release times
+are always within half the range of TickType_t of each other and of the tick
+count, so the comparison remains correct when the tick count overflows. */
+#define taskTIME_IS_BEFORE( xTime1, xTime2 ) ( ( TickType_t ) ( ( xTime2 ) - ( xTime1 ) - ( TickType_t ) 1U ) < ( TickType_t ) ( portMAX_DELAY >> 1U ) )
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	/* Ready lists hold the tasks that have a deadline first, in deadline order
+	(see prvInsertTaskByDeadline()), so the task with the earliest deadline is
+	at the head.  Tasks that have no deadline are held after them and are
+	selected round robin when no task of the same priority has a deadline. */
+	#define taskSELECT_FROM_READY_LIST( pxList )										\
+	{																					\
+		if( ( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( pxList ) ) )->xRelativeDeadline != ( TickType_t ) 0U )	\
+		{																				\
+			pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( pxList ) );		\
+		}																				\
+		else																			\
+		{																				\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, ( pxList ) );					\
+		}																				\
+	}
+
+	#define taskINSERT_INTO_READY_LIST( pxTCB ) prvInsertTaskByDeadline( ( pxTCB ) )
+
+#else
+
+	/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of the
+	same priority get an equal share of the processor time. */
+	#define taskSELECT_FROM_READY_LIST( pxList ) listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, ( pxList ) )
+
+	#define taskINSERT_INTO_READY_LIST( pxTCB ) vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -182,9 +231,7 @@ a statically allocated stack and a dynamically allocated TCB. */
 			--uxTopPriority;																			\
 		}																								\
 																										\
-		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of						\
-		the	same priority get an equal share of the processor time. */									\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );			\
+		taskSELECT_FROM_READY_LIST( &( pxReadyTasksLists[ uxTopPriority ] ) );							\
 		uxTopReadyPriority = uxTopPriority;																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
@@ -214,7 +261,7 @@ a statically allocated stack and a dynamically allocated TCB. */
 		/* Find the highest priority list that contains ready tasks. */								\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( &( pxReadyTasksLists[ uxTopPriority ] ) );						\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -234,32 +281,190 @@ a statically allocated stack and a dynamically allocated TCB. */
 
 /*-----------------------------------------------------------*/
 
-/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
-#define taskSWITCH_DELAYED_LISTS()																	\
-{																									\
-	List_t *pxTemp;																					\
+#if( configNUM_CORES > 1 )
+
+	/* The value held in the xTaskRunState member of a TCB when the task is not
+	running on any core.  Otherwise xTaskRunState holds the number of the core
+	that is running the task. */
+	#define taskTASK_NOT_RUNNING		( ( BaseType_t ) -1 )
+
+	/* A core affinity mask that has a bit set for every core. */
+	#define taskALL_CORES_MASK			( ( ( ( UBaseType_t ) 1U << ( configNUM_CORES - 1 ) ) << 1U ) - ( UBaseType_t ) 1U )
+
+	/* A task that enters the Ready state can preempt the task running on any
+	core it is allowed to run on, not just the task running on the calling
+	core.  prvYieldForTask() selects the core that is running the lowest
+	priority task, interrupts that core if it is not the calling core, and
+	evaluates to pdTRUE if it is the calling core that must switch context. */
+	#define taskTASK_PREEMPTS_CURRENT( pxTCB )				prvYieldForTask( ( pxTCB ), pdFALSE )
+	#define taskTASK_PREEMPTS_OR_EQUALS_CURRENT( pxTCB )	prvYieldForTask( ( pxTCB ), pdTRUE )
+
+	/* A task is in the Running state if it is running on any core. */
+	#define taskTASK_IS_RUNNING( pxTCB )	( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+#else
+
+	/* A task that enters the Ready state preempts the running task if it has a
+	higher priority, or if it has an equal priority and the caller is one that
+	yields to tasks of equal priority.  When EDF scheduling is used it also
+	preempts a task of equal priority that has a later deadline. */
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		#define taskTASK_PREEMPTS_CURRENT( pxTCB )			( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) || ( ( ( pxTCB )->uxPriority == pxCurrentTCB->uxPriority ) && ( prvHasEarlierDeadline( ( pxTCB ), pxCurrentTCB ) != pdFALSE ) ) )
+	#else
+		#define taskTASK_PREEMPTS_CURRENT( pxTCB )			( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+	#endif
+	#define taskTASK_PREEMPTS_OR_EQUALS_CURRENT( pxTCB )	( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority )
+
+	#define taskTASK_IS_RUNNING( pxTCB )	( ( pxTCB ) == pxCurrentTCB )
+
+#endif /* configNUM_CORES */
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_64_BIT_TICKS == 1 )
+
+	/* The tick count never overflows, so there is nothing to switch, and
+	xTaskIncrementTick() does not check for it. */
+
+#elif( configUSE_TIMING_WHEEL == 1 )
+
+	/* The timing wheel is indexed by the time remaining until each task
+	unblocks, so there are no lists to switch when the tick count overflows.
+	Instead xNextTaskUnblockTime is set to 0 to ensure the wheel is processed
+	for the tick count of 0 - due times that overflowed were not allowed to set
+	xNextTaskUnblockTime. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		xNumOfOverflows++;																			\
+		xNextTaskUnblockTime = ( TickType_t ) 0U;													\
+	}
+
+#else
+
+	/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the
+	tick count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		List_t *pxTemp;																				\
 																									\
-	/* The delayed tasks list should be empty when the lists are switched. */						\
-	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
+		/* The delayed tasks list should be empty when the lists are switched. */					\
+		configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );									\
 																									\
-	pxTemp = pxDelayedTaskList;																		\
-	pxDelayedTaskList = pxOverflowDelayedTaskList;													\
-	pxOverflowDelayedTaskList = pxTemp;																\
-	xNumOfOverflows++;																				\
-	prvResetNextTaskUnblockTime();																	\
-}
+		pxTemp = pxDelayedTaskList;																	\
+		pxDelayedTaskList = pxOverflowDelayedTaskList;												\
+		pxOverflowDelayedTaskList = pxTemp;															\
+		xNumOfOverflows++;																			\
+		prvResetNextTaskUnblockTime();																\
+	}
+
+#endif /* configUSE_64_BIT_TICKS */
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	/* The timing wheel has taskTIMING_WHEEL_LEVELS levels, each of which has
+	taskTIMING_WHEEL_SLOTS slots.  Each slot at level n covers a period of
+	2^( n * taskTIMING_WHEEL_SLOT_BITS ) ticks, so the wheel as a whole covers
+	2^taskTIMING_WHEEL_RANGE_BITS ticks (2^20 ticks, or just under three hours
+	at a 100Hz tick).  Tasks that are to block for longer than that are held in
+	an overflow list until they come into range. */
+	#define taskTIMING_WHEEL_LEVELS			( 4U )
+	#define taskTIMING_WHEEL_SLOT_BITS		( 5U )
+	#define taskTIMING_WHEEL_SLOTS			( 1U << taskTIMING_WHEEL_SLOT_BITS )
+	#define taskTIMING_WHEEL_SLOT_MASK		( taskTIMING_WHEEL_SLOTS - 1U )
+	#define taskTIMING_WHEEL_RANGE_BITS		( taskTIMING_WHEEL_LEVELS * taskTIMING_WHEEL_SLOT_BITS )
+
+	/* The index of the lowest set bit in a non-zero uint32_t.  The bit scan
+	instruction used to select the highest priority ready task is used if the
+	port provides one. */
+	#if defined( portGET_HIGHEST_SET_BIT )
+
+		#define taskLOWEST_SET_BIT( uxBit, ulBits ) portGET_HIGHEST_SET_BIT( ( uxBit ), ( ( ulBits ) & ( ~( ulBits ) + 1UL ) ) )
+
+	#elif( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+		#define taskLOWEST_SET_BIT( uxBit, ulBits ) portGET_HIGHEST_PRIORITY( ( uxBit ), ( ( ulBits ) & ( ~( ulBits ) + 1UL ) ) )
+
+	#else
+
+		#define taskLOWEST_SET_BIT( uxBit, ulBits )												\
+		{																						\
+			uint32_t ulShiftedBits = ( ulBits );												\
+																								\
+			for( ( uxBit ) = 0U; ( ulShiftedBits & 1UL ) == 0UL; ( uxBit )++ )					\
+			{																					\
+				ulShiftedBits >>= 1UL;															\
+			}																					\
+		}
+
+	#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+#endif /* configUSE_TIMING_WHEEL */
+
+/* Used by eTaskGetState() to determine if a task is in the Blocked state. */
+#if( configUSE_TIMING_WHEEL == 1 )
+	#define taskLIST_IS_DELAYED_LIST( pxList ) prvTimingWheelIsDelayedList( ( pxList ) )
+#elif( configUSE_64_BIT_TICKS == 1 )
+	#define taskLIST_IS_DELAYED_LIST( pxList ) ( ( pxList ) == pxDelayedTaskList )
+#else
+	#define taskLIST_IS_DELAYED_LIST( pxList ) ( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+#endif
 
 /*-----------------------------------------------------------*/
 
+/*
+ * When run time stats are generated, add the time a task spent in the Blocked
+ * state (or the Suspended state, if it was suspended while it was blocked) to
+ * its blocked time as it is moved to a ready list.  The run time counter is
+ * only read if the task was blocked.
+ */
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+		#define prvGET_RUN_TIME_COUNTER_VALUE( ulCounterValue ) portALT_GET_RUN_TIME_COUNTER_VALUE( ( ulCounterValue ) )
+	#else
+		#define prvGET_RUN_TIME_COUNTER_VALUE( ulCounterValue ) ( ulCounterValue ) = portGET_RUN_TIME_COUNTER_VALUE()
+	#endif
+
+	#define prvRECORD_BLOCKED_TIME( pxTCB )										\
+	if( ( pxTCB )->ulBlockedSince != 0UL )										\
+	{																			\
+	configRUN_TIME_COUNTER_TYPE ulTimeNow;										\
+																				\
+		prvGET_RUN_TIME_COUNTER_VALUE( ulTimeNow );								\
+		( pxTCB )->ulBlockedTimeCounter += ( ulTimeNow - ( pxTCB )->ulBlockedSince );	\
+		( pxTCB )->ulBlockedSince = 0UL;										\
+	}
+#else
+	#define prvRECORD_BLOCKED_TIME( pxTCB )
+#endif
+
+/*
+ * Records the time at which a periodic task that was blocked until its next
+ * release is released, so the period monitor can time the release.
+ */
+#if( configUSE_PERIOD_MONITOR == 1 )
+	#define prvRECORD_PERIOD_RELEASE( pxTCB )									\
+	if( ( pxTCB )->ucPeriodState == taskPERIOD_WAITING )						\
+	{																			\
+		prvGET_RUN_TIME_COUNTER_VALUE( ( pxTCB )->ulReleaseTime );				\
+		( pxTCB )->ucPeriodState = taskPERIOD_RELEASED;							\
+		( ( pxTCB )->xPeriodStats.ulReleases )++;								\
+	}
+#else
+	#define prvRECORD_PERIOD_RELEASE( pxTCB )
+#endif
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
  * the task.  It is inserted at the end of the list.
  */
 #define prvAddTaskToReadyList( pxTCB )																\
 	traceMOVED_TASK_TO_READY_STATE( pxTCB );														\
+	prvRECORD_BLOCKED_TIME( pxTCB );																\
+	prvRECORD_PERIOD_RELEASE( pxTCB );																\
 	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );												\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+	taskINSERT_INTO_READY_LIST( pxTCB );															\
 	tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -269,7 +474,11 @@ count overflows. */
  * task should be used in place of the parameter.  This macro simply checks to
  * see if the parameter is NULL and returns a pointer to the appropriate TCB.
  */
-#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? ( TCB_t * ) pxCurrentTCB : ( TCB_t * ) ( pxHandle ) )
+#if( configNUM_CORES > 1 )
+	#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? prvGetCurrentTCB() : ( TCB_t * ) ( pxHandle ) )
+#else
+	#define prvGetTCBFromHandle( pxHandle ) ( ( ( pxHandle ) == NULL ) ? ( TCB_t * ) pxCurrentTCB : ( TCB_t * ) ( pxHandle ) )
+#endif
 
 /* The item value of the event list item is normally used to hold the priority
 of the task to which it belongs (coded to allow it to be held in reverse
@@ -331,7 +540,10 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;		/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulBlockedTimeCounter;	/*< Stores the amount of time the task has spent in the Blocked state. */
+		configRUN_TIME_COUNTER_TYPE	ulBlockedSince;			/*< The run time counter value when the task last entered the Blocked state, or 0 if it is not blocked. */
+		uint32_t		ulSwitchInCount;	/*< The number of times the task has been switched in. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -346,8 +558,10 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		/* Each index is an independent notification, so a task can wait on one
+		index without being woken by notifications sent to another. */
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments above the definition of
@@ -360,6 +574,24 @@ typedef struct tskTaskControlBlock
 		uint8_t ucDelayAborted;
 	#endif
 
+	#if( configNUM_CORES > 1 )
+		volatile BaseType_t	xTaskRunState;		/*< The number of the core the task is running on, or taskTASK_NOT_RUNNING. */
+		UBaseType_t			uxCoreAffinityMask;	/*< A bit for each core the task is allowed to run on. */
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+		TickType_t		xRelativeDeadline;	/*< The time from each release of the task to its deadline, or 0 if the task has no deadline. */
+		TickType_t		xPeriod;			/*< The time between releases of the task, used by xTaskWaitForNextPeriod(). */
+		TickType_t		xReleaseTime;		/*< The tick count at which the current release of the task occurred. */
+		TickType_t		xDeadline;			/*< The deadline of the current release.  Ready lists are ordered by it. */
+	#endif
+
+	#if( configUSE_PERIOD_MONITOR == 1 )
+		configRUN_TIME_COUNTER_TYPE	ulReleaseTime;	/*< The run time counter value at the current release of the task. */
+		TaskPeriodStats_t	xPeriodStats;		/*< The timing of the releases of the task, returned by vTaskGetPeriodStats(). */
+		uint8_t				ucPeriodState;		/*< One of the taskPERIOD_ values. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -369,16 +601,41 @@ typedef tskTCB TCB_t;
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if( configNUM_CORES > 1 )
+
+	/* The task running on each core.  pxCurrentTCB is the task running on the
+	calling core. */
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUM_CORES ] = { NULL };
+	#define pxCurrentTCB	pxCurrentTCBs[ portGET_CORE_ID() ]
+
+#else
+
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+
+#endif /* configNUM_CORES */
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	PRIVILEGED_DATA static List_t xTimingWheel[ taskTIMING_WHEEL_LEVELS ][ taskTIMING_WHEEL_SLOTS ];	/*< Delayed tasks, held in the slot for the time remaining until they unblock. */
+	PRIVILEGED_DATA static uint32_t ulTimingWheelSlotsInUse[ taskTIMING_WHEEL_LEVELS ];				/*< A bit for each slot that may hold tasks.  Bits are cleared lazily, as tasks can leave a slot through uxListRemove(). */
+	PRIVILEGED_DATA static List_t xTimingWheelOverflowList;										/*< Delayed tasks whose unblock time is beyond the range of the wheel. */
+
+#else
+
+	PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
+
+	#if( configUSE_64_BIT_TICKS == 0 )
+		PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+		PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+	#endif
+
+#endif /* configUSE_TIMING_WHEEL */
+
 #if( INCLUDE_vTaskDelete == 1 )
 
 	PRIVILEGED_DATA static List_t xTasksWaitingTermination;				/*< Tasks that have been deleted - but their memory not yet freed. */
@@ -395,15 +652,34 @@ PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been r
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks 	= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+#ifdef portREADY_PRIORITIES_TYPE
+	/* The port holds the ready priorities in a bit map that is larger than a
+	UBaseType_t, so more priorities can use port optimised task selection. */
+	PRIVILEGED_DATA static volatile portREADY_PRIORITIES_TYPE uxTopReadyPriority;
+#else
+	PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
 
+#if( configNUM_CORES > 1 )
+
+	/* Each core latches its own missed yield.  A yield requested by another
+	core is also recorded until the core has switched context, so the same
+	core is not selected to run two newly readied tasks. */
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUM_CORES ] = { pdFALSE };
+	#define xYieldPending	xYieldPendings[ portGET_CORE_ID() ]
+
+#else
+
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+
+#endif /* configNUM_CORES */
+
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
 lists the xStateListItem can be referenced from, if the scheduler is suspended.
@@ -416,8 +692,13 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	#if( configNUM_CORES > 1 )
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTimes[ configNUM_CORES ] = { 0UL };	/*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+		#define ulTaskSwitchedInTime	ulTaskSwitchedInTimes[ portGET_CORE_ID() ]
+	#else
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#endif
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
@@ -436,6 +717,10 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
+
+	#if( configNUM_CORES > 1 )
+		extern void vApplicationGetPassiveIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex );
+	#endif
 #endif
 
 /* File private functions. --------------------------------*/
@@ -546,10 +831,50 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
 
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
- * will exit the Blocked state.
+ * will exit the Blocked state.  When the timing wheel is used this is instead
+ * the next time at which the wheel must be processed, which can be earlier.
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	/*
+	 * Place a task into the timing wheel slot for the time remaining until
+	 * its xStateListItem value, or into the overflow list if that time is
+	 * beyond the range of the wheel.  O(1).
+	 */
+	static void prvTimingWheelInsert( TCB_t * const pxTCB, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move the tasks held in the slots (and overflow list) whose period starts
+	 * at xTimeNow down the wheel, then return the level 0 slot that holds the
+	 * tasks that unblock at xTimeNow.
+	 */
+	static List_t *prvTimingWheelProcess( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Re-insert each task in pxList into the wheel relative to xTimeNow.
+	 */
+	static void prvTimingWheelMoveTasks( List_t * const pxList, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The time at which the given slot is next processed.
+	 */
+	static TickType_t prvTimingWheelSlotDueTime( const TickType_t xTimeNow, const UBaseType_t uxLevel, const UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Find the time at which the next slot that holds tasks at level uxLevel
+	 * is processed.  Returns pdFALSE if no slot at that level holds tasks.
+	 */
+	static BaseType_t prvTimingWheelNextDueTime( const TickType_t xTimeNow, const UBaseType_t uxLevel, TickType_t * const pxDueTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns pdTRUE if pxList is one of the lists used to hold delayed tasks.
+	 */
+	static BaseType_t prvTimingWheelIsDelayedList( const List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMING_WHEEL */
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -579,6 +904,98 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Returns pdTRUE if pxTCB1 has a deadline and pxTCB2 either has no
+	 * deadline or has a later one.
+	 */
+	static BaseType_t prvHasEarlierDeadline( const TCB_t * const pxTCB1, const TCB_t * const pxTCB2 ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Place pxTCB in the ready list for its priority, after the tasks that
+	 * have an earlier or equal deadline.  A task with no deadline is placed at
+	 * the end of the list.  O(n) in the number of ready tasks of that priority.
+	 */
+	static void prvInsertTaskByDeadline( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if( configUSE_PERIOD_MONITOR == 1 )
+
+	/*
+	 * Count ulTime in the histogram bucket for its range and update the worst
+	 * case time held in pulWorstTime.
+	 */
+	static void prvRecordPeriodTime( uint32_t * const pulHistogram, configRUN_TIME_COUNTER_TYPE * const pulWorstTime, const configRUN_TIME_COUNTER_TYPE ulTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by a periodic task when it completes its current release, the
+	 * deadline of which is xDeadline.  Records the response time and calls the
+	 * deadline miss hook if the release was completed late.
+	 */
+	static void prvRecordPeriodCompletion( const TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called by a periodic task with the scheduler suspended once it is known
+	 * whether the task will block until its next release.  If not, the task
+	 * overran and its next release is timed from now.
+	 */
+	static void prvRecordPeriodEnd( TCB_t * const pxTCB, const BaseType_t xWillBlock ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_PERIOD_MONITOR */
+
+#if( configNUM_CORES > 1 )
+
+	/*
+	 * Select the highest priority task that is allowed to run on core xCoreID
+	 * and is not already running on another core, and make it the task
+	 * running on core xCoreID.  Called with the scheduler lock held.
+	 */
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called when pxTCB has entered the Ready state.  Finds the core running
+	 * the lowest priority task that pxTCB is allowed to preempt.  Returns pdTRUE
+	 * if that is the calling core, otherwise interrupts the selected core (if
+	 * any) and returns pdFALSE.  If xYieldEqualPriority is pdTRUE then the
+	 * calling core is also selected if it is running a task of equal priority.
+	 */
+	static BaseType_t prvYieldForTask( TCB_t *pxTCB, BaseType_t xYieldEqualPriority ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Request a context switch on core xCoreID.  Returns pdTRUE if xCoreID is
+	 * the calling core, in which case the caller must yield, otherwise
+	 * interrupts core xCoreID and returns pdFALSE.
+	 */
+	static BaseType_t prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+
+		/*
+		 * Returns the number of cores that are running a task of priority
+		 * uxPriority.
+		 */
+		static UBaseType_t prvCoresRunningPriority( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+	#endif
+
+	/*
+	 * Returns the task running on the calling core.  The task can migrate
+	 * between reading the core number and reading pxCurrentTCBs[], so the read
+	 * is made inside a critical section.
+	 */
+	static TCB_t *prvGetCurrentTCB( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * The idle task that runs on each core other than core 0.  It only yields
+	 * and waits for an interrupt - the idle task on core 0 performs the clean
+	 * up of deleted tasks and calls the idle hook.
+	 */
+	static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters );
+
+#endif /* configNUM_CORES */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -597,6 +1014,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		configASSERT( puxStackBuffer != NULL );
 		configASSERT( pxTaskBuffer != NULL );
 
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticTask_t equals the size of the real task
+			structure. */
+			volatile size_t xSize = sizeof( StaticTask_t );
+			configASSERT( xSize == sizeof( TCB_t ) );
+		}
+		#endif /* configASSERT_DEFINED */
+
 		if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
 		{
 			/* The memory used for the task's TCB and stack are passed into this
@@ -640,7 +1067,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends
 			on the implementation of the port malloc function and whether or
 			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) configTASK_TCB_MALLOC( sizeof( TCB_t ) );
 
 			if( pxNewTCB != NULL )
 			{
@@ -691,19 +1118,19 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
 			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = ( TCB_t * ) configTASK_TCB_MALLOC( sizeof( TCB_t ) );
 
 			if( pxNewTCB != NULL )
 			{
 				/* Allocate space for the stack used by the task being created.
 				The base of the stack memory stored in the TCB so the task can
 				be deleted later if required. */
-				pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				pxNewTCB->pxStack = ( StackType_t * ) configTASK_STACK_MALLOC( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 				if( pxNewTCB->pxStack == NULL )
 				{
 					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
+					configTASK_TCB_FREE( pxNewTCB );
 					pxNewTCB = NULL;
 				}
 			}
@@ -713,12 +1140,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		StackType_t *pxStack;
 
 			/* Allocate space for the stack used by the task being created. */
-			pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+			pxStack = ( StackType_t * ) configTASK_STACK_MALLOC( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			if( pxStack != NULL )
 			{
 				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
+				pxNewTCB = ( TCB_t * ) configTASK_TCB_MALLOC( sizeof( TCB_t ) ); /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
 
 				if( pxNewTCB != NULL )
 				{
@@ -729,7 +1156,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				{
 					/* The stack cannot be used as the TCB was not created.  Free
 					it again. */
-					vPortFree( pxStack );
+					configTASK_STACK_FREE( pxStack );
 				}
 			}
 			else
@@ -890,6 +1317,9 @@ UBaseType_t x;
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
 	{
 		pxNewTCB->ulRunTimeCounter = 0UL;
+		pxNewTCB->ulBlockedTimeCounter = 0UL;
+		pxNewTCB->ulBlockedSince = 0UL;
+		pxNewTCB->ulSwitchInCount = 0UL;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -915,8 +1345,8 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		memset( ( void * ) &( pxNewTCB->ulNotifiedValue[ 0 ] ), 0x00, sizeof( pxNewTCB->ulNotifiedValue ) );
+		memset( ( void * ) &( pxNewTCB->ucNotifyState[ 0 ] ), taskNOT_WAITING_NOTIFICATION, sizeof( pxNewTCB->ucNotifyState ) );
 	}
 	#endif
 
@@ -933,6 +1363,30 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configNUM_CORES > 1 )
+	{
+		pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+		pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+	}
+	#endif
+
+	#if( configUSE_EDF_SCHEDULING == 1 )
+	{
+		pxNewTCB->xRelativeDeadline = ( TickType_t ) 0U;
+		pxNewTCB->xPeriod = ( TickType_t ) 0U;
+		pxNewTCB->xReleaseTime = ( TickType_t ) 0U;
+		pxNewTCB->xDeadline = ( TickType_t ) 0U;
+	}
+	#endif
+
+	#if( configUSE_PERIOD_MONITOR == 1 )
+	{
+		pxNewTCB->ulReleaseTime = 0UL;
+		( void ) memset( &( pxNewTCB->xPeriodStats ), 0x00, sizeof( TaskPeriodStats_t ) );
+		pxNewTCB->ucPeriodState = taskPERIOD_IDLE;
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
@@ -1020,26 +1474,52 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		prvAddTaskToReadyList( pxNewTCB );
 
 		portSETUP_TCB( pxNewTCB );
+
+		#if( configNUM_CORES > 1 )
+		{
+			/* The new task can preempt a task running on another core, so the
+			check has to be made before another core can select it. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( taskTASK_PREEMPTS_CURRENT( pxNewTCB ) != pdFALSE )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUM_CORES */
 	}
 	taskEXIT_CRITICAL();
 
-	if( xSchedulerRunning != pdFALSE )
+	#if( configNUM_CORES == 1 )
 	{
-		/* If the created task is of a higher priority than the current task
-		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			taskYIELD_IF_USING_PREEMPTION();
+			/* If the created task is of a higher priority than the current task
+			then it should run now. */
+			if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+	#endif /* configNUM_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1102,6 +1582,17 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				required. */
 				portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
 			}
+			#if( configNUM_CORES > 1 )
+				else if( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING )
+				{
+					/* The task is running on another core.  Its TCB and stack
+					cannot be freed until that core has switched away from it, so
+					leave it to the idle task, and interrupt the other core. */
+					vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+					++uxDeletedTasksWaitingCleanUp;
+					( void ) prvYieldCore( pxTCB->xTaskRunState );
+				}
+			#endif /* configNUM_CORES */
 			else
 			{
 				--uxCurrentNumberOfTasks;
@@ -1146,6 +1637,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		configASSERT( ( xTimeIncrement > 0U ) );
 		configASSERT( uxSchedulerSuspended == 0 );
 
+		#if( configUSE_PERIOD_MONITOR == 1 )
+		{
+			/* The call completes the release that occurred at
+			*pxPreviousWakeTime, the deadline of which is the next release. */
+			prvRecordPeriodCompletion( *pxPreviousWakeTime + xTimeIncrement );
+		}
+		#endif
+
 		vTaskSuspendAll();
 		{
 			/* Minor optimisation.  The tick count cannot change in this
@@ -1189,6 +1688,12 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			/* Update the wake time ready for the next call. */
 			*pxPreviousWakeTime = xTimeToWake;
 
+			#if( configUSE_PERIOD_MONITOR == 1 )
+			{
+				prvRecordPeriodEnd( prvGetTCBFromHandle( NULL ), xShouldDelay );
+			}
+			#endif
+
 			if( xShouldDelay != pdFALSE )
 			{
 				traceTASK_DELAY_UNTIL( xTimeToWake );
@@ -1274,9 +1779,10 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxTCB );
 
-		if( pxTCB == pxCurrentTCB )
+		if( taskTASK_IS_RUNNING( pxTCB ) )
 		{
-			/* The task calling this function is querying its own state. */
+			/* The task being queried is the calling task, or, when running on
+			more than one core, a task running on another core. */
 			eReturn = eRunning;
 		}
 		else
@@ -1287,7 +1793,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			if( taskLIST_IS_DELAYED_LIST( pxStateList ) )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1541,6 +2047,34 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					mtCOVERAGE_TEST_MARKER();
 				}
 
+				#if( configNUM_CORES > 1 )
+				{
+					/* The checks above only consider the calling core.  A task
+					that is not running can preempt a task on any core it is
+					allowed to run on, and a running task that has been lowered
+					might have to give way to a task on the core it runs on. */
+					if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+					{
+						if( ( uxNewPriority > uxCurrentBasePriority ) && ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+						{
+							xYieldRequired = taskTASK_PREEMPTS_OR_EQUALS_CURRENT( pxTCB );
+						}
+						else
+						{
+							xYieldRequired = pdFALSE;
+						}
+					}
+					else if( pxTCB->uxPriority < uxPriorityUsedOnEntry )
+					{
+						xYieldRequired = prvYieldCore( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						xYieldRequired = pdFALSE;
+					}
+				}
+				#endif /* configNUM_CORES */
+
 				if( xYieldRequired != pdFALSE )
 				{
 					taskYIELD_IF_USING_PREEMPTION();
@@ -1561,32 +2095,270 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if( configNUM_CORES > 1 )
 
-	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	void vTaskCoreAffinitySet( TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )
 	{
 	TCB_t *pxTCB;
+	BaseType_t xCoreID;
+
+		/* The task must be allowed to run on at least one core. */
+		configASSERT( ( uxCoreAffinityMask & taskALL_CORES_MASK ) != ( UBaseType_t ) 0 );
 
 		taskENTER_CRITICAL();
 		{
-			/* If null is passed in here then it is the running task that is
-			being suspended. */
-			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
-
-			traceTASK_SUSPEND( pxTCB );
+			/* If null is passed in here then it is the affinity of the calling
+			task that is being changed. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
 
-			/* Remove task from the ready/delayed list and place in the
-			suspended list. */
-			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-			{
-				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-			}
-			else
+			if( xSchedulerRunning != pdFALSE )
 			{
-				mtCOVERAGE_TEST_MARKER();
-			}
+				xCoreID = pxTCB->xTaskRunState;
 
-			/* Is the task waiting on an event also? */
+				if( xCoreID != taskTASK_NOT_RUNNING )
+				{
+					/* The task is running on a core it is no longer allowed
+					to run on, so that core must select another task. */
+					if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) == ( UBaseType_t ) 0 )
+					{
+						if( prvYieldCore( xCoreID ) != pdFALSE )
+						{
+							portYIELD_WITHIN_API();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					/* A ready task might now be allowed to run on a core that
+					is running a lower priority task. */
+					if( taskTASK_PREEMPTS_CURRENT( pxTCB ) != pdFALSE )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxReturn = pxTCB->uxCoreAffinityMask;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	void vTaskSetDeadline( TaskHandle_t xTask, TickType_t xRelativeDeadline, TickType_t xPeriod )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xYieldRequired = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the deadline of the calling
+			task that is being set. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			/* The task is released now. */
+			pxTCB->xRelativeDeadline = xRelativeDeadline;
+			pxTCB->xPeriod = xPeriod;
+			pxTCB->xReleaseTime = xTickCount;
+			pxTCB->xDeadline = xTickCount + xRelativeDeadline;
+
+			/* A ready task must be moved to its place in the ready list for
+			its new deadline. */
+			if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+			{
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+
+				if( xSchedulerRunning != pdFALSE )
+				{
+					/* The running task might now have a later deadline than
+					another ready task, so selects again. */
+					if( ( pxTCB == pxCurrentTCB ) || ( taskTASK_PREEMPTS_CURRENT( pxTCB ) != pdFALSE ) )
+					{
+						xYieldRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xYieldRequired != pdFALSE )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	BaseType_t xTaskWaitForNextPeriod( void )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xReturn, xAlreadyYielded;
+
+		configASSERT( uxSchedulerSuspended == 0 );
+
+		#if( configUSE_PERIOD_MONITOR == 1 )
+		{
+			/* The call completes the current release. */
+			prvRecordPeriodCompletion( pxCurrentTCB->xDeadline );
+		}
+		#endif
+
+		vTaskSuspendAll();
+		{
+			/* Minor optimisation.  The tick count cannot change in this
+			block. */
+			const TickType_t xConstTickCount = xTickCount;
+
+			pxTCB = pxCurrentTCB;
+			configASSERT( pxTCB->xPeriod > ( TickType_t ) 0U );
+
+			/* Releases are made at fixed intervals, as with vTaskDelayUntil(),
+			so an overrun does not move the later releases. */
+			pxTCB->xReleaseTime += pxTCB->xPeriod;
+			pxTCB->xDeadline = pxTCB->xReleaseTime + pxTCB->xRelativeDeadline;
+
+			if( taskTIME_IS_BEFORE( xConstTickCount, pxTCB->xReleaseTime ) )
+			{
+				traceTASK_DELAY_UNTIL( pxTCB->xReleaseTime );
+
+				/* prvAddCurrentTaskToDelayedList() needs the block time, not
+				the time to wake, so subtract the current tick count.  The
+				task is placed by its new deadline when it is next readied. */
+				prvAddCurrentTaskToDelayedList( pxTCB->xReleaseTime - xConstTickCount, pdFALSE );
+				xReturn = pdTRUE;
+			}
+			else
+			{
+				xReturn = pdFALSE;
+			}
+
+			#if( configUSE_PERIOD_MONITOR == 1 )
+			{
+				prvRecordPeriodEnd( pxTCB, xReturn );
+			}
+			#endif
+
+			if( xReturn == pdFALSE )
+			{
+				/* The task overran its period, so the next release has
+				already occurred.  Move the task to its place in the ready list
+				for its new deadline.  It remains in the ready list for its
+				priority so the ready priority does not need to be reset. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+				prvAddTaskToReadyList( pxTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		xAlreadyYielded = xTaskResumeAll();
+
+		/* Force a reschedule if xTaskResumeAll has not already done so, as the
+		task has either blocked or has a later deadline. */
+		if( xAlreadyYielded == pdFALSE )
+		{
+			portYIELD_WITHIN_API();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+	void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			/* If null is passed in here then it is the running task that is
+			being suspended. */
+			pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+			traceTASK_SUSPEND( pxTCB );
+
+			/* Remove task from the ready/delayed list and place in the
+			suspended list. */
+			if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+			{
+				taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Is the task waiting on an event also? */
 			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 			{
 				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
@@ -1597,6 +2369,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 
 			vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+
+			#if( configNUM_CORES > 1 )
+			{
+				/* A task running on another core is suspended by interrupting
+				that core. */
+				if( ( xSchedulerRunning != pdFALSE ) && ( pxTCB != pxCurrentTCB ) && ( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING ) )
+				{
+					( void ) prvYieldCore( pxTCB->xTaskRunState );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configNUM_CORES */
 		}
 		taskEXIT_CRITICAL();
 
@@ -1722,7 +2509,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* We may have just resumed a higher priority task. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskTASK_PREEMPTS_OR_EQUALS_CURRENT( pxTCB ) != pdFALSE )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1790,7 +2577,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskTASK_PREEMPTS_OR_EQUALS_CURRENT( pxTCB ) != pdFALSE )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -1865,6 +2652,58 @@ BaseType_t xReturn;
 	}
 	#endif /* configSUPPORT_STATIC_ALLOCATION */
 
+	#if( configNUM_CORES > 1 )
+	{
+	BaseType_t xCoreID;
+	char cIdleName[ configMAX_TASK_NAME_LEN ];
+
+		/* Every core other than the first also needs a task to run when it
+		has nothing else to do.  They are named IDLE01, IDLE02, etc. */
+		configASSERT( configMAX_TASK_NAME_LEN >= 7 );
+
+		for( xCoreID = ( BaseType_t ) 1; ( xCoreID < ( BaseType_t ) configNUM_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+		{
+			cIdleName[ 0 ] = 'I';
+			cIdleName[ 1 ] = 'D';
+			cIdleName[ 2 ] = 'L';
+			cIdleName[ 3 ] = 'E';
+			cIdleName[ 4 ] = ( char ) ( '0' + ( xCoreID / 10 ) );
+			cIdleName[ 5 ] = ( char ) ( '0' + ( xCoreID % 10 ) );
+			cIdleName[ 6 ] = ( char ) 0x00;
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				StaticTask_t *pxIdleTaskTCBBuffer = NULL;
+				StackType_t *pxIdleTaskStackBuffer = NULL;
+				uint32_t ulIdleTaskStackSize;
+
+				/* Created using user provided RAM, as the first idle task. */
+				vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - 1 );
+
+				if( xTaskCreateStatic(	prvPassiveIdleTask,
+										cIdleName,
+										ulIdleTaskStackSize,
+										( void * ) NULL,
+										( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
+										pxIdleTaskStackBuffer,
+										pxIdleTaskTCBBuffer ) == NULL ) /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+				{
+					xReturn = pdFAIL;
+				}
+			}
+			#else
+			{
+				xReturn = xTaskCreate(	prvPassiveIdleTask,
+										cIdleName, configMINIMAL_STACK_SIZE,
+										( void * ) NULL,
+										( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
+										NULL ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+	}
+	#endif /* configNUM_CORES */
+
 	#if ( configUSE_TIMERS == 1 )
 	{
 		if( xReturn == pdPASS )
@@ -1895,6 +2734,19 @@ BaseType_t xReturn;
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 
+		#if( configNUM_CORES > 1 )
+		{
+		BaseType_t xCoreID;
+
+			/* Select the first task to run on each core.  pxCurrentTCBs[ 0 ]
+			was only provisionally set as tasks were created. */
+			for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+			{
+				prvSelectHighestPriorityTask( xCoreID );
+			}
+		}
+		#endif /* configNUM_CORES */
+
 		xNextTaskUnblockTime = portMAX_DELAY;
 		xSchedulerRunning = pdTRUE;
 		xTickCount = ( TickType_t ) 0U;
@@ -1947,7 +2799,23 @@ void vTaskSuspendAll( void )
 	BaseType_t.  Please read Richard Barry's reply in the following link to a
 	post in the FreeRTOS support forum before reporting this as a bug! -
 	http://goo.gl/wu4acr */
-	++uxSchedulerSuspended;
+	#if( configNUM_CORES > 1 )
+	{
+		/* When running on more than one core the scheduler lock must also be
+		taken, so tasks running on other cores wait in their next critical
+		section until the scheduler is resumed. */
+		portENTER_CRITICAL();
+		{
+			portGET_TASK_LOCK();
+			++uxSchedulerSuspended;
+		}
+		portEXIT_CRITICAL();
+	}
+	#else
+	{
+		++uxSchedulerSuspended;
+	}
+	#endif /* configNUM_CORES */
 }
 /*----------------------------------------------------------*/
 
@@ -1969,6 +2837,20 @@ void vTaskSuspendAll( void )
 				uxHigherPriorityReadyTasks = pdTRUE;
 			}
 		}
+		#elif defined( portREADY_PRIORITIES_TYPE )
+		{
+		UBaseType_t uxTopPriority;
+
+			/* The port's bit map cannot be compared as a single value, so
+			find the highest ready priority.  The idle task is running, so at
+			least one bit is set. */
+			portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+
+			if( uxTopPriority > tskIDLE_PRIORITY )
+			{
+				uxHigherPriorityReadyTasks = pdTRUE;
+			}
+		}
 		#else
 		{
 			const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
@@ -2008,6 +2890,20 @@ void vTaskSuspendAll( void )
 			xReturn = xNextTaskUnblockTime - xTickCount;
 		}
 
+		#if ( configUSE_CO_ROUTINES == 1 )
+		{
+		TickType_t xCoRoutineIdleTime;
+
+			/* Do not sleep past the time the next co-routine is ready. */
+			xCoRoutineIdleTime = xCoRoutineGetExpectedIdleTime();
+
+			if( xCoRoutineIdleTime < xReturn )
+			{
+				xReturn = xCoRoutineIdleTime;
+			}
+		}
+		#endif /* configUSE_CO_ROUTINES */
+
 		return xReturn;
 	}
 
@@ -2032,8 +2928,37 @@ BaseType_t xAlreadyYielded = pdFALSE;
 	{
 		--uxSchedulerSuspended;
 
+		#if( configNUM_CORES > 1 )
+		{
+			/* Release the scheduler lock taken by vTaskSuspendAll().  It is
+			still held by the critical section. */
+			portRELEASE_TASK_LOCK();
+		}
+		#endif /* configNUM_CORES */
+
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
+			#if( configNUM_CORES > 1 )
+			{
+			BaseType_t xCoreID;
+
+				/* Other cores that tried to switch context while the scheduler
+				was suspended latched the request in xYieldPendings[], so
+				interrupt them again now the switch can be performed. */
+				for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+				{
+					if( ( xCoreID != ( BaseType_t ) portGET_CORE_ID() ) && ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+					{
+						portYIELD_CORE( xCoreID );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#endif /* configNUM_CORES */
+
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
 			{
 				/* Move any readied tasks from the pending list into the
@@ -2047,7 +2972,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskTASK_PREEMPTS_OR_EQUALS_CURRENT( pxTCB ) != pdFALSE )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2278,19 +3203,44 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
-			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-			}
-
-			if( pxTCB == NULL )
+			#if( configUSE_TIMING_WHEEL == 1 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
-			}
+			UBaseType_t uxLevel, uxSlot;
 
-			#if ( INCLUDE_vTaskSuspend == 1 )
-			{
-				if( pxTCB == NULL )
+				for( uxLevel = 0U; ( uxLevel < taskTIMING_WHEEL_LEVELS ) && ( pxTCB == NULL ); uxLevel++ )
+				{
+					for( uxSlot = 0U; ( uxSlot < taskTIMING_WHEEL_SLOTS ) && ( pxTCB == NULL ); uxSlot++ )
+					{
+						pxTCB = prvSearchForNameWithinSingleList( &( xTimingWheel[ uxLevel ][ uxSlot ] ), pcNameToQuery );
+					}
+				}
+
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &xTimingWheelOverflowList, pcNameToQuery );
+				}
+			}
+			#else
+			{
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
+
+				#if( configUSE_64_BIT_TICKS == 0 )
+				{
+					if( pxTCB == NULL )
+					{
+						pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+					}
+				}
+				#endif
+			}
+			#endif /* configUSE_TIMING_WHEEL */
+
+			#if ( INCLUDE_vTaskSuspend == 1 )
+			{
+				if( pxTCB == NULL )
 				{
 					/* Search the suspended list. */
 					pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
@@ -2318,7 +3268,7 @@ TCB_t *pxTCB;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2338,8 +3288,30 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if( configUSE_TIMING_WHEEL == 1 )
+				{
+				UBaseType_t uxLevel, uxSlot;
+
+					for( uxLevel = 0U; uxLevel < taskTIMING_WHEEL_LEVELS; uxLevel++ )
+					{
+						for( uxSlot = 0U; uxSlot < taskTIMING_WHEEL_SLOTS; uxSlot++ )
+						{
+							uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xTimingWheel[ uxLevel ][ uxSlot ] ), eBlocked );
+						}
+					}
+
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTimingWheelOverflowList, eBlocked );
+				}
+				#else
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					#if( configUSE_64_BIT_TICKS == 0 )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+					}
+					#endif
+				}
+				#endif /* configUSE_TIMING_WHEEL */
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2414,7 +3386,18 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		/* Correct the tick count value after a period during which the tick
 		was suppressed.  Note this does *not* call the tick hook function for
 		each stepped tick. */
-		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		#if( configUSE_TIMING_WHEEL == 1 )
+		{
+			/* The timing wheel must be processed when the tick count reaches
+			xNextTaskUnblockTime, so the tick count can only be stepped to the
+			tick before it. */
+			configASSERT( ( xTickCount + xTicksToJump ) < xNextTaskUnblockTime );
+		}
+		#else
+		{
+			configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		}
+		#endif
 		xTickCount += xTicksToJump;
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
@@ -2470,7 +3453,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskTASK_PREEMPTS_CURRENT( pxTCB ) != pdFALSE )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2501,6 +3484,12 @@ BaseType_t xTaskIncrementTick( void )
 TCB_t * pxTCB;
 TickType_t xItemValue;
 BaseType_t xSwitchRequired = pdFALSE;
+#if( configUSE_TIMING_WHEEL == 1 )
+	List_t *pxUnblockedTaskList = NULL;
+#endif
+#if( ( configNUM_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+	BaseType_t xCoreID;
+#endif
 
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
@@ -2516,14 +3505,18 @@ BaseType_t xSwitchRequired = pdFALSE;
 		delayed lists if it wraps to 0. */
 		xTickCount = xConstTickCount;
 
-		if( xConstTickCount == ( TickType_t ) 0U )
-		{
-			taskSWITCH_DELAYED_LISTS();
-		}
-		else
+		#if( configUSE_64_BIT_TICKS == 0 )
 		{
-			mtCOVERAGE_TEST_MARKER();
+			if( xConstTickCount == ( TickType_t ) 0U )
+			{
+				taskSWITCH_DELAYED_LISTS();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
+		#endif /* configUSE_64_BIT_TICKS */
 
 		/* See if this tick has made a timeout expire.  Tasks are stored in
 		the	queue in the order of their wake time - meaning once one task
@@ -2531,79 +3524,109 @@ BaseType_t xSwitchRequired = pdFALSE;
 		look any further down the list. */
 		if( xConstTickCount >= xNextTaskUnblockTime )
 		{
+			#if( configUSE_TIMING_WHEEL == 1 )
+			{
+				/* Move the tasks in the wheel slots that are due on this tick
+				down the wheel, and obtain the list of tasks that unblock on
+				this tick. */
+				pxUnblockedTaskList = prvTimingWheelProcess( xConstTickCount );
+			}
+			#endif /* configUSE_TIMING_WHEEL */
+
 			for( ;; )
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
-				}
-				else
+				#if( configUSE_TIMING_WHEEL == 1 )
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-					if( xConstTickCount < xItemValue )
+					if( listLIST_IS_EMPTY( pxUnblockedTaskList ) != pdFALSE )
 					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
-						xNextTaskUnblockTime = xItemValue;
+						/* All the tasks that unblock on this tick have been
+						removed from the Blocked state.  Find the next tick
+						on which the wheel needs processing. */
+						prvResetNextTaskUnblockTime();
 						break;
 					}
 					else
 					{
-						mtCOVERAGE_TEST_MARKER();
+						/* Every task in the list unblocks on this tick. */
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxUnblockedTaskList );
+						( void ) xItemValue;
 					}
-
-					/* It is time to remove the item from the Blocked state. */
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				}
+				#else
+				{
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						/* The delayed list is empty.  Set xNextTaskUnblockTime
+						to the maximum possible value so it is extremely
+						unlikely that the
+						if( xTickCount >= xNextTaskUnblockTime ) test will pass
+						next time through. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						break;
 					}
 					else
 					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* Place the unblocked task into the appropriate ready
-					list. */
-					prvAddTaskToReadyList( pxTCB );
-
-					/* A task being unblocked cannot cause an immediate
-					context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
-					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						/* The delayed list is not empty, get the value of the
+						item at the head of the delayed list.  This is the time
+						at which the task at the head of the delayed list must
+						be removed from the Blocked state. */
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+						xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+						if( xConstTickCount < xItemValue )
 						{
-							xSwitchRequired = pdTRUE;
+							/* It is not time to unblock this item yet, but the
+							item value is the time at which the task at the head
+							of the blocked list must be removed from the Blocked
+							state -	so record the item value in
+							xNextTaskUnblockTime. */
+							xNextTaskUnblockTime = xItemValue;
+							break;
 						}
 						else
 						{
 							mtCOVERAGE_TEST_MARKER();
 						}
 					}
-					#endif /* configUSE_PREEMPTION */
 				}
+				#endif /* configUSE_TIMING_WHEEL */
+
+				/* It is time to remove the item from the Blocked state. */
+				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+				/* Is the task waiting on an event also?  If so remove
+				it from the event list. */
+				if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+				{
+					( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Place the unblocked task into the appropriate ready
+				list. */
+				prvAddTaskToReadyList( pxTCB );
+
+				/* A task being unblocked cannot cause an immediate
+				context switch if preemption is turned off. */
+				#if (  configUSE_PREEMPTION == 1 )
+				{
+					/* Preemption is on, but a context switch should
+					only be performed if the unblocked task has a
+					priority that is equal to or higher than the
+					currently executing task. */
+					if( taskTASK_PREEMPTS_OR_EQUALS_CURRENT( pxTCB ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configUSE_PREEMPTION */
 			}
 		}
 
@@ -2612,14 +3635,41 @@ BaseType_t xSwitchRequired = pdFALSE;
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#if( configNUM_CORES > 1 )
 			{
-				xSwitchRequired = pdTRUE;
+				/* A core only needs to time slice if its priority has more
+				ready tasks than there are cores running them. */
+				for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+				{
+					if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > prvCoresRunningPriority( pxCurrentTCBs[ xCoreID ]->uxPriority ) )
+					{
+						if( prvYieldCore( xCoreID ) != pdFALSE )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
 			}
-			else
+			#else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
+			#endif /* configNUM_CORES */
 		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2760,6 +3810,10 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
+	TCB_t *pxPreviousTCB;
+#endif
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -2773,11 +3827,8 @@ void vTaskSwitchContext( void )
 
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
-				#ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-					portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-				#else
-					ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-				#endif
+				pxPreviousTCB = pxCurrentTCB;
+				prvGET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
 
 				/* Add the amount of time the task has been running to the
 				accumulated time so far.  The time the task started running was
@@ -2803,9 +3854,50 @@ void vTaskSwitchContext( void )
 
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK();
+		#if( configNUM_CORES > 1 )
+		{
+			prvSelectHighestPriorityTask( ( BaseType_t ) portGET_CORE_ID() );
+		}
+		#else
+		{
+			taskSELECT_HIGHEST_PRIORITY_TASK();
+		}
+		#endif /* configNUM_CORES */
 		traceTASK_SWITCHED_IN();
 
+		#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* Only count switches to a different task, not the selection of
+			the task that was already running. */
+			if( pxCurrentTCB != pxPreviousTCB )
+			{
+				( pxCurrentTCB->ulSwitchInCount )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
+
+		#if ( configUSE_PERIOD_MONITOR == 1 )
+		{
+			/* The first time a task runs after a release ends its start
+			latency.  With more than one core the release may have been
+			recorded by another core after ulTotalRunTime was read here. */
+			if( pxCurrentTCB->ucPeriodState == taskPERIOD_RELEASED )
+			{
+				prvRecordPeriodTime( pxCurrentTCB->xPeriodStats.ulStartLatencyHistogram, &( pxCurrentTCB->xPeriodStats.ulWorstStartLatency ),
+									 ( ulTotalRunTime > pxCurrentTCB->ulReleaseTime ) ? ( ulTotalRunTime - pxCurrentTCB->ulReleaseTime ) : 0UL );
+				pxCurrentTCB->ucPeriodState = taskPERIOD_RUNNING;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_PERIOD_MONITOR */
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -2925,7 +4017,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskTASK_PREEMPTS_CURRENT( pxUnblockedTCB ) != pdFALSE )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -2983,7 +4075,7 @@ BaseType_t xReturn;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskTASK_PREEMPTS_CURRENT( pxUnblockedTCB ) != pdFALSE )
 	{
 		/* Return true if the task removed from the event list has
 		a higher priority than the calling task.  This allows
@@ -3046,16 +4138,20 @@ BaseType_t xReturn;
 			else
 		#endif
 
-		if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
-		{
-			/* The tick count is greater than the time at which
-			vTaskSetTimeout() was called, but has also overflowed since
-			vTaskSetTimeOut() was called.  It must have wrapped all the way
-			around and gone past again. This passed since vTaskSetTimeout()
-			was called. */
-			xReturn = pdTRUE;
-		}
-		else if( ( ( TickType_t ) ( xConstTickCount - pxTimeOut->xTimeOnEntering ) ) < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+		#if( configUSE_64_BIT_TICKS == 0 )
+			if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+			{
+				/* The tick count is greater than the time at which
+				vTaskSetTimeout() was called, but has also overflowed since
+				vTaskSetTimeOut() was called.  It must have wrapped all the way
+				around and gone past again. This passed since vTaskSetTimeout()
+				was called. */
+				xReturn = pdTRUE;
+			}
+			else
+		#endif
+
+		if( ( ( TickType_t ) ( xConstTickCount - pxTimeOut->xTimeOnEntering ) ) < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
 		{
 			/* Not a genuine timeout. Adjust parameters for time remaining. */
 			*pxTicksToWait -= ( xConstTickCount - pxTimeOut->xTimeOnEntering );
@@ -3161,9 +4257,10 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 
 			A critical region is not required here as we are just reading from
 			the list, and an occasional incorrect value will not matter.  If
-			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			the ready list at the idle priority contains more tasks than there
+			are idle tasks then a task other than an idle task is ready to
+			execute. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUM_CORES )
 			{
 				taskYIELD();
 			}
@@ -3231,10 +4328,72 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			}
 		}
 		#endif /* configUSE_TICKLESS_IDLE */
+
+		/* Wait for the next interrupt rather than spinning.  This does
+		nothing unless the port defines portWAIT_FOR_INTERRUPT().  Don't
+		wait if the list holds more than one idle task per core, as another
+		task at the idle priority is then ready to run and would otherwise
+		be held up until the next interrupt.  Ready co-routines are run by
+		the idle hook on the next iteration instead. */
+		if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) <= ( UBaseType_t ) configNUM_CORES )
+		{
+			#if ( configUSE_CO_ROUTINES == 1 )
+			{
+				if( xCoRoutineGetExpectedIdleTime() != 0 )
+				{
+					portWAIT_FOR_INTERRUPT();
+				}
+			}
+			#else
+			{
+				portWAIT_FOR_INTERRUPT();
+			}
+			#endif /* configUSE_CO_ROUTINES */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
 }
 /*-----------------------------------------------------------*/
 
+#if( configNUM_CORES > 1 )
+
+	static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
+	{
+		/* Stop warnings. */
+		( void ) pvParameters;
+
+		for( ;; )
+		{
+			#if ( configUSE_PREEMPTION == 0 )
+			{
+				/* See the comments in prvIdleTask(). */
+				taskYIELD();
+			}
+			#endif /* configUSE_PREEMPTION */
+
+			#if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+			{
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUM_CORES )
+				{
+					taskYIELD();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+			portWAIT_FOR_INTERRUPT();
+		}
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TICKLESS_IDLE != 0 )
 
 	eSleepModeStatus eTaskConfirmSleepModeStatus( void )
@@ -3339,8 +4498,34 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if( configUSE_TIMING_WHEEL == 1 )
+	{
+	UBaseType_t uxLevel, uxSlot;
+
+		for( uxLevel = 0U; uxLevel < taskTIMING_WHEEL_LEVELS; uxLevel++ )
+		{
+			for( uxSlot = 0U; uxSlot < taskTIMING_WHEEL_SLOTS; uxSlot++ )
+			{
+				vListInitialise( &( xTimingWheel[ uxLevel ][ uxSlot ] ) );
+			}
+
+			ulTimingWheelSlotsInUse[ uxLevel ] = 0UL;
+		}
+
+		vListInitialise( &xTimingWheelOverflowList );
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+
+		#if( configUSE_64_BIT_TICKS == 0 )
+		{
+			vListInitialise( &xDelayedTaskList2 );
+		}
+		#endif
+	}
+	#endif /* configUSE_TIMING_WHEEL */
+
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3355,10 +4540,19 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if( configUSE_TIMING_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+
+		#if( configUSE_64_BIT_TICKS == 0 )
+		{
+			pxOverflowDelayedTaskList = &xDelayedTaskList2;
+		}
+		#endif
+	}
+	#endif /* configUSE_TIMING_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -3388,13 +4582,45 @@ static void prvCheckTasksWaitingTermination( void )
 				taskENTER_CRITICAL();
 				{
 					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					--uxCurrentNumberOfTasks;
-					--uxDeletedTasksWaitingCleanUp;
+
+					#if( configNUM_CORES > 1 )
+					{
+						/* A task deleted while running on another core stays
+						in the list until that core has switched away from
+						it. */
+						if( pxTCB->xTaskRunState != taskTASK_NOT_RUNNING )
+						{
+							pxTCB = NULL;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configNUM_CORES */
+
+					if( pxTCB != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						--uxCurrentNumberOfTasks;
+						--uxDeletedTasksWaitingCleanUp;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 				taskEXIT_CRITICAL();
 
-				prvDeleteTCB( pxTCB );
+				if( pxTCB != NULL )
+				{
+					prvDeleteTCB( pxTCB );
+				}
+				else
+				{
+					/* Try again the next time the idle task runs. */
+					break;
+				}
 			}
 			else
 			{
@@ -3421,9 +4647,30 @@ static void prvCheckTasksWaitingTermination( void )
 		pxTaskStatus->pxStackBase = pxTCB->pxStack;
 		pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
 
-		#if ( INCLUDE_vTaskSuspend == 1 )
-		{
-			/* If the task is in the suspended list then there is a chance it is
+		/* Obtaining the task state is a little fiddly, so is only done if the value
+		of eState passed into this function is eInvalid - otherwise the state is
+		just set to whatever is passed in, other than for a task in a ready list
+		that is actually running.  The state must be known before the check for
+		a task that is blocked indefinitely below. */
+		if( eState != eInvalid )
+		{
+			if( ( eState == eReady ) && taskTASK_IS_RUNNING( pxTCB ) )
+			{
+				pxTaskStatus->eCurrentState = eRunning;
+			}
+			else
+			{
+				pxTaskStatus->eCurrentState = eState;
+			}
+		}
+		else
+		{
+			pxTaskStatus->eCurrentState = eTaskGetState( xTask );
+		}
+
+		#if ( INCLUDE_vTaskSuspend == 1 )
+		{
+			/* If the task is in the suspended list then there is a chance it is
 			actually just blocked indefinitely - so really it should be reported as
 			being in the Blocked state. */
 			if( pxTaskStatus->eCurrentState == eSuspended )
@@ -3452,26 +4699,54 @@ static void prvCheckTasksWaitingTermination( void )
 
 		#if ( configGENERATE_RUN_TIME_STATS == 1 )
 		{
+		configRUN_TIME_COUNTER_TYPE ulTimeNow, ulSwitchedInTime = 0UL;
+
 			pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+			pxTaskStatus->ulBlockedTimeCounter = pxTCB->ulBlockedTimeCounter;
+			pxTaskStatus->ulSwitchInCount = pxTCB->ulSwitchInCount;
+
+			/* A task's run time is only added to when it is switched out, so
+			include the time a running task has run since it was switched in.
+			Otherwise a task that is rarely switched out, such as the idle task
+			on another core, would be reported as using no time at all. */
+			#if( configNUM_CORES > 1 )
+			{
+			/* Read the core once, as another core can switch the task out at
+			any time. */
+			const BaseType_t xRunningCore = pxTCB->xTaskRunState;
+
+				if( xRunningCore != taskTASK_NOT_RUNNING )
+				{
+					ulSwitchedInTime = ulTaskSwitchedInTimes[ xRunningCore ];
+				}
+			}
+			#else
+			{
+				if( pxTCB == pxCurrentTCB )
+				{
+					ulSwitchedInTime = ulTaskSwitchedInTime;
+				}
+			}
+			#endif /* configNUM_CORES */
+
+			if( ulSwitchedInTime != 0UL )
+			{
+				prvGET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+
+				if( ulTimeNow > ulSwitchedInTime )
+				{
+					pxTaskStatus->ulRunTimeCounter += ( ulTimeNow - ulSwitchedInTime );
+				}
+			}
 		}
 		#else
 		{
 			pxTaskStatus->ulRunTimeCounter = 0;
+			pxTaskStatus->ulBlockedTimeCounter = 0;
+			pxTaskStatus->ulSwitchInCount = 0;
 		}
 		#endif
 
-		/* Obtaining the task state is a little fiddly, so is only done if the value
-		of eState passed into this function is eInvalid - otherwise the state is
-		just set to whatever is passed in. */
-		if( eState != eInvalid )
-		{
-			pxTaskStatus->eCurrentState = eState;
-		}
-		else
-		{
-			pxTaskStatus->eCurrentState = eTaskGetState( xTask );
-		}
-
 		/* Obtaining the stack space takes some time, so the xGetFreeStackSpace
 		parameter is provided to allow it to be skipped. */
 		if( xGetFreeStackSpace != pdFALSE )
@@ -3495,6 +4770,43 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_PERIOD_MONITOR == 1 )
+
+	void vTaskGetPeriodStats( TaskHandle_t xTask, TaskPeriodStats_t *pxPeriodStats )
+	{
+	TCB_t *pxTCB;
+
+		configASSERT( pxPeriodStats );
+
+		taskENTER_CRITICAL();
+		{
+			/* xTask is NULL then get the stats of the calling task. */
+			pxTCB = prvGetTCBFromHandle( xTask );
+			*pxPeriodStats = pxTCB->xPeriodStats;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_PERIOD_MONITOR */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIOD_MONITOR == 1 )
+
+	void vTaskClearPeriodStats( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			( void ) memset( &( pxTCB->xPeriodStats ), 0x00, sizeof( TaskPeriodStats_t ) );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_PERIOD_MONITOR */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
 	static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t *pxTaskStatusArray, List_t *pxList, eTaskState eState )
@@ -3597,8 +4909,8 @@ static void prvCheckTasksWaitingTermination( void )
 		{
 			/* The task can only have been allocated dynamically - free both
 			the stack and TCB. */
-			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			configTASK_STACK_FREE( pxTCB->pxStack );
+			configTASK_TCB_FREE( pxTCB );
 		}
 		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE == 1 )
 		{
@@ -3609,14 +4921,14 @@ static void prvCheckTasksWaitingTermination( void )
 			{
 				/* Both the stack and TCB were allocated dynamically, so both
 				must be freed. */
-				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
+				configTASK_STACK_FREE( pxTCB->pxStack );
+				configTASK_TCB_FREE( pxTCB );
 			}
 			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
 			{
 				/* Only the stack was statically allocated, so the TCB is the
 				only memory that must be freed. */
-				vPortFree( pxTCB );
+				configTASK_TCB_FREE( pxTCB );
 			}
 			else
 			{
@@ -3632,28 +4944,268 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+#if( configUSE_TIMING_WHEEL == 1 )
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	static void prvResetNextTaskUnblockTime( void )
 	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
-		xNextTaskUnblockTime = portMAX_DELAY;
+	const TickType_t xTimeNow = xTickCount;
+	TickType_t xDueTime, xTicksToNextDueTime = portMAX_DELAY;
+	BaseType_t xFound = pdFALSE;
+	UBaseType_t uxLevel;
+
+		/* Find the slot, at any level, that is processed next.  The slot may
+		only hold tasks that are moved down the wheel, rather than unblocked,
+		when it is processed - in which case this function is called again at
+		that time. */
+		for( uxLevel = 0U; uxLevel < taskTIMING_WHEEL_LEVELS; uxLevel++ )
+		{
+			if( prvTimingWheelNextDueTime( xTimeNow, uxLevel, &xDueTime ) != pdFALSE )
+			{
+				if( ( xFound == pdFALSE ) || ( ( TickType_t ) ( xDueTime - xTimeNow ) < xTicksToNextDueTime ) )
+				{
+					xTicksToNextDueTime = ( TickType_t ) ( xDueTime - xTimeNow );
+					xFound = pdTRUE;
+				}
+			}
+		}
+
+		/* The overflow list is processed each time the tick count reaches a
+		multiple of the range of the wheel. */
+		if( listLIST_IS_EMPTY( &xTimingWheelOverflowList ) == pdFALSE )
+		{
+			xDueTime = ( TickType_t ) ( ( ( xTimeNow >> taskTIMING_WHEEL_RANGE_BITS ) + 1U ) << taskTIMING_WHEEL_RANGE_BITS );
+
+			if( ( xFound == pdFALSE ) || ( ( TickType_t ) ( xDueTime - xTimeNow ) < xTicksToNextDueTime ) )
+			{
+				xTicksToNextDueTime = ( TickType_t ) ( xDueTime - xTimeNow );
+				xFound = pdTRUE;
+			}
+		}
+
+		if( ( xFound != pdFALSE ) && ( ( TickType_t ) ( xTimeNow + xTicksToNextDueTime ) > xTimeNow ) )
+		{
+			xNextTaskUnblockTime = xTimeNow + xTicksToNextDueTime;
+		}
+		else
+		{
+			/* Nothing is due before the tick count overflows, at which point
+			taskSWITCH_DELAYED_LISTS() ensures the wheel is processed. */
+			xNextTaskUnblockTime = portMAX_DELAY;
+		}
 	}
-	else
+
+#else
+
+	static void prvResetNextTaskUnblockTime( void )
 	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+	TCB_t *pxTCB;
+
+		if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+		{
+			/* The new current delayed list is empty.  Set xNextTaskUnblockTime
+			to the maximum possible value so it is	extremely unlikely that the
+			if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+			there is an item in the delayed list. */
+			xNextTaskUnblockTime = portMAX_DELAY;
+		}
+		else
+		{
+			/* The new current delayed list is not empty, get the value of
+			the item at the head of the delayed list.  This is the time at
+			which the task at the head of the delayed list should be removed
+			from the Blocked state. */
+			( pxTCB ) = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+			xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+		}
 	}
-}
+
+#endif /* configUSE_TIMING_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMING_WHEEL == 1 )
+
+	static void prvTimingWheelInsert( TCB_t * const pxTCB, const TickType_t xTimeNow )
+	{
+	const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+	const TickType_t xTicksToWait = ( TickType_t ) ( xTimeToWake - xTimeNow );
+	TickType_t xDueTime;
+	UBaseType_t uxLevel, uxSlot;
+
+		/* Find the lowest level that can hold the time remaining.  A level
+		that covers 2^n ticks per slot holds the tasks that unblock in less
+		than 2^( n + taskTIMING_WHEEL_SLOT_BITS ) ticks. */
+		for( uxLevel = 0U; uxLevel < taskTIMING_WHEEL_LEVELS; uxLevel++ )
+		{
+			if( ( xTicksToWait >> ( ( uxLevel + 1U ) * taskTIMING_WHEEL_SLOT_BITS ) ) == ( TickType_t ) 0U )
+			{
+				break;
+			}
+		}
+
+		if( uxLevel < taskTIMING_WHEEL_LEVELS )
+		{
+			/* The slot is selected using the wake time itself, not the time
+			remaining, so the slot does not depend on when the task was
+			inserted. */
+			uxSlot = ( UBaseType_t ) ( xTimeToWake >> ( uxLevel * taskTIMING_WHEEL_SLOT_BITS ) ) & taskTIMING_WHEEL_SLOT_MASK;
+			vListInsertEnd( &( xTimingWheel[ uxLevel ][ uxSlot ] ), &( pxTCB->xStateListItem ) );
+			ulTimingWheelSlotsInUse[ uxLevel ] |= ( 1UL << uxSlot );
+			xDueTime = prvTimingWheelSlotDueTime( xTimeNow, uxLevel, uxSlot );
+		}
+		else
+		{
+			vListInsertEnd( &xTimingWheelOverflowList, &( pxTCB->xStateListItem ) );
+			xDueTime = ( TickType_t ) ( ( ( xTimeNow >> taskTIMING_WHEEL_RANGE_BITS ) + 1U ) << taskTIMING_WHEEL_RANGE_BITS );
+		}
+
+		/* A due time that has overflowed must not set xNextTaskUnblockTime,
+		as the wheel is always processed when the tick count overflows. */
+		if( ( xDueTime > xTimeNow ) && ( xDueTime < xNextTaskUnblockTime ) )
+		{
+			xNextTaskUnblockTime = xDueTime;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static List_t *prvTimingWheelProcess( const TickType_t xTimeNow )
+	{
+	UBaseType_t uxLevel, uxSlot, uxShift;
+
+		/* The tasks in the overflow list are moved into the wheel each time
+		the tick count reaches a multiple of the range of the wheel.  Those
+		that are still out of range go back into the overflow list. */
+		if( ( xTimeNow & ( ( ( TickType_t ) 1U << taskTIMING_WHEEL_RANGE_BITS ) - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U )
+		{
+			prvTimingWheelMoveTasks( &xTimingWheelOverflowList, xTimeNow );
+		}
+
+		/* Working down from the top level, the tasks in each slot whose
+		period starts now are moved to a lower level - or to the level 0 slot
+		for this tick if they unblock now. */
+		for( uxLevel = taskTIMING_WHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+		{
+			uxShift = uxLevel * taskTIMING_WHEEL_SLOT_BITS;
+
+			if( ( xTimeNow & ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U ) ) == ( TickType_t ) 0U )
+			{
+				uxSlot = ( UBaseType_t ) ( xTimeNow >> uxShift ) & taskTIMING_WHEEL_SLOT_MASK;
+				prvTimingWheelMoveTasks( &( xTimingWheel[ uxLevel ][ uxSlot ] ), xTimeNow );
+
+				if( listLIST_IS_EMPTY( &( xTimingWheel[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+				{
+					ulTimingWheelSlotsInUse[ uxLevel ] &= ~( 1UL << uxSlot );
+				}
+			}
+		}
+
+		/* Every task in the level 0 slot for this tick unblocks now, and the
+		caller empties the slot. */
+		uxSlot = ( UBaseType_t ) xTimeNow & taskTIMING_WHEEL_SLOT_MASK;
+		ulTimingWheelSlotsInUse[ 0 ] &= ~( 1UL << uxSlot );
+
+		return &( xTimingWheel[ 0 ][ uxSlot ] );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTimingWheelMoveTasks( List_t * const pxList, const TickType_t xTimeNow )
+	{
+	UBaseType_t uxTasksToMove = listCURRENT_LIST_LENGTH( pxList );
+	TCB_t *pxTCB;
+
+		/* The number of tasks to move is read first as a task can be placed
+		back into the list it was taken from. */
+		while( uxTasksToMove > ( UBaseType_t ) 0U )
+		{
+			pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList );
+			( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+			prvTimingWheelInsert( pxTCB, xTimeNow );
+			uxTasksToMove--;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static TickType_t prvTimingWheelSlotDueTime( const TickType_t xTimeNow, const UBaseType_t uxLevel, const UBaseType_t uxSlot )
+	{
+	const UBaseType_t uxShift = uxLevel * taskTIMING_WHEEL_SLOT_BITS;
+	TickType_t xSlotsAhead;
+
+		/* A slot is processed when the tick count reaches the start of the
+		period it covers.  The slot that covers the current period was
+		processed when the period started, so any tasks it holds are not due
+		until the slot next comes round. */
+		xSlotsAhead = ( TickType_t ) ( ( uxSlot - ( UBaseType_t ) ( xTimeNow >> uxShift ) ) & taskTIMING_WHEEL_SLOT_MASK );
+
+		if( xSlotsAhead == ( TickType_t ) 0U )
+		{
+			xSlotsAhead = ( TickType_t ) taskTIMING_WHEEL_SLOTS;
+		}
+
+		return ( TickType_t ) ( ( ( xTimeNow >> uxShift ) + xSlotsAhead ) << uxShift );
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvTimingWheelNextDueTime( const TickType_t xTimeNow, const UBaseType_t uxLevel, TickType_t * const pxDueTime )
+	{
+	const UBaseType_t uxCurrentSlot = ( UBaseType_t ) ( xTimeNow >> ( uxLevel * taskTIMING_WHEEL_SLOT_BITS ) ) & taskTIMING_WHEEL_SLOT_MASK;
+	uint32_t ulSlotsAfterCurrent;
+	UBaseType_t uxSlot;
+	BaseType_t xReturn = pdFALSE;
+
+		while( ulTimingWheelSlotsInUse[ uxLevel ] != 0UL )
+		{
+			/* The next slot to be processed is the first in use after the
+			current slot, wrapping round to the current slot itself. */
+			ulSlotsAfterCurrent = ulTimingWheelSlotsInUse[ uxLevel ] & ~( ( uint32_t ) ( 2UL << uxCurrentSlot ) - 1UL );
+
+			if( ulSlotsAfterCurrent != 0UL )
+			{
+				taskLOWEST_SET_BIT( uxSlot, ulSlotsAfterCurrent );
+			}
+			else
+			{
+				taskLOWEST_SET_BIT( uxSlot, ulTimingWheelSlotsInUse[ uxLevel ] );
+			}
+
+			if( listLIST_IS_EMPTY( &( xTimingWheel[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+			{
+				/* The tasks that were in the slot have left the Blocked state
+				for another reason. */
+				ulTimingWheelSlotsInUse[ uxLevel ] &= ~( 1UL << uxSlot );
+			}
+			else
+			{
+				*pxDueTime = prvTimingWheelSlotDueTime( xTimeNow, uxLevel, uxSlot );
+				xReturn = pdTRUE;
+				break;
+			}
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvTimingWheelIsDelayedList( const List_t * const pxList )
+	{
+	BaseType_t xReturn;
+
+		if( ( pxList == &xTimingWheelOverflowList ) ||
+			( ( pxList >= &( xTimingWheel[ 0 ][ 0 ] ) ) && ( pxList <= &( xTimingWheel[ taskTIMING_WHEEL_LEVELS - 1U ][ taskTIMING_WHEEL_SLOTS - 1U ] ) ) ) )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMING_WHEEL */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -3662,10 +5214,20 @@ TCB_t *pxTCB;
 	{
 	TaskHandle_t xReturn;
 
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
+		#if( configNUM_CORES > 1 )
+		{
+			/* The calling task can migrate to another core between reading
+			the core number and reading the current TCB of that core. */
+			xReturn = prvGetCurrentTCB();
+		}
+		#else
+		{
+			/* A critical section is not required as this is not called from
+			an interrupt and the current TCB will always be the same for any
+			individual execution thread. */
+			xReturn = pxCurrentTCB;
+		}
+		#endif /* configNUM_CORES */
 
 		return xReturn;
 	}
@@ -4038,7 +5600,7 @@ TCB_t *pxTCB;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	volatile UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
 		#if( configUSE_TRACE_FACILITY != 1 )
 		{
@@ -4111,7 +5673,7 @@ TCB_t *pxTCB;
 					{
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 						}
 						#else
 						{
@@ -4127,7 +5689,7 @@ TCB_t *pxTCB;
 						consumed less than 1% of the total run time. */
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 						}
 						#else
 						{
@@ -4192,22 +5754,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
 					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-					traceTASK_NOTIFY_TAKE_BLOCK();
+					traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait );
 
 					/* All ports are written to allow a yield in a critical
 					section (some will yield immediately, others wait until the
@@ -4229,18 +5793,18 @@ TickType_t uxReturn;
 
 		taskENTER_CRITICAL();
 		{
-			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			traceTASK_NOTIFY_TAKE( uxIndexToWait );
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - 1;
 				}
 			}
 			else
@@ -4248,7 +5812,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4260,27 +5824,29 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
 					prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-					traceTASK_NOTIFY_WAIT_BLOCK();
+					traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait );
 
 					/* All ports are written to allow a yield in a critical
 					section (some will yield immediately, others wait until the
@@ -4302,20 +5868,20 @@ TickType_t uxReturn;
 
 		taskENTER_CRITICAL();
 		{
-			traceTASK_NOTIFY_WAIT();
+			traceTASK_NOTIFY_WAIT( uxIndexToWait );
 
 			if( pulNotificationValue != NULL )
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] == taskWAITING_NOTIFICATION )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4324,11 +5890,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4340,44 +5906,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = ( TCB_t * ) xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4392,7 +5959,7 @@ TickType_t uxReturn;
 					break;
 			}
 
-			traceTASK_NOTIFY();
+			traceTASK_NOTIFY( uxIndexToNotify );
 
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
@@ -4420,7 +5987,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskTASK_PREEMPTS_CURRENT( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4446,7 +6013,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4454,6 +6021,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4479,30 +6047,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4517,7 +6085,7 @@ TickType_t uxReturn;
 					break;
 			}
 
-			traceTASK_NOTIFY_FROM_ISR();
+			traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
 
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
@@ -4538,7 +6106,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskTASK_PREEMPTS_CURRENT( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4570,13 +6138,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4600,14 +6169,14 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
-			traceTASK_NOTIFY_GIVE_FROM_ISR();
+			traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
 
 			/* If the task is in the blocked state specifically to wait for a
 			notification then unblock it now. */
@@ -4628,7 +6197,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskTASK_PREEMPTS_CURRENT( pxTCB ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4659,20 +6228,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
@@ -4703,6 +6274,14 @@ const TickType_t xConstTickCount = xTickCount;
 	}
 	#endif
 
+	#if( configGENERATE_RUN_TIME_STATS == 1 )
+	{
+		/* The time spent blocked is added to the task's blocked time when it
+		is next added to a ready list. */
+		prvGET_RUN_TIME_COUNTER_VALUE( pxCurrentTCB->ulBlockedSince );
+	}
+	#endif
+
 	/* Remove the task from the ready list before adding it to the blocked list
 	as the same list item is used for both lists. */
 	if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
@@ -4732,9 +6311,88 @@ const TickType_t xConstTickCount = xTickCount;
 			kernel will manage it correctly. */
 			xTimeToWake = xConstTickCount + xTicksToWait;
 
+			#if( configUSE_64_BIT_TICKS == 1 )
+			{
+				/* The tick count never overflows, so neither may the wake
+				time.  A wake time past the end of time never arrives. */
+				if( xTimeToWake < xConstTickCount )
+				{
+					xTimeToWake = portMAX_DELAY;
+				}
+			}
+			#endif
+
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+			#if( configUSE_TIMING_WHEEL == 1 )
+			{
+				/* The wheel is indexed by the time remaining, so a wake time
+				that has overflowed needs no special handling. */
+				prvTimingWheelInsert( pxCurrentTCB, xConstTickCount );
+			}
+			#else
+			{
+				#if( configUSE_64_BIT_TICKS == 0 )
+				if( xTimeToWake < xConstTickCount )
+				{
+					/* Wake time has overflowed.  Place this item in the
+					overflow list. */
+					vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				}
+				else
+				#endif /* configUSE_64_BIT_TICKS */
+				{
+					/* The wake time has not overflowed, so the current block
+					list is used. */
+					vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+					/* If the task entering the blocked state was placed at the
+					head of the list of blocked tasks then xNextTaskUnblockTime
+					needs to be updated too. */
+					if( xTimeToWake < xNextTaskUnblockTime )
+					{
+						xNextTaskUnblockTime = xTimeToWake;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#endif /* configUSE_TIMING_WHEEL */
+		}
+	}
+	#else /* INCLUDE_vTaskSuspend */
+	{
+		/* Calculate the time at which the task should be woken if the event
+		does not occur.  This may overflow but this doesn't matter, the kernel
+		will manage it correctly. */
+		xTimeToWake = xConstTickCount + xTicksToWait;
+
+		#if( configUSE_64_BIT_TICKS == 1 )
+		{
+			/* The tick count never overflows, so neither may the wake time.
+			A wake time past the end of time never arrives. */
+			if( xTimeToWake < xConstTickCount )
+			{
+				xTimeToWake = portMAX_DELAY;
+			}
+		}
+		#endif
+
+		/* The list item will be inserted in wake time order. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+
+		#if( configUSE_TIMING_WHEEL == 1 )
+		{
+			/* The wheel is indexed by the time remaining, so a wake time that
+			has overflowed needs no special handling. */
+			prvTimingWheelInsert( pxCurrentTCB, xConstTickCount );
+		}
+		#else
+		{
+			#if( configUSE_64_BIT_TICKS == 0 )
 			if( xTimeToWake < xConstTickCount )
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
@@ -4742,6 +6400,7 @@ const TickType_t xConstTickCount = xTickCount;
 				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
+			#endif /* configUSE_64_BIT_TICKS */
 			{
 				/* The wake time has not overflowed, so the current block list
 				is used. */
@@ -4760,45 +6419,425 @@ const TickType_t xConstTickCount = xTickCount;
 				}
 			}
 		}
+		#endif /* configUSE_TIMING_WHEEL */
+
+		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
+		( void ) xCanBlockIndefinitely;
 	}
-	#else /* INCLUDE_vTaskSuspend */
+	#endif /* INCLUDE_vTaskSuspend */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	static BaseType_t prvHasEarlierDeadline( const TCB_t * const pxTCB1, const TCB_t * const pxTCB2 )
 	{
-		/* Calculate the time at which the task should be woken if the event
-		does not occur.  This may overflow but this doesn't matter, the kernel
-		will manage it correctly. */
-		xTimeToWake = xConstTickCount + xTicksToWait;
+	BaseType_t xReturn;
 
-		/* The list item will be inserted in wake time order. */
-		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+		if( pxTCB1->xRelativeDeadline == ( TickType_t ) 0U )
+		{
+			xReturn = pdFALSE;
+		}
+		else if( pxTCB2->xRelativeDeadline == ( TickType_t ) 0U )
+		{
+			xReturn = pdTRUE;
+		}
+		else if( taskTIME_IS_BEFORE( pxTCB1->xDeadline, pxTCB2->xDeadline ) )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvInsertTaskByDeadline( TCB_t * const pxTCB )
+	{
+	List_t * const pxReadyList = &( pxReadyTasksLists[ pxTCB->uxPriority ] );
+	ListItem_t *pxIterator;
+
+		/* Walk past the tasks that have an earlier or equal deadline, so tasks
+		with equal deadlines, and tasks with no deadline, are kept in the order
+		in which they became ready. */
+		for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != listGET_END_MARKER( pxReadyList ); pxIterator = listGET_NEXT( pxIterator ) )
+		{
+			if( prvHasEarlierDeadline( pxTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator ) ) != pdFALSE )
+			{
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		vListInsertBefore( pxReadyList, pxIterator, &( pxTCB->xStateListItem ) );
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIOD_MONITOR == 1 )
+
+	static void prvRecordPeriodTime( uint32_t * const pulHistogram, configRUN_TIME_COUNTER_TYPE * const pulWorstTime, const configRUN_TIME_COUNTER_TYPE ulTime )
+	{
+	configRUN_TIME_COUNTER_TYPE ulScaledTime = ulTime >> configPERIOD_MONITOR_RESOLUTION_BITS;
+	UBaseType_t uxBucket = 0;
+
+		/* The bucket is the number of significant bits left in the time once
+		the resolution bits are discarded, capped at the last bucket. */
+		while( ( ulScaledTime != 0UL ) && ( uxBucket < ( UBaseType_t ) ( configPERIOD_MONITOR_BUCKETS - 1 ) ) )
+		{
+			ulScaledTime >>= 1;
+			uxBucket++;
+		}
+
+		( pulHistogram[ uxBucket ] )++;
 
-		if( xTimeToWake < xConstTickCount )
+		if( ulTime > *pulWorstTime )
 		{
-			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			*pulWorstTime = ulTime;
 		}
 		else
 		{
-			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_PERIOD_MONITOR */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIOD_MONITOR == 1 )
+
+	static void prvRecordPeriodCompletion( const TickType_t xDeadline )
+	{
+	TCB_t * const pxTCB = prvGetTCBFromHandle( NULL );
+	configRUN_TIME_COUNTER_TYPE ulTimeNow;
+	BaseType_t xMissed = pdFALSE;
+
+		/* Only a task that has run since it was released has a release to
+		complete.  The first call made by a periodic task starts it. */
+		if( pxTCB->ucPeriodState == taskPERIOD_RUNNING )
+		{
+			taskENTER_CRITICAL();
+			{
+				prvGET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+				prvRecordPeriodTime( pxTCB->xPeriodStats.ulResponseTimeHistogram, &( pxTCB->xPeriodStats.ulWorstResponseTime ), ulTimeNow - pxTCB->ulReleaseTime );
+				( pxTCB->xPeriodStats.ulCompletions )++;
+
+				/* The release is late if its deadline has passed.  The tick
+				count only resolves the completion to a tick, so completing
+				within the tick of the deadline is on time. */
+				if( taskTIME_IS_BEFORE( xDeadline, xTickCount ) != pdFALSE )
+				{
+					( pxTCB->xPeriodStats.ulDeadlineMisses )++;
+					xMissed = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxTCB->ucPeriodState = taskPERIOD_IDLE;
+			}
+			taskEXIT_CRITICAL();
+
+			#if( configUSE_DEADLINE_MISS_HOOK == 1 )
+			{
+				if( xMissed != pdFALSE )
+				{
+					extern void vApplicationDeadlineMissHook( TaskHandle_t xTask, TickType_t xDeadline );
 
-			/* If the task entering the blocked state was placed at the head of the
-			list of blocked tasks then xNextTaskUnblockTime needs to be updated
-			too. */
-			if( xTimeToWake < xNextTaskUnblockTime )
+					/* Called from the task itself, before it blocks or
+					continues with its next release. */
+					vApplicationDeadlineMissHook( ( TaskHandle_t ) pxTCB, xDeadline );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#else
 			{
-				xNextTaskUnblockTime = xTimeToWake;
+				( void ) xMissed;
+			}
+			#endif /* configUSE_DEADLINE_MISS_HOOK */
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_PERIOD_MONITOR */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_PERIOD_MONITOR == 1 )
+
+	static void prvRecordPeriodEnd( TCB_t * const pxTCB, const BaseType_t xWillBlock )
+	{
+		if( xWillBlock != pdFALSE )
+		{
+			/* The next release is recorded when the task is moved to a
+			ready list. */
+			pxTCB->ucPeriodState = taskPERIOD_WAITING;
+		}
+		else
+		{
+			/* The next release has already occurred, and the task is already
+			running, so it has no start latency. */
+			prvGET_RUN_TIME_COUNTER_VALUE( pxTCB->ulReleaseTime );
+			pxTCB->ucPeriodState = taskPERIOD_RUNNING;
+			( pxTCB->xPeriodStats.ulReleases )++;
+			( pxTCB->xPeriodStats.ulOverruns )++;
+		}
+	}
+
+#endif /* configUSE_PERIOD_MONITOR */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+	{
+	UBaseType_t uxCurrentPriority, uxTasks;
+	List_t *pxReadyList;
+	ListItem_t *pxIterator;
+	TCB_t *pxTCB = NULL;
+	const UBaseType_t uxCoreBit = ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID;
+
+		/* The task that was running on this core can now be selected by any
+		core, including this one. */
+		if( pxCurrentTCBs[ xCoreID ] != NULL )
+		{
+			pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Find the highest priority queue that contains ready tasks. */
+		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		{
+			while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) )
+			{
+				configASSERT( uxTopReadyPriority );
+				--uxTopReadyPriority;
+			}
+			uxCurrentPriority = uxTopReadyPriority;
+		}
+		#else
+		{
+			portGET_HIGHEST_PRIORITY( uxCurrentPriority, uxTopReadyPriority );
+		}
+		#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+		/* The highest priority ready task might already be running on another
+		core, or not be allowed to run on this one, so search down through the
+		priorities.  Each list is searched starting after its pxIndex, so tasks
+		of equal priority still share the cores round robin.  There is an idle
+		task for every core, so the search always finds a task. */
+		for( ;; )
+		{
+			pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
+			pxIterator = pxReadyList->pxIndex;
+
+			for( uxTasks = listCURRENT_LIST_LENGTH( pxReadyList ); uxTasks > ( UBaseType_t ) 0; uxTasks-- )
+			{
+				pxIterator = pxIterator->pxNext;
+
+				if( ( void * ) pxIterator == ( void * ) &( pxReadyList->xListEnd ) )
+				{
+					pxIterator = pxIterator->pxNext;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+				if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) && ( ( pxTCB->uxCoreAffinityMask & uxCoreBit ) != ( UBaseType_t ) 0 ) )
+				{
+					pxReadyList->pxIndex = pxIterator;
+					break;
+				}
+				else
+				{
+					pxTCB = NULL;
+				}
+			}
+
+			if( pxTCB != NULL )
+			{
+				break;
+			}
+			else
+			{
+				configASSERT( uxCurrentPriority > tskIDLE_PRIORITY );
+				--uxCurrentPriority;
+			}
+		}
+
+		pxTCB->xTaskRunState = xCoreID;
+		pxCurrentTCBs[ xCoreID ] = pxTCB;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	static BaseType_t prvYieldForTask( TCB_t *pxTCB, BaseType_t xYieldEqualPriority )
+	{
+	BaseType_t xCoreID, xLowestCoreID = taskTASK_NOT_RUNNING;
+	const BaseType_t xThisCoreID = ( BaseType_t ) portGET_CORE_ID();
+	UBaseType_t uxLowestPriority = pxTCB->uxPriority;
+	BaseType_t xReturn = pdFALSE;
+
+		if( ( xSchedulerRunning != pdFALSE ) && ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) )
+		{
+			/* The calling core is checked first so it is preferred when more
+			than one core is running a task of the lowest priority. */
+			if( ( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xThisCoreID ) ) != ( UBaseType_t ) 0 ) && ( pxCurrentTCBs[ xThisCoreID ]->uxPriority < uxLowestPriority ) )
+			{
+				xLowestCoreID = xThisCoreID;
+				uxLowestPriority = pxCurrentTCBs[ xThisCoreID ]->uxPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			#if( configUSE_PREEMPTION == 1 )
+			{
+				/* A core that is already going to switch context will select
+				the highest priority ready task anyway, so is skipped to leave
+				it for another readied task. */
+				for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+				{
+					if( ( xCoreID != xThisCoreID ) &&
+						( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != ( UBaseType_t ) 0 ) &&
+						( xYieldPendings[ xCoreID ] == pdFALSE ) &&
+						( pxCurrentTCBs[ xCoreID ]->uxPriority < uxLowestPriority ) )
+					{
+						xLowestCoreID = xCoreID;
+						uxLowestPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			#endif /* configUSE_PREEMPTION */
+
+			if( ( xLowestCoreID == taskTASK_NOT_RUNNING ) &&
+				( xYieldEqualPriority != pdFALSE ) &&
+				( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xThisCoreID ) ) != ( UBaseType_t ) 0 ) &&
+				( pxCurrentTCBs[ xThisCoreID ]->uxPriority == pxTCB->uxPriority ) )
+			{
+				xLowestCoreID = xThisCoreID;
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
+
+			if( xLowestCoreID != taskTASK_NOT_RUNNING )
+			{
+				xReturn = prvYieldCore( xLowestCoreID );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
 		}
 
-		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
-		( void ) xCanBlockIndefinitely;
+		return xReturn;
 	}
-	#endif /* INCLUDE_vTaskSuspend */
-}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	static BaseType_t prvYieldCore( BaseType_t xCoreID )
+	{
+	BaseType_t xReturn;
+
+		if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+		{
+			/* The caller performs the yield on the calling core. */
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			xYieldPendings[ xCoreID ] = pdTRUE;
+			portYIELD_CORE( xCoreID );
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
+#if( ( configNUM_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+
+	static UBaseType_t prvCoresRunningPriority( UBaseType_t uxPriority )
+	{
+	BaseType_t xCoreID;
+	UBaseType_t uxCores = 0;
+
+		for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+		{
+			if( pxCurrentTCBs[ xCoreID ]->uxPriority == uxPriority )
+			{
+				uxCores++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return uxCores;
+	}
+
+#endif /* ( ( configNUM_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if( configNUM_CORES > 1 )
+
+	static TCB_t *prvGetCurrentTCB( void )
+	{
+	TCB_t *pxTCB;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = pxCurrentTCB;
+		}
+		taskEXIT_CRITICAL();
+
+		return pxTCB;
+	}
+
+#endif /* configNUM_CORES */
 
 
 #ifdef FREERTOS_MODULE_TEST
@@ -0,0 +1,259 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+
+/*
+ * A benchmark of the tick interrupt - xTaskIncrementTick() - with a 32-bit and
+ * a 64-bit TickType_t, around the tick at which a 32-bit tick count wraps to 0.
+ * The tick count is stepped to just before 2^32, tbDELAYED_TASKS tasks are
+ * delayed until after it, then tbTICKS ticks are generated from within a
+ * critical section and each is timed.  The times are printed as the median and
+ * 99th percentile tick, and the tick on which the tick count reaches 2^32:
+ *
+ * + With configUSE_64_BIT_TICKS set to 0 the delayed tasks are held in the
+ *   overflow delayed list until the tick count wraps, when that tick switches
+ *   the delayed lists and finds the next task to unblock again.
+ *
+ * + With configUSE_64_BIT_TICKS set to 1 the tick count carries on past 2^32,
+ *   so that tick is no different to any other.
+ *
+ * The cost of reading the host's clock is measured first and subtracted.  The
+ * benchmark is built in place of main.c, once for each tick type:
+ *
+ *   gcc -O2 -I. -DconfigUSE_64_BIT_TICKS=0 tick_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o tick_benchmark -lpthread
+ *   ./tick_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_TICKLESS_IDLE == 0 ) || ( configUSE_VIRTUAL_TIME == 1 ) || ( configNUM_CORES > 1 )
+	#error The benchmark steps the tick count with vTaskStepTick(), so must be built for a single core with configUSE_TICKLESS_IDLE set to 1 and configUSE_VIRTUAL_TIME set to 0.
+#endif
+
+#define tbTICKS					( 100000 )
+#define tbDELAYED_TASKS			( 16 )
+
+/* The delayed tasks wake 2^24 ticks apart, all after the tick count passes
+2^32. */
+#define tbDELAY_INTERVAL		( ( TickType_t ) 0x01000000UL )
+
+/* The last tick before a 32-bit tick count wraps, which is the middle of the
+ticks that are timed.  The tick count is first stepped to tbSETUP_TICKS before
+the first of them, so the delayed tasks have time to block. */
+#define tbLAST_32_BIT_TICK		( ( TickType_t ) 0xffffffffUL )
+#define tbFIRST_TICK			( tbLAST_32_BIT_TICK - ( TickType_t ) ( tbTICKS / 2 ) )
+#define tbSETUP_TICKS			( ( TickType_t ) 10 )
+
+#define tbDELAYED_PRIORITY		( tskIDLE_PRIORITY + 1 )
+#define tbBENCHMARK_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Steps the tick count, delays the delayed tasks, times the ticks, prints the
+ * results and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * Each delayed task delays for the number of tbDELAY_INTERVAL periods passed
+ * as its parameter.
+ */
+static void prvDelayedTask( void *pvParameters );
+
+/*
+ * The value below which ulPercent percent of the sorted times lie.
+ */
+static double prvPercentile( double *pdTimes, uint32_t ulPercent );
+static int prvCompareTimes( const void *pvA, const void *pvB );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+/* The time taken by each tick, and by each empty read of the clock. */
+static double dTickTimes[ tbTICKS ];
+static double dClockTimes[ tbTICKS ];
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, tbBENCHMARK_PRIORITY, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+double dStart, dOverhead, dWrapTick;
+UBaseType_t uxTask;
+int iTick;
+
+	( void ) pvParameters;
+
+	/* Nothing is delayed yet, so the tick count can be stepped to just before
+	the ticks that are timed. */
+	taskENTER_CRITICAL();
+	{
+		configASSERT( xTaskGetTickCount() < ( tbFIRST_TICK - tbSETUP_TICKS ) );
+		vTaskStepTick( ( tbFIRST_TICK - tbSETUP_TICKS ) - xTaskGetTickCount() );
+	}
+	taskEXIT_CRITICAL();
+
+	/* The delayed tasks run, and delay, when this task blocks. */
+	for( uxTask = 0; uxTask < tbDELAYED_TASKS; uxTask++ )
+	{
+		xTaskCreate( prvDelayedTask, "DELAYED", configMINIMAL_STACK_SIZE, ( void * ) ( uxTask + 1 ), tbDELAYED_PRIORITY, NULL );
+	}
+
+	vTaskDelay( 1 );
+
+	for( iTick = 0; iTick < tbTICKS; iTick++ )
+	{
+		dStart = prvNanoseconds();
+		dClockTimes[ iTick ] = prvNanoseconds() - dStart;
+	}
+
+	/* The simulated tick interrupt cannot run while the ticks are generated
+	from within the critical section. */
+	taskENTER_CRITICAL();
+	{
+		configASSERT( xTaskGetTickCount() < tbFIRST_TICK );
+		vTaskStepTick( tbFIRST_TICK - xTaskGetTickCount() );
+
+		for( iTick = 0; iTick < tbTICKS; iTick++ )
+		{
+			dStart = prvNanoseconds();
+			( void ) xTaskIncrementTick();
+			dTickTimes[ iTick ] = prvNanoseconds() - dStart;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	/* The tick count reached 2^32 on tick tbTICKS / 2. */
+	dOverhead = prvPercentile( dClockTimes, 50UL );
+	dWrapTick = dTickTimes[ tbTICKS / 2 ] - dOverhead;
+
+	printf( "%u-bit TickType_t, %d delayed tasks, %d ticks around the tick count reaching 2^32 (%.0f ns clock overhead subtracted)\n", ( unsigned ) ( sizeof( TickType_t ) * 8U ), tbDELAYED_TASKS, tbTICKS, dOverhead );
+	printf( "Median tick %.0f ns, 99th percentile tick %.0f ns, tick reaching 2^32 %.0f ns\n", prvPercentile( dTickTimes, 50UL ) - dOverhead, prvPercentile( dTickTimes, 99UL ) - dOverhead, dWrapTick );
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelayedTask( void *pvParameters )
+{
+const TickType_t xDelay = tbDELAY_INTERVAL * ( TickType_t ) ( size_t ) pvParameters;
+
+	for( ;; )
+	{
+		vTaskDelay( xDelay );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static double prvPercentile( double *pdTimes, uint32_t ulPercent )
+{
+	qsort( pdTimes, tbTICKS, sizeof( double ), prvCompareTimes );
+	return pdTimes[ ( ( tbTICKS - 1 ) * ulPercent ) / 100UL ];
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareTimes( const void *pvA, const void *pvB )
+{
+double dA = *( ( const double * ) pvA ), dB = *( ( const double * ) pvB );
+
+	return ( dA > dB ) - ( dA < dB );
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,399 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A benchmark of timer churn - starting, stopping and resetting timers while
+ * many other timers are active.  tmrCOUNTS[] sets how many timers are active
+ * in each run.  Each timer has a different period, spread over more than the
+ * range of the timing wheel in timers.c, so the active timers are held at
+ * every level of the wheel and in its overflow list.  None of the timers
+ * expires while the benchmark runs.
+ *
+ * For each count the benchmark task stops, starts and resets randomly chosen
+ * timers, and the time per command is printed.  The time includes sending the
+ * command to the timer service task and switching to it and back, but it does
+ * not grow with the number of active timers, as the wheel removes and inserts
+ * a timer in constant time.
+ *
+ * For comparison the same commands are also sent to a sorted list service
+ * task, which keeps its active items in a single list sorted by expiry time,
+ * as the timer service task traditionally kept its active timers.  It has the
+ * priority of the timer service task and is sent commands through a queue in
+ * the same way, so the two times include the same queue send and context
+ * switches and differ only in how the active items are held.  Inserting an
+ * item into the sorted list walks the list, so its time grows with the number
+ * of active items.
+ *
+ * The benchmark is built in place of main.c with a heap large enough for the
+ * timers, for example:
+ *
+ *   gcc -O2 -I. -DconfigUSE_FIBERS=1 -DconfigTOTAL_HEAP_SIZE=2000000 timer_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o timer_benchmark -lpthread
+ *   ./timer_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "queue.h"
+
+#define tmrbMAX_TIMERS			( 10000UL )
+#define tmrbITERATIONS			( 100000UL )
+#define tmrbRUNS				( 5 )
+
+/* The periods are between tmrbMIN_PERIOD and tmrbMIN_PERIOD + 2^22 ticks. */
+#define tmrbMIN_PERIOD			( ( TickType_t ) 100000U )
+#define tmrbPERIOD_BITS			( 22U )
+
+/* The commands sent to the sorted list service task. */
+#define tmrbCOMMAND_STOP		( 0 )
+#define tmrbCOMMAND_START		( 1 )
+#define tmrbCOMMAND_RESET		( 2 )
+
+/* A command sent to the sorted list service task, laid out as the commands sent
+to the timer service task are. */
+typedef struct SORTED_LIST_COMMAND
+{
+	BaseType_t xCommand;
+	TickType_t xPeriod;
+	ListItem_t *pxItem;
+} SortedListCommand_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Creates and starts the timers for each count in turn, then times the churn
+ * on them and on the sorted list, prints the results and exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * The nanoseconds per command of the fastest of tmrbRUNS runs of churn on the
+ * first ulCount timers.
+ */
+static double prvTimeTimers( uint32_t ulCount );
+
+/*
+ * The nanoseconds per command of the fastest of tmrbRUNS runs of the same
+ * churn on the first ulCount items of the sorted list service task.
+ */
+static double prvTimeSortedList( uint32_t ulCount );
+
+/*
+ * The sorted list service task.  Stops, starts and resets the items of
+ * xSortedList as commanded through xSortedListQueue.
+ */
+static void prvSortedListTask( void *pvParameters );
+
+/*
+ * The period of timer ulTimer, and a pseudo random sequence used to choose the
+ * timers to churn.
+ */
+static TickType_t prvPeriod( uint32_t ulTimer );
+static uint32_t prvRandom( void );
+
+/*
+ * The timers never expire while the benchmark runs.
+ */
+static void prvTimerCallback( TimerHandle_t xTimer );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static const uint32_t tmrCOUNTS[] = { 10UL, 100UL, 1000UL, 10000UL };
+
+static TimerHandle_t xTimers[ tmrbMAX_TIMERS ];
+
+static List_t xSortedList;
+static ListItem_t xSortedListItems[ tmrbMAX_TIMERS ];
+static QueueHandle_t xSortedListQueue = NULL;
+
+static uint32_t ulRandomState = 1UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+uint32_t ulItem;
+
+	vListInitialise( &xSortedList );
+
+	for( ulItem = 0; ulItem < tmrbMAX_TIMERS; ulItem++ )
+	{
+		vListInitialiseItem( &( xSortedListItems[ ulItem ] ) );
+	}
+
+	xSortedListQueue = xQueueCreate( configTIMER_QUEUE_LENGTH, sizeof( SortedListCommand_t ) );
+	configASSERT( xSortedListQueue );
+
+	xTaskCreate( prvSortedListTask, "SORTED", configMINIMAL_STACK_SIZE, NULL, configTIMER_TASK_PRIORITY, NULL );
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+uint32_t ulTimer, ulCreated = 0UL;
+size_t x;
+
+	( void ) pvParameters;
+
+	printf( "Active timers  Timing wheel (ns per command)  Sorted list (ns per command)\n" );
+
+	for( x = 0; x < sizeof( tmrCOUNTS ) / sizeof( tmrCOUNTS[ 0 ] ); x++ )
+	{
+		/* Create and start the timers that are to be active for this count in
+		addition to those that are already active. */
+		for( ulTimer = ulCreated; ulTimer < tmrCOUNTS[ x ]; ulTimer++ )
+		{
+			xTimers[ ulTimer ] = xTimerCreate( "BENCH", prvPeriod( ulTimer ), pdTRUE, NULL, prvTimerCallback );
+
+			if( xTimers[ ulTimer ] == NULL )
+			{
+				printf( "Could not create %lu timers, build with a larger configTOTAL_HEAP_SIZE\n", ( unsigned long ) tmrCOUNTS[ x ] );
+				exit( 1 );
+			}
+
+			xTimerStart( xTimers[ ulTimer ], portMAX_DELAY );
+		}
+
+		ulCreated = tmrCOUNTS[ x ];
+
+		printf( "%-14lu %-30.1f %.1f\n", ( unsigned long ) tmrCOUNTS[ x ], prvTimeTimers( tmrCOUNTS[ x ] ), prvTimeSortedList( tmrCOUNTS[ x ] ) );
+	}
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeTimers( uint32_t ulCount )
+{
+uint32_t ulIteration;
+TimerHandle_t xTimer;
+int iRun;
+double dStart, dTime, dFastest = 0.0;
+
+	/* The fastest run is the one least disturbed by the host. */
+	for( iRun = 0; iRun < tmrbRUNS; iRun++ )
+	{
+		ulRandomState = 1UL;
+		dStart = prvNanoseconds();
+
+		for( ulIteration = 0; ulIteration < tmrbITERATIONS; ulIteration++ )
+		{
+			/* The timer service task has a higher priority than this task, so
+			each command is processed before the function returns. */
+			xTimer = xTimers[ prvRandom() % ulCount ];
+			xTimerStop( xTimer, portMAX_DELAY );
+			xTimerStart( xTimer, portMAX_DELAY );
+			xTimerReset( xTimers[ prvRandom() % ulCount ], portMAX_DELAY );
+		}
+
+		dTime = prvNanoseconds() - dStart;
+
+		if( ( iRun == 0 ) || ( dTime < dFastest ) )
+		{
+			dFastest = dTime;
+		}
+	}
+
+	return dFastest / ( double ) ( tmrbITERATIONS * 3UL );
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeSortedList( uint32_t ulCount )
+{
+uint32_t ulIteration, ulItem;
+int iRun;
+double dStart, dTime, dFastest = 0.0;
+SortedListCommand_t xCommand;
+
+	/* Start the items that are to be active for this count.  Those that are
+	already active are restarted. */
+	for( ulItem = 0; ulItem < ulCount; ulItem++ )
+	{
+		xCommand.xCommand = tmrbCOMMAND_START;
+		xCommand.xPeriod = prvPeriod( ulItem );
+		xCommand.pxItem = &( xSortedListItems[ ulItem ] );
+		xQueueSend( xSortedListQueue, &xCommand, portMAX_DELAY );
+	}
+
+	for( iRun = 0; iRun < tmrbRUNS; iRun++ )
+	{
+		ulRandomState = 1UL;
+		dStart = prvNanoseconds();
+
+		for( ulIteration = 0; ulIteration < tmrbITERATIONS; ulIteration++ )
+		{
+			/* The sorted list service task has a higher priority than this
+			task, so each command is processed before the send returns, as
+			for the timers. */
+			ulItem = prvRandom() % ulCount;
+			xCommand.pxItem = &( xSortedListItems[ ulItem ] );
+			xCommand.xPeriod = prvPeriod( ulItem );
+			xCommand.xCommand = tmrbCOMMAND_STOP;
+			xQueueSend( xSortedListQueue, &xCommand, portMAX_DELAY );
+			xCommand.xCommand = tmrbCOMMAND_START;
+			xQueueSend( xSortedListQueue, &xCommand, portMAX_DELAY );
+
+			ulItem = prvRandom() % ulCount;
+			xCommand.pxItem = &( xSortedListItems[ ulItem ] );
+			xCommand.xPeriod = prvPeriod( ulItem );
+			xCommand.xCommand = tmrbCOMMAND_RESET;
+			xQueueSend( xSortedListQueue, &xCommand, portMAX_DELAY );
+		}
+
+		dTime = prvNanoseconds() - dStart;
+
+		if( ( iRun == 0 ) || ( dTime < dFastest ) )
+		{
+			dFastest = dTime;
+		}
+	}
+
+	return dFastest / ( double ) ( tmrbITERATIONS * 3UL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSortedListTask( void *pvParameters )
+{
+SortedListCommand_t xCommand;
+ListItem_t *pxItem;
+
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		if( xQueueReceive( xSortedListQueue, &xCommand, portMAX_DELAY ) == pdPASS )
+		{
+			pxItem = xCommand.pxItem;
+
+			/* Every command removes the item if it is active, as stopping,
+			starting or resetting a timer does. */
+			if( listLIST_ITEM_CONTAINER( pxItem ) != NULL )
+			{
+				( void ) uxListRemove( pxItem );
+			}
+
+			/* A start or a reset then inserts it in order of expiry time. */
+			if( xCommand.xCommand != tmrbCOMMAND_STOP )
+			{
+				listSET_LIST_ITEM_VALUE( pxItem, xTaskGetTickCount() + xCommand.xPeriod );
+				vListInsert( &xSortedList, pxItem );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvPeriod( uint32_t ulTimer )
+{
+	/* Multiplying by a large odd constant scatters the periods. */
+	return tmrbMIN_PERIOD + ( TickType_t ) ( ( uint32_t ) ( ulTimer * 2654435761UL ) >> ( 32U - tmrbPERIOD_BITS ) );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+	/* xorshift32. */
+	ulRandomState ^= ulRandomState << 13;
+	ulRandomState ^= ulRandomState >> 17;
+	ulRandomState ^= ulRandomState << 5;
+	return ulRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	( void ) xTimer;
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,500 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "trace_recorder.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The recorder is only built when the kernel trace macros call it, so this file
+can always be compiled. */
+#if( configUSE_TRACE_RECORDER == 1 )
+
+#if( ( configTRACE_RECORDER_BUFFER_EVENTS & ( configTRACE_RECORDER_BUFFER_EVENTS - 1 ) ) != 0 )
+	#error configTRACE_RECORDER_BUFFER_EVENTS must be a power of 2
+#endif
+
+#ifndef configNUM_CORES
+	#define configNUM_CORES 1
+#endif
+
+/* Each ring is a bounded multiple producer, single consumer queue.  A writer
+claims a slot by moving the head index on with a compare and swap, writes the
+event, then publishes the slot by storing its sequence number with release
+semantics.  The flush task reads a slot once its sequence number shows it was
+published, then releases it for the writer one lap later.  A writer that is
+stopped part way through writing an event - for example a task thread that is
+suspended while a simulated interrupt is handled - therefore holds up the flush
+task, but never another writer.
+
+The sequence number of a slot is stored relative to the start of the lap of the
+ring it can next be used in, so the zero initialised rings need no setup:
+  - a sequence of the lap start means the slot is free for a writer,
+  - the lap start plus one means the slot holds an event for the reader. */
+#if defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L ) && !defined( __STDC_NO_ATOMICS__ )
+
+	#include <stdatomic.h>
+
+	typedef _Atomic uint32_t trcIndex_t;
+
+	#define trcLOAD_ACQUIRE( x )				atomic_load_explicit( &( x ), memory_order_acquire )
+	#define trcLOAD_RELAXED( x )				atomic_load_explicit( &( x ), memory_order_relaxed )
+	#define trcSTORE_RELEASE( x, xValue )		atomic_store_explicit( &( x ), ( xValue ), memory_order_release )
+	#define trcEXCHANGE( x, xValue )			atomic_exchange_explicit( &( x ), ( xValue ), memory_order_relaxed )
+	#define trcINCREMENT( x )					( ( void ) atomic_fetch_add_explicit( &( x ), 1U, memory_order_relaxed ) )
+	#define trcCOMPARE_AND_SWAP( x, ulExpected, ulNew )	atomic_compare_exchange_weak_explicit( &( x ), &( ulExpected ), ( ulNew ), memory_order_relaxed, memory_order_relaxed )
+
+#elif defined( _WIN32 )
+
+	/* Compilers without C11 atomics, such as older versions of MSVC.  Windows.h
+	has already been included by portmacro.h.  Aligned volatile accesses are
+	atomic on the targets Windows runs on, and MSVC gives them acquire and
+	release semantics on x86 and x64. */
+	typedef volatile LONG trcIndex_t;
+
+	#define trcLOAD_ACQUIRE( x )				( ( uint32_t ) ( x ) )
+	#define trcLOAD_RELAXED( x )				( ( uint32_t ) ( x ) )
+	#define trcSTORE_RELEASE( x, xValue )		( ( x ) = ( LONG ) ( xValue ) )
+	#define trcEXCHANGE( x, xValue )			( ( uint32_t ) InterlockedExchange( &( x ), ( LONG ) ( xValue ) ) )
+	#define trcINCREMENT( x )					( ( void ) InterlockedIncrement( &( x ) ) )
+	#define trcCOMPARE_AND_SWAP( x, ulExpected, ulNew )	prvCompareAndSwap( &( x ), &( ulExpected ), ( ulNew ) )
+
+	static portINLINE BaseType_t prvCompareAndSwap( trcIndex_t *pxIndex, uint32_t *pulExpected, uint32_t ulNew )
+	{
+	uint32_t ulFound = ( uint32_t ) InterlockedCompareExchange( pxIndex, ( LONG ) ulNew, ( LONG ) *pulExpected );
+	BaseType_t xSwapped = ( ulFound == *pulExpected ) ? pdTRUE : pdFALSE;
+
+		*pulExpected = ulFound;
+		return xSwapped;
+	}
+
+#else
+	#error trace_recorder.c requires C11 atomics
+#endif
+
+#define trcRING_MASK	( ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS - 1U )
+#define trcLAP_START( ulPosition )	( ( ulPosition ) & ~trcRING_MASK )
+
+/* The longest name recorded, in characters. */
+#define trcMAX_NAME_LENGTH	32
+
+/* The number of events the flush task copies out of a ring at a time. */
+#define trcFLUSH_BATCH_EVENTS	256
+
+typedef struct xTRACE_SLOT
+{
+	trcIndex_t ulSequence;
+	TraceEvent_t xEvent;
+} TraceSlot_t;
+
+typedef struct xTRACE_RING
+{
+	trcIndex_t ulHead;						/*< The position of the next slot to be claimed by a writer. */
+	trcIndex_t ulDropped;					/*< The number of events dropped because the ring was full. */
+	uint32_t ulTail;						/*< The position of the next slot to be read.  Only used by the flush task. */
+	const void * volatile pvCurrentTask;	/*< The task last switched in on the core. */
+	TraceSlot_t xSlots[ configTRACE_RECORDER_BUFFER_EVENTS ];
+} TraceRing_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Write an event into the ring of the calling core.
+ */
+static void prvWriteEvent( TraceRing_t *pxRing, uint32_t ulEventID, uint64_t ullObject, uint64_t ullTask, uint32_t ulValue );
+
+/*
+ * The ring of the core the caller is running on.
+ */
+static TraceRing_t *prvGetRing( void );
+
+/*
+ * Copy the events out of each ring and write them to the file.  Called with
+ * xFlushMutex held.
+ */
+static void prvFlushRings( void );
+
+/*
+ * The task that calls prvFlushRings() periodically.
+ */
+static portTASK_FUNCTION_PROTO( prvTraceFlushTask, pvParameters );
+
+/*-----------------------------------------------------------*/
+
+static TraceRing_t xRings[ configNUM_CORES ];
+
+static FILE *pxTraceFile = NULL;
+static SemaphoreHandle_t xFlushMutex = NULL;
+static TickType_t xTraceFlushPeriod = ( TickType_t ) 0;
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	/* xTraceRecorderStart() is only called once, so the flush task and its
+	mutex can be created statically, in case configSUPPORT_DYNAMIC_ALLOCATION
+	is 0. */
+	static StaticSemaphore_t xFlushMutexBuffer;
+	static StaticTask_t xFlushTaskTCB;
+	static StackType_t uxFlushTaskStack[ configMINIMAL_STACK_SIZE ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+static TraceRing_t *prvGetRing( void )
+{
+BaseType_t xCore = 0;
+
+	#if( configNUM_CORES > 1 )
+	{
+		/* Threads that are not part of a core, such as a host thread that
+		raises a simulated interrupt, use the ring of core 0. */
+		xCore = portGET_CORE_ID();
+
+		if( ( xCore < 0 ) || ( xCore >= configNUM_CORES ) )
+		{
+			xCore = 0;
+		}
+	}
+	#endif /* configNUM_CORES */
+
+	return &( xRings[ xCore ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteEvent( TraceRing_t *pxRing, uint32_t ulEventID, uint64_t ullObject, uint64_t ullTask, uint32_t ulValue )
+{
+uint32_t ulPosition, ulSequence;
+int32_t lDifference;
+TraceSlot_t *pxSlot;
+uint16_t usCore = ( uint16_t ) ( pxRing - xRings );
+
+	ulPosition = trcLOAD_RELAXED( pxRing->ulHead );
+
+	for( ;; )
+	{
+		pxSlot = &( pxRing->xSlots[ ulPosition & trcRING_MASK ] );
+		ulSequence = trcLOAD_ACQUIRE( pxSlot->ulSequence );
+		lDifference = ( int32_t ) ( ulSequence - trcLAP_START( ulPosition ) );
+
+		if( lDifference == 0 )
+		{
+			/* The slot is free.  Claim it, unless another writer got there
+			first, in which case ulPosition is updated to the new head. */
+			if( trcCOMPARE_AND_SWAP( pxRing->ulHead, ulPosition, ulPosition + 1U ) )
+			{
+				break;
+			}
+		}
+		else if( lDifference < 0 )
+		{
+			/* The slot still holds an event from the previous lap, so the
+			ring is full. */
+			trcINCREMENT( pxRing->ulDropped );
+			return;
+		}
+		else
+		{
+			/* Another writer claimed and published the slot since the head
+			was read. */
+			ulPosition = trcLOAD_RELAXED( pxRing->ulHead );
+		}
+	}
+
+	pxSlot->xEvent.ullTimestamp = ullPortGetRunTimeCounterValue();
+	pxSlot->xEvent.ullObject = ullObject;
+	pxSlot->xEvent.ullTask = ullTask;
+	pxSlot->xEvent.usEventID = ( uint16_t ) ulEventID;
+	pxSlot->xEvent.usCore = usCore;
+	pxSlot->xEvent.ulValue = ulValue;
+
+	trcSTORE_RELEASE( pxSlot->ulSequence, trcLAP_START( ulPosition ) + 1U );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordEvent( uint32_t ulEventID, const void *pvObject, uint32_t ulValue )
+{
+TraceRing_t *pxRing;
+
+	pxRing = prvGetRing();
+	prvWriteEvent( pxRing, ulEventID, ( uint64_t ) ( size_t ) pvObject, ( uint64_t ) ( size_t ) pxRing->pvCurrentTask, ulValue );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordSwitchedIn( const void *pvTask )
+{
+TraceRing_t *pxRing;
+
+	pxRing = prvGetRing();
+
+	/* The scheduler often selects the task that was already running. */
+	if( pxRing->pvCurrentTask != pvTask )
+	{
+		pxRing->pvCurrentTask = pvTask;
+		prvWriteEvent( pxRing, traceEVENT_TASK_SWITCHED_IN, ( uint64_t ) ( size_t ) pvTask, ( uint64_t ) ( size_t ) pvTask, 0UL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecordName( const void *pvObject, const char *pcName )
+{
+TraceRing_t *pxRing;
+uint32_t ulOffset;
+uint64_t ullCharacters;
+size_t xLength;
+
+	pxRing = prvGetRing();
+	xLength = strlen( pcName );
+
+	if( xLength > trcMAX_NAME_LENGTH )
+	{
+		xLength = trcMAX_NAME_LENGTH;
+	}
+
+	/* Eight characters are carried in the ullTask member of each event.  An
+	empty name is still recorded, as a single event. */
+	ulOffset = 0U;
+
+	do
+	{
+		ullCharacters = 0U;
+		memcpy( &ullCharacters, &( pcName[ ulOffset ] ), ( ( xLength - ulOffset ) < sizeof( ullCharacters ) ) ? ( xLength - ulOffset ) : sizeof( ullCharacters ) );
+		prvWriteEvent( pxRing, traceEVENT_OBJECT_NAME, ( uint64_t ) ( size_t ) pvObject, ullCharacters, ulOffset );
+		ulOffset += ( uint32_t ) sizeof( ullCharacters );
+	} while( ulOffset < xLength );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTraceRecorderStart( const char *pcFileName, TickType_t xFlushPeriod, UBaseType_t uxPriority )
+{
+TraceFileHeader_t xHeader;
+BaseType_t xReturn = pdFAIL;
+
+	configASSERT( xFlushPeriod > ( TickType_t ) 0 );
+	configASSERT( pxTraceFile == NULL );
+
+	xTraceFlushPeriod = xFlushPeriod;
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		xFlushMutex = xSemaphoreCreateMutexStatic( &xFlushMutexBuffer );
+	}
+	#else
+	{
+		xFlushMutex = xSemaphoreCreateMutex();
+	}
+	#endif
+	pxTraceFile = fopen( pcFileName, "wb" );
+
+	if( ( pxTraceFile != NULL ) && ( xFlushMutex != NULL ) )
+	{
+		memcpy( xHeader.cMagic, traceFILE_MAGIC, sizeof( xHeader.cMagic ) );
+		xHeader.ulEventSize = ( uint32_t ) sizeof( TraceEvent_t );
+		xHeader.ulNumCores = ( uint32_t ) configNUM_CORES;
+		xHeader.ulTickRateHz = ( uint32_t ) configTICK_RATE_HZ;
+		xHeader.ulReserved = 0U;
+
+		if( fwrite( &xHeader, sizeof( xHeader ), 1, pxTraceFile ) == 1 )
+		{
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				if( xTaskCreateStatic( prvTraceFlushTask, "TRACE", configMINIMAL_STACK_SIZE, NULL, uxPriority, uxFlushTaskStack, &xFlushTaskTCB ) != NULL )
+				{
+					xReturn = pdPASS;
+				}
+			}
+			#else
+			{
+				xReturn = xTaskCreate( prvTraceFlushTask, "TRACE", configMINIMAL_STACK_SIZE, NULL, uxPriority, NULL );
+			}
+			#endif
+		}
+	}
+
+	if( ( xReturn != pdPASS ) && ( pxTraceFile != NULL ) )
+	{
+		fclose( pxTraceFile );
+		pxTraceFile = NULL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStop( void )
+{
+	if( xFlushMutex != NULL )
+	{
+		xSemaphoreTake( xFlushMutex, portMAX_DELAY );
+		{
+			if( pxTraceFile != NULL )
+			{
+				prvFlushRings();
+				fclose( pxTraceFile );
+				pxTraceFile = NULL;
+			}
+		}
+		xSemaphoreGive( xFlushMutex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFlushRings( void )
+{
+static TraceEvent_t xBatch[ trcFLUSH_BATCH_EVENTS ];
+UBaseType_t uxCore, uxCount;
+TraceRing_t *pxRing;
+TraceSlot_t *pxSlot;
+uint32_t ulDropped;
+
+	for( uxCore = 0; uxCore < ( UBaseType_t ) configNUM_CORES; uxCore++ )
+	{
+		pxRing = &( xRings[ uxCore ] );
+
+		do
+		{
+			uxCount = 0;
+
+			while( uxCount < ( UBaseType_t ) trcFLUSH_BATCH_EVENTS )
+			{
+				pxSlot = &( pxRing->xSlots[ pxRing->ulTail & trcRING_MASK ] );
+
+				if( trcLOAD_ACQUIRE( pxSlot->ulSequence ) != ( trcLAP_START( pxRing->ulTail ) + 1U ) )
+				{
+					/* Not yet published. */
+					break;
+				}
+
+				xBatch[ uxCount ] = pxSlot->xEvent;
+				uxCount++;
+
+				/* Free the slot for the writer in the next lap. */
+				trcSTORE_RELEASE( pxSlot->ulSequence, trcLAP_START( pxRing->ulTail ) + ( uint32_t ) configTRACE_RECORDER_BUFFER_EVENTS );
+				pxRing->ulTail++;
+			}
+
+			if( uxCount > 0 )
+			{
+				( void ) fwrite( xBatch, sizeof( TraceEvent_t ), ( size_t ) uxCount, pxTraceFile );
+			}
+		} while( uxCount == ( UBaseType_t ) trcFLUSH_BATCH_EVENTS );
+
+		ulDropped = trcEXCHANGE( pxRing->ulDropped, 0U );
+
+		if( ulDropped != 0U )
+		{
+			memset( &( xBatch[ 0 ] ), 0x00, sizeof( TraceEvent_t ) );
+			xBatch[ 0 ].ullTimestamp = ullPortGetRunTimeCounterValue();
+			xBatch[ 0 ].usEventID = traceEVENT_DROPPED;
+			xBatch[ 0 ].usCore = ( uint16_t ) uxCore;
+			xBatch[ 0 ].ulValue = ulDropped;
+			( void ) fwrite( xBatch, sizeof( TraceEvent_t ), 1, pxTraceFile );
+		}
+	}
+
+	( void ) fflush( pxTraceFile );
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvTraceFlushTask, pvParameters )
+{
+TickType_t xLastWakeTime;
+
+	( void ) pvParameters;
+
+	xLastWakeTime = xTaskGetTickCount();
+
+	for( ;; )
+	{
+		vTaskDelayUntil( &xLastWakeTime, xTraceFlushPeriod );
+
+		xSemaphoreTake( xFlushMutex, portMAX_DELAY );
+		{
+			if( pxTraceFile != NULL )
+			{
+				prvFlushRings();
+			}
+		}
+		xSemaphoreGive( xFlushMutex );
+	}
+}
+
+#endif /* configUSE_TRACE_RECORDER */
@@ -0,0 +1,312 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * This header is included twice.  FreeRTOSConfig.h includes it when
+ * configUSE_TRACE_RECORDER is 1, before any FreeRTOS types are defined, so the
+ * first part defines the kernel trace macros and the recorded event format
+ * using only the standard integer types.  The offline converter in
+ * trace_to_json.c also includes it for the event format alone.  The second part
+ * declares the API used by the application, and is included once the FreeRTOS
+ * types are available - that is, when the application includes this header
+ * after FreeRTOS.h.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The trace recorder writes a fixed size binary event into a ring buffer each
+ * time the kernel calls one of its trace macros, such as traceTASK_SWITCHED_IN()
+ * and traceBLOCKING_ON_QUEUE_RECEIVE().  Each simulated core has its own ring,
+ * and any number of threads - the core's tasks and its simulated interrupt
+ * handlers - can write into it without a lock.  A flush task, created by
+ * xTraceRecorderStart(), streams the rings to a file.  The trace_to_json
+ * program converts the file to Chrome trace JSON, which can be opened in
+ * https://ui.perfetto.dev or chrome://tracing.
+ *
+ * An event is dropped, and counted, if the ring it is written to is full.  The
+ * flush task writes the number of dropped events into the file.
+ *
+ * \defgroup TraceRecorder
+ */
+
+/* The number of events each ring can hold.  Must be a power of 2. */
+#ifndef configTRACE_RECORDER_BUFFER_EVENTS
+	#define configTRACE_RECORDER_BUFFER_EVENTS	4096
+#endif
+
+/* Event IDs.  Where an event is about a kernel object, the object is the handle
+of that object, and the value is as given below. */
+#define traceEVENT_TASK_SWITCHED_IN			1	/* The object is the task that was switched in. */
+#define traceEVENT_TASK_CREATE				2	/* The value is the task's priority. */
+#define traceEVENT_TASK_DELETE				3
+#define traceEVENT_TASK_DELAY				4	/* The value is the number of ticks. */
+#define traceEVENT_TASK_DELAY_UNTIL			5	/* The value is the wake time. */
+#define traceEVENT_TASK_SUSPEND				6
+#define traceEVENT_TASK_RESUME				7
+#define traceEVENT_TASK_RESUME_FROM_ISR		8
+#define traceEVENT_TASK_READY				9	/* The task was moved to a ready list. */
+#define traceEVENT_TASK_PRIORITY_SET		10	/* The value is the new priority. */
+#define traceEVENT_TASK_PRIORITY_INHERIT	11	/* The value is the inherited priority. */
+#define traceEVENT_TASK_PRIORITY_DISINHERIT	12	/* The value is the priority returned to. */
+#define traceEVENT_TICK						16	/* The value is the tick count before it was incremented. */
+#define traceEVENT_TICK_JUMP				17	/* The value is the number of ticks the tick count was moved forward by after tickless idle. */
+#define traceEVENT_QUEUE_CREATE				32	/* The value is the queue type. */
+#define traceEVENT_QUEUE_DELETE				33
+#define traceEVENT_QUEUE_SEND				34
+#define traceEVENT_QUEUE_SEND_FAILED		35
+#define traceEVENT_QUEUE_SEND_FROM_ISR		36
+#define traceEVENT_QUEUE_RECEIVE			37
+#define traceEVENT_QUEUE_RECEIVE_FAILED		38
+#define traceEVENT_QUEUE_RECEIVE_FROM_ISR	39
+#define traceEVENT_QUEUE_PEEK				40
+#define traceEVENT_QUEUE_BLOCK_ON_SEND		41
+#define traceEVENT_QUEUE_BLOCK_ON_RECEIVE	42
+#define traceEVENT_EVENT_GROUP_CREATE		48
+#define traceEVENT_EVENT_GROUP_DELETE		49
+#define traceEVENT_EVENT_GROUP_SET_BITS		50	/* The value is the bits that were set. */
+#define traceEVENT_EVENT_GROUP_SET_BITS_FROM_ISR	51	/* The value is the bits that were set. */
+#define traceEVENT_EVENT_GROUP_CLEAR_BITS	52	/* The value is the bits that were cleared. */
+#define traceEVENT_EVENT_GROUP_WAIT_BLOCK	53	/* The value is the bits waited for. */
+#define traceEVENT_EVENT_GROUP_WAIT_END		54	/* The value is 1 if the wait timed out. */
+#define traceEVENT_EVENT_GROUP_SYNC_BLOCK	55	/* The value is the bits waited for. */
+#define traceEVENT_EVENT_GROUP_SYNC_END		56	/* The value is 1 if the wait timed out. */
+#define traceEVENT_TASK_NOTIFY				64	/* The object is the task that was notified, and the value is the index notified. */
+#define traceEVENT_TASK_NOTIFY_FROM_ISR		65	/* The object is the task that was notified, and the value is the index notified. */
+#define traceEVENT_TASK_NOTIFY_TAKE_BLOCK	66	/* The value is the index waited on. */
+#define traceEVENT_TASK_NOTIFY_WAIT_BLOCK	67	/* The value is the index waited on. */
+#define traceEVENT_OBJECT_NAME				80	/* ullTask holds up to 8 characters of the name of the object, and the value is the offset of the first of them in the name. */
+#define traceEVENT_DROPPED					81	/* The value is the number of events that were dropped from the core's ring since the last flush. */
+
+/**
+ * trace_recorder.h
+ *
+ * A recorded event.  Events are written to the file in this format, in the
+ * byte order of the host, after a TraceFileHeader_t.
+ *
+ * \defgroup TraceEvent_t TraceEvent_t
+ * \ingroup TraceRecorder
+ */
+typedef struct xTRACE_EVENT
+{
+	uint64_t ullTimestamp;	/* Nanoseconds from the host's monotonic clock. */
+	uint64_t ullObject;		/* The handle of the object the event is about. */
+	uint64_t ullTask;		/* The task that was running on the core when the event was recorded. */
+	uint16_t usEventID;		/* One of the traceEVENT_ values. */
+	uint16_t usCore;		/* The core the event was recorded on. */
+	uint32_t ulValue;
+} TraceEvent_t;
+
+/**
+ * trace_recorder.h
+ *
+ * The header at the start of a trace file.
+ *
+ * \defgroup TraceFileHeader_t TraceFileHeader_t
+ * \ingroup TraceRecorder
+ */
+#define traceFILE_MAGIC		"FRTRACE1"
+
+typedef struct xTRACE_FILE_HEADER
+{
+	char cMagic[ 8 ];		/* traceFILE_MAGIC, without the terminating null. */
+	uint32_t ulEventSize;	/* sizeof( TraceEvent_t ). */
+	uint32_t ulNumCores;
+	uint32_t ulTickRateHz;
+	uint32_t ulReserved;
+} TraceFileHeader_t;
+
+/* The kernel trace macros.  Only the event IDs above are recorded - the other
+trace macros keep their default empty definitions. */
+#if defined( configUSE_TRACE_RECORDER ) && ( configUSE_TRACE_RECORDER == 1 )
+
+	void vTraceRecordEvent( uint32_t ulEventID, const void *pvObject, uint32_t ulValue );
+	void vTraceRecordSwitchedIn( const void *pvTask );
+	void vTraceRecordName( const void *pvObject, const char *pcName );
+
+	/* Tasks. */
+	#define traceTASK_SWITCHED_IN()							vTraceRecordSwitchedIn( pxCurrentTCB )
+	#define traceTASK_CREATE( pxNewTCB )					vTraceRecordEvent( traceEVENT_TASK_CREATE, ( pxNewTCB ), ( uint32_t ) ( pxNewTCB )->uxPriority ); vTraceRecordName( ( pxNewTCB ), ( pxNewTCB )->pcTaskName )
+	#define traceTASK_DELETE( pxTCB )						vTraceRecordEvent( traceEVENT_TASK_DELETE, ( pxTCB ), 0UL )
+	#define traceTASK_DELAY()								vTraceRecordEvent( traceEVENT_TASK_DELAY, pxCurrentTCB, ( uint32_t ) xTicksToDelay )
+	#define traceTASK_DELAY_UNTIL( xTimeToWake )			vTraceRecordEvent( traceEVENT_TASK_DELAY_UNTIL, pxCurrentTCB, ( uint32_t ) ( xTimeToWake ) )
+	#define traceTASK_SUSPEND( pxTCB )						vTraceRecordEvent( traceEVENT_TASK_SUSPEND, ( pxTCB ), 0UL )
+	#define traceTASK_RESUME( pxTCB )						vTraceRecordEvent( traceEVENT_TASK_RESUME, ( pxTCB ), 0UL )
+	#define traceTASK_RESUME_FROM_ISR( pxTCB )				vTraceRecordEvent( traceEVENT_TASK_RESUME_FROM_ISR, ( pxTCB ), 0UL )
+	#define traceMOVED_TASK_TO_READY_STATE( pxTCB )			vTraceRecordEvent( traceEVENT_TASK_READY, ( pxTCB ), 0UL )
+	#define traceTASK_PRIORITY_SET( pxTCB, uxNewPriority )	vTraceRecordEvent( traceEVENT_TASK_PRIORITY_SET, ( pxTCB ), ( uint32_t ) ( uxNewPriority ) )
+	#define traceTASK_PRIORITY_INHERIT( pxTCB, uxPriority )	vTraceRecordEvent( traceEVENT_TASK_PRIORITY_INHERIT, ( pxTCB ), ( uint32_t ) ( uxPriority ) )
+	#define traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriority )	vTraceRecordEvent( traceEVENT_TASK_PRIORITY_DISINHERIT, ( pxTCB ), ( uint32_t ) ( uxPriority ) )
+	#define traceTASK_INCREMENT_TICK( xTickCount )			vTraceRecordEvent( traceEVENT_TICK, NULL, ( uint32_t ) ( xTickCount ) )
+	#define traceINCREASE_TICK_COUNT( xTicksToJump )		vTraceRecordEvent( traceEVENT_TICK_JUMP, NULL, ( uint32_t ) ( xTicksToJump ) )
+
+	/* Queues, semaphores and mutexes. */
+	#define traceQUEUE_CREATE( pxNewQueue )					vTraceRecordEvent( traceEVENT_QUEUE_CREATE, ( pxNewQueue ), ( uint32_t ) ucQueueType )
+	#define traceQUEUE_DELETE( pxQueue )					vTraceRecordEvent( traceEVENT_QUEUE_DELETE, ( pxQueue ), 0UL )
+	#define traceQUEUE_SEND( pxQueue )						vTraceRecordEvent( traceEVENT_QUEUE_SEND, ( pxQueue ), 0UL )
+	#define traceQUEUE_SEND_FAILED( pxQueue )				vTraceRecordEvent( traceEVENT_QUEUE_SEND_FAILED, ( pxQueue ), 0UL )
+	#define traceQUEUE_SEND_FROM_ISR( pxQueue )				vTraceRecordEvent( traceEVENT_QUEUE_SEND_FROM_ISR, ( pxQueue ), 0UL )
+	#define traceQUEUE_RECEIVE( pxQueue )					vTraceRecordEvent( traceEVENT_QUEUE_RECEIVE, ( pxQueue ), 0UL )
+	#define traceQUEUE_RECEIVE_FAILED( pxQueue )			vTraceRecordEvent( traceEVENT_QUEUE_RECEIVE_FAILED, ( pxQueue ), 0UL )
+	#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )			vTraceRecordEvent( traceEVENT_QUEUE_RECEIVE_FROM_ISR, ( pxQueue ), 0UL )
+	#define traceQUEUE_PEEK( pxQueue )						vTraceRecordEvent( traceEVENT_QUEUE_PEEK, ( pxQueue ), 0UL )
+	#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )			vTraceRecordEvent( traceEVENT_QUEUE_BLOCK_ON_SEND, ( pxQueue ), 0UL )
+	#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )		vTraceRecordEvent( traceEVENT_QUEUE_BLOCK_ON_RECEIVE, ( pxQueue ), 0UL )
+	#define traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName )	vTraceRecordName( ( xQueue ), ( pcQueueName ) )
+
+	/* Event groups. */
+	#define traceEVENT_GROUP_CREATE( xEventGroup )			vTraceRecordEvent( traceEVENT_EVENT_GROUP_CREATE, ( xEventGroup ), 0UL )
+	#define traceEVENT_GROUP_DELETE( xEventGroup )			vTraceRecordEvent( traceEVENT_EVENT_GROUP_DELETE, ( xEventGroup ), 0UL )
+	#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )			vTraceRecordEvent( traceEVENT_EVENT_GROUP_SET_BITS, ( xEventGroup ), ( uint32_t ) ( uxBitsToSet ) )
+	#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )	vTraceRecordEvent( traceEVENT_EVENT_GROUP_SET_BITS_FROM_ISR, ( xEventGroup ), ( uint32_t ) ( uxBitsToSet ) )
+	#define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear )		vTraceRecordEvent( traceEVENT_EVENT_GROUP_CLEAR_BITS, ( xEventGroup ), ( uint32_t ) ( uxBitsToClear ) )
+	#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )	vTraceRecordEvent( traceEVENT_EVENT_GROUP_WAIT_BLOCK, ( xEventGroup ), ( uint32_t ) ( uxBitsToWaitFor ) )
+	#define traceEVENT_GROUP_WAIT_BITS_END( xEventGroup, uxBitsToWaitFor, xTimeoutOccurred )	vTraceRecordEvent( traceEVENT_EVENT_GROUP_WAIT_END, ( xEventGroup ), ( uint32_t ) ( xTimeoutOccurred ) )
+	#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )	vTraceRecordEvent( traceEVENT_EVENT_GROUP_SYNC_BLOCK, ( xEventGroup ), ( uint32_t ) ( uxBitsToWaitFor ) )
+	#define traceEVENT_GROUP_SYNC_END( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTimeoutOccurred )	vTraceRecordEvent( traceEVENT_EVENT_GROUP_SYNC_END, ( xEventGroup ), ( uint32_t ) ( xTimeoutOccurred ) )
+
+	/* Task notifications.  pxTCB is the task being notified, and the value is
+	the index of the notification. */
+	#define traceTASK_NOTIFY( uxIndexToNotify )				vTraceRecordEvent( traceEVENT_TASK_NOTIFY, pxTCB, ( uint32_t ) ( uxIndexToNotify ) )
+	#define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )	vTraceRecordEvent( traceEVENT_TASK_NOTIFY_FROM_ISR, pxTCB, ( uint32_t ) ( uxIndexToNotify ) )
+	#define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )	vTraceRecordEvent( traceEVENT_TASK_NOTIFY_FROM_ISR, pxTCB, ( uint32_t ) ( uxIndexToNotify ) )
+	#define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )	vTraceRecordEvent( traceEVENT_TASK_NOTIFY_TAKE_BLOCK, pxCurrentTCB, ( uint32_t ) ( uxIndexToWait ) )
+	#define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )	vTraceRecordEvent( traceEVENT_TASK_NOTIFY_WAIT_BLOCK, pxCurrentTCB, ( uint32_t ) ( uxIndexToWait ) )
+
+#endif /* configUSE_TRACE_RECORDER */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_RECORDER_H */
+
+/* The application API, which needs the FreeRTOS types. */
+#if defined( PORTMACRO_H ) && !defined( TRACE_RECORDER_API_H )
+#define TRACE_RECORDER_API_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * trace_recorder.h
+ * <pre>
+ BaseType_t xTraceRecorderStart( const char *pcFileName, TickType_t xFlushPeriod, UBaseType_t uxPriority );
+ </pre>
+ *
+ * Create pcFileName and the task that streams the recorded events to it.
+ * Events are recorded from the time the program starts, so if this is called
+ * before the application creates its tasks and queues the file also names
+ * them.  Must be called once, before vTraceRecorderStop().
+ *
+ * @param pcFileName The file to write the trace to.  An existing file is
+ * overwritten.
+ *
+ * @param xFlushPeriod The time between flushes of the rings, in ticks.  Each
+ * core must record fewer than configTRACE_RECORDER_BUFFER_EVENTS events in
+ * this time, or events are dropped.
+ *
+ * @param uxPriority The priority of the flush task.
+ *
+ * @return pdPASS if the file was created and the flush task was created,
+ * otherwise pdFAIL.
+ *
+ * \defgroup xTraceRecorderStart xTraceRecorderStart
+ * \ingroup TraceRecorder
+ */
+BaseType_t xTraceRecorderStart( const char *pcFileName, TickType_t xFlushPeriod, UBaseType_t uxPriority );
+
+/**
+ * trace_recorder.h
+ * <pre>
+ void vTraceRecorderStop( void );
+ </pre>
+ *
+ * Write any events still in the rings to the file, and close it.  Call it
+ * before the program exits, from a task.  Events recorded afterwards are
+ * discarded.
+ *
+ * \defgroup vTraceRecorderStop vTraceRecorderStop
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderStop( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
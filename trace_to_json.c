@@ -0,0 +1,549 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * Converts a trace file written by the trace recorder (see trace_recorder.h) to
+ * Chrome trace JSON, which can be opened in https://ui.perfetto.dev or
+ * chrome://tracing.  It is a host program, so is built on its own:
+ *
+ *   gcc -O2 -I. trace_to_json.c -o trace_to_json
+ *   ./trace_to_json trace.bin trace.json
+ *
+ * The timeline has a row for each core, showing the task running on it, and a
+ * row for each task, showing when it ran, what it was blocked on and for how
+ * long, and its queue, event group and notification activity.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace_recorder.h"
+
+/* The row that holds the tasks' timelines, and the row that holds the cores'. */
+#define tjPID_CORES		0
+#define tjPID_TASKS		1
+
+#define tjMAX_NAME_LENGTH	40
+
+typedef struct xOBJECT
+{
+	uint64_t ullHandle;
+	char cName[ tjMAX_NAME_LENGTH ];
+	int iIsTask;
+	int iRow;							/* The task's row, if the object is a task. */
+	int iWaiting;						/* Non-zero while the task is blocked. */
+	uint64_t ullWaitStart;
+	char cWaitName[ tjMAX_NAME_LENGTH + 16 ];
+} Object_t;
+
+typedef struct xRECORD
+{
+	TraceEvent_t xEvent;
+	size_t xIndex;						/* The position in the file, so the sort is stable. */
+} Record_t;
+
+static Object_t *pxObjects = NULL;
+static size_t xObjectCount = 0, xObjectSpace = 0;
+static int iTaskCount = 0;
+static uint64_t ullStartTime = 0;
+static FILE *pxOutput = NULL;
+static int iFirstOutput = 1;
+
+/*-----------------------------------------------------------*/
+
+static Object_t *prvFindObject( uint64_t ullHandle )
+{
+size_t x;
+
+	for( x = 0; x < xObjectCount; x++ )
+	{
+		if( pxObjects[ x ].ullHandle == ullHandle )
+		{
+			return &( pxObjects[ x ] );
+		}
+	}
+
+	if( xObjectCount == xObjectSpace )
+	{
+		xObjectSpace = ( xObjectSpace == 0 ) ? 64 : xObjectSpace * 2;
+		pxObjects = realloc( pxObjects, xObjectSpace * sizeof( Object_t ) );
+
+		if( pxObjects == NULL )
+		{
+			fprintf( stderr, "Out of memory\n" );
+			exit( 1 );
+		}
+	}
+
+	memset( &( pxObjects[ xObjectCount ] ), 0x00, sizeof( Object_t ) );
+	pxObjects[ xObjectCount ].ullHandle = ullHandle;
+	snprintf( pxObjects[ xObjectCount ].cName, tjMAX_NAME_LENGTH, "0x%llx", ( unsigned long long ) ullHandle );
+
+	return &( pxObjects[ xObjectCount++ ] );
+}
+/*-----------------------------------------------------------*/
+
+static Object_t *prvFindTask( uint64_t ullHandle )
+{
+Object_t *pxTask = prvFindObject( ullHandle );
+
+	if( pxTask->iIsTask == 0 )
+	{
+		pxTask->iIsTask = 1;
+		pxTask->iRow = ++iTaskCount;
+	}
+
+	return pxTask;
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareRecords( const void *pv1, const void *pv2 )
+{
+const Record_t *px1 = pv1, *px2 = pv2;
+
+	if( px1->xEvent.ullTimestamp != px2->xEvent.ullTimestamp )
+	{
+		return ( px1->xEvent.ullTimestamp < px2->xEvent.ullTimestamp ) ? -1 : 1;
+	}
+
+	return ( px1->xIndex < px2->xIndex ) ? -1 : 1;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteSeparator( void )
+{
+	fprintf( pxOutput, iFirstOutput ? "\n" : ",\n" );
+	iFirstOutput = 0;
+}
+/*-----------------------------------------------------------*/
+
+/* Names come from the application, so quotes and backslashes are escaped. */
+static void prvWriteString( const char *pcString )
+{
+	fputc( '"', pxOutput );
+
+	for( ; *pcString != 0x00; pcString++ )
+	{
+		if( ( *pcString == '"' ) || ( *pcString == '\\' ) )
+		{
+			fputc( '\\', pxOutput );
+		}
+
+		if( ( unsigned char ) *pcString >= ' ' )
+		{
+			fputc( *pcString, pxOutput );
+		}
+	}
+
+	fputc( '"', pxOutput );
+}
+/*-----------------------------------------------------------*/
+
+static double prvMicroseconds( uint64_t ullTimestamp )
+{
+	return ( double ) ( ullTimestamp - ullStartTime ) / 1000.0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteMetadata( int iPid, int iTid, const char *pcName, int iSortIndex )
+{
+	prvWriteSeparator();
+	fprintf( pxOutput, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_name\",\"args\":{\"name\":", iPid, iTid );
+	prvWriteString( pcName );
+	fprintf( pxOutput, "}}" );
+
+	prvWriteSeparator();
+	fprintf( pxOutput, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%d}}", iPid, iTid, iSortIndex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteSlice( int iPid, int iTid, const char *pcName, uint64_t ullStart, uint64_t ullEnd )
+{
+	prvWriteSeparator();
+	fprintf( pxOutput, "{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"name\":", iPid, iTid );
+	prvWriteString( pcName );
+	fprintf( pxOutput, ",\"ts\":%.3f,\"dur\":%.3f}", prvMicroseconds( ullStart ), prvMicroseconds( ullEnd ) - prvMicroseconds( ullStart ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriteInstant( int iPid, int iTid, const char *pcName, uint64_t ullTime, unsigned long ulValue )
+{
+	prvWriteSeparator();
+	fprintf( pxOutput, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"name\":", iPid, iTid );
+	prvWriteString( pcName );
+	fprintf( pxOutput, ",\"ts\":%.3f,\"args\":{\"value\":%lu}}", prvMicroseconds( ullTime ), ulValue );
+}
+/*-----------------------------------------------------------*/
+
+static const char *prvDescribeEvent( uint16_t usEventID )
+{
+	switch( usEventID )
+	{
+		case traceEVENT_QUEUE_BLOCK_ON_SEND:			return "wait to send to";
+		case traceEVENT_QUEUE_BLOCK_ON_RECEIVE:			return "wait to receive from";
+		case traceEVENT_EVENT_GROUP_WAIT_BLOCK:			return "wait for bits of";
+		case traceEVENT_EVENT_GROUP_SYNC_BLOCK:			return "sync on";
+		case traceEVENT_QUEUE_SEND:						return "send to";
+		case traceEVENT_QUEUE_SEND_FAILED:				return "send failed to";
+		case traceEVENT_QUEUE_RECEIVE:					return "receive from";
+		case traceEVENT_QUEUE_RECEIVE_FAILED:			return "receive failed from";
+		case traceEVENT_QUEUE_PEEK:						return "peek";
+		case traceEVENT_EVENT_GROUP_SET_BITS:			return "set bits of";
+		case traceEVENT_EVENT_GROUP_CLEAR_BITS:			return "clear bits of";
+		case traceEVENT_TASK_NOTIFY:					return "notify";
+		case traceEVENT_QUEUE_SEND_FROM_ISR:			return "ISR send to";
+		case traceEVENT_QUEUE_RECEIVE_FROM_ISR:			return "ISR receive from";
+		case traceEVENT_EVENT_GROUP_SET_BITS_FROM_ISR:	return "ISR set bits of";
+		case traceEVENT_TASK_NOTIFY_FROM_ISR:			return "ISR notify";
+		case traceEVENT_TASK_RESUME_FROM_ISR:			return "ISR resume";
+		default:										return "event";
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Start a wait for the task, named after what it is waiting for. */
+static void prvStartWait( Object_t *pxTask, const char *pcWhat, const Object_t *pxObject, uint64_t ullTime )
+{
+	pxTask->iWaiting = 1;
+	pxTask->ullWaitStart = ullTime;
+
+	if( pxObject != NULL )
+	{
+		snprintf( pxTask->cWaitName, sizeof( pxTask->cWaitName ), "%s %s", pcWhat, pxObject->cName );
+	}
+	else
+	{
+		snprintf( pxTask->cWaitName, sizeof( pxTask->cWaitName ), "%s", pcWhat );
+	}
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+FILE *pxInput;
+TraceFileHeader_t xHeader;
+Record_t *pxRecords = NULL;
+size_t xRecordCount = 0, xRecordSpace = 0, x;
+unsigned long ulDropped = 0;
+uint32_t ulCore;
+char cName[ tjMAX_NAME_LENGTH + 32 ];
+
+/* The task running on each core, and when it was switched in. */
+Object_t **ppxRunning;
+uint64_t *pullRunningSince;
+
+	if( argc != 3 )
+	{
+		fprintf( stderr, "Usage: %s trace-file json-file\n", argv[ 0 ] );
+		return 1;
+	}
+
+	pxInput = fopen( argv[ 1 ], "rb" );
+
+	if( pxInput == NULL )
+	{
+		fprintf( stderr, "Cannot open %s\n", argv[ 1 ] );
+		return 1;
+	}
+
+	if( ( fread( &xHeader, sizeof( xHeader ), 1, pxInput ) != 1 ) ||
+		( memcmp( xHeader.cMagic, traceFILE_MAGIC, sizeof( xHeader.cMagic ) ) != 0 ) ||
+		( xHeader.ulEventSize != sizeof( TraceEvent_t ) ) ||
+		( xHeader.ulNumCores == 0 ) )
+	{
+		fprintf( stderr, "%s is not a trace file written by this version of the trace recorder\n", argv[ 1 ] );
+		return 1;
+	}
+
+	/* Read every event.  The file holds a batch from each core in turn, so the
+	events are sorted back into time order. */
+	for( ;; )
+	{
+		if( xRecordCount == xRecordSpace )
+		{
+			xRecordSpace = ( xRecordSpace == 0 ) ? 65536 : xRecordSpace * 2;
+			pxRecords = realloc( pxRecords, xRecordSpace * sizeof( Record_t ) );
+
+			if( pxRecords == NULL )
+			{
+				fprintf( stderr, "Out of memory\n" );
+				return 1;
+			}
+		}
+
+		if( fread( &( pxRecords[ xRecordCount ].xEvent ), sizeof( TraceEvent_t ), 1, pxInput ) != 1 )
+		{
+			break;
+		}
+
+		pxRecords[ xRecordCount ].xIndex = xRecordCount;
+		xRecordCount++;
+	}
+
+	fclose( pxInput );
+
+	if( xRecordCount == 0 )
+	{
+		fprintf( stderr, "%s holds no events\n", argv[ 1 ] );
+		return 1;
+	}
+
+	qsort( pxRecords, xRecordCount, sizeof( Record_t ), prvCompareRecords );
+	ullStartTime = pxRecords[ 0 ].xEvent.ullTimestamp;
+
+	/* Names are recorded when objects are created, or added to the queue
+	registry, so collect them all before writing any events that use them. */
+	for( x = 0; x < xRecordCount; x++ )
+	{
+	const TraceEvent_t *pxEvent = &( pxRecords[ x ].xEvent );
+	Object_t *pxObject;
+
+		if( pxEvent->usEventID == traceEVENT_OBJECT_NAME )
+		{
+			pxObject = prvFindObject( pxEvent->ullObject );
+
+			if( pxEvent->ulValue + sizeof( pxEvent->ullTask ) < tjMAX_NAME_LENGTH )
+			{
+				if( pxEvent->ulValue == 0 )
+				{
+					memset( pxObject->cName, 0x00, sizeof( pxObject->cName ) );
+				}
+
+				memcpy( &( pxObject->cName[ pxEvent->ulValue ] ), &( pxEvent->ullTask ), sizeof( pxEvent->ullTask ) );
+			}
+		}
+		else if( ( pxEvent->usEventID == traceEVENT_TASK_CREATE ) || ( pxEvent->usEventID == traceEVENT_TASK_SWITCHED_IN ) )
+		{
+			( void ) prvFindTask( pxEvent->ullObject );
+		}
+	}
+
+	pxOutput = fopen( argv[ 2 ], "w" );
+
+	if( pxOutput == NULL )
+	{
+		fprintf( stderr, "Cannot create %s\n", argv[ 2 ] );
+		return 1;
+	}
+
+	fprintf( pxOutput, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" );
+
+	prvWriteSeparator();
+	fprintf( pxOutput, "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\",\"args\":{\"name\":\"Cores\"}}", tjPID_CORES );
+	prvWriteSeparator();
+	fprintf( pxOutput, "{\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\",\"args\":{\"name\":\"Tasks\"}}", tjPID_TASKS );
+
+	for( ulCore = 0; ulCore < xHeader.ulNumCores; ulCore++ )
+	{
+		snprintf( cName, sizeof( cName ), "Core %u", ( unsigned ) ulCore );
+		prvWriteMetadata( tjPID_CORES, ( int ) ulCore, cName, ( int ) ulCore );
+	}
+
+	for( x = 0; x < xObjectCount; x++ )
+	{
+		if( pxObjects[ x ].iIsTask != 0 )
+		{
+			prvWriteMetadata( tjPID_TASKS, pxObjects[ x ].iRow, pxObjects[ x ].cName, pxObjects[ x ].iRow );
+		}
+	}
+
+	ppxRunning = calloc( xHeader.ulNumCores, sizeof( Object_t * ) );
+	pullRunningSince = calloc( xHeader.ulNumCores, sizeof( uint64_t ) );
+
+	if( ( ppxRunning == NULL ) || ( pullRunningSince == NULL ) )
+	{
+		fprintf( stderr, "Out of memory\n" );
+		return 1;
+	}
+
+	for( x = 0; x < xRecordCount; x++ )
+	{
+	const TraceEvent_t *pxEvent = &( pxRecords[ x ].xEvent );
+	Object_t *pxObject = NULL, *pxTask = NULL;
+
+		ulCore = ( pxEvent->usCore < xHeader.ulNumCores ) ? pxEvent->usCore : 0;
+
+		if( pxEvent->ullTask != 0 )
+		{
+			pxTask = prvFindTask( pxEvent->ullTask );
+		}
+
+		switch( pxEvent->usEventID )
+		{
+			case traceEVENT_TASK_SWITCHED_IN:
+				/* Close the slice of the task that was running on the core. */
+				if( ppxRunning[ ulCore ] != NULL )
+				{
+					prvWriteSlice( tjPID_CORES, ( int ) ulCore, ppxRunning[ ulCore ]->cName, pullRunningSince[ ulCore ], pxEvent->ullTimestamp );
+					snprintf( cName, sizeof( cName ), "running on core %u", ( unsigned ) ulCore );
+					prvWriteSlice( tjPID_TASKS, ppxRunning[ ulCore ]->iRow, cName, pullRunningSince[ ulCore ], pxEvent->ullTimestamp );
+				}
+
+				ppxRunning[ ulCore ] = prvFindTask( pxEvent->ullObject );
+				pullRunningSince[ ulCore ] = pxEvent->ullTimestamp;
+				break;
+
+			case traceEVENT_TASK_READY:
+				/* A task leaving the Blocked state ends its wait. */
+				pxObject = prvFindTask( pxEvent->ullObject );
+
+				if( pxObject->iWaiting != 0 )
+				{
+					prvWriteSlice( tjPID_TASKS, pxObject->iRow, pxObject->cWaitName, pxObject->ullWaitStart, pxEvent->ullTimestamp );
+					pxObject->iWaiting = 0;
+				}
+				break;
+
+			case traceEVENT_TASK_DELAY:
+			case traceEVENT_TASK_DELAY_UNTIL:
+				prvStartWait( prvFindTask( pxEvent->ullObject ), "delay", NULL, pxEvent->ullTimestamp );
+				break;
+
+			case traceEVENT_TASK_NOTIFY_TAKE_BLOCK:
+			case traceEVENT_TASK_NOTIFY_WAIT_BLOCK:
+				prvStartWait( prvFindTask( pxEvent->ullObject ), "wait for notification", NULL, pxEvent->ullTimestamp );
+				break;
+
+			case traceEVENT_QUEUE_BLOCK_ON_SEND:
+			case traceEVENT_QUEUE_BLOCK_ON_RECEIVE:
+			case traceEVENT_EVENT_GROUP_WAIT_BLOCK:
+			case traceEVENT_EVENT_GROUP_SYNC_BLOCK:
+				if( pxTask != NULL )
+				{
+					prvStartWait( pxTask, prvDescribeEvent( pxEvent->usEventID ), prvFindObject( pxEvent->ullObject ), pxEvent->ullTimestamp );
+				}
+				break;
+
+			case traceEVENT_QUEUE_SEND:
+			case traceEVENT_QUEUE_SEND_FAILED:
+			case traceEVENT_QUEUE_RECEIVE:
+			case traceEVENT_QUEUE_RECEIVE_FAILED:
+			case traceEVENT_QUEUE_PEEK:
+			case traceEVENT_EVENT_GROUP_SET_BITS:
+			case traceEVENT_EVENT_GROUP_CLEAR_BITS:
+			case traceEVENT_TASK_NOTIFY:
+				if( pxTask != NULL )
+				{
+					snprintf( cName, sizeof( cName ), "%s %s", prvDescribeEvent( pxEvent->usEventID ), prvFindObject( pxEvent->ullObject )->cName );
+					prvWriteInstant( tjPID_TASKS, pxTask->iRow, cName, pxEvent->ullTimestamp, ( unsigned long ) pxEvent->ulValue );
+				}
+				break;
+
+			case traceEVENT_QUEUE_SEND_FROM_ISR:
+			case traceEVENT_QUEUE_RECEIVE_FROM_ISR:
+			case traceEVENT_EVENT_GROUP_SET_BITS_FROM_ISR:
+			case traceEVENT_TASK_NOTIFY_FROM_ISR:
+			case traceEVENT_TASK_RESUME_FROM_ISR:
+				/* Interrupts are shown on the core they interrupted. */
+				snprintf( cName, sizeof( cName ), "%s %s", prvDescribeEvent( pxEvent->usEventID ), prvFindObject( pxEvent->ullObject )->cName );
+				prvWriteInstant( tjPID_CORES, ( int ) ulCore, cName, pxEvent->ullTimestamp, ( unsigned long ) pxEvent->ulValue );
+				break;
+
+			case traceEVENT_TICK:
+				prvWriteSeparator();
+				fprintf( pxOutput, "{\"ph\":\"C\",\"pid\":%d,\"name\":\"tick count\",\"ts\":%.3f,\"args\":{\"tick\":%lu}}", tjPID_CORES, prvMicroseconds( pxEvent->ullTimestamp ), ( unsigned long ) pxEvent->ulValue + 1UL );
+				break;
+
+			case traceEVENT_DROPPED:
+				ulDropped += ( unsigned long ) pxEvent->ulValue;
+				prvWriteInstant( tjPID_CORES, ( int ) ulCore, "events dropped", pxEvent->ullTimestamp, ( unsigned long ) pxEvent->ulValue );
+				break;
+
+			default:
+				/* Creation, deletion, names and priority changes are not shown
+				on the timeline. */
+				break;
+		}
+	}
+
+	/* Close the slices that were still open at the end of the trace. */
+	for( ulCore = 0; ulCore < xHeader.ulNumCores; ulCore++ )
+	{
+		if( ppxRunning[ ulCore ] != NULL )
+		{
+			prvWriteSlice( tjPID_CORES, ( int ) ulCore, ppxRunning[ ulCore ]->cName, pullRunningSince[ ulCore ], pxRecords[ xRecordCount - 1 ].xEvent.ullTimestamp );
+		}
+	}
+
+	for( x = 0; x < xObjectCount; x++ )
+	{
+		if( pxObjects[ x ].iWaiting != 0 )
+		{
+			prvWriteSlice( tjPID_TASKS, pxObjects[ x ].iRow, pxObjects[ x ].cWaitName, pxObjects[ x ].ullWaitStart, pxRecords[ xRecordCount - 1 ].xEvent.ullTimestamp );
+		}
+	}
+
+	fprintf( pxOutput, "\n]}\n" );
+	fclose( pxOutput );
+
+	printf( "%lu events, %lu dropped, %.3f ms\n", ( unsigned long ) xRecordCount, ulDropped, prvMicroseconds( pxRecords[ xRecordCount - 1 ].xEvent.ullTimestamp ) / 1000.0 );
+
+	return 0;
+}
@@ -0,0 +1,252 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * A benchmark of the zero-copy queue functions (configUSE_QUEUE_ZERO_COPY)
+ * against the copying ones, for items of 28 bytes (the I2C payload of main.c),
+ * 1 KiB and 64 KiB.  zcbITEM_SIZES[] sets the item sizes.
+ *
+ * For each item size one task passes zcbITEMS items through a queue, one at a
+ * time, in two ways:
+ *
+ * + Copying - the item is written into a buffer of the task, copied into the
+ *   queue by xQueueSend(), copied out into the buffer by xQueueReceive(), then
+ *   read from the buffer.
+ *
+ * + Zero-copy - the item is written in place in the slot reserved by
+ *   xQueueSendReserve() and posted by xQueueSendCommit(), then read in place
+ *   from the slot obtained by xQueueReceiveAcquire() and removed by
+ *   xQueueReceiveRelease().
+ *
+ * Both ways write every byte of the item and read its first and last bytes,
+ * so they differ only in the queue calls and the copies.  The time per item
+ * and the throughput are printed for each.  The zero-copy functions take twice
+ * as many critical sections per item, so they only pay off once the copies
+ * cost more than the critical sections.
+ *
+ * The queues are statically allocated.  The benchmark is built in place of
+ * main.c:
+ *
+ *   gcc -O2 -I. -DconfigUSE_QUEUE_ZERO_COPY=1 zero_copy_benchmark.c croutine.c cpu_profiler.c event_groups.c heap_4.c list.c port.c port_posix.c port_posix_smp.c port_posix_fiber.c queue.c supporting_functions.c tasks.c timers.c trace_recorder.c -o zero_copy_benchmark -lpthread
+ *   ./zero_copy_benchmark
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#if( configUSE_QUEUE_ZERO_COPY != 1 )
+	#error The benchmark must be built with configUSE_QUEUE_ZERO_COPY set to 1.
+#endif
+
+#define zcbMAX_ITEM_SIZE		( 65536UL )
+#define zcbQUEUE_LENGTH			( 4UL )
+#define zcbBYTES				( 1024UL * 1024UL * 1024UL )
+#define zcbRUNS					( 5 )
+
+/* At least 100000 items, and at least zcbBYTES bytes, are passed through the
+queue for each item size. */
+#define zcbITEMS( ulSize )		( ( ( zcbBYTES / ( ulSize ) ) > 100000UL ) ? ( zcbBYTES / ( ulSize ) ) : 100000UL )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Times both ways of passing items for each item size, prints the results and
+ * exits.
+ */
+static void prvBenchmarkTask( void *pvParameters );
+
+/*
+ * The nanoseconds per item of the fastest of zcbRUNS runs of passing items of
+ * ulSize bytes through xQueue, copying them or not as given by xZeroCopy.
+ */
+static double prvTimeItems( QueueHandle_t xQueue, uint32_t ulSize, BaseType_t xZeroCopy );
+
+/*
+ * The host's monotonic clock in nanoseconds.
+ */
+static double prvNanoseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static const uint32_t zcbITEM_SIZES[] = { 28UL, 1024UL, 65536UL };
+
+static StaticQueue_t xStaticQueue;
+static uint8_t ucQueueStorage[ zcbQUEUE_LENGTH * zcbMAX_ITEM_SIZE ];
+
+/* The buffer of the task that copied items are written to and read from. */
+static uint8_t ucItemBuffer[ zcbMAX_ITEM_SIZE ];
+
+/* Stops the reads of the items being optimised away. */
+static volatile uint32_t ulItemsRead = 0UL;
+
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvBenchmarkTask, "BENCH", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL );
+
+	vTaskStartScheduler();
+
+	for( ;; );
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+QueueHandle_t xQueue;
+double dCopy, dZeroCopy;
+size_t x;
+
+	( void ) pvParameters;
+
+	printf( "Item size  Copy (ns per item, MB/s)  Zero-copy (ns per item, MB/s)\n" );
+
+	for( x = 0; x < sizeof( zcbITEM_SIZES ) / sizeof( zcbITEM_SIZES[ 0 ] ); x++ )
+	{
+		xQueue = xQueueCreateStatic( zcbQUEUE_LENGTH, zcbITEM_SIZES[ x ], ucQueueStorage, &xStaticQueue );
+		configASSERT( xQueue );
+
+		dCopy = prvTimeItems( xQueue, zcbITEM_SIZES[ x ], pdFALSE );
+		dZeroCopy = prvTimeItems( xQueue, zcbITEM_SIZES[ x ], pdTRUE );
+
+		printf( "%-10lu %8.1f %10.0f       %8.1f %10.0f\n", ( unsigned long ) zcbITEM_SIZES[ x ],
+				dCopy, ( ( double ) zcbITEM_SIZES[ x ] * 1000.0 ) / dCopy,
+				dZeroCopy, ( ( double ) zcbITEM_SIZES[ x ] * 1000.0 ) / dZeroCopy );
+
+		vQueueDelete( xQueue );
+	}
+
+	exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+static double prvTimeItems( QueueHandle_t xQueue, uint32_t ulSize, BaseType_t xZeroCopy )
+{
+uint32_t ulItem, ulItems = zcbITEMS( ulSize );
+uint8_t *pucItem;
+int iRun;
+double dStart, dTime, dFastest = 0.0;
+
+	/* The fastest run is the one least disturbed by the host. */
+	for( iRun = 0; iRun < zcbRUNS; iRun++ )
+	{
+		dStart = prvNanoseconds();
+
+		for( ulItem = 0; ulItem < ulItems; ulItem++ )
+		{
+			if( xZeroCopy != pdFALSE )
+			{
+				xQueueSendReserve( xQueue, ( void ** ) &pucItem, portMAX_DELAY );
+				memset( pucItem, ( int ) ( ulItem & 0xffUL ), ulSize );
+				xQueueSendCommit( xQueue );
+
+				xQueueReceiveAcquire( xQueue, ( void ** ) &pucItem, portMAX_DELAY );
+				ulItemsRead += ( uint32_t ) pucItem[ 0 ] + ( uint32_t ) pucItem[ ulSize - 1UL ];
+				xQueueReceiveRelease( xQueue );
+			}
+			else
+			{
+				memset( ucItemBuffer, ( int ) ( ulItem & 0xffUL ), ulSize );
+				xQueueSend( xQueue, ucItemBuffer, portMAX_DELAY );
+
+				xQueueReceive( xQueue, ucItemBuffer, portMAX_DELAY );
+				ulItemsRead += ( uint32_t ) ucItemBuffer[ 0 ] + ( uint32_t ) ucItemBuffer[ ulSize - 1UL ];
+			}
+		}
+
+		dTime = prvNanoseconds() - dStart;
+
+		if( ( iRun == 0 ) || ( dTime < dFastest ) )
+		{
+			dFastest = dTime;
+		}
+	}
+
+	return dFastest / ( double ) ulItems;
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( double ) xNow.tv_sec * 1000000000.0 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/